@@ -129,8 +129,6 @@ const char * PROGRAM_VERSION = "0.2";
 #include <../../include/seqan/sequence/iterator_range.h>
 #endif
 
-#include "index_qgram_parallel.h"
-
 //Boost Math headers
 #include <boost/math/distributions.hpp>
 #include <boost/math/special_functions/binomial.hpp>
@@ -4708,7 +4706,7 @@ unsigned correctReads(
         for (TQGramDirSize i = endBucket; i < dirLen - 1; ++i)
             dir[i] = (TQGramDirValue)-1;
 
-        resize(indexSA(qgramIndex), _qgramCummulativeSum(indexDir(qgramIndex), True(), True(), Unsigned<1>(), Parallel()), Exact());
+        resize(indexSA(qgramIndex), _qgramCummulativeSum(indexDir(qgramIndex), True(), Parallel()), Exact());
         _qgramFillSuffixArray(indexSA(qgramIndex), indexText(qgramIndex), indexShape(qgramIndex), indexDir(qgramIndex), qgramIndex.bucketMap, getStepSize(qgramIndex), True(), Parallel());
         _qgramPostprocessBuckets(indexDir(qgramIndex), Parallel());
         
@@ -52,7 +52,7 @@ _loadSequences(TSeqSet& sequences, TNameSet& fastaIDs, const char *fileName)
 
 template <typename TAlphabet, typename TScore>
 inline void
-customizedMsaAlignment(MsaOptions<TAlphabet, TScore> const& msaOpt)
+customizedMsaAlignment(MsaOptions<TAlphabet, TScore> const& msaOpt, int numThreads)
 {
     typedef String<TAlphabet> TSequence;
     StringSet<TSequence, Owner<> > sequenceSet;
@@ -64,8 +64,16 @@ customizedMsaAlignment(MsaOptions<TAlphabet, TScore> const& msaOpt)
     // Alignment of the sequences
     Graph<Alignment<StringSet<TSequence, Dependent<> >, void, WithoutEdgeId> > gAlign;
 
-    // MSA
-    globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt);
+    // MSA, the library and the progressive alignment use all threads
+    if (numThreads > 1)
+    {
+        omp_set_num_threads(numThreads);
+        globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt, Parallel());
+    }
+    else
+    {
+        globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt, Serial());
+    }
 
     // Alignment output
     TOutStream outStream;
@@ -226,6 +234,8 @@ _initMsaParams(ArgumentParser& parser, TScore& scMat)
         msaOpt.build = 3;
     else if (optionVal == "wavg")
         msaOpt.build = 4;
+    else if (optionVal == "mbed")
+        msaOpt.build = 5;
 
     // Set alignment evaluation	options
     getOptionValue(msaOpt.infile, parser, "infile");
@@ -250,7 +260,9 @@ _initMsaParams(ArgumentParser& parser, TScore& scMat)
             printShortHelp(parser, std::cerr);	// print short help and exit
             exit(0);
         }
-        customizedMsaAlignment(msaOpt);
+        int numThreads = 1;
+        getOptionValue(numThreads, parser, "threads");
+        customizedMsaAlignment(msaOpt, numThreads);
     }
 }
 
@@ -343,6 +355,10 @@ _setUpArgumentParser(ArgumentParser & parser)
     setValidValues(parser, "outfile", outputFormats);
 
 
+    addOption(parser, ArgParseOption("t", "threads", "Number of threads to use.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "threads", "1");
+    setDefaultValue(parser, "threads", 1);
+
   //  addOption(parser, ArgParseOption("f", "format", "Format of the output.", ArgParseArgument::STRING));
  //   setValidValues(parser, "format", "fasta msf");
  //   setDefaultValue(parser, "format", "fasta");
@@ -407,11 +423,13 @@ _setUpArgumentParser(ArgumentParser & parser)
                     "Method to build the tree. "
                     "Following methods are provided: \\fINeighbor-Joining\\fP (\\fBnj\\fP), \\fIUPGMA single linkage\\fP "
                     "(\\fBmin\\fP), \\fIUPGMA complete linkage\\fP (\\fBmax\\fP), \\fIUPGMA average linkage\\fP "
-                    "(\\fBavg\\fP), \\fIUPGMA weighted average linkage\\fP (\\fBwavg\\fP). "
-                    "\\fINeighbor-Joining\\fP creates an unrooted tree, which we root at the last joined pair.",
+                    "(\\fBavg\\fP), \\fIUPGMA weighted average linkage\\fP (\\fBwavg\\fP), \\fIk-mer embedding\\fP "
+                    "(\\fBmbed\\fP). "
+                    "\\fINeighbor-Joining\\fP creates an unrooted tree, which we root at the last joined pair. "
+                    "The \\fIk-mer embedding\\fP needs no distance matrix and is meant for thousands of sequences.",
                     ArgParseArgument::STRING));
     setDefaultValue(parser, "build", "nj");
-    setValidValues(parser, "build", "nj min max avg wavg");
+    setValidValues(parser, "build", "nj min max avg wavg mbed");
 
     addSection(parser, "Alignment Evaluation Options:");
     addOption(
@@ -60,6 +60,17 @@ def main(source_base, binary_base):
                       ph.outFile('%s.fasta' % fname))])
         conf_list.append(conf)
 
+    # Run with several threads, the output does not change.
+    for fname in ['1aab', '1ad2', '2trx']:
+        conf = app_tests.TestConf(
+            program=path_to_program,
+            args=['-t', '4',
+                  '-s', ph.inFile('%s.fa' % fname),
+                  '-o', ph.outFile('%s.t4.fasta' % fname)],
+            to_diff=[(ph.inFile('%s.fasta' % fname),
+                      ph.outFile('%s.t4.fasta' % fname))])
+        conf_list.append(conf)
+
     # Run with explicit alphabet.
     for fname in ['1aab', '1ad2', '2trx']:
         conf = app_tests.TestConf(
@@ -23,6 +23,7 @@
 
 #include <seqan/arg_parse.h>
 #include <seqan/index.h>
+#include <seqan/parallel.h>
 #include <seqan/seq_io.h>
 
 #include "stellar.h"
@@ -136,54 +137,277 @@ struct FunctorComplement<AminoAcid>:
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Initializes a Pattern object with the query sequences,
-//  and calls _stellarOnOne for each database sequence
-template <typename TSequence, typename TId>
+// Initializes a Finder object for a database sequence and calls stellar
+//  for the queries of one q-gram index. Used by the parallel mode, thus it
+//  prints nothing.
+template <typename TSequence, typename TId, typename TPattern, typename TMatches>
+inline void
+_stellarOnShard(TSequence & database,
+                TId & databaseID,
+                TPattern & swiftPattern,
+                bool databaseStrand,
+                TMatches & matches,
+                unsigned & compactThresh,
+                StellarOptions const & options)
+{
+    typedef Finder<TSequence, Swift<SwiftLocal> > TFinder;
+    TFinder swiftFinder(database, options.minRepeatLength, options.maxRepeatPeriod);
+
+    if (options.fastOption == CharString("exact"))
+        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                options.disableThresh, compactThresh, options.numMatches, false,
+                databaseID, databaseStrand, matches, AllLocal());
+    else if (options.fastOption == "bestLocal")
+        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                options.disableThresh, compactThresh, options.numMatches, false,
+                databaseID, databaseStrand, matches, BestLocal());
+    else if (options.fastOption == "bandedGlobal")
+        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                options.disableThresh, compactThresh, options.numMatches, false,
+                databaseID, databaseStrand, matches, BandedGlobal());
+    else if (options.fastOption == "bandedGlobalExtend")
+        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                options.disableThresh, compactThresh, options.numMatches, false,
+                databaseID, databaseStrand, matches, BandedGlobalExtend());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Merges the matches of one shard into the matches of its queries, which
+//  begin at firstQuery. The matches are inserted one by one with _insertMatch(),
+//  which compacts and disables as the single-threaded mode does during
+//  verification, and are compacted afterwards as stellar() does.
+template <typename TMatches>
+inline void
+_mergeShardMatches(TMatches & matches,
+                   TMatches & local,
+                   unsigned firstQuery,
+                   unsigned & compactThresh,
+                   StellarOptions const & options)
+{
+    typedef typename Value<TMatches>::Type  TQueryMatches;
+    typedef typename Size<TMatches>::Type   TSize;
+
+    for (TSize k = 0; k < length(local); ++k)
+    {
+        TQueryMatches & queryMatches = matches[firstQuery + k];
+        if (queryMatches.disabled)
+            continue;
+
+        if (local[k].disabled)
+        {
+            queryMatches.disabled = true;
+            clear(queryMatches.matches);
+            continue;
+        }
+
+        for (TSize m = 0; m < length(local[k].matches); ++m)
+            if (!_insertMatch(queryMatches, local[k].matches[m], options.minLength,
+                              options.disableThresh, compactThresh, options.numMatches))
+                break;
+
+        if (!queryMatches.disabled && length(queryMatches.matches) > 0)
+        {
+            maskOverlaps(queryMatches.matches, options.minLength);
+            compactMatches(queryMatches.matches, options.numMatches);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Aligns every query chunk to one database sequence on the current strand.
+//  Each chunk is processed by one thread, which merges its matches right away.
+//  The chunks have disjoint queries, so no shard outlives its thread.
+template <typename TSequence, typename TId, typename TIndices, typename TChunkBegins, typename TMatches,
+          typename TCompactThreshs>
+inline void
+_stellarOnAllChunks(TSequence & database,
+                    TId & databaseID,
+                    TIndices & indices,
+                    TChunkBegins const & chunkBegins,
+                    TMatches & matches,
+                    TCompactThreshs & compactThreshs,
+                    bool databaseStrand,
+                    StellarOptions const & options)
+{
+    typedef typename Value<TIndices>::Type              TQGramIndex;
+    typedef Pattern<TQGramIndex, Swift<SwiftLocal> >    TPattern;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int c = 0; c < (int)length(indices); ++c)
+    {
+        TPattern swiftPattern(indices[c]);
+
+        // Queries disabled on previous database sequences are not verified again.
+        TMatches local;
+        resize(local, chunkBegins[c + 1] - chunkBegins[c]);
+        for (unsigned k = 0; k < length(local); ++k)
+            local[k].disabled = matches[chunkBegins[c] + k].disabled;
+
+        _stellarOnShard(database, databaseID, swiftPattern, databaseStrand, local, compactThreshs[c], options);
+        _mergeShardMatches(matches, local, chunkBegins[c], compactThreshs[c], options);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Multi-threaded variant of the alignment loop in _stellarOnAll.
+//  The queries are split into a fixed number of chunks of similar total length
+//  with one q-gram index each. The database sequences and strands are processed
+//  in the order of the single-threaded mode and the chunks of each in parallel.
+//  Each chunk has its own compaction threshold, so the kept matches do not
+//  depend on the number of threads, but once disableThresh or compactThresh is
+//  reached, they can differ from the single-threaded mode.
+template <typename TSequence, typename TId, typename TMatches>
 inline bool
-_stellarOnAll(StringSet<TSequence> & databases,
-              StringSet<TId> & databaseIDs,
-              StringSet<TSequence> & queries,
-              StringSet<TId> & queryIDs,
-              StellarOptions & options)
+_stellarOnAllParallel(StringSet<TSequence> & databases,
+                      StringSet<TId> & databaseIDs,
+                      StringSet<TSequence> & queries,
+                      TMatches & matches,
+                      StellarOptions & options)
 {
-    // pattern
     typedef Index<StringSet<TSequence, Dependent<> >, IndexQGram<SimpleShape, OpenAddressing> > TQGramIndex;
-    TQGramIndex qgramIndex(queries);
-    resize(indexShape(qgramIndex), options.qGram);
-    cargo(qgramIndex).abundanceCut = options.qgramAbundanceCut;
-    Pattern<TQGramIndex, Swift<SwiftLocal> > swiftPattern(qgramIndex);
+    typedef typename Size<StringSet<TSequence> >::Type                                          TSize;
+
+    // Each chunk scans every database sequence, more chunks balance better but filter more.
+    static const TSize QUERY_CHUNKS = 16;
+
+    if (options.fastOption != "exact" && options.fastOption != "bestLocal" &&
+        options.fastOption != "bandedGlobal" && options.fastOption != "bandedGlobalExtend")
+    {
+        std::cerr << "\nUnknown verification strategy: " << options.fastOption << std::endl;
+        return false;
+    }
 
-    if (options.verbose)
-        swiftPattern.params.printDots = true;
+    omp_set_num_threads(options.threadsCount);
 
-    // Construct index
+    // The abundance cut depends on the q-gram counts of all queries, in this case use a single index.
+    TSize chunkCount = (options.qgramAbundanceCut != 1) ? 1 : _min(QUERY_CHUNKS, length(queries));
+
+    // Split queries into chunks of similar total length.
+    String<TSize> chunkBegins;
+    appendValue(chunkBegins, 0);
+    double totalLength = lengthSum(queries);
+    double chunkLength = 0;
+    for (TSize j = 0; j + 1 < length(queries) && length(chunkBegins) < chunkCount; ++j)
+    {
+        chunkLength += length(queries[j]);
+        if (chunkLength * chunkCount >= totalLength * length(chunkBegins))
+            appendValue(chunkBegins, j + 1);
+    }
+    appendValue(chunkBegins, length(queries));
+    chunkCount = length(chunkBegins) - 1;
+
+    // Construct one index per chunk, a single index is constructed by all threads
     std::cout << "Constructing index..." << std::endl;
-    indexRequire(qgramIndex, QGramSADir());
+    String<TQGramIndex> indices;
+    resize(indices, chunkCount);
+
+    if (chunkCount == 1)
+    {
+        for (TSize j = 0; j < length(queries); ++j)
+            appendValue(indexText(indices[0]), queries[j]);
+        resize(indexShape(indices[0]), options.qGram);
+        cargo(indices[0]).abundanceCut = options.qgramAbundanceCut;
+        indexCreate(indices[0], QGramSADir(), Parallel());
+        stringSetLimits(indexText(indices[0]));     // limits are computed lazily, do it before sharing the index
+    }
+    else
+    {
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+        for (int c = 0; c < (int)chunkCount; ++c)
+        {
+            for (TSize j = chunkBegins[c]; j < chunkBegins[c + 1]; ++j)
+                appendValue(indexText(indices[c]), queries[j]);
+            resize(indexShape(indices[c]), options.qGram);
+            cargo(indices[c]).abundanceCut = options.qgramAbundanceCut;
+            indexRequire(indices[c], QGramSADir());
+            stringSetLimits(indexText(indices[c]));     // limits are computed lazily, do it before sharing the index
+        }
+    }
     std::cout << std::endl;
 
-    // container for eps-matches
-    StringSet<QueryMatches<StellarMatch<TSequence, TId> > > matches;
-    resize(matches, length(queries));
+    // The compaction threshold of each chunk is raised across database sequences as in the single-threaded mode.
+    String<unsigned> compactThreshs;
+    resize(compactThreshs, chunkCount, options.compactThresh);
 
     std::cout << "Aligning all query sequences to database sequence..." << std::endl;
-    for (unsigned i = 0; i < length(databases); ++i)
+    bool reverse = options.reverse && options.alphabet != "protein" && options.alphabet != "char";
+    for (TSize i = 0; i < length(databases); ++i)
     {
         // positive database strand
         if (options.forward)
-        {
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
-                return 1;
-        }
+            _stellarOnAllChunks(databases[i], databaseIDs[i], indices, chunkBegins, matches, compactThreshs, true,
+                                options);
+
         // negative (reverse complemented) database strand
-        if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+        if (reverse)
         {
             reverseComplement(databases[i]);
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
-                return 1;
-
+            _stellarOnAllChunks(databases[i], databaseIDs[i], indices, chunkBegins, matches, compactThreshs, false,
+                                options);
             reverseComplement(databases[i]);
         }
     }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Initializes a Pattern object with the query sequences,
+//  and calls _stellarOnOne for each database sequence
+template <typename TSequence, typename TId>
+inline bool
+_stellarOnAll(StringSet<TSequence> & databases,
+              StringSet<TId> & databaseIDs,
+              StringSet<TSequence> & queries,
+              StringSet<TId> & queryIDs,
+              StellarOptions & options)
+{
+    // container for eps-matches
+    StringSet<QueryMatches<StellarMatch<TSequence, TId> > > matches;
+    resize(matches, length(queries));
+
+    if (options.threadsCount > 1)
+    {
+        if (!_stellarOnAllParallel(databases, databaseIDs, queries, matches, options))
+            return 1;
+    }
+    else
+    {
+        // pattern
+        typedef Index<StringSet<TSequence, Dependent<> >, IndexQGram<SimpleShape, OpenAddressing> > TQGramIndex;
+        TQGramIndex qgramIndex(queries);
+        resize(indexShape(qgramIndex), options.qGram);
+        cargo(qgramIndex).abundanceCut = options.qgramAbundanceCut;
+        Pattern<TQGramIndex, Swift<SwiftLocal> > swiftPattern(qgramIndex);
+
+        if (options.verbose)
+            swiftPattern.params.printDots = true;
+
+        // Construct index
+        std::cout << "Constructing index..." << std::endl;
+        indexRequire(qgramIndex, QGramSADir());
+        std::cout << std::endl;
+
+        std::cout << "Aligning all query sequences to database sequence..." << std::endl;
+        for (unsigned i = 0; i < length(databases); ++i)
+        {
+            // positive database strand
+            if (options.forward)
+            {
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
+                    return 1;
+            }
+            // negative (reverse complemented) database strand
+            if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+            {
+                reverseComplement(databases[i]);
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
+                    return 1;
+
+                reverseComplement(databases[i]);
+            }
+        }
+    }
     std::cout << std::endl;
 
     // file output
@@ -397,6 +621,10 @@ _writeSpecifiedParams(TOptions & options)
     {
         std::cout << "  q-gram abundance cut ratio       : " << options.qgramAbundanceCut << std::endl;
     }
+    if (options.threadsCount != 1)
+    {
+        std::cout << "  number of threads                : " << options.threadsCount << std::endl;
+    }
     std::cout << std::endl;
 }
 
@@ -463,6 +691,7 @@ _parseOptions(ArgumentParser & parser, TOptions & options)
     getOptionValue(options.qgramAbundanceCut, parser, "abundanceCut");
 
     getOptionValue(options.verbose, parser, "verbose");
+    getOptionValue(options.threadsCount, parser, "threads");
 
     if (isSet(parser, "kmer") && options.qGram >= 1 / options.epsilon)
     {
@@ -562,6 +791,20 @@ void _setParser(ArgumentParser & parser)
                                      "space.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "s", "500");
 
+    addSection(parser, "Performance Options");
+
+    addOption(parser, ArgParseOption("th", "threads",
+                                     "Specify the number of threads to use. The kept matches are the same for any "
+                                     "number of threads above one, but may differ from a single thread once "
+                                     "--disableThresh or --sortThresh is reached.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "threads", "1");
+#ifdef _OPENMP
+    setMaxValue(parser, "threads", "2048");
+#else
+    setMaxValue(parser, "threads", "1");
+#endif
+    setDefaultValue(parser, "threads", "1");
+
     addSection(parser, "Output Options");
 
     addOption(parser, ArgParseOption("o", "out", "Name of output file.", ArgParseArgument::OUTPUT_FILE));
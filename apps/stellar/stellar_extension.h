@@ -356,24 +356,11 @@ _align_banded_nw_best_ends(TTrace& trace,
 	resize(bestEnds, newLength + 1);
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// Reverses the infixes of the left extension in place in hosts of infH and infV.
-template<typename TSequenceA, typename TSequenceB, typename TSeed>
-void
-_reverseLeftExtension(Segment<TSequenceA, InfixSegment> const & infH,
-					  Segment<TSequenceB, InfixSegment> const & infV,
-					  TSeed & seed,
-					  TSeed & seedOld) {
-	Segment<TSequenceA, InfixSegment> infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
-	Segment<TSequenceB, InfixSegment> infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
-	reverse(infixH);
-	reverse(infixV);
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix for the left extension and 
 //   returns a string with possible start positions of an eps-match.
-// Caution: The infixes of the left extension is reversed in place in hosts of infH and infV!
+// The infixes of the left extension are reversed by a modifier, so the hosts of infH and infV
+//   are left untouched and may be shared between threads.
 template<typename TMatrix, typename TPossEnd, typename TSequence, typename TSeed, typename TScore>
 void
 _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
@@ -385,16 +372,14 @@ _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
 						TScore const & scoreMatrix) {
 
 	typedef Segment<TSequence, InfixSegment> TInfix;
+	typedef ModifiedString<TInfix, ModReverse> TReverseInfix;
 
 	TInfix infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
 	TInfix infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
 
-	reverse(infixH);
-	reverse(infixV);
-
-	StringSet<TInfix> str;
-	appendValue(str, infixH);
-	appendValue(str, infixV);
+	StringSet<TReverseInfix> str;
+	appendValue(str, TReverseInfix(infixH));
+	appendValue(str, TReverseInfix(infixV));
 
 	// _align_banded_nw_best_ends(matrixLeft, possibleEndsLeft, str, scoreMatrix,
 	// 						   upperDiagonal(seedOld) - upperDiagonal(seed),
@@ -695,7 +680,6 @@ _bestExtension(TInfix const & infH,
 	// fill banded matrix and gaps string for ...
 	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT) { // ... extension to the left
 		_fillMatrixBestEndsLeft(matrixLeft, possibleEndsLeft, infH, infV, seed, seedOld, scoreMatrix);
-		// Caution: left extension infix is now reversed in host(infH and infV) !!!
         SEQAN_ASSERT_NOT(empty(possibleEndsLeft));
 	} else appendValue(possibleEndsLeft, TEndInfo());
 	if (direction == EXTEND_BOTH || direction == EXTEND_RIGHT) { // ... extension to the right
@@ -706,11 +690,8 @@ _bestExtension(TInfix const & infH,
 	// longest eps match on poss ends string
 	Pair<TEndIterator> endPair = longestEpsMatch(possibleEndsLeft, possibleEndsRight, alignLen, alignErr, minLength, eps);
 
-	if (endPair == Pair<TEndIterator>(0, 0)) { // no eps-match found
-		if (direction != 1) 
-			_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
+	if (endPair == Pair<TEndIterator>(0, 0)) // no eps-match found
 		return false;
-	}
 
 	// determine end positions of maximal eps-match in ...
 	TPos endLeftH = 0, endLeftV = 0;
@@ -751,9 +732,6 @@ _bestExtension(TInfix const & infH,
 	}
     SEQAN_ASSERT_EQ(length(row(align, 0)), length(row(align, 1)));
 
-	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT)
-		_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
-
 	return true;
 }
 
@@ -57,6 +57,7 @@ struct StellarOptions {
 	unsigned minRepeatLength;	// minimal length of low complexity repeats to be filtered
 	double qgramAbundanceCut;
 	bool verbose;				// verbose mode
+	unsigned threadsCount;		// number of threads used for filtering and verification
 
 
 	StellarOptions() {
@@ -81,6 +82,7 @@ struct StellarOptions {
 		minRepeatLength = 1000;
 		qgramAbundanceCut = 1;
 		verbose = false;
+		threadsCount = 1;
 	}
 }; 
 
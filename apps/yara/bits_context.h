@@ -75,6 +75,19 @@ inline void clear(ReadsContext<TSpec, TConfig> & ctx)
     shrinkToFit(ctx.paired);
 }
 
+// ----------------------------------------------------------------------------
+// Function swap()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+inline void swap(ReadsContext<TSpec, TConfig> & a, ReadsContext<TSpec, TConfig> & b)
+{
+    swap(a.seedErrors, b.seedErrors);
+    swap(a.minErrors, b.minErrors);
+    swap(a.mapped, b.mapped);
+    swap(a.paired, b.paired);
+}
+
 // ----------------------------------------------------------------------------
 // Function resize()
 // ----------------------------------------------------------------------------
@@ -77,7 +77,7 @@ inline bool save(Index<StringSet<TText, TSSetSpec>, FMIndex<TSpec, TConfig> > co
     name = fileName;    append(name, ".lf");
     if (!save(getFibre(index, FibreLF()), toCString(name), openMode)) return false;
 
-    return true;
+    return _saveKmers(index, fileName, openMode);
 }
 
 // ----------------------------------------------------------------------------
@@ -99,7 +99,8 @@ inline bool open(Index<StringSet<TText, TSSetSpec>, FMIndex<TSpec, TConfig> > &
 
     setFibre(getFibre(index, FibreSA()), getFibre(index, FibreLF()), FibreLF());
 
-    return true;
+    // Indices built without the k-mer table are still searched from the root.
+    return _openKmers(index, fileName, openMode);
 }
 
 // ----------------------------------------------------------------------------
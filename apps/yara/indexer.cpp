@@ -81,12 +81,16 @@ struct Options
     __uint64        contigsSum;
 
     bool            verbose;
+    unsigned        threadsCount;
+    bool            inMemorySA;
 
     Options() :
         contigsSize(),
         contigsMaxLength(),
         contigsSum(),
-        verbose(false)
+        verbose(false),
+        threadsCount(1),
+        inMemorySA(false)
     {}
 };
 
@@ -117,7 +121,7 @@ struct YaraIndexer
 // Function setupArgumentParser()
 // ----------------------------------------------------------------------------
 
-void setupArgumentParser(ArgumentParser & parser, Options const & /* options */)
+void setupArgumentParser(ArgumentParser & parser, Options const & options)
 {
     setAppName(parser, "yara_indexer");
     setShortDescription(parser, "Yara Indexer");
@@ -141,6 +145,22 @@ void setupArgumentParser(ArgumentParser & parser, Options const & /* options */)
 
     addOption(parser, ArgParseOption("td", "tmp-dir", "Specify a temporary directory where to construct the index. \
                                      Default: use the output directory.", ArgParseOption::STRING));
+
+    addSection(parser, "Performance Options");
+
+    addOption(parser, ArgParseOption("t", "threads", "Specify the number of threads to use.", ArgParseOption::INTEGER));
+    setMinValue(parser, "threads", "1");
+#ifdef _OPENMP
+    setMaxValue(parser, "threads", "2048");
+#else
+    setMaxValue(parser, "threads", "1");
+#endif
+    setDefaultValue(parser, "threads", options.threadsCount);
+
+    addOption(parser, ArgParseOption("ims", "in-memory-sa", "Build the suffix array in main memory with (parallel) \
+                                     SA-IS instead of on disk with Skew7. This is faster, but needs main memory for the \
+                                     full suffix array plus at most 7 bytes per reference base, or 13 bytes if the \
+                                     reference has 4G bases or more."));
 }
 
 // ----------------------------------------------------------------------------
@@ -177,6 +197,10 @@ parseCommandLine(Options & options, ArgumentParser & parser, int argc, char cons
     }
     setEnv("TMPDIR", tmpDir);
 
+    // Parse performance options.
+    getOptionValue(options.threadsCount, parser, "threads");
+    getOptionValue(options.inMemorySA, parser, "in-memory-sa");
+
     return ArgumentParser::PARSE_OK;
 }
 
@@ -230,6 +254,95 @@ void saveContigs(YaraIndexer<TSpec, TConfig> & me)
         std::cerr << me.timer << std::endl;
 }
 
+// ----------------------------------------------------------------------------
+// Function configureThreads()
+// ----------------------------------------------------------------------------
+// Sets the number of threads that OpenMP can spawn.
+
+template <typename TSpec, typename TConfig>
+inline void configureThreads(YaraIndexer<TSpec, TConfig> & me)
+{
+    omp_set_num_threads(me.options.threadsCount);
+
+    if (me.options.verbose)
+        std::cerr << "Threads count:\t\t\t\t" << omp_get_max_threads() << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+// Builds the suffix array, then the LF table, the compressed suffix array and the k-mer table from it.
+
+template <typename TSpec, typename TConfig, typename TIndex, typename TSA, typename TAlgorithm, typename TThreading>
+void buildIndex(YaraIndexer<TSpec, TConfig> & me, TIndex & index, TSA & sa, TAlgorithm const & algorithm,
+                TThreading const & threading)
+{
+    typedef typename Fibre<TIndex, FibreText>::Type         TText;
+
+    TText const & text = indexText(index);
+
+    if (me.options.verbose)
+        std::cerr << "Building suffix array:\t\t\t" << std::flush;
+
+    start(me.timer);
+    resize(sa, lengthSum(text), Exact());
+    createSuffixArray(sa, text, algorithm);
+    stop(me.timer);
+
+    if (me.options.verbose)
+        std::cerr << me.timer << std::endl;
+
+    if (me.options.verbose)
+        std::cerr << "Building BWT:\t\t\t\t" << std::flush;
+
+    start(me.timer);
+    _indexCreateLF(index, sa, threading);
+    stop(me.timer);
+
+    if (me.options.verbose)
+        std::cerr << me.timer << std::endl;
+
+    if (me.options.verbose)
+        std::cerr << "Sampling suffix array:\t\t\t" << std::flush;
+
+    start(me.timer);
+    _indexCreateCompressedSA(index, sa, threading);
+    clear(sa);
+    stop(me.timer);
+
+    if (me.options.verbose)
+        std::cerr << me.timer << std::endl;
+
+    if (me.options.verbose)
+        std::cerr << "Building k-mer table:\t\t\t" << std::flush;
+
+    start(me.timer);
+    indexCreate(index, FibreKmers(), threading);
+    stop(me.timer);
+
+    if (me.options.verbose)
+        std::cerr << me.timer << std::endl;
+}
+
+// The suffix array is built on disk with Skew7 unless it is requested in main memory.
+template <typename TSpec, typename TConfig, typename TIndex, typename TThreading>
+void buildIndex(YaraIndexer<TSpec, TConfig> & me, TIndex & index, TThreading const & threading)
+{
+    typedef typename Fibre<TIndex, FibreTempSA>::Type       TTempSA;
+    typedef typename SAValue<TIndex>::Type                  TSAValue;
+
+    if (me.options.inMemorySA)
+    {
+        String<TSAValue> sa;
+        buildIndex(me, index, sa, Sais_<TThreading>(), threading);
+    }
+    else
+    {
+        TTempSA sa;
+        buildIndex(me, index, sa, Skew7(), threading);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function saveIndex()
 // ----------------------------------------------------------------------------
@@ -241,11 +354,6 @@ void saveIndex(YaraIndexer<TSpec, TConfig> & me)
     typedef FMIndex<void, TIndexConfig>                             TIndexSpec;
     typedef Index<typename TIndexConfig::Text, TIndexSpec>          TIndex;
 
-    if (me.options.verbose)
-        std::cerr << "Building reference index:\t\t" << std::flush;
-
-    start(me.timer);
-
     // Randomly replace Ns with A, C, G, T.
     randomizeNs(me.contigs);
 
@@ -263,9 +371,12 @@ void saveIndex(YaraIndexer<TSpec, TConfig> & me)
 
     try
     {
-        // Iterator instantiation triggers index construction.
-        typename Iterator<TIndex, TopDown<> >::Type it(index);
-        ignoreUnusedVariableWarning(it);
+#ifdef _OPENMP
+        if (me.options.threadsCount > 1)
+            buildIndex(me, index, Parallel());
+        else
+#endif
+            buildIndex(me, index, Serial());
     }
     catch (BadAlloc const & /* e */)
     {
@@ -278,11 +389,6 @@ void saveIndex(YaraIndexer<TSpec, TConfig> & me)
                             Specify a bigger temporary folder using the options --tmp-dir.");
     }
 
-    stop(me.timer);
-
-    if (me.options.verbose)
-        std::cerr << me.timer << std::endl;
-
     if (me.options.verbose)
         std::cerr << "Saving reference index:\t\t\t" << std::flush;
 
@@ -354,6 +460,7 @@ void runYaraIndexer(Options & options)
 {
     YaraIndexer<> indexer(options);
 
+    configureThreads(indexer);
     loadContigs(indexer);
     setContigsLimits(options, indexer.contigs.seqs);
     saveContigs(indexer);
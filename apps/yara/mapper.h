@@ -167,7 +167,7 @@ struct MapperTraits
     typedef SeqStore<void, YaraReadsConfig>                         TReads;
     typedef typename If<IsSameType<TSequencing, PairedEnd>,
                         Pair<SeqFileIn>, SeqFileIn>::Type           TReadsFileIn;
-    typedef PrefetchedFile<TReadsFileIn, TReads, TThreading>        TReadsFile;
+    typedef PrefetchedFile<TReadsFileIn, TReads, Serial>            TReadsFile;
     typedef FormattedFile<Bam, Output, TContigNames>                TOutputFile;
 
     typedef typename TReads::TSeqs                                  TReadSeqs;
@@ -220,6 +220,10 @@ struct Stats
     TValue alignMatches;
     TValue writeMatches;
 
+    TValue loadStall;
+    TValue mapStall;
+    TValue writeStall;
+
     unsigned long loadedReads;
     unsigned long mappedReads;
     unsigned long pairedReads;
@@ -237,6 +241,9 @@ struct Stats
         selectPairs(0),
         alignMatches(0),
         writeMatches(0),
+        loadStall(0),
+        mapStall(0),
+        writeStall(0),
         loadedReads(0),
         mappedReads(0),
         pairedReads(0)
@@ -283,6 +290,27 @@ struct Mapper
     {};
 };
 
+// ----------------------------------------------------------------------------
+// Class MapperBlock
+// ----------------------------------------------------------------------------
+// One block of reads travelling through the load/map/write pipeline.
+
+template <typename TSpec, typename TConfig = void>
+struct MapperBlock
+{
+    typedef MapperTraits<TSpec, TConfig>    Traits;
+
+    typename Traits::TReads             reads;
+    typename Traits::TReadsContext      ctx;
+
+    typename Traits::TMatches           matches;
+    typename Traits::TMatchesSet        matchesSet;
+    typename Traits::TMatches           primaryMatches;
+
+    typename Traits::TCigar             cigars;
+    typename Traits::TCigarSet          cigarSet;
+};
+
 // ============================================================================
 // Functions
 // ============================================================================
@@ -335,7 +363,8 @@ inline void loadContigsIndex(Mapper<TSpec, TConfig> & me)
     start(me.timer);
     try
     {
-        if (!open(me.index, toCString(me.options.contigsIndexFile)))
+        // The index fibres are memory mapped read-only, concurrent mappers share them through the page cache.
+        if (!open(me.index, toCString(me.options.contigsIndexFile), OPEN_RDONLY))
             throw RuntimeError("Error while opening reference index file.");
     }
     catch (BadAlloc const & /* e */)
@@ -390,28 +419,34 @@ inline void closeReads(Mapper<TSpec, TConfig> & me)
 
 template <typename TSpec, typename TConfig>
 inline void loadReads(Mapper<TSpec, TConfig> & me)
+{
+    loadReads(me, me.reads, me.timer);
+}
+
+template <typename TSpec, typename TConfig, typename TReads, typename TValue>
+inline void loadReads(Mapper<TSpec, TConfig> & me, TReads & reads, Timer<TValue> & timer)
 {
     typedef typename MapperTraits<TSpec, TConfig>::TMatch   TMatch;
 
-    start(me.timer);
+    start(timer);
 
-    readRecords(me.reads, me.readsFile);
+    readRecords(reads, me.readsFile);
 
-    if (maxLength(me.reads.seqs, typename TConfig::TThreading()) > MemberLimits<TMatch, ReadSize>::VALUE)
+    if (maxLength(reads.seqs, typename TConfig::TThreading()) > MemberLimits<TMatch, ReadSize>::VALUE)
         throw RuntimeError("Maximum read length exceeded.");
 
     // Append reverse complemented reads.
-    appendReverseComplement(me.reads);
+    appendReverseComplement(reads);
 
-    stop(me.timer);
+    stop(timer);
 
-    me.stats.loadReads += getValue(me.timer);
-    me.stats.loadedReads += getReadsCount(me.reads.seqs);
+    me.stats.loadReads += getValue(timer);
+    me.stats.loadedReads += getReadsCount(reads.seqs);
 
     if (me.options.verbose > 1)
     {
-        std::cerr << "Loading reads:\t\t\t" << me.timer << std::endl;
-        std::cerr << "Reads count:\t\t\t" << getReadsCount(me.reads.seqs) << std::endl;
+        std::cerr << "Loading reads:\t\t\t" << timer << std::endl;
+        std::cerr << "Reads count:\t\t\t" << getReadsCount(reads.seqs) << std::endl;
     }
 }
 
@@ -966,6 +1001,64 @@ inline void writeMatches(Mapper<TSpec, TConfig> & me)
         std::cerr << "Output time:\t\t\t" << me.timer << std::endl;
 }
 
+template <typename TSpec, typename TConfig, typename TValue>
+inline void writeMatches(Mapper<TSpec, TConfig> & me, MapperBlock<TSpec, TConfig> & block, Timer<TValue> & timer)
+{
+    typedef MapperTraits<TSpec, TConfig>        TTraits;
+    typedef MatchesWriter<TSpec, TTraits>       TMatchesWriter;
+
+    start(timer);
+    TMatchesWriter writer(me.outputFile,
+                          block.matchesSet, block.primaryMatches, block.cigarSet,
+                          block.ctx, block.reads,
+                          me.options);
+    stop(timer);
+    me.stats.writeMatches += getValue(timer);
+
+    if (me.options.verbose > 1)
+        std::cerr << "Output time:\t\t\t" << timer << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+// Function swapMatches()
+// ----------------------------------------------------------------------------
+// Exchanges the reads and everything needed to output them with a block.
+
+template <typename TSpec, typename TConfig>
+inline void swapMatches(Mapper<TSpec, TConfig> & me, MapperBlock<TSpec, TConfig> & block)
+{
+    swap(me.reads, block.reads);
+    swap(me.ctx, block.ctx);
+
+    swap(me.matches, block.matches);
+    swap(me.suboptimalMatchesSet, block.matchesSet);
+    setHost(me.suboptimalMatchesSet, me.matches);
+    setHost(block.matchesSet, block.matches);
+    swap(me.primaryMatches, block.primaryMatches);
+
+    swap(me.cigars, block.cigars);
+    swap(me.cigarSet, block.cigarSet);
+    setHost(me.cigarSet, me.cigars);
+    setHost(block.cigarSet, block.cigars);
+}
+
+// ----------------------------------------------------------------------------
+// Function clear(MapperBlock)
+// ----------------------------------------------------------------------------
+// Clears a block before it is recycled for the next reads.
+
+template <typename TSpec, typename TConfig>
+inline void clear(MapperBlock<TSpec, TConfig> & block)
+{
+    clear(block.reads);
+    clear(block.ctx);
+    clear(block.matchesSet);
+    clear(block.matches);
+    clear(block.primaryMatches);
+    clear(block.cigarSet);
+    clear(block.cigars);
+}
+
 // ----------------------------------------------------------------------------
 // Function mapReads()
 // ----------------------------------------------------------------------------
@@ -1006,9 +1099,6 @@ inline void _mapReadsImpl(Mapper<TSpec, TConfig> & me, TReadSeqs & readSeqs, All
 //    verifyMatches(me, readSeqs);
     rankMatches(me, readSeqs);
     alignMatches(me);
-    writeMatches(me);
-    clearMatches(me);
-    clearAlignments(me);
 }
 
 // ----------------------------------------------------------------------------
@@ -1064,9 +1154,6 @@ inline void _mapReadsImpl(Mapper<TSpec, TConfig> & me, TReadSeqs & readSeqs, Str
 //    verifyMatches(me, readSeqs);
     rankMatches(me, readSeqs);
     alignMatches(me);
-    writeMatches(me);
-    clearMatches(me);
-    clearAlignments(me);
 }
 
 // ----------------------------------------------------------------------------
@@ -1095,6 +1182,12 @@ inline void printStats(Mapper<TSpec, TConfig> const & me, Timer<TValue> const &
         std::cerr << "Pairing time:\t\t\t" << me.stats.selectPairs << " sec" << "\t\t" << me.stats.selectPairs / total << " %" << std::endl;
     std::cerr << "Alignment time:\t\t\t" << me.stats.alignMatches << " sec" << "\t\t" << me.stats.alignMatches / total << " %" << std::endl;
     std::cerr << "Output time:\t\t\t" << me.stats.writeMatches << " sec" << "\t\t" << me.stats.writeMatches / total << " %" << std::endl;
+    if (IsSameType<typename TConfig::TThreading, Parallel>::VALUE)
+    {
+        std::cerr << "Loading stall time:\t\t" << me.stats.loadStall << " sec" << "\t\t" << me.stats.loadStall / total << " %" << std::endl;
+        std::cerr << "Mapping stall time:\t\t" << me.stats.mapStall << " sec" << "\t\t" << me.stats.mapStall / total << " %" << std::endl;
+        std::cerr << "Output stall time:\t\t" << me.stats.writeStall << " sec" << "\t\t" << me.stats.writeStall / total << " %" << std::endl;
+    }
 
     printRuler(std::cerr);
 
@@ -1105,6 +1198,194 @@ inline void printStats(Mapper<TSpec, TConfig> const & me, Timer<TValue> const &
         std::cerr << "Paired reads:\t\t\t" << me.stats.pairedReads << "\t\t" << me.stats.pairedReads / totalReads << " %" << std::endl;
 }
 
+// ----------------------------------------------------------------------------
+// Function processReads()
+// ----------------------------------------------------------------------------
+// Loads, maps and writes all reads block by block.
+
+template <typename TSpec, typename TConfig>
+inline void processReads(Mapper<TSpec, TConfig> & me)
+{
+    _processReadsImpl(me, typename TConfig::TThreading());
+}
+
+// ----------------------------------------------------------------------------
+// Function _processReadsImpl(); Serial
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig>
+inline void _processReadsImpl(Mapper<TSpec, TConfig> & me, Serial)
+{
+    while (true)
+    {
+        if (me.options.verbose > 1) printRuler(std::cerr);
+        loadReads(me);
+        if (empty(me.reads.seqs)) break;
+        mapReads(me);
+        writeMatches(me);
+        clearMatches(me);
+        clearAlignments(me);
+        clearReads(me);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _processReadsImpl(); Parallel
+// ----------------------------------------------------------------------------
+// Runs loading, mapping and output as a three-stage pipeline connected by
+// bounded queues: block N is written while block N+1 is mapped and block N+2
+// is loaded. The stall times account for each stage waiting on its queues.
+// Only the mapping stage uses the OpenMP threads, loading and writing parse and
+// format their blocks sequentially to stay within the threads count.
+
+template <typename TSpec, typename TConfig>
+inline void _processReadsImpl(Mapper<TSpec, TConfig> & me, Parallel)
+{
+    typedef MapperBlock<TSpec, TConfig>                     TBlock;
+    typedef ConcurrentQueue<TBlock *, Suspendable<Limit> >  TBlockQueue;
+
+    static const unsigned BLOCKS = 3;
+
+    String<TBlock> blocks;
+    resize(blocks, BLOCKS);
+
+    TBlockQueue idleQueue(BLOCKS);
+    TBlockQueue loadedQueue(BLOCKS);
+    TBlockQueue mappedQueue(BLOCKS);
+
+    setReaderWriterCount(idleQueue, 1, 1);
+    setReaderWriterCount(loadedQueue, 1, 1);
+    setReaderWriterCount(mappedQueue, 1, 1);
+
+    for (unsigned i = 0; i < BLOCKS; ++i)
+        appendValue(idleQueue, &blocks[i]);
+
+    Atomic<bool>::Type aborted(false);
+    std::exception_ptr loadError;
+    std::exception_ptr mapError;
+    std::exception_ptr writeError;
+
+    // Load blocks of reads.
+    std::thread loader([&]()
+    {
+        omp_set_num_threads(1);
+
+        Timer<double> timer;
+        Timer<double> stall;
+        TBlock * block = NULL;
+
+        try
+        {
+            while (!aborted)
+            {
+                start(stall);
+                bool idle = popFront(block, idleQueue);
+                stop(stall);
+                me.stats.loadStall += getValue(stall);
+                if (!idle) break;
+
+                loadReads(me, block->reads, timer);
+                if (empty(block->reads.seqs)) break;
+
+                appendValue(loadedQueue, block);
+            }
+        }
+        catch (...)
+        {
+            loadError = std::current_exception();
+            aborted = true;
+        }
+
+        unlockReading(idleQueue);
+        unlockWriting(loadedQueue);
+    });
+
+    // Write the matches of mapped blocks.
+    std::thread writer([&]()
+    {
+        omp_set_num_threads(1);
+
+        Timer<double> timer;
+        Timer<double> stall;
+        TBlock * block = NULL;
+
+        while (true)
+        {
+            start(stall);
+            bool mapped = popFront(block, mappedQueue);
+            stop(stall);
+            me.stats.writeStall += getValue(stall);
+            if (!mapped) break;
+
+            if (!aborted)
+            {
+                try
+                {
+                    writeMatches(me, *block, timer);
+                }
+                catch (...)
+                {
+                    writeError = std::current_exception();
+                    aborted = true;
+                }
+            }
+
+            clear(*block);
+            appendValue(idleQueue, block);
+        }
+
+        unlockReading(mappedQueue);
+        unlockWriting(idleQueue);
+    });
+
+    // Map the loaded blocks.
+    Timer<double> stall;
+    TBlock * block = NULL;
+
+    while (true)
+    {
+        start(stall);
+        bool loaded = popFront(block, loadedQueue);
+        stop(stall);
+        me.stats.mapStall += getValue(stall);
+        if (!loaded) break;
+
+        if (!aborted)
+        {
+            try
+            {
+                if (me.options.verbose > 1) printRuler(std::cerr);
+                swap(me.reads, block->reads);
+                mapReads(me);
+                swapMatches(me, *block);
+                clearMatches(me);
+                clearAlignments(me);
+                clearReads(me);
+            }
+            catch (...)
+            {
+                mapError = std::current_exception();
+                aborted = true;
+            }
+        }
+
+        start(stall);
+        appendValue(mappedQueue, block);
+        stop(stall);
+        me.stats.mapStall += getValue(stall);
+    }
+
+    unlockReading(loadedQueue);
+    unlockWriting(mappedQueue);
+
+    loader.join();
+    writer.join();
+
+    if (loadError) std::rethrow_exception(loadError);
+    if (mapError) std::rethrow_exception(mapError);
+    if (writeError) std::rethrow_exception(writeError);
+}
+
 // ----------------------------------------------------------------------------
 // Function runMapper()
 // ----------------------------------------------------------------------------
@@ -1128,14 +1409,7 @@ inline void runMapper(Mapper<TSpec, TConfig> & me)
     openReads(me);
 
     // Process reads in blocks.
-    while (true)
-    {
-        if (me.options.verbose > 1) printRuler(std::cerr);
-        loadReads(me);
-        if (empty(me.reads.seqs)) break;
-        mapReads(me);
-        clearReads(me);
-    }
+    processReads(me);
 
     closeReads(me);
     closeOutputFile(me);
@@ -144,10 +144,13 @@ struct SeqFileBuffer_<StringSet<TString, TSSetSpec>, TSpec>
 // FMIndex Config
 // ----------------------------------------------------------------------------
 
-template <typename TSize, typename TLen, typename TSum, typename TAlloc = Alloc<> >
+// The rank dictionary of the BWT is selected by TBwt, i.e. Levels or EPR.  Both store a different layout in the
+// .lf.drv fibre, hence indices must be opened with the TBwt they were built with.  Existing indices use Levels.
+template <typename TSize, typename TLen, typename TSum, typename TAlloc = Alloc<>,
+          template <typename, typename> class TBwt = Levels>
 struct YaraFMConfig
 {
-    typedef YaraFMConfig<TSize, TLen, TSum, TAlloc>     TMe;
+    typedef YaraFMConfig<TSize, TLen, TSum, TAlloc, TBwt>   TMe;
 
     // Text.
     typedef Owner<ConcatDirect<TMe> >                   TSSetSpec_;
@@ -157,7 +160,7 @@ struct YaraFMConfig
     typedef TSum                                        LengthSum;
 
     // LF's RankDictionary Config.
-    typedef Levels<void, TMe>                           Bwt;
+    typedef TBwt<void, TMe>                             Bwt;
     typedef typename If<IsSameType<TSize, __uint8>,
                         Naive<void, TMe>,
                         Levels<void, TMe> >::Type       Sentinels;
@@ -168,6 +171,9 @@ struct YaraFMConfig
 
     // Sparse SA sampling rate.
     static const unsigned SAMPLING =                    10;
+
+    // Seeds start from the precomputed ranges of their first 10 symbols.
+    static const unsigned KMER_LENGTH =                 10;
 };
 
 // ----------------------------------------------------------------------------
@@ -175,8 +181,9 @@ struct YaraFMConfig
 // ----------------------------------------------------------------------------
 
 namespace seqan {
-template <typename TValue, typename TSpec, typename TSize, typename TLen, typename TSum, typename TAlloc>
-struct SAValue<StringSet<String<TValue, TSpec>, Owner<ConcatDirect<YaraFMConfig<TSize, TLen, TSum, TAlloc> > > > >
+template <typename TValue, typename TSpec, typename TSize, typename TLen, typename TSum, typename TAlloc,
+          template <typename, typename> class TBwt>
+struct SAValue<StringSet<String<TValue, TSpec>, Owner<ConcatDirect<YaraFMConfig<TSize, TLen, TSum, TAlloc, TBwt> > > > >
 {
     typedef Pair<TSize, TLen, Pack>   Type;
 };
@@ -202,8 +209,9 @@ struct Fibre<SparseString<String<TValue, TAlloc>, TSpec>, FibreIndicators>
 // TODO(esiragusa): remove this crap once the CSA gets refactored.
 
 namespace seqan {
-template <typename TString, typename TSize, typename TLen, typename TSum, typename TAlloc>
-struct Size<SparseString<TString, YaraFMConfig<TSize, TLen, TSum, TAlloc> > >
+template <typename TString, typename TSize, typename TLen, typename TSum, typename TAlloc,
+          template <typename, typename> class TBwt>
+struct Size<SparseString<TString, YaraFMConfig<TSize, TLen, TSum, TAlloc, TBwt> > >
 {
     typedef TSum Type;
 };
@@ -164,8 +164,8 @@ inline bool save(SeqStore<TSpec, TConfig> const & me, TFileName const & fileName
 template <typename TSpec, typename TConfig>
 void swap(SeqStore<TSpec, TConfig> & a, SeqStore<TSpec, TConfig> & b)
 {
-    std::swap(a.seqs, b.seqs);
-    std::swap(a.names, b.names);
+    swap(a.seqs, b.seqs);
+    swap(a.names, b.names);
 }
 
 // ----------------------------------------------------------------------------
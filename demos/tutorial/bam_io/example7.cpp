@@ -42,7 +42,7 @@ int main(int argc, char const * argv[])
         return 1;
     }
 
-    // Translate BEGIN and END arguments to number, 1-based to 0-based.
+    // Translate BEGIN and END arguments to number, 1-based inclusive to 0-based half-open.
     int beginPos = 0, endPos = 0;
     if (!lexicalCast(beginPos, argv[4]) || beginPos <= 0)
     {
@@ -55,7 +55,6 @@ int main(int argc, char const * argv[])
         std::cerr << "ERROR: End position " << argv[5] << " is invalid.\n";
         return 1;
     }
-    endPos -= 1;  // 1-based to 0-based.
 
     // Translate number of elements to print to number.
     int num = 0;
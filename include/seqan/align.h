@@ -50,6 +50,7 @@
 // ============================================================================
 
 #include <seqan/basic.h>
+#include <seqan/basic/basic_simd_vector.h>  // SimdVector<> for the batch alignments.
 #include <seqan/modifier.h>  // ModifiedAlphabet<>.
 #include <seqan/align/align_metafunctions.h>
 #include <seqan/graph_align.h>  // TODO(holtgrew): We should not have to depend on this.
@@ -157,6 +158,12 @@
 #include <seqan/align/dp_traceback_impl.h>
 #include <seqan/align/dp_algorithm_impl.h>
 
+// Inter-sequence vectorized computation of the scores of many pairs.
+#include <seqan/align/dp_batch_impl.h>
+
+// Striped (Farrar) vectorized computation of local alignment scores.
+#include <seqan/align/dp_striped_impl.h>
+
 //################################################################################
 // Old module
 //################################################################################
@@ -195,6 +202,10 @@
 #include <seqan/align/local_alignment_unbanded.h>
 #include <seqan/align/local_alignment_banded.h>
 
+// The front-end functions for batches of global and local alignments.
+#include <seqan/align/global_alignment_batch.h>
+#include <seqan/align/local_alignment_batch.h>
+
 // The front-end for enumeration of local alignments.
 #include <seqan/align/local_alignment_enumeration.h>  // documentation
 #include <seqan/align/local_alignment_enumeration_unbanded.h>
@@ -152,6 +152,18 @@ typedef Tag<SmithWaterman_> SmithWaterman;
 struct WatermanEggert_;
 typedef Tag<WatermanEggert_> WatermanEggert;
 
+/*!
+ * @tag PairwiseLocalAlignmentAlgorithms#Striped
+ * @headerfile <seqan/align.h>
+ * @brief Tag for selecting the Smith-Waterman algorithm with Farrar's striped vectorization.
+ *
+ * @signature struct Striped_;
+ * @signature typedef Tag<Striped_> Striped;
+ */
+
+struct Striped_;
+typedef Tag<Striped_> Striped;
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -0,0 +1,627 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Inter-sequence vectorized computation of alignment scores.  Pairs of
+// sequences are packed into the lanes of a SimdVector and the dynamic
+// programming matrices of all lanes are computed simultaneously.  The
+// recursion mirrors the one of the scalar DP core (dp_formula.h,
+// dp_formula_affine.h) such that both yield identical scores.
+//
+// Pairs that cannot be computed in vector lanes (unsupported scoring schemes,
+// scores that could overflow the lanes, invalid DP settings) are computed
+// with the scalar DP core.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_BATCH_IMPL_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_DP_BATCH_IMPL_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class DPBatchLessLength_
+// ----------------------------------------------------------------------------
+
+// Orders pair ids by the lengths of their sequences.  Pairs of similar lengths
+// end up in the same batch which keeps the padding of the lanes small.
+template <typename TLengths>
+struct DPBatchLessLength_
+{
+    TLengths const & lengthsH;
+    TLengths const & lengthsV;
+
+    DPBatchLessLength_(TLengths const & lengthsH, TLengths const & lengthsV) :
+        lengthsH(lengthsH), lengthsV(lengthsV)
+    {}
+
+    template <typename TId>
+    bool operator()(TId a, TId b) const
+    {
+        if (lengthsH[a] != lengthsH[b])
+            return lengthsH[a] < lengthsH[b];
+        return lengthsV[a] < lengthsV[b];
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction IsBatchScoringScheme_
+// ----------------------------------------------------------------------------
+
+// Scoring schemes with position independent gap costs and a substitution
+// score only depending on the two aligned characters can be vectorized.
+template <typename TScoringScheme>
+struct IsBatchScoringScheme_ :
+    False {};
+
+template <typename TScoreValue>
+struct IsBatchScoringScheme_<Score<TScoreValue, Simple> > :
+    True {};
+
+template <typename TScoreValue, typename TSequenceValue, typename TSource>
+struct IsBatchScoringScheme_<Score<TScoreValue, ScoreMatrix<TSequenceValue, TSource> > > :
+    True {};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentScoreScalar()
+// ----------------------------------------------------------------------------
+
+// Computes the score of a single pair without inter-sequence vectorization.
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel>
+inline TScoreValue
+_computeAlignmentScoreScalar(TSequenceH const & seqH,
+                             TSequenceV const & seqV,
+                             Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                             AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                             TGapModel const & gapModel)
+{
+    DPScoutState_<Default> dpScoutState;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    return _setUpAndRunAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, alignConfig, gapModel);
+}
+
+#ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function _simdBlend()
+// ----------------------------------------------------------------------------
+
+// Selects the lanes of a where mask is set and the lanes of b otherwise.
+template <typename TSimdVector>
+inline TSimdVector
+_simdBlend(TSimdVector const & a, TSimdVector const & b, TSimdVector const & mask)
+{
+    return (a & mask) | (b & ~mask);
+}
+
+// ----------------------------------------------------------------------------
+// Function _simdMax()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector>
+inline TSimdVector
+_simdMax(TSimdVector const & a, TSimdVector const & b)
+{
+    return _simdBlend(a, b, static_cast<TSimdVector>(a > b));
+}
+
+// ----------------------------------------------------------------------------
+// Function _alignedSimdBuffer()
+// ----------------------------------------------------------------------------
+
+// allocate() only guarantees the alignment of operator new which is not
+// sufficient for AVX registers.  We over-allocate a char buffer and return a
+// properly aligned pointer into it.
+template <typename TSimdVector, typename TSize>
+inline TSimdVector *
+_alignedSimdBuffer(String<char> & buffer, TSize count)
+{
+    resize(buffer, (count + 1) * sizeof(TSimdVector), Exact());
+    char * ptr = begin(buffer, Standard());
+    size_t misalignment = reinterpret_cast<size_t>(ptr) % sizeof(TSimdVector);
+    if (misalignment != 0)
+        ptr += sizeof(TSimdVector) - misalignment;
+    return reinterpret_cast<TSimdVector *>(ptr);
+}
+
+// ----------------------------------------------------------------------------
+// Function _batchSubstitutionTable()
+// ----------------------------------------------------------------------------
+
+// Tabulates the substitution scores for all pairs of ordinal values and
+// returns the maximal absolute score.
+template <typename TTable, typename TValueH, typename TValueV, typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_batchSubstitutionTable(TTable & table,
+                        TValueH const &,
+                        TValueV const &,
+                        Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    unsigned const sizeH = ValueSize<TValueH>::VALUE;
+    unsigned const sizeV = ValueSize<TValueV>::VALUE;
+
+    TScoreValue maxAbs = 0;
+    resize(table, sizeH * sizeV, Exact());
+    for (unsigned h = 0; h < sizeH; ++h)
+        for (unsigned v = 0; v < sizeV; ++v)
+        {
+            TScoreValue s = score(scoringScheme, TValueH(h), TValueV(v));
+            table[h * sizeV + v] = s;
+            maxAbs = std::max(maxAbs, static_cast<TScoreValue>((s < 0) ? -s : s));
+        }
+    return maxAbs;
+}
+
+// ----------------------------------------------------------------------------
+// Function _batchSubstitution()
+// ----------------------------------------------------------------------------
+
+// Computes the substitution scores of a cell for all lanes.  The generic
+// version looks them up in the tabulated scoring scheme lane by lane, as the
+// byte shuffles cannot index tables of 16 or 32 bit scores.  Only the version
+// for simple scores and identical alphabets is vectorized, it compares the
+// characters directly.
+template <typename TSimdVector, typename TTable, typename TScoreValue, typename TScoreSpec>
+inline void
+_batchSubstitution(TSimdVector & subst,
+                   TSimdVector const & hChars,
+                   TSimdVector const & vChars,
+                   TTable const & table,
+                   unsigned sizeV,
+                   Score<TScoreValue, TScoreSpec> const & /*scoringScheme*/,
+                   False const & /*compare*/)
+{
+    for (unsigned k = 0; k < LENGTH<TSimdVector>::VALUE; ++k)
+        subst[k] = table[static_cast<unsigned>(hChars[k]) * sizeV + static_cast<unsigned>(vChars[k])];
+}
+
+template <typename TSimdVector, typename TTable, typename TScoreValue, typename TScoreSpec>
+inline void
+_batchSubstitution(TSimdVector & subst,
+                   TSimdVector const & hChars,
+                   TSimdVector const & vChars,
+                   TTable const & /*table*/,
+                   unsigned /*sizeV*/,
+                   Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                   True const & /*compare*/)
+{
+    typedef typename Value<TSimdVector>::Type TLane;
+
+    TSimdVector vecMatch;
+    TSimdVector vecMismatch;
+    fill(vecMatch, static_cast<TLane>(scoreMatch(scoringScheme)));
+    fill(vecMismatch, static_cast<TLane>(scoreMismatch(scoringScheme)));
+    subst = _simdBlend(vecMatch, vecMismatch, static_cast<TSimdVector>(hChars == vChars));
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatchSimd()
+// ----------------------------------------------------------------------------
+
+// Computes the scores of up to LENGTH<TSimdVector>::VALUE pairs whose ids are
+// given by [idsBegin, idsEnd).  The band is shared by all lanes, so the rows
+// of a column that lie inside the band are the same for all lanes.
+template <typename TSimdVector, typename TResults, typename TIdIter,
+          typename TSequenceH, typename TSpecH, typename TSequenceV, typename TSpecV,
+          typename TTable, typename TScoreValue, typename TScoreSpec, typename TBand, typename TDPProfile,
+          typename TCompare>
+void
+_computeAlignmentBatchSimd(TResults & results,
+                           TIdIter idsBegin,
+                           TIdIter idsEnd,
+                           StringSet<TSequenceH, TSpecH> const & seqSetH,
+                           StringSet<TSequenceV, TSpecV> const & seqSetV,
+                           TTable const & table,
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                           TScoreValue gapOpen,
+                           TScoreValue gapExtend,
+                           TBand const & band,
+                           TDPProfile const &,
+                           TCompare const & compare)
+{
+    typedef typename Value<TSimdVector>::Type TLane;
+    typedef typename Value<TSequenceV>::Type TValueV;
+
+    enum { LANES = LENGTH<TSimdVector>::VALUE };
+    unsigned const sizeV = ValueSize<TValueV>::VALUE;
+
+    bool const isLocal = IsLocalAlignment_<TDPProfile>::VALUE;
+    bool const freeFirstRow = IsFreeEndGap_<TDPProfile, DPFirstRow>::VALUE;
+    bool const freeFirstColumn = IsFreeEndGap_<TDPProfile, DPFirstColumn>::VALUE;
+    bool const freeLastRow = IsFreeEndGap_<TDPProfile, DPLastRow>::VALUE;
+    bool const freeLastColumn = IsFreeEndGap_<TDPProfile, DPLastColumn>::VALUE;
+
+    TLane const inf = MinValue<TLane>::VALUE / 2;
+
+    // ------------------------------------------------------------------------
+    // Transpose the sequences into lanes.
+    // ------------------------------------------------------------------------
+
+    unsigned lanes = idsEnd - idsBegin;
+    int lengthH[LANES];
+    int lengthV[LANES];
+    TLane best[LANES];
+    int maxH = 0;
+    int maxV = 0;
+    for (unsigned k = 0; k < LANES; ++k)
+    {
+        lengthH[k] = (k < lanes) ? static_cast<int>(length(seqSetH[idsBegin[k]])) : 0;
+        lengthV[k] = (k < lanes) ? static_cast<int>(length(seqSetV[idsBegin[k]])) : 0;
+        best[k] = (isLocal) ? 0 : inf;
+        maxH = std::max(maxH, lengthH[k]);
+        maxV = std::max(maxV, lengthV[k]);
+    }
+
+    String<char> buffer;
+    TSimdVector * ordH = _alignedSimdBuffer<TSimdVector>(buffer, maxH + 4 * maxV + 3);
+    TSimdVector * ordV = ordH + maxH;
+    TSimdVector * colH = ordV + maxV;
+    TSimdVector * colE = colH + maxV + 1;
+    TSimdVector * rowActive = colE + maxV + 1;  // Only used for local alignments.
+
+    for (int j = 0; j < maxH; ++j)
+        for (unsigned k = 0; k < LANES; ++k)
+            ordH[j][k] = (j < lengthH[k]) ? ordValue(seqSetH[idsBegin[k]][j]) : 0;
+    for (int i = 0; i < maxV; ++i)
+        for (unsigned k = 0; k < LANES; ++k)
+            ordV[i][k] = (i < lengthV[k]) ? ordValue(seqSetV[idsBegin[k]][i]) : 0;
+
+    TSimdVector vecZero;
+    TSimdVector vecInf;
+    TSimdVector vecOpen;
+    TSimdVector vecExtend;
+    TSimdVector vecBest;
+    TSimdVector vecLengthH;
+    TSimdVector vecLengthV;
+    clear(vecZero);
+    fill(vecInf, inf);
+    fill(vecOpen, static_cast<TLane>(gapOpen));
+    fill(vecExtend, static_cast<TLane>(gapExtend));
+    fill(vecBest, (isLocal) ? 0 : inf);
+    for (unsigned k = 0; k < LANES; ++k)
+    {
+        vecLengthH[k] = lengthH[k];
+        vecLengthV[k] = lengthV[k];
+    }
+
+    for (int i = 0; i <= maxV; ++i)
+    {
+        colH[i] = vecInf;
+        colE[i] = vecInf;
+        if (isLocal)
+        {
+            TSimdVector vecRow;
+            fill(vecRow, static_cast<TLane>(i));
+            rowActive[i] = static_cast<TSimdVector>(vecRow <= vecLengthV);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compute the matrices column by column.
+    // ------------------------------------------------------------------------
+
+    for (int j = 0; j <= maxH; ++j)
+    {
+        // The rows of column j that are covered by the band.
+        int lo = 0;
+        int hi = maxV;
+        if (_isBandEnabled(band))
+        {
+            lo = std::max(lo, j - upperDiagonal(band));
+            hi = std::min(hi, j - lowerDiagonal(band));
+        }
+        if (lo > hi)
+            continue;
+
+        TSimdVector colActive = vecZero;
+        if (isLocal)
+        {
+            TSimdVector vecCol;
+            fill(vecCol, static_cast<TLane>(j));
+            colActive = static_cast<TSimdVector>(vecCol <= vecLengthH);
+        }
+
+        TSimdVector diag;
+        TSimdVector up;
+        TSimdVector vert;
+        int i = lo;
+        if (lo == 0)
+        {
+            // Initialize the first cell of the column.
+            diag = colH[0];
+            if (j == 0 || isLocal || freeFirstRow)
+            {
+                colH[0] = vecZero;
+                colE[0] = (isLocal) ? vecZero : vecInf;
+            }
+            else
+            {
+                colE[0] = _simdMax(colE[0] + vecExtend, colH[0] + vecOpen);
+                colH[0] = colE[0];
+            }
+            up = colH[0];
+            vert = (isLocal) ? vecZero : vecInf;
+            ++i;
+        }
+        else
+        {
+            diag = colH[lo - 1];
+            up = vecInf;
+            vert = vecInf;
+        }
+
+        if (j == 0)
+        {
+            // Initialize the first column.
+            for (; i <= hi; ++i)
+            {
+                if (isLocal || freeFirstColumn)
+                {
+                    colH[i] = vecZero;
+                    vert = (isLocal) ? vecZero : vecInf;
+                }
+                else
+                {
+                    vert = _simdMax(vert + vecExtend, up + vecOpen);
+                    colH[i] = vert;
+                }
+                colE[i] = (isLocal) ? vecZero : vecInf;
+                up = colH[i];
+            }
+        }
+        else
+        {
+            TSimdVector const & hChars = ordH[j - 1];
+            for (; i <= hi; ++i)
+            {
+                TSimdVector const & vChars = ordV[i - 1];
+                TSimdVector subst;
+                _batchSubstitution(subst, hChars, vChars, table, sizeV, scoringScheme, compare);
+
+                TSimdVector left = colH[i];
+                TSimdVector hori = _simdMax(colE[i] + vecExtend, left + vecOpen);
+                vert = _simdMax(vert + vecExtend, up + vecOpen);
+                TSimdVector cell = _simdMax(diag + subst, _simdMax(hori, vert));
+                if (isLocal)
+                {
+                    // Cells with a non-positive score are reset completely.
+                    TSimdVector positive = static_cast<TSimdVector>(cell > vecZero);
+                    cell &= positive;
+                    hori &= positive;
+                    vert &= positive;
+                    TSimdVector better = static_cast<TSimdVector>(cell > vecBest) & rowActive[i] & colActive;
+                    vecBest = _simdBlend(cell, vecBest, better);
+                }
+                diag = left;
+                colH[i] = cell;
+                colE[i] = hori;
+                up = cell;
+            }
+        }
+
+        // The cells right below the band are read by the next column.
+        if (hi < maxV)
+        {
+            colH[hi + 1] = vecInf;
+            colE[hi + 1] = vecInf;
+        }
+
+        if (isLocal)
+            continue;
+
+        // Track the global alignment scores in the last row and column of each lane.
+        for (unsigned k = 0; k < lanes; ++k)
+        {
+            if (j > lengthH[k])
+                continue;
+            if ((freeLastRow || j == lengthH[k]) && lo <= lengthV[k] && lengthV[k] <= hi)
+                best[k] = std::max(best[k], static_cast<TLane>(colH[lengthV[k]][k]));
+            if (freeLastColumn && j == lengthH[k])
+                for (int r = lo; r <= std::min(hi, lengthV[k]); ++r)
+                    best[k] = std::max(best[k], static_cast<TLane>(colH[r][k]));
+        }
+    }
+
+    for (unsigned k = 0; k < lanes; ++k)
+        results[idsBegin[k]] = static_cast<TScoreValue>((isLocal) ? vecBest[k] : best[k]);
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatch()                            [SIMD version]
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TSpec,
+          typename TSequenceH, typename TSpecH, typename TSequenceV, typename TSpecV, typename TScoreSpec,
+          typename TDPType, typename TBand, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel>
+inline void
+_computeAlignmentBatch(String<TScoreValue, TSpec> & results,
+                       StringSet<TSequenceH, TSpecH> const & seqSetH,
+                       StringSet<TSequenceV, TSpecV> const & seqSetV,
+                       Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                       AlignConfig2<TDPType, TBand, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                       TGapModel const & gapModel,
+                       True const & /*vectorize*/)
+{
+    typedef typename Value<TSequenceH>::Type TValueH;
+    typedef typename Value<TSequenceV>::Type TValueV;
+    typedef typename SetupAlignmentProfile_<TDPType, TFreeEndGaps, TGapModel, TracebackOff>::Type TDPProfile;
+    typedef SimdVector<short>::Type TSimdShort;
+    typedef SimdVector<int>::Type TSimdInt;
+    typedef typename Size<StringSet<TSequenceH, TSpecH> const>::Type TSize;
+    typedef typename And<IsSameType<TScoreSpec, Simple>, IsSameType<TValueH, TValueV> >::Type TCompare;
+
+    // The vectorized DP only supports gap models with constant open/extend costs.
+    TScoreValue gapExtend = scoreGapExtend(scoringScheme);
+    TScoreValue gapOpen = (IsSameType<TGapModel, LinearGaps>::VALUE) ? gapExtend : scoreGapOpen(scoringScheme);
+
+    String<int> table;
+    TScoreValue maxStep = _batchSubstitutionTable(table, TValueH(), TValueV(), scoringScheme);
+    maxStep = std::max(maxStep, static_cast<TScoreValue>((gapOpen < 0) ? -gapOpen : gapOpen));
+    maxStep = std::max(maxStep, static_cast<TScoreValue>((gapExtend < 0) ? -gapExtend : gapExtend));
+
+    // Invalid settings (e.g. empty sequences or a band outside the matrix) are
+    // handled by the scalar DP, all other pairs are sorted by length.
+    String<TSize> ids;
+    String<unsigned> lengthsH;
+    String<unsigned> lengthsV;
+    resize(lengthsH, length(seqSetH), Exact());
+    resize(lengthsV, length(seqSetV), Exact());
+    for (TSize pairId = 0; pairId < length(seqSetH); ++pairId)
+    {
+        lengthsH[pairId] = length(seqSetH[pairId]);
+        lengthsV[pairId] = length(seqSetV[pairId]);
+        if (_isValidDPSettings(seqSetH[pairId], seqSetV[pairId], alignConfig._band, TDPProfile()))
+            appendValue(ids, pairId);
+        else
+            results[pairId] = _computeAlignmentScoreScalar(seqSetH[pairId], seqSetV[pairId], scoringScheme,
+                                                           alignConfig, gapModel);
+    }
+    std::sort(begin(ids, Standard()), end(ids, Standard()), DPBatchLessLength_<String<unsigned> >(lengthsH, lengthsV));
+
+    typedef typename Iterator<String<TSize>, Standard>::Type TIdIter;
+    TIdIter idsEnd = end(ids, Standard());
+    for (TIdIter it = begin(ids, Standard()); it != idsEnd;)
+    {
+        // Choose the narrowest lanes that cannot overflow for this batch.  The
+        // infinity value of the lanes must stay far below all reachable scores.
+        TIdIter batchEnd = it + std::min(static_cast<long>(idsEnd - it), static_cast<long>(LENGTH<TSimdShort>::VALUE));
+        unsigned maxLength = 0;
+        for (TIdIter batchIt = it; batchIt != batchEnd; ++batchIt)
+            maxLength = std::max(maxLength, lengthsH[*batchIt] + lengthsV[*batchIt]);
+        __int64 bound = static_cast<__int64>(maxLength + 2) * maxStep;
+
+        if (bound < (MaxValue<short>::VALUE >> 2))
+        {
+            _computeAlignmentBatchSimd<TSimdShort>(results, it, batchEnd, seqSetH, seqSetV, table, scoringScheme,
+                                                   gapOpen, gapExtend, alignConfig._band, TDPProfile(), TCompare());
+            it = batchEnd;
+            continue;
+        }
+
+        batchEnd = it + std::min(static_cast<long>(idsEnd - it), static_cast<long>(LENGTH<TSimdInt>::VALUE));
+        maxLength = 0;
+        for (TIdIter batchIt = it; batchIt != batchEnd; ++batchIt)
+            maxLength = std::max(maxLength, lengthsH[*batchIt] + lengthsV[*batchIt]);
+        bound = static_cast<__int64>(maxLength + 2) * maxStep;
+
+        if (bound < (MaxValue<int>::VALUE >> 2))
+        {
+            _computeAlignmentBatchSimd<TSimdInt>(results, it, batchEnd, seqSetH, seqSetV, table, scoringScheme,
+                                                 gapOpen, gapExtend, alignConfig._band, TDPProfile(), TCompare());
+        }
+        else
+        {
+            for (TIdIter batchIt = it; batchIt != batchEnd; ++batchIt)
+                results[*batchIt] = _computeAlignmentScoreScalar(seqSetH[*batchIt], seqSetV[*batchIt], scoringScheme,
+                                                                 alignConfig, gapModel);
+        }
+        it = batchEnd;
+    }
+}
+
+#endif  // #ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatch()                          [scalar version]
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TSpec,
+          typename TSequenceH, typename TSpecH, typename TSequenceV, typename TSpecV, typename TScoreSpec,
+          typename TAlignConfig2, typename TGapModel>
+inline void
+_computeAlignmentBatch(String<TScoreValue, TSpec> & results,
+                       StringSet<TSequenceH, TSpecH> const & seqSetH,
+                       StringSet<TSequenceV, TSpecV> const & seqSetV,
+                       Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                       TAlignConfig2 const & alignConfig,
+                       TGapModel const & gapModel,
+                       False const & /*vectorize*/)
+{
+    typedef typename Size<StringSet<TSequenceH, TSpecH> const>::Type TSize;
+
+    for (TSize pairId = 0; pairId < length(seqSetH); ++pairId)
+        results[pairId] = _computeAlignmentScoreScalar(seqSetH[pairId], seqSetV[pairId], scoringScheme,
+                                                       alignConfig, gapModel);
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeAlignmentBatch()
+// ----------------------------------------------------------------------------
+
+// Computes the alignment scores of the pairs (seqSetH[i], seqSetV[i]).  The
+// vectorized version is chosen if the instruction set and the scoring scheme
+// permit it.
+template <typename TScoreValue, typename TSpec,
+          typename TSequenceH, typename TSpecH, typename TSequenceV, typename TSpecV, typename TScoreSpec,
+          typename TAlignConfig2, typename TGapModel>
+inline void
+_computeAlignmentBatch(String<TScoreValue, TSpec> & results,
+                       StringSet<TSequenceH, TSpecH> const & seqSetH,
+                       StringSet<TSequenceV, TSpecV> const & seqSetV,
+                       Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                       TAlignConfig2 const & alignConfig,
+                       TGapModel const & gapModel)
+{
+    SEQAN_ASSERT_EQ(length(seqSetH), length(seqSetV));
+    resize(results, length(seqSetH), Exact());
+
+#ifdef __SSE4_1__
+    typedef typename Value<TSequenceH>::Type TValueH;
+    typedef typename Value<TSequenceV>::Type TValueV;
+    typedef typename And<And<IsBatchScoringScheme_<Score<TScoreValue, TScoreSpec> >, IsIntegral<TScoreValue> >,
+                         And<Or<IsSameType<TGapModel, LinearGaps>, IsSameType<TGapModel, AffineGaps> >,
+                             Eval<ValueSize<TValueH>::VALUE <= 256u && ValueSize<TValueV>::VALUE <= 256u> >
+                        >::Type TVectorize;
+#else
+    typedef False TVectorize;
+#endif
+
+    _computeAlignmentBatch(results, seqSetH, seqSetV, scoringScheme, alignConfig, gapModel, TVectorize());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_BATCH_IMPL_H_
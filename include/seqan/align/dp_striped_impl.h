@@ -0,0 +1,799 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Striped (Farrar) intra-sequence vectorization of unbanded local
+// alignments, selected with the Striped tag.  The vertical sequence (the query) is laid out in a striped
+// query profile, the horizontal sequence is processed column by column.
+// Scores are computed with saturated 8 bit lanes first and recomputed with
+// 16 bit lanes if they overflow.  If those overflow, too, or the alignment is
+// not supported, the scalar DP is used.
+//
+// Without traceback, the striped DP only computes the score.  With
+// traceback, it determines the cell the DPScout would report and a begin
+// bound for all optimal alignments ending there.  Only this rectangle is
+// then aligned with the scalar DP, which yields the same alignment as
+// aligning the whole sequences.
+//
+// Farrar M. Striped Smith-Waterman speeds database searches six times over
+// other SIMD implementations.  Bioinformatics 23(2):156-161, 2007.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_STRIPED_IMPL_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_DP_STRIPED_IMPL_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+#ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Class StripedLanes_
+// ----------------------------------------------------------------------------
+
+// The saturated operations on SIMD registers of BITS bits for a lane type.
+// All lanes hold non-negative scores, the floor at zero of the local
+// alignment comes for free with the saturated subtraction.
+template <typename TValue, unsigned BITS>
+struct StripedLanes_;
+
+// 8 bit lanes.  The scores are unsigned, therefore the profile is biased by
+// the negated minimal substitution score.
+template <>
+struct StripedLanes_<unsigned char, 128>
+{
+    typedef __m128i TRegister;
+    enum { LANES = 16 };
+    static const int MAX_VALUE = 255;
+
+    static __m128i zero() { return _mm_setzero_si128(); }
+    static __m128i set(int v) { return _mm_set1_epi8(static_cast<char>(v)); }
+    static __m128i shift(__m128i const & a) { return _mm_slli_si128(a, 1); }
+    static __m128i max(__m128i const & a, __m128i const & b) { return _mm_max_epu8(a, b); }
+    static __m128i subs(__m128i const & a, __m128i const & b) { return _mm_subs_epu8(a, b); }
+
+    static __m128i addProfile(__m128i const & a, __m128i const & p, __m128i const & bias)
+    {
+        return _mm_subs_epu8(_mm_adds_epu8(a, p), bias);
+    }
+
+    static bool anyGreater(__m128i const & a, __m128i const & b)
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(a, b), _mm_setzero_si128())) != 0xffff;
+    }
+};
+
+// 16 bit lanes.  The scores are signed and not biased.
+template <>
+struct StripedLanes_<short, 128>
+{
+    typedef __m128i TRegister;
+    enum { LANES = 8 };
+    static const int MAX_VALUE = 32767;
+
+    static __m128i zero() { return _mm_setzero_si128(); }
+    static __m128i set(int v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    static __m128i shift(__m128i const & a) { return _mm_slli_si128(a, 2); }
+    static __m128i max(__m128i const & a, __m128i const & b) { return _mm_max_epi16(a, b); }
+    static __m128i subs(__m128i const & a, __m128i const & b) { return _mm_subs_epu16(a, b); }
+
+    static __m128i addProfile(__m128i const & a, __m128i const & p, __m128i const & /*bias*/)
+    {
+        return _mm_adds_epi16(a, p);
+    }
+
+    static bool anyGreater(__m128i const & a, __m128i const & b)
+    {
+        return _mm_movemask_epi8(_mm_cmpgt_epi16(a, b)) != 0;
+    }
+};
+
+#ifdef __AVX2__
+
+// The byte-wise shift of 256 bit registers has to carry the upper lane of
+// the lower half into the upper half, see shift().
+template <>
+struct StripedLanes_<unsigned char, 256>
+{
+    typedef __m256i TRegister;
+    enum { LANES = 32 };
+    static const int MAX_VALUE = 255;
+
+    static __m256i zero() { return _mm256_setzero_si256(); }
+    static __m256i set(int v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+    static __m256i max(__m256i const & a, __m256i const & b) { return _mm256_max_epu8(a, b); }
+    static __m256i subs(__m256i const & a, __m256i const & b) { return _mm256_subs_epu8(a, b); }
+
+    static __m256i shift(__m256i const & a)
+    {
+        return _mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 15);
+    }
+
+    static __m256i addProfile(__m256i const & a, __m256i const & p, __m256i const & bias)
+    {
+        return _mm256_subs_epu8(_mm256_adds_epu8(a, p), bias);
+    }
+
+    static bool anyGreater(__m256i const & a, __m256i const & b)
+    {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), _mm256_setzero_si256())) != -1;
+    }
+};
+
+template <>
+struct StripedLanes_<short, 256>
+{
+    typedef __m256i TRegister;
+    enum { LANES = 16 };
+    static const int MAX_VALUE = 32767;
+
+    static __m256i zero() { return _mm256_setzero_si256(); }
+    static __m256i set(int v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    static __m256i max(__m256i const & a, __m256i const & b) { return _mm256_max_epi16(a, b); }
+    static __m256i subs(__m256i const & a, __m256i const & b) { return _mm256_subs_epu16(a, b); }
+
+    static __m256i shift(__m256i const & a)
+    {
+        return _mm256_alignr_epi8(a, _mm256_permute2x128_si256(a, a, 0x08), 14);
+    }
+
+    static __m256i addProfile(__m256i const & a, __m256i const & p, __m256i const & /*bias*/)
+    {
+        return _mm256_adds_epi16(a, p);
+    }
+
+    static bool anyGreater(__m256i const & a, __m256i const & b)
+    {
+        return _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b)) != 0;
+    }
+};
+
+// The widest registers are used.
+enum { STRIPED_REGISTER_BITS = 256 };
+
+#else  // #ifdef __AVX2__
+
+enum { STRIPED_REGISTER_BITS = 128 };
+
+#endif  // #ifdef __AVX2__
+
+// ----------------------------------------------------------------------------
+// Class StripedMaxScore_
+// ----------------------------------------------------------------------------
+
+// Tracks the maximal score only.
+template <typename TLanes>
+struct StripedMaxScore_
+{
+    typedef typename TLanes::TRegister TRegister;
+
+    TRegister vMaxScore;
+};
+
+// ----------------------------------------------------------------------------
+// Class StripedBestCell_
+// ----------------------------------------------------------------------------
+
+// Tracks the first cell with the maximal score in column-major order, which
+// is the one the DPScout reports.  The column in which the maximum improves
+// is kept to find the row in the end.
+template <typename TLanes>
+struct StripedBestCell_
+{
+    typedef typename TLanes::TRegister TRegister;
+
+    int score;
+    int column;
+    TRegister vScore;
+    TRegister * bestColumn;
+    String<char> buffer;
+};
+
+// ----------------------------------------------------------------------------
+// Class StripedBeginBound_
+// ----------------------------------------------------------------------------
+
+// Tracks the last column and, per row, the maximal score of a local
+// alignment of reversed prefixes.  The cells reaching the given score bound
+// the begin of all optimal alignments ending at the end of the prefixes.
+template <typename TLanes>
+struct StripedBeginBound_
+{
+    typedef typename TLanes::TRegister TRegister;
+
+    int score;
+    int column;
+    TRegister vThreshold;
+    TRegister * rowMax;
+    String<char> buffer;
+
+    StripedBeginBound_(int score) : score(score), column(-1), rowMax(0)
+    {}
+};
+
+#endif  // #ifdef __SSE4_1__
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction IsStripedAlignment_
+// ----------------------------------------------------------------------------
+
+// The striped DP requires integral scores from a substitution table and
+// alphabets of at most 256 characters.  Dynamic gaps are not supported.
+template <typename TScoringScheme, typename TSequenceH, typename TSequenceV, typename TGapScheme>
+struct IsStripedAlignment_ :
+    And<And<IsBatchScoringScheme_<TScoringScheme>, IsIntegral<typename Value<TScoringScheme>::Type> >,
+        And<Not<IsSameType<TGapScheme, DynamicGaps> >,
+            Eval<ValueSize<typename Value<TSequenceH>::Type>::VALUE <= 256u &&
+                 ValueSize<typename Value<TSequenceV>::Type>::VALUE <= 256u> > >
+{};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+#ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function _stripedLaneMax()
+// ----------------------------------------------------------------------------
+
+template <typename TLane, unsigned BITS>
+inline int
+_stripedLaneMax(typename StripedLanes_<TLane, BITS>::TRegister const & vec, StripedLanes_<TLane, BITS> const & /*lanes*/)
+{
+    TLane const * lanes = reinterpret_cast<TLane const *>(&vec);
+    int result = 0;
+    for (int k = 0; k < StripedLanes_<TLane, BITS>::LANES; ++k)
+        result = std::max(result, static_cast<int>(lanes[k]));
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function _stripedInit()
+// ----------------------------------------------------------------------------
+
+template <typename TLanes>
+inline void
+_stripedInit(StripedMaxScore_<TLanes> & tracker, int /*segLength*/)
+{
+    tracker.vMaxScore = TLanes::zero();
+}
+
+template <typename TLanes>
+inline void
+_stripedInit(StripedBestCell_<TLanes> & tracker, int segLength)
+{
+    tracker.score = 0;
+    tracker.column = -1;
+    tracker.vScore = TLanes::zero();
+    tracker.bestColumn = _alignedSimdBuffer<typename TLanes::TRegister>(tracker.buffer, segLength);
+}
+
+template <typename TLanes>
+inline void
+_stripedInit(StripedBeginBound_<TLanes> & tracker, int segLength)
+{
+    tracker.column = -1;
+    tracker.vThreshold = TLanes::set(tracker.score - 1);
+    tracker.rowMax = _alignedSimdBuffer<typename TLanes::TRegister>(tracker.buffer, segLength);
+    for (int i = 0; i < segLength; ++i)
+        tracker.rowMax[i] = TLanes::zero();
+}
+
+// ----------------------------------------------------------------------------
+// Function _stripedCell()
+// ----------------------------------------------------------------------------
+
+template <typename TLanes>
+inline void
+_stripedCell(StripedMaxScore_<TLanes> & /*tracker*/, int /*segment*/, typename TLanes::TRegister const & /*vH*/)
+{}
+
+template <typename TLanes>
+inline void
+_stripedCell(StripedBestCell_<TLanes> & /*tracker*/, int /*segment*/, typename TLanes::TRegister const & /*vH*/)
+{}
+
+template <typename TLanes>
+inline void
+_stripedCell(StripedBeginBound_<TLanes> & tracker, int segment, typename TLanes::TRegister const & vH)
+{
+    tracker.rowMax[segment] = TLanes::max(tracker.rowMax[segment], vH);
+}
+
+// ----------------------------------------------------------------------------
+// Function _stripedColumn()
+// ----------------------------------------------------------------------------
+
+template <typename TLanes>
+inline void
+_stripedColumn(StripedMaxScore_<TLanes> & tracker,
+               int /*column*/,
+               typename TLanes::TRegister const & vMaxColumn,
+               typename TLanes::TRegister const * /*pvH*/,
+               int /*segLength*/)
+{
+    tracker.vMaxScore = TLanes::max(tracker.vMaxScore, vMaxColumn);
+}
+
+template <typename TLanes>
+inline void
+_stripedColumn(StripedBestCell_<TLanes> & tracker,
+               int column,
+               typename TLanes::TRegister const & vMaxColumn,
+               typename TLanes::TRegister const * pvH,
+               int segLength)
+{
+    // Like the DPScout, only a strictly greater score is a new maximum.
+    if (!TLanes::anyGreater(vMaxColumn, tracker.vScore))
+        return;
+    tracker.score = _stripedLaneMax(vMaxColumn, TLanes());
+    tracker.vScore = TLanes::set(tracker.score);
+    tracker.column = column;
+    std::copy(pvH, pvH + segLength, tracker.bestColumn);
+}
+
+template <typename TLanes>
+inline void
+_stripedColumn(StripedBeginBound_<TLanes> & tracker,
+               int column,
+               typename TLanes::TRegister const & vMaxColumn,
+               typename TLanes::TRegister const * /*pvH*/,
+               int /*segLength*/)
+{
+    if (TLanes::anyGreater(vMaxColumn, tracker.vThreshold))
+        tracker.column = column;
+}
+
+// ----------------------------------------------------------------------------
+// Function _stripedRowScore()
+// ----------------------------------------------------------------------------
+
+// Returns the score of a row in a striped column.
+template <typename TLane, unsigned BITS>
+inline int
+_stripedRowScore(typename StripedLanes_<TLane, BITS>::TRegister const * pvH,
+                 int segLength,
+                 int row,
+                 StripedLanes_<TLane, BITS> const & /*lanes*/)
+{
+    return reinterpret_cast<TLane const *>(pvH + row % segLength)[row / segLength];
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeStripedLocal()
+// ----------------------------------------------------------------------------
+
+// Computes the local alignment matrix of seqH and seqV with affine gap costs
+// in the lanes of TLanes and reports the cells to the tracker.  Returns
+// false if the scores do not fit into the lanes.
+template <typename TTracker, typename TSequenceH, typename TSequenceV, typename TTable, typename TLane,
+          unsigned BITS>
+bool
+_computeStripedLocal(TTracker & tracker,
+                     TSequenceH const & seqH,
+                     TSequenceV const & seqV,
+                     TTable const & table,
+                     int minScore,
+                     int maxScore,
+                     int gapOpenCost,
+                     int gapExtendCost,
+                     StripedLanes_<TLane, BITS> const & /*lanes*/)
+{
+    typedef StripedLanes_<TLane, BITS> TOps;
+    typedef typename TOps::TRegister TRegister;
+    typedef typename Value<TSequenceH>::Type TValueH;
+    typedef typename Value<TSequenceV>::Type TValueV;
+    typedef typename Iterator<TSequenceH const, Standard>::Type TIterH;
+
+    enum { LANES = TOps::LANES };
+    unsigned const sizeH = ValueSize<TValueH>::VALUE;
+    unsigned const sizeV = ValueSize<TValueV>::VALUE;
+
+    // Only the 8 bit lanes are biased.
+    int bias = (TOps::MAX_VALUE == 255) ? -minScore : 0;
+    int threshold = TOps::MAX_VALUE - (maxScore + bias);
+    if (threshold <= 0 || gapOpenCost > TOps::MAX_VALUE || gapExtendCost > TOps::MAX_VALUE)
+        return false;
+
+    // ------------------------------------------------------------------------
+    // Build the striped query profile.
+    // ------------------------------------------------------------------------
+
+    // Lane k of segment i holds query position k * segLength + i.  The
+    // positions behind the end of the query get the substitution score 0.
+    int lengthV = length(seqV);
+    int segLength = (lengthV + LANES - 1) / LANES;
+
+    String<char> buffer;
+    TRegister * profile = _alignedSimdBuffer<TRegister>(buffer, (sizeH + 3) * segLength);
+    TRegister * pvHStore = profile + sizeH * segLength;
+    TRegister * pvHLoad = pvHStore + segLength;
+    TRegister * pvE = pvHLoad + segLength;
+
+    for (unsigned h = 0; h < sizeH; ++h)
+    {
+        TLane * vP = reinterpret_cast<TLane *>(profile + h * segLength);
+        for (int i = 0; i < segLength; ++i)
+            for (int k = 0; k < LANES; ++k)
+            {
+                int pos = k * segLength + i;
+                int s = (pos < lengthV) ? table[h * sizeV + ordValue(seqV[pos])] : 0;
+                *vP++ = static_cast<TLane>(s + bias);
+            }
+    }
+
+    TRegister vZero = TOps::zero();
+    for (int i = 0; i < segLength; ++i)
+        pvHStore[i] = pvHLoad[i] = pvE[i] = vZero;
+
+    TRegister vBias = TOps::set(bias);
+    TRegister vGapO = TOps::set(gapOpenCost);
+    TRegister vGapE = TOps::set(gapExtendCost);
+    TRegister vThreshold = TOps::set(threshold);
+    _stripedInit(tracker, segLength);
+
+    // ------------------------------------------------------------------------
+    // Compute the matrix column by column.
+    // ------------------------------------------------------------------------
+
+    TIterH itBegin = begin(seqH, Standard());
+    TIterH itEnd = end(seqH, Standard());
+    for (TIterH it = itBegin; it != itEnd; ++it)
+    {
+        TRegister vF = vZero;
+        TRegister vMaxColumn = vZero;
+        TRegister vH = TOps::shift(pvHStore[segLength - 1]);
+        TRegister const * vP = profile + ordValue(*it) * segLength;
+        std::swap(pvHLoad, pvHStore);
+
+        for (int i = 0; i < segLength; ++i)
+        {
+            vH = TOps::addProfile(vH, vP[i], vBias);
+            TRegister vE = pvE[i];
+            vH = TOps::max(vH, vE);
+            vH = TOps::max(vH, vF);
+            vMaxColumn = TOps::max(vMaxColumn, vH);
+            pvHStore[i] = vH;
+            _stripedCell(tracker, i, vH);
+
+            vH = TOps::subs(vH, vGapO);
+            pvE[i] = TOps::max(TOps::subs(vE, vGapE), vH);
+            vF = TOps::max(TOps::subs(vF, vGapE), vH);
+            vH = pvHLoad[i];
+        }
+
+        // Lazy F loop: propagate the vertical gaps across the segment
+        // boundaries until they cannot improve any cell anymore.
+        vF = TOps::shift(vF);
+        for (int i = 0; TOps::anyGreater(vF, TOps::subs(pvHStore[i], vGapO));)
+        {
+            vH = TOps::max(pvHStore[i], vF);
+            pvHStore[i] = vH;
+            vMaxColumn = TOps::max(vMaxColumn, vH);
+            _stripedCell(tracker, i, vH);
+
+            vH = TOps::subs(vH, vGapO);
+            pvE[i] = TOps::max(pvE[i], vH);
+            vF = TOps::subs(vF, vGapE);
+            if (++i == segLength)
+            {
+                i = 0;
+                vF = TOps::shift(vF);
+            }
+        }
+
+        // The next column could saturate if a cell exceeds the threshold.
+        if (TOps::anyGreater(vMaxColumn, vThreshold))
+            return false;
+        _stripedColumn(tracker, it - itBegin, vMaxColumn, pvHStore, segLength);
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeStripedLocalAlignment()
+// ----------------------------------------------------------------------------
+
+// Score only.
+template <typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue2, typename TScoreSpec, typename TTable, typename TLane, unsigned BITS>
+inline bool
+_computeStripedLocalAlignment(TScoreValue2 & score,
+                              DPContext<TScoreValue, TGapScheme> & /*dpContext*/,
+                              TTraceTarget & /*traceSegments*/,
+                              DPScoutState_<Default> & /*scoutState*/,
+                              TSequenceH const & seqH,
+                              TSequenceV const & seqV,
+                              Score<TScoreValue2, TScoreSpec> const & /*scoringScheme*/,
+                              TTable const & table,
+                              int minScore,
+                              int maxScore,
+                              int gapOpenCost,
+                              int gapExtendCost,
+                              DPProfile_<LocalAlignment_<>, TGapScheme, TracebackOff> const & /*dpProfile*/,
+                              StripedLanes_<TLane, BITS> const & lanes)
+{
+    StripedMaxScore_<StripedLanes_<TLane, BITS> > tracker;
+    if (!_computeStripedLocal(tracker, seqH, seqV, table, minScore, maxScore, gapOpenCost, gapExtendCost, lanes))
+        return false;
+    score = static_cast<TScoreValue2>(_stripedLaneMax(tracker.vMaxScore, lanes));
+    return true;
+}
+
+// With traceback.
+template <typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue2, typename TScoreSpec, typename TTable, typename TTraceFlag, typename TLane,
+          unsigned BITS>
+inline bool
+_computeStripedLocalAlignment(TScoreValue2 & score,
+                              DPContext<TScoreValue, TGapScheme> & dpContext,
+                              TTraceTarget & traceSegments,
+                              DPScoutState_<Default> & scoutState,
+                              TSequenceH const & seqH,
+                              TSequenceV const & seqV,
+                              Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                              TTable const & table,
+                              int minScore,
+                              int maxScore,
+                              int gapOpenCost,
+                              int gapExtendCost,
+                              DPProfile_<LocalAlignment_<>, TGapScheme, TTraceFlag> const & dpProfile,
+                              StripedLanes_<TLane, BITS> const & lanes)
+{
+    typedef StripedLanes_<TLane, BITS> TLanes;
+    typedef typename Value<TSequenceH>::Type TValueH;
+    typedef typename Value<TSequenceV>::Type TValueV;
+    typedef typename Size<TTraceTarget>::Type TTraceSize;
+
+    // The end of the alignment is the first cell with the maximal score in
+    // column-major order.  The scalar DP handles alignments of score 0.
+    StripedBestCell_<TLanes> bestCell;
+    if (!_computeStripedLocal(bestCell, seqH, seqV, table, minScore, maxScore, gapOpenCost, gapExtendCost, lanes) ||
+        bestCell.score == 0)
+        return false;
+
+    int lengthV = length(seqV);
+    int segLength = (lengthV + TLanes::LANES - 1) / TLanes::LANES;
+    int endH = bestCell.column;
+    int endV = 0;
+    while (_stripedRowScore(bestCell.bestColumn, segLength, endV, lanes) != bestCell.score)
+        ++endV;
+
+    // An optimal alignment ending there does not begin with a gap, because
+    // gaps have positive costs.  Its reversal is a local alignment of the
+    // reversed prefixes with the maximal score, so the last column and row
+    // in which such an alignment ends bound the begin of all of them.
+    String<TValueH> revH;
+    String<TValueV> revV;
+    resize(revH, endH + 1, Exact());
+    resize(revV, endV + 1, Exact());
+    for (int j = 0; j <= endH; ++j)
+        revH[j] = seqH[endH - j];
+    for (int i = 0; i <= endV; ++i)
+        revV[i] = seqV[endV - i];
+
+    StripedBeginBound_<TLanes> beginBound(bestCell.score);
+    if (!_computeStripedLocal(beginBound, revH, revV, table, minScore, maxScore, gapOpenCost, gapExtendCost, lanes))
+        return false;
+
+    int revSegLength = (endV + TLanes::LANES) / TLanes::LANES;
+    int lastRow = endV;
+    while (_stripedRowScore(beginBound.rowMax, revSegLength, lastRow, lanes) < bestCell.score)
+        --lastRow;
+    int beginH = endH - beginBound.column;
+    int beginV = endV - lastRow;
+
+    // The scalar DP on the rectangle computes the same scores and trace
+    // values along these alignments as on the whole matrix.  If it does not
+    // find the striped score, the caller aligns the whole sequences.
+    TTraceSize oldLength = length(traceSegments);
+    score = _computeAlignment(dpContext, traceSegments, scoutState, infix(seqH, beginH, endH + 1),
+                              infix(seqV, beginV, endV + 1), scoringScheme, DPBandConfig<BandOff>(), dpProfile);
+    if (score != static_cast<TScoreValue2>(bestCell.score))
+    {
+        resize(traceSegments, oldLength);
+        return false;
+    }
+
+    for (TTraceSize i = oldLength; i < length(traceSegments); ++i)
+    {
+        traceSegments[i]._horizontalBeginPos += beginH;
+        traceSegments[i]._verticalBeginPos += beginV;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeStripedAlignment()
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue2, typename TScoreSpec, typename TTraceFlag>
+inline bool
+_computeStripedAlignment(TScoreValue2 & /*score*/,
+                         DPContext<TScoreValue, TGapScheme> & /*dpContext*/,
+                         TTraceTarget & /*traceSegments*/,
+                         DPScoutState_<Default> & /*scoutState*/,
+                         TSequenceH const & /*seqH*/,
+                         TSequenceV const & /*seqV*/,
+                         Score<TScoreValue2, TScoreSpec> const & /*scoringScheme*/,
+                         DPProfile_<LocalAlignment_<>, TGapScheme, TTraceFlag> const & /*dpProfile*/,
+                         False const & /*striped*/)
+{
+    return false;
+}
+
+// Escalates from 8 to 16 bit lanes and returns false if those overflow.
+template <typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue2, typename TScoreSpec, typename TTraceFlag>
+inline bool
+_computeStripedAlignment(TScoreValue2 & score,
+                         DPContext<TScoreValue, TGapScheme> & dpContext,
+                         TTraceTarget & traceSegments,
+                         DPScoutState_<Default> & scoutState,
+                         TSequenceH const & seqH,
+                         TSequenceV const & seqV,
+                         Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                         DPProfile_<LocalAlignment_<>, TGapScheme, TTraceFlag> const & dpProfile,
+                         True const & /*striped*/)
+{
+    typedef typename Value<TSequenceH>::Type TValueH;
+    typedef typename Value<TSequenceV>::Type TValueV;
+
+    if (empty(seqH) || empty(seqV))
+        return false;
+
+    // Gaps must have positive costs, the linear gap model only uses the
+    // extension costs.
+    int gapExtendCost = -scoreGapExtend(scoringScheme);
+    int gapOpenCost = IsSameType<TGapScheme, LinearGaps>::VALUE ? gapExtendCost : -scoreGapOpen(scoringScheme);
+    if (gapOpenCost <= 0 || gapExtendCost < 0)
+        return false;
+
+    String<int> table;
+    _batchSubstitutionTable(table, TValueH(), TValueV(), scoringScheme);
+    int minScore = 0;
+    int maxScore = 0;
+    for (unsigned i = 0; i < length(table); ++i)
+    {
+        minScore = std::min(minScore, table[i]);
+        maxScore = std::max(maxScore, table[i]);
+    }
+
+    if (_computeStripedLocalAlignment(score, dpContext, traceSegments, scoutState, seqH, seqV, scoringScheme, table,
+                                      minScore, maxScore, gapOpenCost, gapExtendCost, dpProfile,
+                                      StripedLanes_<unsigned char, STRIPED_REGISTER_BITS>()))
+        return true;
+    return _computeStripedLocalAlignment(score, dpContext, traceSegments, scoutState, seqH, seqV, scoringScheme, table,
+                                         minScore, maxScore, gapOpenCost, gapExtendCost, dpProfile,
+                                         StripedLanes_<short, STRIPED_REGISTER_BITS>());
+}
+
+// Unbanded local alignments with the default scout, see IsStripedAlignment_.
+template <typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TSequenceH, typename TSequenceV,
+          typename TScoreValue2, typename TScoreSpec, typename TTraceFlag>
+inline bool
+_computeStripedAlignment(TScoreValue2 & score,
+                         DPContext<TScoreValue, TGapScheme> & dpContext,
+                         TTraceTarget & traceSegments,
+                         DPScoutState_<Default> & scoutState,
+                         TSequenceH const & seqH,
+                         TSequenceV const & seqV,
+                         Score<TScoreValue2, TScoreSpec> const & scoringScheme,
+                         DPBandConfig<BandOff> const & /*band*/,
+                         DPProfile_<LocalAlignment_<>, TGapScheme, TTraceFlag> const & dpProfile)
+{
+    typedef typename IsStripedAlignment_<Score<TScoreValue2, TScoreSpec>, TSequenceH, TSequenceV,
+                                         TGapScheme>::Type TStriped;
+    return _computeStripedAlignment(score, dpContext, traceSegments, scoutState, seqH, seqV, scoringScheme, dpProfile,
+                                    TStriped());
+}
+
+#endif  // #ifdef __SSE4_1__
+
+// All other alignments are computed with the scalar DP.
+template <typename TScoreValue2, typename TScoreValue, typename TGapScheme, typename TTraceTarget, typename TScoutState,
+          typename TSequenceH, typename TSequenceV, typename TScoreScheme, typename TBandSwitch,
+          typename TAlignmentAlgorithm, typename TTraceFlag>
+inline bool
+_computeStripedAlignment(TScoreValue2 & /*score*/,
+                         DPContext<TScoreValue, TGapScheme> & /*dpContext*/,
+                         TTraceTarget & /*traceSegments*/,
+                         TScoutState & /*scoutState*/,
+                         TSequenceH const & /*seqH*/,
+                         TSequenceV const & /*seqV*/,
+                         TScoreScheme const & /*scoreScheme*/,
+                         DPBandConfig<TBandSwitch> const & /*band*/,
+                         DPProfile_<TAlignmentAlgorithm, TGapScheme, TTraceFlag> const & /*dpProfile*/)
+{
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function _setUpAndRunStripedAlignment()
+// ----------------------------------------------------------------------------
+
+// Runs an unbanded local alignment with the striped DP if possible, with the
+// scalar DP otherwise.
+template <typename TTraceSegment, typename TSpec, typename TSequenceH, typename TSequenceV, typename TScoreValue,
+          typename TScoreSpec, typename TFreeEndGaps, typename TTraceConfig, typename TGapModel>
+inline TScoreValue
+_setUpAndRunStripedAlignment(String<TTraceSegment, TSpec> & traceSegments,
+                             DPScoutState_<Default> & dpScoutState,
+                             TSequenceH const & seqH,
+                             TSequenceV const & seqV,
+                             Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                             AlignConfig2<DPLocal, DPBandConfig<BandOff>, TFreeEndGaps, TTraceConfig> const & alignConfig,
+                             TGapModel const & /*gapModel*/)
+{
+    typedef typename SetupAlignmentProfile_<DPLocal, TFreeEndGaps, TGapModel, TTraceConfig>::Type TDPProfile;
+
+    DPContext<TScoreValue, TGapModel> dpContext;
+    TScoreValue score = 0;
+    if (_computeStripedAlignment(score, dpContext, traceSegments, dpScoutState, seqH, seqV, scoringScheme,
+                                 alignConfig._band, TDPProfile()))
+        return score;
+    return _computeAlignment(dpContext, traceSegments, dpScoutState, seqH, seqV, scoringScheme, alignConfig._band,
+                             TDPProfile());
+}
+
+template <typename TTraceSegment, typename TSpec, typename TSequenceH, typename TSequenceV, typename TScoreValue,
+          typename TScoreSpec, typename TFreeEndGaps, typename TTraceConfig>
+inline TScoreValue
+_setUpAndRunStripedAlignment(String<TTraceSegment, TSpec> & traceSegments,
+                             DPScoutState_<Default> & dpScoutState,
+                             TSequenceH const & seqH,
+                             TSequenceV const & seqV,
+                             Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                             AlignConfig2<DPLocal, DPBandConfig<BandOff>, TFreeEndGaps, TTraceConfig> const & alignConfig)
+{
+    if (_usesAffineGaps(scoringScheme, seqH, seqV))
+        return _setUpAndRunStripedAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, alignConfig,
+                                            AffineGaps());
+    else
+        return _setUpAndRunStripedAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, alignConfig,
+                                            LinearGaps());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_DP_STRIPED_IMPL_H_
@@ -0,0 +1,307 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Global alignment interface for batches of sequence pairs.  The scores of
+// the pairs (seqSetH[i], seqSetV[i]) are computed with the inter-sequence
+// vectorized DP in dp_batch_impl.h if available.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_BATCH_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_BATCH_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScore()                     [unbanded, batch of pairs]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn globalAlignmentScore#globalAlignmentScore (batch)
+ * @headerfile <seqan/align.h>
+ * @brief Computes the best global alignment scores of many pairs of sequences.
+ *
+ * @signature TScoreString globalAlignmentScore(seqSetH, seqSetV, scoringScheme, [alignConfig,] [lowerDiag, upperDiag,] [algorithmTag]);
+ *
+ * @param[in] seqSetH       @link StringSet @endlink with the horizontal sequences.
+ * @param[in] seqSetV       @link StringSet @endlink with the vertical sequences, must have the same length as
+ *                          <tt>seqSetH</tt>.
+ * @param[in] scoringScheme The @link Score scoring scheme @endlink to use for all alignments.
+ * @param[in] alignConfig   @link AlignConfig @endlink instance to use for the alignment configuration.
+ * @param[in] lowerDiag     Optional lower diagonal (<tt>int</tt>).
+ * @param[in] upperDiag     Optional upper diagonal (<tt>int</tt>).
+ * @param[in] algorithmTag  Tag to select the alignment algorithm, one of @link
+ *                          AlignmentAlgorithmTags#NeedlemanWunsch @endlink and @link AlignmentAlgorithmTags#Gotoh
+ *                          @endlink.
+ *
+ * @return TScoreString A @link String @endlink of score values, the i-th value is the score of the alignment of
+ *                      <tt>seqSetH[i]</tt> and <tt>seqSetV[i]</tt>.
+ *
+ * When compiled with SSE4.1 (or AVX2) support, the pairs are packed into the lanes of @link SimdVector @endlink
+ * registers and aligned simultaneously.  This requires a @link SimpleScore @endlink or a @link MatrixScore @endlink
+ * with integral score values.  Only simple scores of identical alphabets are computed with vector operations, the
+ * substitution scores of other scoring schemes are looked up lane by lane.  Pairs of similar lengths are grouped into
+ * one batch and 16 bit lanes are used if the scores cannot overflow them, 32 bit lanes otherwise.  All other
+ * configurations fall back to the scalar DP.  Both versions compute identical scores.
+ *
+ * @see globalAlignment
+ */
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & /*alignConfig*/,
+                                         TAlgoTag const & /*algoTag*/)
+{
+    typedef AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> TAlignConfig;
+    typedef typename SubstituteAlignConfig_<TAlignConfig>::Type TFreeEndGaps;
+    typedef AlignConfig2<DPGlobal, DPBandConfig<BandOff>, TFreeEndGaps, TracebackOff> TAlignConfig2;
+    typedef typename SubstituteAlgoTag_<TAlgoTag>::Type TGapModel;
+
+    String<TScoreValue> results;
+    _computeAlignmentBatch(results, seqSetH, seqSetV, scoringScheme, TAlignConfig2(), TGapModel());
+    return results;
+}
+
+// Interface without AlignConfig<>.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         TAlgoTag const & algoTag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, algoTag);
+}
+
+// Interface without algorithm tag.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, NeedlemanWunsch());
+    else
+        return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, Gotoh());
+}
+
+// Interface without AlignConfig<> and algorithm tag.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig);
+}
+
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScore()                       [banded, batch of pairs]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & /*alignConfig*/,
+                                         int lowerDiag,
+                                         int upperDiag,
+                                         TAlgoTag const & /*algoTag*/)
+{
+    typedef AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> TAlignConfig;
+    typedef typename SubstituteAlignConfig_<TAlignConfig>::Type TFreeEndGaps;
+    typedef AlignConfig2<DPGlobal, DPBandConfig<BandOn>, TFreeEndGaps, TracebackOff> TAlignConfig2;
+    typedef typename SubstituteAlgoTag_<TAlgoTag>::Type TGapModel;
+
+    String<TScoreValue> results;
+    _computeAlignmentBatch(results, seqSetH, seqSetV, scoringScheme, TAlignConfig2(lowerDiag, upperDiag),
+                           TGapModel());
+    return results;
+}
+
+// Interface without AlignConfig<>.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         int lowerDiag,
+                                         int upperDiag,
+                                         TAlgoTag const & algoTag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, lowerDiag, upperDiag, algoTag);
+}
+
+// Interface without algorithm tag.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig,
+                                         int lowerDiag,
+                                         int upperDiag)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, lowerDiag, upperDiag,
+                                    NeedlemanWunsch());
+    else
+        return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, lowerDiag, upperDiag, Gotoh());
+}
+
+// Interface without AlignConfig<> and algorithm tag.
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                         StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                         Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                         int lowerDiag,
+                                         int upperDiag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, lowerDiag, upperDiag);
+}
+
+// ----------------------------------------------------------------------------
+// Function globalAlignment()                          [batch of Align objects]
+// ----------------------------------------------------------------------------
+
+// The vectorized batch DP computes scores only, hence each alignment is
+// computed separately with the scalar DP, including its trace.
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec,
+          typename TAlgoTag>
+String<TScoreValue> globalAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                    AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig,
+                                    TAlgoTag const & algoTag)
+{
+    String<TScoreValue> results;
+    resize(results, length(alignSet), Exact());
+    for (unsigned i = 0; i < length(alignSet); ++i)
+        results[i] = globalAlignment(alignSet[i], scoringScheme, alignConfig, algoTag);
+    return results;
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                    AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return globalAlignment(alignSet, scoringScheme, alignConfig, NeedlemanWunsch());
+    else
+        return globalAlignment(alignSet, scoringScheme, alignConfig, Gotoh());
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignment(alignSet, scoringScheme, alignConfig);
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec,
+          bool TOP, bool LEFT, bool RIGHT, bool BOTTOM, typename TACSpec>
+String<TScoreValue> globalAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                    AlignConfig<TOP, LEFT, RIGHT, BOTTOM, TACSpec> const & alignConfig,
+                                    int lowerDiag,
+                                    int upperDiag)
+{
+    String<TScoreValue> results;
+    resize(results, length(alignSet), Exact());
+    for (unsigned i = 0; i < length(alignSet); ++i)
+        results[i] = globalAlignment(alignSet[i], scoringScheme, alignConfig, lowerDiag, upperDiag);
+    return results;
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> globalAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                    int lowerDiag,
+                                    int upperDiag)
+{
+    AlignConfig<> alignConfig;
+    return globalAlignment(alignSet, scoringScheme, alignConfig, lowerDiag, upperDiag);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_GLOBAL_ALIGNMENT_BATCH_H_
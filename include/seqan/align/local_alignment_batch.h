@@ -0,0 +1,194 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Local alignment interface for batches of sequence pairs.  The scores of
+// the pairs (seqSetH[i], seqSetV[i]) are computed with the inter-sequence
+// vectorized DP in dp_batch_impl.h if available.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_BATCH_H_
+#define SEQAN_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_BATCH_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                      [unbanded, batch of pairs]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn localAlignmentScore
+ * @headerfile <seqan/align.h>
+ * @brief Computes the best local alignment score of a pair or of many pairs of sequences.
+ *
+ * @signature TScoreVal    localAlignmentScore(seqH, seqV, scoringScheme, [Striped()]);
+ * @signature TScoreString localAlignmentScore(seqSetH, seqSetV, scoringScheme, [lowerDiag, upperDiag,] [algoTag]);
+ *
+ * @param[in] seqH          The horizontal sequence (e.g. a reference region).
+ * @param[in] seqV          The vertical sequence (e.g. the query).
+ * @param[in] seqSetH       @link StringSet @endlink with the horizontal sequences.
+ * @param[in] seqSetV       @link StringSet @endlink with the vertical sequences, must have the same length as
+ *                          <tt>seqSetH</tt>.
+ * @param[in] scoringScheme The @link Score scoring scheme @endlink to use for all alignments.
+ * @param[in] lowerDiag     Optional lower diagonal (<tt>int</tt>).
+ * @param[in] upperDiag     Optional upper diagonal (<tt>int</tt>).
+ * @param[in] algoTag       Optional tag, one of <tt>LinearGaps</tt> and <tt>AffineGaps</tt>.  Selected by the gap
+ *                          costs of the scoring scheme if omitted.
+ *
+ * @return TScoreVal    The score of the best local alignment of <tt>seqH</tt> and <tt>seqV</tt>.
+ * @return TScoreString A @link String @endlink of score values, the i-th value is the score of the best local
+ *                      alignment of <tt>seqSetH[i]</tt> and <tt>seqSetV[i]</tt>.
+ *
+ * For a single pair, the @link PairwiseLocalAlignmentAlgorithms#Striped @endlink tag selects the striped
+ * intra-sequence vectorization by Farrar when compiled with SSE4.1 or AVX2 support, see @link localAlignment
+ * @endlink.  <tt>seqV</tt> is laid out in a query profile, so it should be the shorter sequence.  The scores are
+ * computed in saturated 8 bit lanes first and recomputed with 16 bit lanes or the scalar DP on overflow.  For
+ * batches, the vectorization follows the rules of @link globalAlignmentScore#globalAlignmentScore (batch) @endlink.
+ *
+ * @see localAlignment
+ */
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TTag>
+String<TScoreValue> localAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                        StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                        TTag const & tag)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    String<TScoreValue> results;
+    _computeAlignmentBatch(results, seqSetH, seqSetV, scoringScheme, TAlignConfig2(), tag);
+    return results;
+}
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                        StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return localAlignmentScore(seqSetH, seqSetV, scoringScheme, LinearGaps());
+    else
+        return localAlignmentScore(seqSetH, seqSetV, scoringScheme, AffineGaps());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                        [banded, batch of pairs]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec,
+          typename TTag>
+String<TScoreValue> localAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                        StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                        int lowerDiag,
+                                        int upperDiag,
+                                        TTag const & tag)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOn>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    String<TScoreValue> results;
+    _computeAlignmentBatch(results, seqSetH, seqSetV, scoringScheme, TAlignConfig2(lowerDiag, upperDiag), tag);
+    return results;
+}
+
+template <typename TSequenceH, typename TSpecH,
+          typename TSequenceV, typename TSpecV,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignmentScore(StringSet<TSequenceH, TSpecH> const & seqSetH,
+                                        StringSet<TSequenceV, TSpecV> const & seqSetV,
+                                        Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                        int lowerDiag,
+                                        int upperDiag)
+{
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        return localAlignmentScore(seqSetH, seqSetV, scoringScheme, lowerDiag, upperDiag, LinearGaps());
+    else
+        return localAlignmentScore(seqSetH, seqSetV, scoringScheme, lowerDiag, upperDiag, AffineGaps());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignment()                           [batch of Align objects]
+// ----------------------------------------------------------------------------
+
+// The traces are computed pair by pair with the scalar DP.
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                   Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    String<TScoreValue> results;
+    resize(results, length(alignSet), Exact());
+    for (unsigned i = 0; i < length(alignSet); ++i)
+        results[i] = localAlignment(alignSet[i], scoringScheme);
+    return results;
+}
+
+template <typename TSequence, typename TAlignSpec, typename TSpec,
+          typename TScoreValue, typename TScoreSpec>
+String<TScoreValue> localAlignment(String<Align<TSequence, TAlignSpec>, TSpec> & alignSet,
+                                   Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                   int lowerDiag,
+                                   int upperDiag)
+{
+    String<TScoreValue> results;
+    resize(results, length(alignSet), Exact());
+    for (unsigned i = 0; i < length(alignSet); ++i)
+        results[i] = localAlignment(alignSet[i], scoringScheme, lowerDiag, upperDiag);
+    return results;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_BATCH_H_
@@ -66,6 +66,8 @@ namespace seqan {
  *
  * @signature TScoreVal localAlignment(align,          scoringScheme, [lowerDiag, upperDiag]);
  * @signature TScoreVal localAlignment(gapsH, gapsV,   scoringScheme, [lowerDiag, upperDiag]);
+ * @signature TScoreVal localAlignment(align,          scoringScheme, Striped());
+ * @signature TScoreVal localAlignment(gapsH, gapsV,   scoringScheme, Striped());
  * @signature TScoreVal localAlignment(fragmentString, scoringScheme, [lowerDiag, upperDiag]);
  *
  * @param[in,out] gapsH Horizontal gapped sequence in alignment matrix. Types: @link Gaps @endlink
@@ -90,6 +92,12 @@ namespace seqan {
  * The Waterman-Eggert algorithm (local alignment with declumping) is available through the @link
  * LocalAlignmentEnumerator @endlink class.
  *
+ * With the @link PairwiseLocalAlignmentAlgorithms#Striped @endlink tag, the striped vectorized DP by Farrar is used
+ * when compiled with SSE4.1 or AVX2 support and the scoring scheme is @link SimpleScore @endlink or a @link
+ * MatrixScore @endlink with integral scores.  It determines the end and a begin bound of the best alignment, only this
+ * part of the DP matrix is computed with traceback.  The result is the same as without vectorization, otherwise the
+ * scalar DP is used.
+ *
  * When using @link Gaps @endlink and @link Align @endlink objects, only parts (i.e. one infix) of each sequence will be
  * aligned.  This will be presented to the user by setting the clipping begin and end position of the gaps (the rows in
  * the case of @link Align @endlink objects).  When using @link Fragment @endlink strings, these parts of the sequences
@@ -191,6 +199,27 @@ TScoreValue localAlignment(Align<TSequence, TAlignSpec> & align,
          return localAlignment(align, scoringScheme, LinearGaps());
  }
 
+template <typename TSequence, typename TAlignSpec, typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignment(Align<TSequence, TAlignSpec> & align,
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                           Striped const & /*tag*/)
+{
+    SEQAN_ASSERT_EQ(length(rows(align)), 2u);
+    typedef Align<TSequence, TAlignSpec> TAlign;
+    typedef typename Size<TAlign>::Type TSize;
+    typedef typename Position<TAlign>::Type TPosition;
+    typedef TraceSegment_<TPosition, TSize> TTraceSegment;
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<> > TAlignConfig2;
+
+    String<TTraceSegment> trace;
+    DPScoutState_<Default> dpScoutState;
+    TScoreValue res = _setUpAndRunStripedAlignment(trace, dpScoutState, source(row(align, 0)), source(row(align, 1)),
+                                                   scoringScheme, TAlignConfig2());
+
+    _adaptTraceSegmentsTo(row(align, 0), row(align, 1), trace);
+    return res;
+}
+
 // ----------------------------------------------------------------------------
 // Function localAlignment()                                   [unbanded, Gaps]
 // ----------------------------------------------------------------------------
@@ -228,6 +257,26 @@ TScoreValue localAlignment(Gaps<TSequenceH, TGapsSpecH> & gapsH,
          return localAlignment(gapsH, gapsV, scoringScheme, LinearGaps());
 }
 
+template <typename TSequenceH, typename TGapsSpecH, typename TSequenceV, typename TGapsSpecV, typename TScoreValue,
+          typename TScoreSpec>
+TScoreValue localAlignment(Gaps<TSequenceH, TGapsSpecH> & gapsH,
+                           Gaps<TSequenceV, TGapsSpecV> & gapsV,
+                           Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                           Striped const & /*tag*/)
+{
+    typedef typename Size<TSequenceH>::Type TSize;
+    typedef typename Position<TSequenceH>::Type TPosition;
+    typedef TraceSegment_<TPosition, TSize> TTraceSegment;
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<> > TAlignConfig2;
+
+    String<TTraceSegment> trace;
+    DPScoutState_<Default> dpScoutState;
+    TScoreValue res = _setUpAndRunStripedAlignment(trace, dpScoutState, source(gapsH), source(gapsV), scoringScheme,
+                                                   TAlignConfig2());
+    _adaptTraceSegmentsTo(gapsH, gapsV, trace);
+    return res;
+}
+
 // ----------------------------------------------------------------------------
 // Function localAlignment()                     [unbanded, Graph<Alignment<>>]
 // ----------------------------------------------------------------------------
@@ -312,6 +361,41 @@ TScoreValue localAlignment(String<Fragment<TSize, TFragmentSpec>, TStringSpec> &
         return localAlignment(fragmentString, strings, scoringScheme, LinearGaps());
 }
 
+// ----------------------------------------------------------------------------
+// Function localAlignmentScore()                          [unbanded, sequences]
+// ----------------------------------------------------------------------------
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    if (empty(seqH) || empty(seqV))
+        return 0;
+
+    DPScoutState_<Default> dpScoutState;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    return _setUpAndRunAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, TAlignConfig2());
+}
+
+template <typename TSequenceH, typename TSequenceV, typename TScoreValue, typename TScoreSpec>
+TScoreValue localAlignmentScore(TSequenceH const & seqH,
+                                TSequenceV const & seqV,
+                                Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                                Striped const & /*tag*/)
+{
+    typedef AlignConfig2<DPLocal, DPBandConfig<BandOff>, FreeEndGaps_<>, TracebackOff> TAlignConfig2;
+
+    if (empty(seqH) || empty(seqV))
+        return 0;
+
+    DPScoutState_<Default> dpScoutState;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;  // Dummy segments.
+    return _setUpAndRunStripedAlignment(traceSegments, dpScoutState, seqH, seqV, scoringScheme, TAlignConfig2());
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_INCLUDE_SEQAN_ALIGN_LOCAL_ALIGNMENT_UNBANDED_H_
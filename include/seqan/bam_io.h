@@ -48,6 +48,7 @@
 #include <seqan/stream.h>
 #include <seqan/align.h>
 #include <seqan/misc/name_store_cache.h>
+#include <seqan/seq_io/genomic_region.h>
 
 // ===========================================================================
 // Data Structures & Conversion.
@@ -91,6 +92,8 @@
 // BAM indices are only available when ZLIB is available.
 #if SEQAN_HAS_ZLIB
 #include <seqan/bam_io/bam_index_bai.h>
+#include <seqan/bam_io/bam_index_csi.h>
+#include <seqan/bam_io/bam_process_regions.h>
 #endif  // #if SEQAN_HAS_ZLIB
 
 #endif  // INCLUDE_SEQAN_BAM_IO_H_
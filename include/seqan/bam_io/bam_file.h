@@ -233,6 +233,62 @@ readRecord(BamAlignmentRecord & record,
         readRecord(record, context, iter, static_cast<typename TagSelector<TTagList>::Base const &>(format));
 }
 
+// support for dynamically chosen file formats
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_registerContigNames(Pair<__int32> & /* contigIds */,
+                     BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+                     TBuffer const & /* rawRecord */,
+                     TagSelector<> const & /* format */)
+{
+    SEQAN_FAIL("BamFileIn: File format not specified.");
+}
+
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer, typename TTagList>
+inline void
+_registerContigNames(Pair<__int32> & contigIds,
+                     BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+                     TBuffer const & rawRecord,
+                     TagSelector<TTagList> const & format)
+{
+    typedef typename TTagList::Type TFormat;
+
+    if (isEqual(format, TFormat()))
+        _registerContigNames(contigIds, context, rawRecord, TFormat());
+    else
+        _registerContigNames(contigIds, context, rawRecord, static_cast<typename TagSelector<TTagList>::Base const &>(format));
+}
+
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_decodeBamRecord(BamAlignmentRecord & /* record */,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+                 CharString & /* scratch */,
+                 TBuffer & /* rawRecord */,
+                 Pair<__int32> const & /* contigIds */,
+                 TagSelector<> const & /* format */)
+{
+    SEQAN_FAIL("BamFileIn: File format not specified.");
+}
+
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer, typename TTagList>
+inline void
+_decodeBamRecord(BamAlignmentRecord & record,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+                 CharString & scratch,
+                 TBuffer & rawRecord,
+                 Pair<__int32> const & contigIds,
+                 TagSelector<TTagList> const & format)
+{
+    typedef typename TTagList::Type TFormat;
+
+    if (isEqual(format, TFormat()))
+        _decodeBamRecord(record, context, scratch, rawRecord, contigIds, TFormat());
+    else
+        _decodeBamRecord(record, context, scratch, rawRecord, contigIds,
+                         static_cast<typename TagSelector<TTagList>::Base const &>(format));
+}
+
 // convient BamFile variant
 template <typename TSpec>
 inline void
@@ -247,22 +303,43 @@ inline SEQAN_FUNC_ENABLE_IF(And<IsSameType<typename Value<TRecords>::Type, BamAl
 readRecords(TRecords & records, FormattedFile<Bam, Input, TSpec> & file, TSize maxRecords)
 {
     String<CharString> & buffers = context(file).buffers;
+    String<Pair<__int32> > & contigIds = context(file).bufferContigIds;
     if ((TSize)length(buffers) < maxRecords)
     {
         resize(buffers, maxRecords, Exact());
+        resize(contigIds, maxRecords, Exact());
         resize(records, maxRecords, Exact());
     }
 
+    // Read raw records sequentially and translate their contig names in file order.
     TSize numRecords = 0;
     for (; numRecords < maxRecords && !atEnd(file.iter); ++numRecords)
+    {
         _readBamRecord(buffers[numRecords], file.iter, file.format);
+        _registerContigNames(contigIds[numRecords], context(file), buffers[numRecords], file.format);
+    }
 
-//    SEQAN_OMP_PRAGMA(parallel for)
-    for (int i = 0; i < (int)numRecords; ++i)
+    // Decode them in parallel, each thread with its own scratch buffer.  The name store is not accessed here.
+    // Exceptions must not leave the parallel region, we rethrow the one of the first broken record.
+    ParallelError_ parallelError((int)numRecords);
+    SEQAN_OMP_PRAGMA(parallel)
     {
-        CharIterator bufIter = begin(buffers[i]);
-        readRecord(records[i], context(file), bufIter, file.format);
+        CharString scratch;
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 64))
+        for (int i = 0; i < (int)numRecords; ++i)
+        {
+            SEQAN_TRY
+            {
+                _decodeBamRecord(records[i], context(file), scratch, buffers[i], contigIds[i], file.format);
+            }
+            SEQAN_CATCH(...)
+            {
+                SEQAN_OMP_PRAGMA(critical (readRecordsError))
+                _storeCurrentException(parallelError, i);
+            }
+        }
     }
+    _rethrowException(parallelError);
     return numRecords;
 }
 
@@ -163,7 +163,8 @@ public:
  * @brief Seek in BamFileIn using an index.
  *
  * You provide a region <tt>[pos, posEnd)</tt> on the reference <tt>refID</tt> that you want to jump to and the function
- * jumps to the first alignment in this region, if any.
+ * jumps to the first alignment overlapping this region, if any.  This may be an alignment that begins left of
+ * <tt>pos</tt>, alignments following it do not necessarily overlap the region.
  *
  * @signature bool jumpToRegion(bamFileIn, hasAlignments, refID, pos, posEnd, index);
  *
@@ -179,7 +180,8 @@ public:
  *
  * @section Remarks
  *
- * This function fails if <tt>refID</tt>/<tt>pos</tt> are invalid.
+ * This function fails if <tt>refID</tt> is invalid.  A negative <tt>pos</tt> is treated as 0 and an empty region,
+ * i.e. <tt>posEnd &lt;= pos</tt>, like the single position <tt>pos</tt>.
  */
 
 static inline void
@@ -197,6 +199,43 @@ _baiReg2bins(String<__uint16> & list, __uint32 beg, __uint32 end)
     for (k = 4681 + (beg>>14); k <= 4681 + (end>>14); ++k) appendValue(list, k);
 }
 
+// Seek to the first alignment overlapping [pos, posEnd) on refId, scanning from offset.  No alignment overlapping
+// the region may come before offset.
+
+template <typename TSpec>
+inline bool
+_bamScanToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
+                 bool & hasAlignments,
+                 __int32 refId,
+                 __int32 pos,
+                 __int32 posEnd,
+                 __uint64 offset)
+{
+    if (!setPosition(bamFile, offset))
+        return false;  // Error while seeking.
+
+    BamAlignmentRecord record;
+    while (!atEnd(bamFile))
+    {
+        __uint64 recordOffset = position(bamFile);
+        readRecord(record, bamFile);
+
+        if (record.rID != refId || record.beginPos >= posEnd)
+            break;  // Cannot find overlapping alignments any more.
+
+        __int32 recordEnd = record.beginPos + std::max(getAlignmentLengthInRef(record), (unsigned)1);
+        if (recordEnd > pos)
+        {
+            // Found the first overlapping alignment, jump back to it.
+            hasAlignments = true;
+            return setPosition(bamFile, recordOffset);
+        }
+    }
+
+    // Finding no overlapping alignment is not an error, hasAlignments is false.
+    return true;
+}
+
 template <typename TSpec>
 inline bool
 jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
@@ -206,6 +245,11 @@ jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
              __int32 posEnd,
              BamIndex<Bai> const & index)
 {
+    typedef BamIndex<Bai>::TBinIndex_ TBinIndex;
+    typedef BamIndex<Bai>::TLinearIndex_ TLinearIndex;
+    typedef Iterator<String<__uint16>, Standard>::Type TCandidateIter;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
     if (!isEqual(format(bamFile), Bam()))
         return false;
 
@@ -215,108 +259,53 @@ jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
     if (static_cast<unsigned>(refId) >= length(index._binIndices))
         return false;  // Cannot seek to invalid reference.
 
+    // Clamp a negative pos and look up an empty region like the single position pos.
+    pos = std::max(pos, (__int32)0);
+    posEnd = std::max(posEnd, pos + 1);
+
     // ------------------------------------------------------------------------
     // Compute offset in BGZF file.
     // ------------------------------------------------------------------------
-    __uint64 offset = MaxValue<__uint64>::VALUE;
+
+    // Alignments overlapping pos cannot begin before the offset of its 16kb window in the linear index.  No
+    // alignment overlaps the windows behind the linear index.
+    TLinearIndex const & linearIndex = index._linearIndices[refId];
+    unsigned windowIdx = pos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+    __uint64 minOffset = 0;
+    if (windowIdx < length(linearIndex))
+        minOffset = linearIndex[windowIdx];
+    else if (!empty(linearIndex))
+        minOffset = back(linearIndex);
 
     // Retrieve the candidate bin identifiers for [pos, posEnd).
     String<__uint16> candidateBins;
     _baiReg2bins(candidateBins, pos, posEnd);
 
-    // Retrieve the smallest required offset from the linear index.
-    unsigned windowIdx = pos >> 14;  // Linear index consists of 16kb windows.
-    __uint64 linearMinOffset = 0;
-    if (windowIdx >= length(index._linearIndices[refId]))
-    {
-        // TODO(holtgrew): Can we simply always take case 1?
-
-        // This is the case were we want to jump in a non-existing window.
-        //
-        // If there are no linear indices for this reference then we use the linear min offset of the next
-        // reference that has an linear index.
-        if (empty(index._linearIndices[refId]))
-        {
-            for (unsigned i = refId; i < length(index._linearIndices); ++i)
-            {
-                if (!empty(index._linearIndices[i]))
-                {
-                    linearMinOffset = front(index._linearIndices[i]);
-                    if (linearMinOffset != 0u)
-                        break;
-                    for (unsigned j = 1; j < length(index._linearIndices[i]); ++j)
-                    {
-                        if (index._linearIndices[i][j] > linearMinOffset)
-                        {
-                            linearMinOffset = index._linearIndices[i][j];
-                            break;
-                        }
-                    }
-                    if (linearMinOffset != 0u)
-                        break;
-                }
-            }
-        }
-        else
-        {
-            linearMinOffset = back(index._linearIndices[refId]);
-        }
-    }
-    else
-    {
-        linearMinOffset = index._linearIndices[refId][windowIdx];
-    }
-
-    // Combine candidate bins and smallest required offset from linear index into candidate offset.
-    typedef std::set<__uint64> TOffsetCandidates;
-    TOffsetCandidates offsetCandidates;
-    typedef typename Iterator<String<__uint16>, Rooted>::Type TCandidateIter;
-    for (TCandidateIter it = begin(candidateBins, Rooted()); !atEnd(it); goNext(it))
+    // The first overlapping alignment is in one of the chunks of the candidate bins that end behind minOffset.
+    // Starting at the rightmost chunk that begins left of pos would miss alignments of other bins that begin
+    // before this chunk and overlap pos.
+    TBinIndex const & binIndex = index._binIndices[refId];
+    __uint64 offset = MaxValue<__uint64>::VALUE;
+    for (TCandidateIter it = begin(candidateBins, Standard()); it != end(candidateBins, Standard()); ++it)
     {
-        typedef typename std::map<__uint32, BaiBamIndexBinData_>::const_iterator TMapIter;
-        TMapIter mIt = index._binIndices[refId].find(*it);
-        if (mIt == index._binIndices[refId].end())
+        TBinIndex::const_iterator mIt = binIndex.find(*it);
+        if (mIt == binIndex.end())
             continue;  // Candidate is not in index!
 
-        typedef typename Iterator<String<Pair<__uint64, __uint64> > const, Rooted>::Type TBegEndIter;
-        for (TBegEndIter it2 = begin(mIt->second.chunkBegEnds, Rooted()); !atEnd(it2); goNext(it2))
-            if (it2->i2 >= linearMinOffset)
-                offsetCandidates.insert(it2->i1);
+        for (TChunkIter itC = begin(mIt->second.chunkBegEnds, Standard());
+             itC != end(mIt->second.chunkBegEnds, Standard()); ++itC)
+            if (itC->i2 > minOffset)
+                offset = std::min(offset, std::max(itC->i1, minOffset));
     }
 
-    // Search through candidate offsets, find rightmost possible.
-    //
-    // Note that it is not necessarily the first.
-    //
-    // TODO(holtgrew): Can this be optimized similar to how bamtools does it?
-    typedef typename TOffsetCandidates::const_iterator TOffsetCandidateIter;
-    BamAlignmentRecord record;
-    for (TOffsetCandidateIter candIt = offsetCandidates.begin(); candIt != offsetCandidates.end(); ++candIt)
-    {
-        setPosition(bamFile, *candIt);
-
-        readRecord(record, bamFile);
-
-        // std::cerr << "record.beginPos == " << record.beginPos << "\n";
-        // __int32 endPos = record.beginPos + getAlignmentLengthInRef(record);
-        if (record.rID != refId)
-            continue;  // Wrong contig.
-        if (!hasAlignments || record.beginPos <= pos)
-        {
-            // Found a valid alignment.
-            hasAlignments = true;
-            offset = *candIt;
-        }
-
-        if (record.beginPos >= posEnd)
-            break;  // Cannot find overlapping any more.
-    }
+    if (offset == MaxValue<__uint64>::VALUE)
+        return true;  // No candidate chunk.
 
-    if (offset != MaxValue<__uint64>::VALUE)
-        setPosition(bamFile, offset);
+    // ------------------------------------------------------------------------
+    // Scan to the first overlapping alignment.
+    // ------------------------------------------------------------------------
 
-    // Finding no overlapping alignment is not an error, hasAlignments is false.
-    return true;
+    return _bamScanToRegion(bamFile, hasAlignments, refId, pos, posEnd, offset);
 }
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,666 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// The CSI index (coordinate-sorted index) generalizes the BAI binning scheme
+// to a configurable minimal bin size (min shift) and number of levels
+// (depth).  The linear index of BAI is replaced by the smallest offset of
+// each bin (loffset).  See the CSIv1 specification of htslib, the binning
+// functions follow its MIT-licensed implementation.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_BAM_IO_BAM_INDEX_CSI_H_
+#define INCLUDE_SEQAN_BAM_IO_BAM_INDEX_CSI_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag Csi
+// ----------------------------------------------------------------------------
+
+struct Csi_;
+typedef Tag<Csi_> Csi;
+
+// ----------------------------------------------------------------------------
+// Helper Class CsiBamIndexBinData_
+// ----------------------------------------------------------------------------
+
+// Store the information of a bin.
+
+struct CsiBamIndexBinData_
+{
+    // Smallest virtual offset of the alignments overlapping the first window of the bin.
+    __uint64 loffset;
+    String<Pair<__uint64, __uint64> > chunkBegEnds;
+
+    CsiBamIndexBinData_() : loffset(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Spec CSI BamIndex
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class CsiBamIndex
+ * @headerfile <seqan/bam_io.h>
+ * @extends BamIndex
+ * @brief Access to CSI indices (htslib-style), for references longer than 512 Mbp.
+ *
+ * @signature template <>
+ *            class BamIndex<Csi>;
+ *
+ * The smallest bin spans <tt>2^minShift</tt> bases, each of the <tt>depth</tt> levels above has bins that are 8 times
+ * larger.  BAI corresponds to minShift 14 and depth 5 which limits references to <tt>2^29</tt> bases.  Smaller
+ * values of minShift give finer bins and hence more precise seeks at the cost of a larger index.
+ */
+
+/*!
+ * @fn CsiBamIndex::BamIndex
+ * @brief Constructor.
+ *
+ * @signature BamIndex::BamIndex([minShift[, depth]]);
+ *
+ * @param[in] minShift The bit width of the smallest bin (<tt>unsigned</tt>, default 14).
+ * @param[in] depth    The number of levels below the root bin (<tt>unsigned</tt>).  The default 0 chooses the
+ *                     smallest depth that covers the longest reference when building the index.
+ */
+
+template <>
+class BamIndex<Csi>
+{
+public:
+    typedef std::map<__uint32, CsiBamIndexBinData_> TBinIndex_;
+
+    __uint64 _unalignedCount;
+
+    __int32 _minShift;
+    __int32 _depth;
+
+    String<TBinIndex_> _binIndices;
+
+    BamIndex(unsigned minShift = 14, unsigned depth = 0) :
+        _unalignedCount(maxValue<__uint64>()), _minShift(minShift), _depth(depth)
+    {}
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _csiBinFirst()
+// ----------------------------------------------------------------------------
+
+// The id of the first bin on the given level, the root is on level 0.
+
+inline __uint32
+_csiBinFirst(__int32 level)
+{
+    return ((1u << (3 * level)) - 1) / 7;
+}
+
+// ----------------------------------------------------------------------------
+// Function _csiBinLimit()
+// ----------------------------------------------------------------------------
+
+// The number of regular bins, bin ids from here on are pseudo-bins with meta data.
+
+inline __uint32
+_csiBinLimit(__int32 depth)
+{
+    return _csiBinFirst(depth + 1);
+}
+
+// ----------------------------------------------------------------------------
+// Function _csiReg2Bin()
+// ----------------------------------------------------------------------------
+
+// Smallest bin that completely contains [beg, end).
+
+inline __uint32
+_csiReg2Bin(__uint64 beg, __uint64 end, __int32 minShift, __int32 depth)
+{
+    __int32 shift = minShift;
+    --end;
+    for (__int32 level = depth; level > 0; --level, shift += 3)
+        if (beg >> shift == end >> shift)
+            return _csiBinFirst(level) + (beg >> shift);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _csiReg2Bins()
+// ----------------------------------------------------------------------------
+
+// All bins that may contain alignments overlapping [beg, end).
+
+inline void
+_csiReg2Bins(String<__uint32> & list, __uint64 beg, __uint64 end, __int32 minShift, __int32 depth)
+{
+    if (beg >= end)
+        return;
+    --end;
+    __int32 shift = minShift + 3 * depth;
+    for (__int32 level = 0; level <= depth; ++level, shift -= 3)
+    {
+        __uint32 first = _csiBinFirst(level);
+        for (__uint64 k = first + (beg >> shift); k <= first + (end >> shift); ++k)
+            appendValue(list, k);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _csiMinOffset()
+// ----------------------------------------------------------------------------
+
+// Smallest offset at which alignments overlapping pos can begin.  This is the loffset of the smallest existing bin
+// that contains pos.
+
+inline __uint64
+_csiMinOffset(BamIndex<Csi>::TBinIndex_ const & binIndex, __uint64 pos, __int32 minShift, __int32 depth)
+{
+    __uint32 bin = _csiBinFirst(depth) + (pos >> minShift);
+    while (true)
+    {
+        BamIndex<Csi>::TBinIndex_::const_iterator it = binIndex.find(bin);
+        if (it != binIndex.end())
+            return it->second.loffset;
+        if (bin == 0)
+            return 0;
+        bin = (bin - 1) >> 3;  // Go to the parent bin.
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function jumpToRegion()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline bool
+jumpToRegion(FormattedFile<Bam, Input, TSpec> & bamFile,
+             bool & hasAlignments,
+             __int32 refId,
+             __int32 pos,
+             __int32 posEnd,
+             BamIndex<Csi> const & index)
+{
+    typedef BamIndex<Csi>::TBinIndex_ TBinIndex;
+    typedef Iterator<String<__uint32>, Standard>::Type TCandidateIter;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
+    if (!isEqual(format(bamFile), Bam()))
+        return false;
+
+    hasAlignments = false;
+    if (refId < 0)
+        return false;  // Cannot seek to invalid reference.
+    if (static_cast<unsigned>(refId) >= length(index._binIndices))
+        return false;  // Cannot seek to invalid reference.
+
+    // Clamp a negative pos and look up an empty region like the single position pos.
+    pos = std::max(pos, (__int32)0);
+    posEnd = std::max(posEnd, pos + 1);
+
+    // ------------------------------------------------------------------------
+    // Compute offset in BGZF file.
+    // ------------------------------------------------------------------------
+
+    TBinIndex const & binIndex = index._binIndices[refId];
+    __uint64 minOffset = _csiMinOffset(binIndex, pos, index._minShift, index._depth);
+
+    // Retrieve the candidate bin identifiers for [pos, posEnd).
+    String<__uint32> candidateBins;
+    _csiReg2Bins(candidateBins, pos, posEnd, index._minShift, index._depth);
+
+    // The first overlapping alignment is in one of the chunks of the candidate bins that end behind minOffset.
+    __uint64 offset = MaxValue<__uint64>::VALUE;
+    for (TCandidateIter it = begin(candidateBins, Standard()); it != end(candidateBins, Standard()); ++it)
+    {
+        TBinIndex::const_iterator mIt = binIndex.find(*it);
+        if (mIt == binIndex.end())
+            continue;  // Candidate is not in index!
+
+        for (TChunkIter itC = begin(mIt->second.chunkBegEnds, Standard());
+             itC != end(mIt->second.chunkBegEnds, Standard()); ++itC)
+            if (itC->i2 > minOffset)
+                offset = std::min(offset, std::max(itC->i1, minOffset));
+    }
+
+    if (offset == MaxValue<__uint64>::VALUE)
+        return true;  // No candidate chunk.
+
+    // ------------------------------------------------------------------------
+    // Scan to the first overlapping alignment.
+    // ------------------------------------------------------------------------
+
+    return _bamScanToRegion(bamFile, hasAlignments, refId, pos, posEnd, offset);
+}
+
+// ----------------------------------------------------------------------------
+// Function jumpToOrphans()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+bool jumpToOrphans(FormattedFile<Bam, Input, TSpec> & bamFile,
+                   bool & hasAlignments,
+                   BamIndex<Csi> const & index)
+{
+    typedef BamIndex<Csi>::TBinIndex_ TBinIndex;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
+    if (!isEqual(format(bamFile), Bam()))
+        return false;
+
+    hasAlignments = false;
+
+    // The orphans follow the last chunk of all references.
+    __uint64 aliOffset = MaxValue<__uint64>::VALUE;
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+        for (TBinIndex::const_iterator it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
+            for (TChunkIter itC = begin(it->second.chunkBegEnds, Standard());
+                 itC != end(it->second.chunkBegEnds, Standard()); ++itC)
+                if (aliOffset == MaxValue<__uint64>::VALUE || itC->i2 > aliOffset)
+                    aliOffset = itC->i2;
+    if (aliOffset == MaxValue<__uint64>::VALUE)
+        return false;  // No offset found.
+
+    // Get index of the first orphan alignment by seeking from the end of the last chunk.
+    BamAlignmentRecord record;
+    __uint64 offset = MaxValue<__uint64>::VALUE;
+    __uint64 result = 0;
+    if (!setPosition(bamFile, aliOffset))
+        return false;  // Error while seeking.
+    while (!atEnd(bamFile))
+    {
+        result = position(bamFile);
+        readRecord(record, bamFile);
+        if (record.rID == -1)
+        {
+            // Found alignment.
+            hasAlignments = true;
+            offset = result;
+            break;
+        }
+    }
+
+    // Jump back to the first alignment.
+    if (offset != MaxValue<__uint64>::VALUE)
+    {
+        if (!setPosition(bamFile, offset))
+            return false;  // Error while seeking.
+    }
+
+    // Finding no orphan alignment is not an error, hasAlignments is false then.
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function getUnalignedCount()
+// ----------------------------------------------------------------------------
+
+inline __uint64
+getUnalignedCount(BamIndex<Csi> const & index)
+{
+    return index._unalignedCount;
+}
+
+// ----------------------------------------------------------------------------
+// Function open()
+// ----------------------------------------------------------------------------
+
+inline bool
+open(BamIndex<Csi> & index, char const * filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::in);
+    if (!file.good())
+        return false;  // Could not open file.
+
+    // CSI files are BGZF-compressed, the compression is detected from the stream.
+    VirtualStream<char, Input> fin;
+    if (!open(fin, file))
+        return false;
+
+    // Read magic number.
+    CharString buffer;
+    resize(buffer, 4);
+    fin.read(&buffer[0], 4);
+    if (!fin.good())
+        return false;
+    if (buffer != "CSI\1")
+        return false;  // Magic number is wrong.
+
+    __int32 lAux = 0;
+    fin.read(reinterpret_cast<char *>(&index._minShift), 4);
+    fin.read(reinterpret_cast<char *>(&index._depth), 4);
+    fin.read(reinterpret_cast<char *>(&lAux), 4);
+    if (!fin.good() || lAux < 0)
+        return false;
+    fin.ignore(lAux);  // The auxiliary data is only used by tabix.
+
+    __int32 nRef = 0;
+    fin.read(reinterpret_cast<char *>(&nRef), 4);
+    if (!fin.good())
+        return false;
+
+    clear(index._binIndices);
+    resize(index._binIndices, nRef);
+
+    __uint32 binLimit = _csiBinLimit(index._depth);
+    for (int i = 0; i < nRef; ++i)  // For each reference.
+    {
+        __int32 nBin = 0;
+        fin.read(reinterpret_cast<char *>(&nBin), 4);
+        if (!fin.good())
+            return false;
+        CsiBamIndexBinData_ data;
+        for (int j = 0; j < nBin; ++j)  // For each bin.
+        {
+            clear(data.chunkBegEnds);
+
+            __uint32 bin = 0;
+            __int32 nChunk = 0;
+            fin.read(reinterpret_cast<char *>(&bin), 4);
+            fin.read(reinterpret_cast<char *>(&data.loffset), 8);
+            fin.read(reinterpret_cast<char *>(&nChunk), 4);
+            if (!fin.good())
+                return false;
+            reserve(data.chunkBegEnds, nChunk);
+            for (int k = 0; k < nChunk; ++k)  // For each chunk;
+            {
+                __uint64 chunkBeg = 0;
+                __uint64 chunkEnd = 0;
+                fin.read(reinterpret_cast<char *>(&chunkBeg), 8);
+                fin.read(reinterpret_cast<char *>(&chunkEnd), 8);
+                if (!fin.good())
+                    return false;
+                appendValue(data.chunkBegEnds, Pair<__uint64>(chunkBeg, chunkEnd));
+            }
+
+            // Skip the pseudo-bin with statistics, its chunks are no offsets.
+            if (bin < binLimit)
+                index._binIndices[i][bin] = data;
+        }
+    }
+
+    // Read (optional) number of alignments without coordinate.
+    __uint64 nNoCoord = 0;
+    fin.read(reinterpret_cast<char *>(&nNoCoord), 8);
+    if (!fin.good())
+        nNoCoord = 0;
+    index._unalignedCount = nNoCoord;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function save()
+// ----------------------------------------------------------------------------
+
+inline bool
+save(BamIndex<Csi> const & index, char const * filename)
+{
+    typedef BamIndex<Csi>::TBinIndex_ TBinIndex;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::out);
+    if (!file.good())
+        return false;  // Could not open file.
+
+    VirtualStream<char, Output> out;
+    if (!open(out, file, BgzfFile()))
+        return false;
+
+    // Write header, BAM indices have no auxiliary data.
+    out.write("CSI\1", 4);
+    __int32 lAux = 0;
+    __int32 nRef = length(index._binIndices);
+    out.write(reinterpret_cast<char const *>(&index._minShift), 4);
+    out.write(reinterpret_cast<char const *>(&index._depth), 4);
+    out.write(reinterpret_cast<char const *>(&lAux), 4);
+    out.write(reinterpret_cast<char const *>(&nRef), 4);
+
+    for (__int32 i = 0; i < nRef; ++i)
+    {
+        TBinIndex const & binIndex = index._binIndices[i];
+        __int32 nBin = binIndex.size();
+        out.write(reinterpret_cast<char const *>(&nBin), 4);
+        for (TBinIndex::const_iterator itB = binIndex.begin(); itB != binIndex.end(); ++itB)
+        {
+            out.write(reinterpret_cast<char const *>(&itB->first), 4);
+            out.write(reinterpret_cast<char const *>(&itB->second.loffset), 8);
+            __int32 nChunk = length(itB->second.chunkBegEnds);
+            out.write(reinterpret_cast<char const *>(&nChunk), 4);
+            for (TChunkIter itC = begin(itB->second.chunkBegEnds, Standard());
+                 itC != end(itB->second.chunkBegEnds, Standard()); ++itC)
+            {
+                out.write(reinterpret_cast<char const *>(&itC->i1), 8);
+                out.write(reinterpret_cast<char const *>(&itC->i2), 8);
+            }
+        }
+    }
+
+    // Write the number of unaligned reads if set.
+    if (index._unalignedCount != maxValue<__uint64>())
+        out.write(reinterpret_cast<char const *>(&index._unalignedCount), 8);
+
+    bool success = out.good();
+    close(out);
+    return success && file.good();  // false on error, true on success.
+}
+
+// ----------------------------------------------------------------------------
+// Function _csiFinishReference()
+// ----------------------------------------------------------------------------
+
+// Set the loffset of each bin of a reference to the linear index entry of the first window of the bin.  Windows
+// without alignments get the offset of the previous window.
+
+inline void
+_csiFinishReference(BamIndex<Csi>::TBinIndex_ & binIndex, String<__uint64> & linearIndex, BamIndex<Csi> const & index)
+{
+    typedef Iterator<String<__uint64>, Standard>::Type TLinearIndexIter;
+
+    if (empty(linearIndex))
+        return;
+
+    TLinearIndexIter it = begin(linearIndex, Standard());
+    TLinearIndexIter itEnd = end(linearIndex, Standard());
+    __uint64 offset = MaxValue<__uint64>::VALUE;
+    for (TLinearIndexIter itFirst = it; itFirst != itEnd && offset == MaxValue<__uint64>::VALUE; ++itFirst)
+        offset = *itFirst;
+    for (; it != itEnd; ++it)
+    {
+        if (*it == MaxValue<__uint64>::VALUE)
+            *it = offset;
+        else
+            offset = *it;
+    }
+
+    for (BamIndex<Csi>::TBinIndex_::iterator itB = binIndex.begin(); itB != binIndex.end(); ++itB)
+    {
+        __int32 level = 0;
+        while (itB->first >= _csiBinFirst(level + 1))
+            ++level;
+        __uint64 window = (__uint64)(itB->first - _csiBinFirst(level)) << (3 * (index._depth - level));
+        itB->second.loffset = (window < length(linearIndex)) ? linearIndex[window] : back(linearIndex);
+    }
+
+    clear(linearIndex);
+}
+
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#buildIndex
+ * @brief Build a CSI index for a coordinate-sorted BAM file and write it to <tt>filename + ".csi"</tt>.
+ *
+ * @signature bool buildIndex(csiIndex, filename);
+ *
+ * @param[in,out] csiIndex The @link CsiBamIndex @endlink to build, its minShift and depth are used.
+ * @param[in]     filename Path to the BAM file to index. Types: char const *
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file cannot be read, is not sorted by coordinate or
+ *              has a reference longer than the bins of the chosen depth can cover.
+ *
+ * The index is built in a single pass over the BAM file.
+ */
+
+inline bool
+buildIndex(BamIndex<Csi> & index, char const * filename)
+{
+    typedef BamIndex<Csi>::TBinIndex_ TBinIndex;
+
+    clear(index._binIndices);
+    index._unalignedCount = 0;
+
+    // Open BAM file for reading.
+    BamFileIn bamFile;
+    if (!open(bamFile, filename))
+        return false;  // Could not open BAM file.
+    if (!isEqual(format(bamFile), Bam()))
+        return false;  // Only BAM files have virtual offsets.
+
+    // Read BAM header.
+    BamHeader header;
+    readHeader(header, bamFile);
+
+    __uint32 numRefSeqs = length(contigNames(context(bamFile)));
+    resize(index._binIndices, numRefSeqs);
+
+    // Choose the smallest depth that covers the longest reference.
+    __uint64 maxLength = 0;
+    for (unsigned i = 0; i < length(contigLengths(context(bamFile))); ++i)
+        maxLength = std::max(maxLength, (__uint64)contigLengths(context(bamFile))[i]);
+    if (index._depth <= 0)
+        for (index._depth = 1; (__uint64)1 << (index._minShift + 3 * index._depth) < maxLength; ++index._depth) {}
+    __uint64 maxPos = (__uint64)1 << (index._minShift + 3 * index._depth);
+    if (maxLength > maxPos)
+        return false;  // References are too long for the chosen depth.
+
+    // Scan over BAM file and create index.
+    BamAlignmentRecord record;
+    String<__uint64> linearIndex;
+    __int32 prevRefId = BamAlignmentRecord::INVALID_REFID;
+    __int32 prevPos = 0;
+    __uint32 currBin = MaxValue<__uint32>::VALUE;
+    __uint64 chunkBeg = 0;
+    __uint64 prevOffset = position(bamFile);
+
+    while (!atEnd(bamFile))
+    {
+        __uint64 offset = prevOffset;
+        readRecord(record, bamFile);
+        prevOffset = position(bamFile);
+
+        // The reference changed, close the last chunk and compute the loffsets of the previous reference.
+        if (record.rID != prevRefId)
+        {
+            if (prevRefId != BamAlignmentRecord::INVALID_REFID)
+            {
+                if (record.rID >= 0 && record.rID < prevRefId)
+                    return false;  // File is not sorted by reference.
+
+                TBinIndex & binIndex = index._binIndices[prevRefId];
+                appendValue(binIndex[currBin].chunkBegEnds, Pair<__uint64>(chunkBeg, offset));
+                _csiFinishReference(binIndex, linearIndex, index);
+            }
+            else if (index._unalignedCount > 0)
+            {
+                return false;  // Aligned records after unaligned ones.
+            }
+
+            prevRefId = record.rID;
+            prevPos = 0;
+            currBin = MaxValue<__uint32>::VALUE;
+        }
+
+        // Unaligned reads without coordinate are at the end of the file.
+        if (record.rID < 0)
+        {
+            ++index._unalignedCount;
+            continue;
+        }
+        if (static_cast<unsigned>(record.rID) >= numRefSeqs)
+            return false;  // Invalid reference.
+
+        // Check ordering.
+        if (record.beginPos < prevPos)
+            return false;
+        prevPos = record.beginPos;
+
+        __uint64 beginPos = record.beginPos;
+        __uint64 endPos = beginPos + std::max(getAlignmentLengthInRef(record), (unsigned)1);
+        if (endPos > maxPos)
+            return false;  // Alignment lies behind the last bin.
+
+        // Update the linear index of the smallest bins.
+        __uint64 windowBeg = beginPos >> index._minShift;
+        __uint64 windowEnd = (endPos - 1) >> index._minShift;
+        if (length(linearIndex) <= windowEnd)
+            resize(linearIndex, windowEnd + 1, MaxValue<__uint64>::VALUE);
+        for (__uint64 w = windowBeg; w <= windowEnd; ++w)
+            if (linearIndex[w] == MaxValue<__uint64>::VALUE)
+                linearIndex[w] = offset;
+
+        // Extend the current chunk or start a new one if the bin changes.
+        __uint32 bin = _csiReg2Bin(beginPos, endPos, index._minShift, index._depth);
+        if (bin != currBin)
+        {
+            if (currBin != MaxValue<__uint32>::VALUE)
+                appendValue(index._binIndices[record.rID][currBin].chunkBegEnds, Pair<__uint64>(chunkBeg, offset));
+            currBin = bin;
+            chunkBeg = offset;
+        }
+    }
+
+    // Close the last reference.
+    if (prevRefId != BamAlignmentRecord::INVALID_REFID)
+    {
+        TBinIndex & binIndex = index._binIndices[prevRefId];
+        appendValue(binIndex[currBin].chunkBegEnds, Pair<__uint64>(chunkBeg, prevOffset));
+        _csiFinishReference(binIndex, linearIndex, index);
+    }
+
+    // Write out index.
+    CharString csiFilename(filename);
+    append(csiFilename, ".csi");
+    return save(index, toCString(csiFilename));
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_BAM_IO_BAM_INDEX_CSI_H_
@@ -107,6 +107,7 @@ typedef Tag<LengthStoreMember_> LengthStoreMember;
  *
  * @tparam TNameStore      The type used to represent the names.
  * @tparam TNameStoreCache The type used to cache the names. Defaults to @link NameStoreCache @endlink &lt;TNameStore&gtl;.
+ *                         Use @link OpenAddressingNameStoreCache @endlink for references with many contigs.
  *
  * BamIOContext objects store the names of (and provide a cache for) reference contig names.
  *
@@ -169,6 +170,7 @@ public:
     TLengthStoreMember      _contigLengths;
     CharString              buffer;
     String<CharString>      buffers;
+    String<Pair<__int32> >  bufferContigIds;
     String<unsigned>        translateFile2GlobalRefId;
 
     BamIOContext() :
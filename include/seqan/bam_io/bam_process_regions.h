@@ -0,0 +1,226 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Region-parallel processing of indexed BAM files.  Each thread owns a
+// BamFileIn on the same file and seeks to the regions it processes.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_BAM_IO_BAM_PROCESS_REGIONS_H_
+#define INCLUDE_SEQAN_BAM_IO_BAM_PROCESS_REGIONS_H_
+
+namespace seqan {
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function partitionContigs()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIOContext#partitionContigs
+ * @headerfile <seqan/bam_io.h>
+ * @brief Partition all contigs into consecutive windows.
+ *
+ * @signature void partitionContigs(regions, context, windowSize);
+ *
+ * @param[out] regions    A @link String @endlink of @link GenomicRegion @endlink objects, the windows in genome order.
+ * @param[in]  context    The @link BamIOContext @endlink with the contig names and lengths, e.g. of a
+ *                        @link BamFileIn @endlink after reading the header.
+ * @param[in]  windowSize The length of the windows, the last window of a contig may be shorter.
+ *
+ * Contigs of length 0 are skipped.
+ */
+
+template <typename TRegions, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+partitionContigs(TRegions & regions,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> const & context,
+                 __int32 windowSize)
+{
+    typedef typename Value<TRegions>::Type TRegion;
+
+    SEQAN_ASSERT_GT(windowSize, 0);
+
+    clear(regions);
+    TRegion region;
+    for (unsigned rID = 0; rID < length(contigLengths(context)); ++rID)
+    {
+        __int32 contigLength = contigLengths(context)[rID];
+        region.rID = rID;
+        region.seqName = (rID < length(contigNames(context))) ? contigNames(context)[rID] : CharString();
+        for (__int32 pos = 0; pos < contigLength; pos += windowSize)
+        {
+            region.beginPos = pos;
+            region.endPos = (contigLength - pos > windowSize) ? pos + windowSize : contigLength;
+            appendValue(regions, region);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _readRegion()
+// ----------------------------------------------------------------------------
+
+// Read all alignments overlapping region into records.
+template <typename TRecords, typename TSpec, typename TIndexSpec>
+inline void
+_readRegion(TRecords & records,
+            BamAlignmentRecord & record,
+            FormattedFile<Bam, Input, TSpec> & bamFile,
+            GenomicRegion const & region,
+            BamIndex<TIndexSpec> const & index)
+{
+    clear(records);
+
+    __int32 rID = region.rID;
+    if (rID < 0 && !getIdByName(rID, contigNamesCache(context(bamFile)), region.seqName))
+        return;  // Unknown contig.
+
+    __int32 beginPos = std::max(region.beginPos, (__int32)0);
+    __int32 endPos = (region.endPos < 0) ? MaxValue<__int32>::VALUE : region.endPos;
+    if (beginPos >= endPos)
+        return;
+
+    // A failed jump, e.g. to a reference the index does not cover or a failed seek, must not look like an empty region.
+    bool hasAlignments = false;
+    if (!jumpToRegion(bamFile, hasAlignments, rID, beginPos, endPos, index))
+        SEQAN_THROW(IOError("Could not jump to region in BAM file."));
+    if (!hasAlignments)
+        return;
+
+    while (!atEnd(bamFile))
+    {
+        readRecord(record, bamFile);
+        if (record.rID != rID || record.beginPos >= endPos)
+            break;  // Cannot find overlapping alignments any more.
+
+        __int32 recordEnd = record.beginPos + std::max(getAlignmentLengthInRef(record), (unsigned)1);
+        if (recordEnd > beginPos)
+            appendValue(records, record);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function processRegions()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#processRegions
+ * @headerfile <seqan/bam_io.h>
+ * @brief Process the alignments of many regions of an indexed BAM file in parallel.
+ *
+ * @signature void processRegions(results, fileName, regions, index, functor);
+ *
+ * @param[out] results  A @link String @endlink with one result per region, in the order of <tt>regions</tt>.
+ *                      The results are default-constructed before they are passed to the functor.
+ * @param[in]  fileName The path of the BAM file, <tt>char const *</tt>.
+ * @param[in]  regions  A @link String @endlink of @link GenomicRegion @endlink objects, e.g. created with
+ *                      @link BamIOContext#partitionContigs @endlink.  Regions are identified by their
+ *                      <tt>rID</tt> or, if it is <tt>-1</tt>, by their <tt>seqName</tt>.  Regions with a
+ *                      <tt>seqName</tt> that is not in the header of the file are passed to the functor without
+ *                      records, like empty regions.
+ * @param[in]  index    The @link BamIndex @endlink of the file, a <tt>BamIndex&lt;Bai&gt;</tt> or
+ *                      <tt>BamIndex&lt;Csi&gt;</tt>.
+ * @param[in]  functor  Called as <tt>functor(result, region, records)</tt> for each region, where <tt>records</tt> is
+ *                      a @link String @endlink of all @link BamAlignmentRecord @endlink objects overlapping the region
+ *                      in file order.
+ *
+ * The regions are distributed dynamically over the OpenMP threads.  Each thread opens its own
+ * @link BamFileIn @endlink on <tt>fileName</tt> and works on its own copy of <tt>functor</tt>, which can hold
+ * per-thread scratch buffers.  Alignments overlapping several regions are passed to each of them, those with
+ * <tt>record.beginPos &gt;= region.beginPos</tt> are passed to only one of consecutive, disjoint regions.
+ *
+ * An exception thrown while opening the file, reading, or by the functor is rethrown after all threads have
+ * finished, the one of the first region if there are several.  An @link IOError @endlink is thrown for regions
+ * whose <tt>rID</tt> is not covered by <tt>index</tt> and if seeking in the file fails.
+ */
+
+template <typename TResults, typename TRegions, typename TIndexSpec, typename TFunctor>
+inline void
+processRegions(TResults & results,
+               char const * fileName,
+               TRegions const & regions,
+               BamIndex<TIndexSpec> const & index,
+               TFunctor const & functor)
+{
+    clear(results);
+    resize(results, length(regions));
+
+    // Exceptions must not leave the parallel region, we rethrow the one of the first failed region.
+    ParallelError_ parallelError((int)length(regions));
+    SEQAN_OMP_PRAGMA(parallel)
+    {
+        BamFileIn bamFile;
+        BamHeader header;
+        BamAlignmentRecord record;
+        String<BamAlignmentRecord> records;
+        TFunctor threadFunctor(functor);
+        bool isOpen = false;
+
+        SEQAN_TRY
+        {
+            if (!open(bamFile, fileName))
+                SEQAN_THROW(FileOpenError(fileName));
+            readHeader(header, bamFile);
+            isOpen = true;
+        }
+        SEQAN_CATCH(...)
+        {
+            SEQAN_OMP_PRAGMA(critical (processRegionsError))
+            _storeCurrentException(parallelError, -1);
+        }
+
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 1))
+        for (int i = 0; i < (int)length(regions); ++i)
+        {
+            if (!isOpen)
+                continue;
+
+            SEQAN_TRY
+            {
+                _readRegion(records, record, bamFile, regions[i], index);
+                threadFunctor(results[i], regions[i], static_cast<String<BamAlignmentRecord> const &>(records));
+            }
+            SEQAN_CATCH(...)
+            {
+                SEQAN_OMP_PRAGMA(critical (processRegionsError))
+                _storeCurrentException(parallelError, i);
+            }
+        }
+    }
+    _rethrowException(parallelError);
+}
+
+}  // namespace seqan
+
+#endif  // INCLUDE_SEQAN_BAM_IO_BAM_PROCESS_REGIONS_H_
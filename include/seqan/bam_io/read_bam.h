@@ -188,22 +188,19 @@ _readBamRecord(TBuffer & rawRecord, TForwardIter & iter, Bam)
     write(rawRecord, iter, (size_t)recordLen);
 }
 
-template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+// Decode a raw record (without the leading block size) that starts at it and is remainingBytes long.
+// The context is only read, so records can be decoded concurrently.
+template <typename TCharIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
 inline void
-readRecord(BamAlignmentRecord & record,
-           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
-           TForwardIter & iter,
-           Bam const & /* tag */)
+_parseBamRecord(BamAlignmentRecord & record,
+                BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> const & context,
+                TCharIter it,
+                __int32 remainingBytes)
 {
-    typedef typename Iterator<CharString, Standard>::Type                             TCharIter;
     typedef typename Iterator<String<CigarElement<> >, Standard>::Type SEQAN_RESTRICT TCigarIter;
     typedef typename Iterator<IupacString, Standard>::Type SEQAN_RESTRICT             TSeqIter;
     typedef typename Iterator<CharString, Standard>::Type SEQAN_RESTRICT              TQualIter;
 
-    // Read size and data of the remaining block in one chunk (fastest).
-    __int32 remainingBytes = _readBamRecordWithoutSize(context.buffer, iter);
-    TCharIter it = begin(context.buffer, Standard());
-
     // BamAlignmentRecordCore.
     arrayCopyForward(it, it + sizeof(BamAlignmentRecordCore), reinterpret_cast<char*>(&record));
     it += sizeof(BamAlignmentRecordCore);
@@ -273,6 +270,54 @@ readRecord(BamAlignmentRecord & record,
     arrayCopyForward(it, it + remainingBytes, begin(record.tags, Standard()));
 }
 
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(BamAlignmentRecord & record,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Bam const & /* tag */)
+{
+    // Read size and data of the remaining block in one chunk (fastest).
+    __int32 remainingBytes = _readBamRecordWithoutSize(context.buffer, iter);
+    _parseBamRecord(record, context, begin(context.buffer, Standard()), remainingBytes);
+}
+
+// ----------------------------------------------------------------------------
+// Function _decodeBamRecord()                               BamAlignmentRecord
+// ----------------------------------------------------------------------------
+
+// Decode a raw record read by _readBamRecord() in-place, i.e. without touching context.buffer.
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_decodeBamRecord(BamAlignmentRecord & record,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+                 CharString & /* scratch */,
+                 TBuffer & rawRecord,
+                 Pair<__int32> const & /* contigIds */,
+                 Bam const & /* tag */)
+{
+    typedef typename Iterator<TBuffer, Standard>::Type TCharIter;
+
+    TCharIter it = begin(rawRecord, Standard());
+    __int32 remainingBytes = 0;
+    readRawPod(remainingBytes, it);
+    SEQAN_ASSERT_EQ(length(rawRecord), sizeof(__int32) + remainingBytes);
+    _parseBamRecord(record, context, it, remainingBytes);
+}
+
+// ----------------------------------------------------------------------------
+// Function _registerContigNames()
+// ----------------------------------------------------------------------------
+
+// BAM records refer to contigs by their ids only, nothing to do.
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_registerContigNames(Pair<__int32> & /* contigIds */,
+                     BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+                     TBuffer const & /* rawRecord */,
+                     Bam const & /* tag */)
+{}
+
 }  // namespace seqan
 
 #endif  // #ifndef INCLUDE_SEQAN_BAM_IO_READ_BAM_H_
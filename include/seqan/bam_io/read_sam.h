@@ -250,12 +250,42 @@ _readBamRecord(TBuffer & rawRecord, TForwardIter & iter, Sam)
 // Function readRecord()                                     BamAlignmentRecord
 // ----------------------------------------------------------------------------
 
-template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+// Translates the RNAME (column 2) and RNEXT (column 6) of a record into contig ids.  Unknown names are appended to
+// the name store, hence this must not be used concurrently.
+template <typename TContext>
+struct SamContigNameToId_
+{
+    TContext & context;
+
+    SamContigNameToId_(TContext & context) : context(context)
+    {}
+
+    inline __int32 operator()(CharString const & name, unsigned /* col */) const
+    {
+        return nameToId(contigNamesCache(context), name);
+    }
+};
+
+// Returns the contig ids resolved by _registerContigNames() without any name store lookup.
+struct SamRegisteredContigIds_
+{
+    Pair<__int32> const & ids;
+
+    SamRegisteredContigIds_(Pair<__int32> const & ids) : ids(ids)
+    {}
+
+    inline __int32 operator()(CharString const & /* name */, unsigned col) const
+    {
+        return (col == 2) ? ids.i1 : ids.i2;
+    }
+};
+
+template <typename TForwardIter, typename TContigNameToId>
 inline void
-readRecord(BamAlignmentRecord & record,
-           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
-           TForwardIter & iter,
-           Sam const & /*tag*/)
+_readSamRecord(BamAlignmentRecord & record,
+               CharString & buffer,
+               TForwardIter & iter,
+               TContigNameToId const & contigNameToId)
 {
     // fail, if we read "@" (did you miss to call readRecord(header, bamFile) first?)
     if (nextIs(iter, SamHeader()))
@@ -264,7 +294,6 @@ readRecord(BamAlignmentRecord & record,
     OrFunctor<IsTab, AssertFunctor<NotFunctor<IsNewline>, ParseError, Sam> > nextEntry;
 
     clear(record);
-    CharString &buffer = context.buffer;
 
     // QNAME
     readUntil(record.qName, iter, nextEntry);
@@ -283,7 +312,7 @@ readRecord(BamAlignmentRecord & record,
     if (buffer == "*")
         record.rID = BamAlignmentRecord::INVALID_REFID;
     else
-        record.rID = nameToId(contigNamesCache(context), buffer);
+        record.rID = contigNameToId(buffer, 2);
     skipOne(iter, IsTab());
 
     // POS
@@ -333,7 +362,7 @@ readRecord(BamAlignmentRecord & record,
     else if (buffer == "=")
         record.rNextId = record.rID;
     else
-        record.rNextId = nameToId(contigNamesCache(context), buffer);
+        record.rNextId = contigNameToId(buffer, 6);
     skipOne(iter, IsTab());
 
     // PNEXT
@@ -394,6 +423,73 @@ readRecord(BamAlignmentRecord & record,
     appendTagsSamToBam(record.tags, buffer);
 }
 
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(BamAlignmentRecord & record,
+           BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Sam const & /*tag*/)
+{
+    typedef BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> TContext;
+    _readSamRecord(record, context.buffer, iter, SamContigNameToId_<TContext>(context));
+}
+
+// ----------------------------------------------------------------------------
+// Function _decodeBamRecord()                               BamAlignmentRecord
+// ----------------------------------------------------------------------------
+
+// Decode a raw record read by _readBamRecord() using scratch instead of context.buffer.  The contig ids were resolved
+// by _registerContigNames() before, so the name store is not accessed and records can be decoded concurrently.
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_decodeBamRecord(BamAlignmentRecord & record,
+                 BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & /* context */,
+                 CharString & scratch,
+                 TBuffer & rawRecord,
+                 Pair<__int32> const & contigIds,
+                 Sam const & /* tag */)
+{
+    typename Iterator<TBuffer, Rooted>::Type iter = begin(rawRecord, Rooted());
+    _readSamRecord(record, scratch, iter, SamRegisteredContigIds_(contigIds));
+}
+
+// ----------------------------------------------------------------------------
+// Function _registerContigNames()
+// ----------------------------------------------------------------------------
+
+// Translate the RNAME and RNEXT names of a raw record into contig ids and append unknown names to the name store.
+// Calling this for all records in file order before decoding them concurrently yields the same contig ids as reading
+// them one by one.
+template <typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TBuffer>
+inline void
+_registerContigNames(Pair<__int32> & contigIds,
+                     BamIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+                     TBuffer const & rawRecord,
+                     Sam const & /* tag */)
+{
+    typedef typename Iterator<TBuffer const, Standard>::Type TIter;
+
+    TIter it = begin(rawRecord, Standard());
+    TIter itEnd = end(rawRecord, Standard());
+
+    // The ids of "*" and "=" are set by _readSamRecord() itself.
+    contigIds.i1 = contigIds.i2 = BamAlignmentRecord::INVALID_REFID;
+
+    // RNAME and RNEXT are the 3rd and 7th column.
+    for (unsigned col = 0; it != itEnd && col < 7; ++col)
+    {
+        TIter colEnd = std::find(it, itEnd, '\t');
+        if (col == 2 || col == 6)
+        {
+            assign(context.buffer, infix(rawRecord, it - begin(rawRecord, Standard()),
+                                         colEnd - begin(rawRecord, Standard())));
+            if (context.buffer != "*" && !(col == 6 && context.buffer == "="))
+                ((col == 2) ? contigIds.i1 : contigIds.i2) = nameToId(contigNamesCache(context), context.buffer);
+        }
+        it = (colEnd == itEnd) ? itEnd : colEnd + 1;
+    }
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef INCLUDE_SEQAN_BAM_IO_READ_SAM_H_
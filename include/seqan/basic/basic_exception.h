@@ -266,6 +266,37 @@ typedef std::runtime_error      RuntimeError;
 
 //typedef std::logic_error        LogicError;
 
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class ParallelError_
+// ----------------------------------------------------------------------------
+// Keeps the exception of the first failing item of a parallel loop.  Exceptions must not leave an OpenMP parallel
+// region, so they are stored by _storeCurrentException() and rethrown by _rethrowException() after the region.
+// Without the C++11 exception_ptr only the message survives and is rethrown as a RuntimeError.
+
+struct ParallelError_
+{
+    int pos;
+#ifdef SEQAN_CXX11_STL
+    std::exception_ptr error;
+#else
+    bool failed;
+    std::string message;
+#endif
+
+    explicit ParallelError_(int pos) :
+#ifdef SEQAN_CXX11_STL
+        pos(pos)
+#else
+        pos(pos),
+        failed(false)
+#endif
+    {}
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -346,6 +377,53 @@ struct AssertFunctor
 // Functions
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Function _storeCurrentException()
+// ----------------------------------------------------------------------------
+// Call from a catch block, inside a critical section.  Keeps the exception if pos precedes the one stored so far.
+
+inline void
+_storeCurrentException(ParallelError_ & parallelError, int pos)
+{
+    if (pos >= parallelError.pos)
+        return;
+
+    parallelError.pos = pos;
+#ifdef SEQAN_CXX11_STL
+    parallelError.error = std::current_exception();
+#else
+    parallelError.failed = true;
+    SEQAN_TRY
+    {
+        SEQAN_RETHROW;
+    }
+    SEQAN_CATCH(Exception & e)
+    {
+        parallelError.message = e.what();
+    }
+    SEQAN_CATCH(...)
+    {
+        parallelError.message = "Exception of unknown type.";
+    }
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _rethrowException()
+// ----------------------------------------------------------------------------
+
+inline void
+_rethrowException(ParallelError_ const & parallelError)
+{
+#ifdef SEQAN_CXX11_STL
+    if (parallelError.error)
+        std::rethrow_exception(parallelError.error);
+#else
+    if (parallelError.failed)
+        SEQAN_THROW(RuntimeError(parallelError.message));
+#endif
+}
+
 // ----------------------------------------------------------------------------
 // Function globalExceptionHandler()
 // ----------------------------------------------------------------------------
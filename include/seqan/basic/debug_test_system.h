@@ -68,6 +68,10 @@
 #include <signal.h>
 #endif  // #ifdef PLATFORM_WINDOWS
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif  // #if defined(_OPENMP)
+
 // ============================================================================
 // Classes
 // ============================================================================
@@ -1717,6 +1721,30 @@ inline void fail()
 
 #endif  // #if SEQAN_ENABLE_TESTING
 
+// Sets the number of OpenMP threads and restores the previous number on
+// destruction, so that a test does not change the threads of later tests.
+struct ScopedNumThreads
+{
+    int oldNumThreads;
+
+    explicit ScopedNumThreads(int numThreads) : oldNumThreads(1)
+    {
+#if defined(_OPENMP)
+        oldNumThreads = omp_get_max_threads();
+        omp_set_num_threads(numThreads);
+#else
+        (void)numThreads;
+#endif  // #if defined(_OPENMP)
+    }
+
+    ~ScopedNumThreads()
+    {
+#if defined(_OPENMP)
+        omp_set_num_threads(oldNumThreads);
+#endif  // #if defined(_OPENMP)
+    }
+};
+
 }  // namespace ClassTest
 
 /*!
@@ -372,6 +372,15 @@ typedef Tag<LevenshteinDistance_>   EditDistance;
 struct Blat_;
 typedef Tag<Blat_> Blat;
 
+// ----------------------------------------------------------------------------
+// Tag OpenAddressing
+// ----------------------------------------------------------------------------
+
+// Selects hashing with open addressing, used by the q-gram index and the NameStoreCache.
+
+struct OpenAddressing_;
+typedef Tag<OpenAddressing_> OpenAddressing;
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
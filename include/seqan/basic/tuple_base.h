@@ -157,8 +157,9 @@ struct Tuple<TValue, SIZE, Pack>
         return i[k];
     }
 
+    // Returns a copy, a const reference would be bound to a temporary as the members are not aligned.
     template <typename TPos>
-    inline typename StoredTupleValue_<TValue>::Type const &
+    inline typename StoredTupleValue_<TValue>::Type
     operator[](TPos k) const
     {
         SEQAN_ASSERT_GEQ(static_cast<__int64>(k), 0);
@@ -47,6 +47,7 @@
 #include <seqan/graph_algorithms.h>
 #include <seqan/map.h>
 #include <seqan/parallel.h>
+#include <seqan/basic/basic_simd_vector.h>  // SimdVector<> for the batch verification.
 
 // ===========================================================================
 // Base headers.
@@ -92,6 +93,7 @@
 
 #include <seqan/find/find_score.h>
 #include <seqan/find/find_myers_ukkonen.h>
+#include <seqan/find/find_myers_batch.h>
 #include <seqan/find/find_abndm.h>
 #include <seqan/find/find_pex.h>
 
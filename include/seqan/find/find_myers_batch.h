@@ -0,0 +1,313 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Inter-candidate vectorized Myers bit-vector verification.  Each lane of a
+// SimdVector holds the bit-vectors of one needle/text pair; all lanes are
+// advanced by one text character per step.  The recursion is the one of
+// _findMyersSmallPatterns() in find_myers_ukkonen.h, hence the lanes yield
+// the same hits as a MyersUkkonen pattern.
+//
+// Needles longer than a lane and builds without SSE4.1 use the scalar
+// MyersUkkonen pattern.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_FIND_FIND_MYERS_BATCH_H_
+#define SEQAN_INCLUDE_SEQAN_FIND_FIND_MYERS_BATCH_H_
+
+namespace seqan {
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _findMyersBatchScalar()
+// ----------------------------------------------------------------------------
+
+// Verifies a single pair with the MyersUkkonen pattern and keeps the first
+// hit of maximal score.
+template <typename TEndPosition, typename TScore, typename TText, typename TNeedle>
+inline void
+_findMyersBatchScalar(TEndPosition & endPos,
+                      TScore & score,
+                      TText const & text,
+                      TNeedle const & needle,
+                      int minScore)
+{
+    endPos = 0;
+    score = minScore - 1;
+    if (empty(needle))
+        return;
+
+    Finder<TText const> finder(text);
+    Pattern<TNeedle, MyersUkkonen> pattern(needle);
+    while (find(finder, pattern, minScore))
+        if (getScore(pattern) > score)
+        {
+            score = getScore(pattern);
+            endPos = endPosition(finder);
+        }
+}
+
+#ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function _findMyersBatchSimd()
+// ----------------------------------------------------------------------------
+
+// Verifies up to LENGTH<TWordVector> pairs, the needles must not be longer
+// than a lane.  Lanes are masked out after the end of their text.
+template <typename TWordVector, typename TErrorVector,
+          typename TEndPositions, typename TScores, typename TTexts, typename TNeedles, typename TIds>
+inline void
+_findMyersBatchSimd(TEndPositions & endPositions,
+                    TScores & scores,
+                    TTexts const & texts,
+                    TNeedles const & needles,
+                    TIds const & ids,
+                    int minScore)
+{
+    typedef typename Value<TWordVector>::Type                       TWord;
+    typedef typename Value<TErrorVector>::Type                      TErrors;
+    typedef typename Value<TNeedles const>::Type                    TNeedle;
+    typedef typename Value<TNeedle>::Type                           TAlphabet;
+    typedef typename Value<TTexts const>::Type                      TText;
+    typedef typename Iterator<TText const, Standard>::Type          TTextIterator;
+    typedef typename Size<TText>::Type                              TSize;
+
+    enum { LANES = LENGTH<TWordVector>::VALUE, SIGMA = ValueSize<TAlphabet>::VALUE };
+
+    TWord bitMasks[LANES * SIGMA];
+    TTextIterator textIt[LANES];
+    TSize textLength[LANES];
+    TSize maxTextLength = 0;
+
+    TWordVector lastBit, VP, VN, X, D0, HN, HP;
+    TErrorVector errors, bestErrors, bestEnd, lengths;
+    clear(X);
+    clear(lastBit);
+    clear(errors);
+    clear(lengths);
+    clear(bestEnd);
+    fill(VP, ~(TWord)0);
+    clear(VN);
+    fill(bestErrors, (TErrors)(1 - minScore));
+
+    // encoding the letters as bit-vectors
+    for (unsigned l = 0; l < LANES * SIGMA; ++l)
+        bitMasks[l] = 0;
+    for (unsigned l = 0; l < LANES; ++l)
+    {
+        textLength[l] = 0;
+        if (l >= length(ids))
+            continue;
+
+        TNeedle const & needle = needles[ids[l]];
+        TText const & text = texts[ids[l]];
+        for (unsigned j = 0; j < length(needle); ++j)
+            bitMasks[l * SIGMA + ordValue(getValue(needle, j))] |= (TWord)1 << j;
+
+        assignValue(lastBit, l, (TWord)1 << (length(needle) - 1));
+        assignValue(errors, l, (TErrors)length(needle));
+        assignValue(lengths, l, (TErrors)length(text));
+        textIt[l] = begin(text, Standard());
+        textLength[l] = length(text);
+        maxTextLength = std::max(maxTextLength, textLength[l]);
+    }
+
+    for (TSize pos = 0; pos < maxTextLength; ++pos)
+    {
+        for (unsigned l = 0; l < LANES; ++l)
+            assignValue(X, l, (pos < textLength[l])? bitMasks[l * SIGMA + ordValue((TAlphabet) textIt[l][pos])]: 0);
+        X |= VN;
+
+        D0 = ((VP + (X & VP)) ^ VP) | X;
+        HN = VP & D0;
+        HP = VN | ~(VP | D0);
+        X = HP << 1;
+        VN = X & D0;
+        VP = (HN << 1) | ~(X | D0);
+
+        // comparisons yield -1 in the lanes where they hold
+        errors -= SEQAN_VECTOR_CAST_(TErrorVector, (HP & lastBit) != 0);
+        errors += SEQAN_VECTOR_CAST_(TErrorVector, (HN & lastBit) != 0);
+
+        // keep the first position of the minimal number of errors
+        TErrorVector improved = SEQAN_VECTOR_CAST_(TErrorVector, errors < bestErrors) &
+                                SEQAN_VECTOR_CAST_(TErrorVector, (TErrors)pos < lengths);
+        bestErrors = (errors & improved) | (bestErrors & ~improved);
+        bestEnd = (((TErrors)(pos + 1)) & improved) | (bestEnd & ~improved);
+    }
+
+    for (unsigned l = 0; l < length(ids); ++l)
+    {
+        if ((int)bestErrors[l] <= -minScore)
+        {
+            endPositions[ids[l]] = bestEnd[l];
+            scores[ids[l]] = -(int)bestErrors[l];
+        }
+        else
+        {
+            endPositions[ids[l]] = 0;
+            scores[ids[l]] = minScore - 1;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _findMyersBatchSimdRun()
+// ----------------------------------------------------------------------------
+
+// Splits the ids into groups of LENGTH<TWordVector> and verifies them.
+template <typename TWordVector, typename TErrorVector,
+          typename TEndPositions, typename TScores, typename TTexts, typename TNeedles, typename TIds,
+          typename TParallelTag>
+inline void
+_findMyersBatchSimdRun(TEndPositions & endPositions,
+                       TScores & scores,
+                       TTexts const & texts,
+                       TNeedles const & needles,
+                       TIds const & ids,
+                       int minScore,
+                       Tag<TParallelTag>)
+{
+    typedef typename Infix<TIds const>::Type    TIdsInfix;
+
+    unsigned const LANES = LENGTH<TWordVector>::VALUE;
+    int batchCount = (length(ids) + LANES - 1) / LANES;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) if (IsSameType<Tag<TParallelTag>, Parallel>::VALUE))
+    for (int batch = 0; batch < batchCount; ++batch)
+    {
+        TIdsInfix batchIds = infix(ids, batch * LANES, std::min((unsigned)length(ids), (batch + 1) * LANES));
+        _findMyersBatchSimd<TWordVector, TErrorVector>(endPositions, scores, texts, needles, batchIds, minScore);
+    }
+}
+
+#endif  // #ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function findMyersBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn findMyersBatch
+ * @headerfile <seqan/find.h>
+ * @brief Verifies many needle/text pairs with Myers' bit-vector algorithm.
+ *
+ * @signature void findMyersBatch(endPositions, scores, texts, needles, minScore[, parallelTag]);
+ *
+ * @param[out] endPositions A @link String @endlink of end positions, resized to the number of pairs.  The end
+ *                          position of a pair is 0 if the needle does not occur with at least <tt>minScore</tt>.
+ * @param[out] scores       A @link String @endlink of <tt>int</tt> scores, resized to the number of pairs.  Pairs
+ *                          without a hit get <tt>minScore - 1</tt>.
+ * @param[in]  texts        A @link StringSet @endlink of texts, e.g. the candidate windows of a read mapper.
+ * @param[in]  needles      A @link StringSet @endlink of needles, one for each text.
+ * @param[in]  minScore     The minimal score (negative edit distance) of a hit.
+ * @param[in]  parallelTag  Tag to enable/disable multi-threading, one of @link ParallelismTags#Serial @endlink and
+ *                          @link ParallelismTags#Parallel @endlink.  Default: Serial.
+ *
+ * For each pair <tt>i</tt> the needle is searched approximately in the text as by a @link MyersPattern @endlink with
+ * @link ApproximateFinderSearchTypeTags#FindInfix @endlink.  Among the hits found by iterating @link Finder#find
+ * @endlink the first one of maximal score is returned.
+ *
+ * If SSE4.1 is enabled, pairs are verified in the lanes of a SIMD vector: needles of up to 32
+ * characters in 32 bit lanes, needles of up to 64 characters in 64 bit lanes.  This yields 4 or 2 lanes with SSE and
+ * 8 or 4 lanes with AVX2.  Longer needles are verified with the scalar pattern.
+ */
+
+template <typename TEndPositions, typename TScores, typename TTexts, typename TNeedles, typename TParallelTag>
+inline void
+findMyersBatch(TEndPositions & endPositions,
+               TScores & scores,
+               TTexts const & texts,
+               TNeedles const & needles,
+               int minScore,
+               Tag<TParallelTag> parallelTag)
+{
+    typedef typename Size<TTexts>::Type TSize;
+
+    SEQAN_ASSERT_EQ(length(texts), length(needles));
+    SEQAN_ASSERT_LEQ(minScore, 0);
+
+    resize(endPositions, length(texts), Exact());
+    resize(scores, length(texts), Exact());
+
+    String<TSize> scalarIds;
+
+#ifdef __SSE4_1__
+    String<TSize> shortIds;
+    String<TSize> mediumIds;
+    for (TSize i = 0; i < length(texts); ++i)
+    {
+        if (empty(needles[i]))
+            appendValue(scalarIds, i);
+        else if (length(needles[i]) <= 32)
+            appendValue(shortIds, i);
+        else if (length(needles[i]) <= 64)
+            appendValue(mediumIds, i);
+        else
+            appendValue(scalarIds, i);
+    }
+
+    _findMyersBatchSimdRun<typename SimdVector<unsigned>::Type, typename SimdVector<int>::Type>(
+        endPositions, scores, texts, needles, shortIds, minScore, parallelTag);
+    _findMyersBatchSimdRun<typename SimdVector<__uint64>::Type, typename SimdVector<__int64>::Type>(
+        endPositions, scores, texts, needles, mediumIds, minScore, parallelTag);
+#else
+    ignoreUnusedVariableWarning(parallelTag);
+    resize(scalarIds, length(texts), Exact());
+    for (TSize i = 0; i < length(texts); ++i)
+        scalarIds[i] = i;
+#endif  // #ifdef __SSE4_1__
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) if (IsSameType<Tag<TParallelTag>, Parallel>::VALUE))
+    for (int k = 0; k < (int)length(scalarIds); ++k)
+    {
+        TSize i = scalarIds[k];
+        _findMyersBatchScalar(endPositions[i], scores[i], texts[i], needles[i], minScore);
+    }
+}
+
+template <typename TEndPositions, typename TScores, typename TTexts, typename TNeedles>
+inline void
+findMyersBatch(TEndPositions & endPositions,
+               TScores & scores,
+               TTexts const & texts,
+               TNeedles const & needles,
+               int minScore)
+{
+    findMyersBatch(endPositions, scores, texts, needles, minScore, Serial());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_FIND_FIND_MYERS_BATCH_H_
@@ -39,6 +39,7 @@
 #include <seqan/graph_algorithms.h>
 #include <seqan/graph_align.h>
 #include <seqan/align.h>
+#include <seqan/parallel.h>
 
 //MSA
 #include <seqan/graph_msa/graph_align_tcoffee_base.h>
@@ -900,6 +900,374 @@ upgmaTree(TDistance& dist,
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+// mBed
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Fractional k-mer distance of two sorted k-tupel strings, the same value as
+// getDistanceMatrix(..., KmerDistance()) computes for the sequence pair.
+template<typename TTupelString>
+inline double
+_mbedKmerDistance(TTupelString const& tup1,
+                  TTupelString const& tup2)
+{
+    typedef typename Size<TTupelString>::Type TSize;
+    typedef typename Iterator<TTupelString const, Standard>::Type TIter;
+
+    TSize minLen = std::min(length(tup1), length(tup2));
+    if (minLen == 0) return SEQAN_DISTANCE_UNITY;
+
+    // Common k-tupels, counted with their minimal multiplicity
+    TSize common = 0;
+    TIter it1 = begin(tup1, Standard());
+    TIter it1End = end(tup1, Standard());
+    TIter it2 = begin(tup2, Standard());
+    TIter it2End = end(tup2, Standard());
+    while ((it1 != it1End) && (it2 != it2End)) {
+        if (*it1 < *it2) ++it1;
+        else if (*it2 < *it1) ++it2;
+        else {
+            ++common; ++it1; ++it2;
+        }
+    }
+    return SEQAN_DISTANCE_UNITY - static_cast<double>(common) / static_cast<double>(minLen) * SEQAN_DISTANCE_UNITY;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TCoords, typename TSize>
+inline double
+_mbedSquaredDistance(TCoords const& coords1,
+                     TSize pos1,
+                     TCoords const& coords2,
+                     TSize pos2,
+                     TSize nSeeds)
+{
+    typedef typename Iterator<TCoords const, Standard>::Type TIter;
+
+    double sum = 0;
+    TIter it1 = begin(coords1, Standard()) + pos1 * nSeeds;
+    TIter it2 = begin(coords2, Standard()) + pos2 * nSeeds;
+    for(TSize k = 0; k < nSeeds; ++k, ++it1, ++it2)
+        sum += (*it1 - *it2) * (*it1 - *it2);
+    return sum;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Copies a guide tree of a cluster into the guide tree of all sequences, the
+// leaves of the cluster tree are the positions in members.
+template<typename TCargo, typename TSpec, typename TSubTree, typename TVertexDescriptor2, typename TMembers>
+inline typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type
+_mbedCopySubTree(Graph<Tree<TCargo, TSpec> >& g,
+                 TSubTree& subTree,
+                 TVertexDescriptor2 v,
+                 TMembers const& members)
+{
+    typedef typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type TVertexDescriptor;
+    typedef typename Iterator<TSubTree, OutEdgeIterator>::Type TOutEdgeIterator;
+
+    if (isLeaf(subTree, v)) return members[v];
+
+    // Children first, such that the root is the last vertex as in upgmaTree()
+    String<TVertexDescriptor> children;
+    String<TCargo> weights;
+    for(TOutEdgeIterator itOut(subTree, v); !atEnd(itOut); goNext(itOut)) {
+        appendValue(children, _mbedCopySubTree(g, subTree, targetVertex(itOut), members));
+        appendValue(weights, (TCargo) cargo(*itOut));
+    }
+    TVertexDescriptor internalVertex = addVertex(g);
+    for(unsigned i = 0; i < length(children); ++i)
+        addEdge(g, internalVertex, children[i], weights[i]);
+    return internalVertex;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Joins a small cluster with UPGMA on the k-mer distances of its members.
+template<typename TCargo, typename TSpec, typename TTupelStringSet, typename TMembers>
+inline typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type
+_mbedUpgmaCluster(Graph<Tree<TCargo, TSpec> >& g,
+                  TTupelStringSet const& tupSet,
+                  TMembers const& members)
+{
+    typedef typename Size<TMembers>::Type TSize;
+
+    TSize nMembers = length(members);
+    if (nMembers == 1) return members[0];
+
+    String<double> mat;
+    resize(mat, nMembers * nMembers, 0);
+    for(TSize i = 0; i < nMembers; ++i) {
+        for(TSize j = i + 1; j < nMembers; ++j) {
+            mat[i * nMembers + j] = _mbedKmerDistance(tupSet[members[i]], tupSet[members[j]]);
+            mat[j * nMembers + i] = mat[i * nMembers + j];
+        }
+    }
+    Graph<Tree<TCargo, TSpec> > subTree;
+    upgmaTree(mat, subTree, UpgmaWeightAvg());
+    return _mbedCopySubTree(g, subTree, getRoot(subTree), members);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Bisects the cluster with 2-means on the embedded sequences.  Returns the
+// weight of the edges to the two halves.
+template<typename TCargo, typename TLeft, typename TRight, typename TCoords, typename TMembers, typename TSize>
+inline TCargo
+_mbedBisect(TLeft& left,
+            TRight& right,
+            TCoords const& coords,
+            TMembers const& members,
+            TSize nSeeds,
+            TCargo)
+{
+    TSize nMembers = length(members);
+
+    // Initial centers, the member farthest from the centroid and the member farthest from that one
+    String<double> centers;
+    resize(centers, 2 * nSeeds, 0);
+    for(TSize i = 0; i < nMembers; ++i)
+        for(TSize k = 0; k < nSeeds; ++k)
+            centers[k] += coords[members[i] * nSeeds + k] / nMembers;
+    TSize first = 0;
+    double maxDist = -1;
+    for(TSize i = 0; i < nMembers; ++i) {
+        double d = _mbedSquaredDistance(coords, (TSize) members[i], centers, (TSize) 0, nSeeds);
+        if (d > maxDist) { maxDist = d; first = members[i]; }
+    }
+    TSize second = first;
+    maxDist = -1;
+    for(TSize i = 0; i < nMembers; ++i) {
+        double d = _mbedSquaredDistance(coords, (TSize) members[i], coords, first, nSeeds);
+        if (d > maxDist) { maxDist = d; second = members[i]; }
+    }
+    for(TSize k = 0; k < nSeeds; ++k) {
+        centers[k] = coords[first * nSeeds + k];
+        centers[nSeeds + k] = coords[second * nSeeds + k];
+    }
+
+    // 2-means
+    String<bool> side;
+    resize(side, nMembers, false);
+    TSize nRight = 0;
+    for(unsigned iter = 0; iter < 10; ++iter) {
+        bool changed = (iter == 0);
+        nRight = 0;
+        for(TSize i = 0; i < nMembers; ++i) {
+            bool right = _mbedSquaredDistance(coords, (TSize) members[i], centers, (TSize) 1, nSeeds) <
+                         _mbedSquaredDistance(coords, (TSize) members[i], centers, (TSize) 0, nSeeds);
+            if (right != side[i]) changed = true;
+            side[i] = right;
+            if (right) ++nRight;
+        }
+        if (!changed || nRight == 0 || nRight == nMembers) break;
+
+        arrayFill(begin(centers, Standard()), end(centers, Standard()), 0.0);
+        for(TSize i = 0; i < nMembers; ++i) {
+            TSize c = (side[i]) ? 1 : 0;
+            TSize size = (side[i]) ? nRight : nMembers - nRight;
+            for(TSize k = 0; k < nSeeds; ++k)
+                centers[c * nSeeds + k] += coords[members[i] * nSeeds + k] / size;
+        }
+    }
+
+    // Split the members, halve them if the embedding does not separate them
+    if (nRight == 0 || nRight == nMembers) {
+        for(TSize i = 0; i < nMembers; ++i)
+            appendValue((i < nMembers / 2) ? left : right, members[i]);
+    } else {
+        for(TSize i = 0; i < nMembers; ++i)
+            appendValue((side[i]) ? right : left, members[i]);
+    }
+    return (TCargo) (std::sqrt(_mbedSquaredDistance(centers, (TSize) 0, centers, (TSize) 1, nSeeds)) / 2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TSize, typename TVertexDescriptor, typename TCargo>
+struct MbedClusterFrame_
+{
+    String<TSize> members;
+    String<TSize> right;            // the right half while the left one is clustered
+    TCargo w;
+    TVertexDescriptor leftRoot;
+    unsigned state;                 // 0: not bisected, 1: left half pending, 2: right half pending
+
+    MbedClusterFrame_() : w(0), leftRoot(0), state(0)
+    {}
+};
+
+// Bisects the cluster with 2-means on the embedded sequences until it is small
+// enough for UPGMA on the k-mer distances of its members.  Skewed bisections
+// can nest almost as deep as there are sequences, so the clusters are kept on
+// an explicit stack rather than recursing.  The vertices are added in the
+// order of a post-order traversal.
+template<typename TCargo, typename TSpec, typename TTupelStringSet, typename TCoords, typename TMembers, typename TSize>
+inline typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type
+_mbedCluster(Graph<Tree<TCargo, TSpec> >& g,
+             TTupelStringSet const& tupSet,
+             TCoords const& coords,
+             TMembers const& members,
+             TSize nSeeds,
+             TSize maxClusterSize)
+{
+    typedef typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type TVertexDescriptor;
+    typedef MbedClusterFrame_<TSize, TVertexDescriptor, TCargo> TFrame;
+
+    String<TFrame> stack;
+    resize(stack, 1);
+    back(stack).members = members;
+
+    TVertexDescriptor root = 0;     // the root of the last finished cluster
+    while (!empty(stack)) {
+        TFrame& frame = back(stack);
+        if (frame.state == 0) {
+            if (length(frame.members) <= maxClusterSize) {
+                root = _mbedUpgmaCluster(g, tupSet, frame.members);
+                eraseBack(stack);
+                continue;
+            }
+            String<TSize> left;
+            frame.w = _mbedBisect(left, frame.right, coords, frame.members, nSeeds, TCargo());
+            clear(frame.members);
+            frame.state = 1;
+            resize(stack, length(stack) + 1);
+            back(stack).members = left;
+        } else if (frame.state == 1) {
+            frame.leftRoot = root;
+            frame.state = 2;
+            String<TSize> right = frame.right;
+            clear(frame.right);
+            resize(stack, length(stack) + 1);
+            back(stack).members = right;
+        } else {
+            TVertexDescriptor internalVertex = addVertex(g);
+            addEdge(g, internalVertex, frame.leftRoot, frame.w);
+            addEdge(g, internalVertex, root, frame.w);
+            root = internalVertex;
+            eraseBack(stack);
+        }
+    }
+    return root;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TSize>
+struct MbedLengthLess_
+{
+    String<TSize> const & lengths;
+
+    MbedLengthLess_(String<TSize> const & lengths) : lengths(lengths)
+    {}
+
+    bool operator()(TSize a, TSize b) const
+    {
+        return (lengths[a] < lengths[b]) || ((lengths[a] == lengths[b]) && (a < b));
+    }
+};
+
+/*!
+ * @fn mbedTree
+ * @headerfile <seqan/graph_msa.h>
+ * @brief Computes a guide tree from k-mer distances to a few seed sequences (mBed).
+ *
+ * @signature void mbedTree(strSet, tree[, ktup[, alphabet]]);
+ *
+ * @param[in]  strSet   The @link StringSet @endlink of sequences.
+ * @param[out] tree     The guide tree, its leaves are the positions of the sequences in <tt>strSet</tt>.
+ * @param[in]  ktup     The k-mer length.  Default: 3.
+ * @param[in]  alphabet The alphabet to count k-mers over.  Default: the value type of the sequences.
+ *
+ * Each sequence is embedded as the vector of its k-mer distances to <tt>(log2 n)^2</tt> seed sequences, picked
+ * evenly from the sequences sorted by length.  The embedded sequences are bisected with 2-means until the clusters
+ * have at most 100 members, these are joined with @link upgmaTree @endlink on their k-mer distances.
+ *
+ * In contrast to @link njTree @endlink and @link upgmaTree @endlink no distance matrix of all sequences is needed.
+ * For <tt>n</tt> sequences the embedding takes <tt>n (log2 n)^2</tt> k-mer distance computations instead of
+ * <tt>n^2</tt>, and each level of the bisection takes <tt>O(n (log n)^2)</tt> time, i.e. <tt>O(n (log n)^3)</tt> in
+ * total if the clusters are split evenly.
+ *
+ * @section References
+ *
+ * Blackshields, G., Sievers, F., Shi, W., Wilm, A. and Higgins, D. G. Sequence embedding for fast construction of
+ * guide trees for multiple sequence alignment. Algorithms Mol Biol 5, 21 (2010).
+ */
+
+template<typename TString, typename TStringSpec, typename TCargo, typename TSpec, typename TSize, typename TAlphabet>
+inline void
+mbedTree(StringSet<TString, TStringSpec> const& strSet,
+         Graph<Tree<TCargo, TSpec> >& g,
+         TSize ktup,
+         TAlphabet)
+{
+    typedef String<unsigned> TTupelString;
+    typedef typename Size<StringSet<TString, TStringSpec> >::Type TPos;
+
+    TPos nseq = length(strSet);
+    clearVertices(g);
+    if (nseq == 0) return;
+
+    // Sorted k-tupels of all sequences
+    StringSet<TTupelString> tupSet;
+    resize(tupSet, nseq);
+    String<TPos> lengths;
+    resize(lengths, nseq);
+    for(TPos i = 0; i < nseq; ++i) {
+        _getTupelString(strSet[i], tupSet[i], ktup, TAlphabet());
+        std::sort(begin(tupSet[i], Standard()), end(tupSet[i], Standard()));
+        lengths[i] = length(strSet[i]);
+    }
+
+    // Seeds, evenly spaced in the order of the sequence lengths
+    double logN = std::log((double) nseq) / std::log(2.0);
+    TPos nSeeds = std::max((TPos) 1, std::min(nseq, (TPos) std::ceil(logN * logN)));
+    String<TPos> order;
+    resize(order, nseq);
+    for(TPos i = 0; i < nseq; ++i) order[i] = i;
+    std::sort(begin(order, Standard()), end(order, Standard()), MbedLengthLess_<TPos>(lengths));
+    String<TPos> seeds;
+    resize(seeds, nSeeds);
+    for(TPos k = 0; k < nSeeds; ++k) seeds[k] = order[(k * nseq) / nSeeds];
+    clear(order);
+    clear(lengths);
+
+    // Embedding, the k-mer distances to the seeds
+    String<double> coords;
+    resize(coords, nseq * nSeeds);
+    for(TPos i = 0; i < nseq; ++i)
+        for(TPos k = 0; k < nSeeds; ++k)
+            coords[i * nSeeds + k] = _mbedKmerDistance(tupSet[i], tupSet[seeds[k]]);
+
+    // One leaf for each sequence, then the clusters
+    for(TPos i = 0; i < nseq; ++i) addVertex(g);
+    String<TPos> members;
+    resize(members, nseq);
+    for(TPos i = 0; i < nseq; ++i) members[i] = i;
+    g.data_root = _mbedCluster(g, tupSet, coords, members, nSeeds, (TPos) 100);
+}
+
+template<typename TString, typename TStringSpec, typename TCargo, typename TSpec, typename TSize>
+inline void
+mbedTree(StringSet<TString, TStringSpec> const& strSet,
+         Graph<Tree<TCargo, TSpec> >& g,
+         TSize ktup)
+{
+    mbedTree(strSet, g, ktup, typename Value<TString>::Type());
+}
+
+template<typename TString, typename TStringSpec, typename TCargo, typename TSpec>
+inline void
+mbedTree(StringSet<TString, TStringSpec> const& strSet,
+         Graph<Tree<TCargo, TSpec> >& g)
+{
+    mbedTree(strSet, g, 3u);
+}
+
+
 }// namespace SEQAN_NAMESPACE_MAIN
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -562,6 +562,32 @@ getAlignmentStatistics(String<TFragment, TSpec1> const& matches,
 //////////////////////////////////////////////////////////////////////////////
 
 
+//////////////////////////////////////////////////////////////////////////////
+
+// Appends the segment matches and scores of each pair in the order of the pair
+// list, such that the result equals the one of a serial run.
+template<typename TSegmentMatches, typename TScores, typename TPairMatches, typename TPairScores>
+inline void
+_appendPairSegmentMatches(TSegmentMatches& matches,
+                          TScores& scores,
+                          TPairMatches const& pairMatches,
+                          TPairScores const& pairScores)
+{
+    typedef typename Size<TPairMatches>::Type TSize;
+
+    TSize total = length(matches);
+    for(TSize k = 0; k < length(pairMatches); ++k)
+        total += length(pairMatches[k]);
+    reserve(matches, total, Exact());
+    reserve(scores, total, Exact());
+
+    resize(scores, length(matches));
+    for(TSize k = 0; k < length(pairMatches); ++k) {
+        append(matches, pairMatches[k]);
+        append(scores, pairScores[k]);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TSegmentMatches, typename TScores>
@@ -609,6 +635,57 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TSegmentMatches, typename TScores>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TSegmentMatches& matches,
+                     TScores& scores,
+                     LcsLibrary,
+                     Serial)
+{
+    appendSegmentMatches(str, pList, matches, scores, LcsLibrary());
+}
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TSegmentMatches, typename TScores>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TSegmentMatches& matches,
+                     TScores& scores,
+                     LcsLibrary,
+                     Parallel)
+{
+    typedef StringSet<TString, Dependent<TSpec> > TStringSet;
+    typedef typename Id<TStringSet>::Type TId;
+
+    // Pairwise longest common subsequence, each pair into its own buffer
+    int nPairs = length(pList) / 2;
+    String<TSegmentMatches> pairMatches;
+    String<TScores> pairScores;
+    resize(pairMatches, nPairs);
+    resize(pairScores, nPairs);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for(int k = 0; k < nPairs; ++k) {
+        TStringSet pairSet;
+        TId id1 = positionToId(str, pList[2 * k]);
+        TId id2 = positionToId(str, pList[2 * k + 1]);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+        globalAlignment(pairMatches[k], pairSet, Lcs());
+        resize(pairScores[k], length(pairMatches[k]));
+        for(unsigned i = 0; i < length(pairMatches[k]); ++i)
+            pairScores[k][i] = pairMatches[k][i].len;
+    }
+
+    _appendPairSegmentMatches(matches, scores, pairMatches, pairScores);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 
 template<typename TString, typename TSpec, typename TSegmentMatches, typename TScores, typename TAlphabet, typename TSize>
@@ -730,6 +807,55 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 
 //////////////////////////////////////////////////////////////////////////////
 
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TScore, typename TSegmentMatches, typename TScores>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TScore const& score_type,
+                     TSegmentMatches& matches,
+                     TScores& scores,
+                     LocalPairwiseLibrary,
+                     Serial)
+{
+    appendSegmentMatches(str, pList, score_type, matches, scores, LocalPairwiseLibrary());
+}
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TScore, typename TSegmentMatches, typename TScores>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TScore const& score_type,
+                     TSegmentMatches& matches,
+                     TScores& scores,
+                     LocalPairwiseLibrary,
+                     Parallel)
+{
+    typedef StringSet<TString, Dependent<TSpec> > TStringSet;
+    typedef typename Id<TStringSet>::Type TId;
+
+    // Pairwise alignments, each pair into its own buffer
+    int nPairs = length(pList) / 2;
+    String<TSegmentMatches> pairMatches;
+    String<TScores> pairScores;
+    resize(pairMatches, nPairs);
+    resize(pairScores, nPairs);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for(int k = 0; k < nPairs; ++k) {
+        TStringSet pairSet;
+        TId id1 = positionToId(str, pList[2 * k]);
+        TId id2 = positionToId(str, pList[2 * k + 1]);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+        _multiLocalAlignment(pairSet, pairMatches[k], pairScores[k], score_type, 4, SmithWatermanClump());
+    }
+
+    _appendPairSegmentMatches(matches, scores, pairMatches, pairScores);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 template<typename TValue, typename TSpec, typename TSize>
 inline void
 _resizeWithRespectToDistance(String<TValue, TSpec>& dist,
@@ -901,6 +1027,90 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
     appendSegmentMatches(str, pList, score_type, matches, scores, dist, AlignConfig<>(), GlobalPairwiseLibrary() );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TScore, typename TSegmentMatches, typename TScoreValues, typename TDistance, typename TAlignConfig>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TScore const& score_type,
+                     TSegmentMatches& matches,
+                     TScoreValues& scores,
+                     TDistance& dist,
+                     TAlignConfig const& ac,
+                     GlobalPairwiseLibrary,
+                     Serial)
+{
+    appendSegmentMatches(str, pList, score_type, matches, scores, dist, ac, GlobalPairwiseLibrary());
+}
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TScore, typename TSegmentMatches, typename TScoreValues, typename TDistance, typename TAlignConfig>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TScore const& score_type,
+                     TSegmentMatches& matches,
+                     TScoreValues& scores,
+                     TDistance& dist,
+                     TAlignConfig const& ac,
+                     GlobalPairwiseLibrary,
+                     Parallel)
+{
+    typedef StringSet<TString, Dependent<TSpec> > TStringSet;
+    typedef typename Id<TStringSet>::Type TId;
+    typedef typename Size<TStringSet>::Type TSize;
+    typedef typename Value<TScoreValues>::Type TScoreValue;
+
+    // Initialization
+    TSize nseq = length(str);
+    _resizeWithRespectToDistance(dist, nseq);
+
+    // Pairwise alignments, each pair into its own buffer
+    int nPairs = length(pList) / 2;
+    String<TSegmentMatches> pairMatches;
+    String<TScoreValues> pairScores;
+    resize(pairMatches, nPairs);
+    resize(pairScores, nPairs);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for(int k = 0; k < nPairs; ++k) {
+        TStringSet pairSet;
+        TId id1 = positionToId(str, pList[2 * k]);
+        TId id2 = positionToId(str, pList[2 * k + 1]);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+        assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+        TScoreValue myScore = globalAlignment(pairMatches[k], pairSet, score_type, ac, Gotoh() );
+        resize(pairScores[k], length(pairMatches[k]), myScore);
+    }
+
+    // Get the alignment statistics, serially as the distance may be a graph
+    for(int k = 0; k < nPairs; ++k) {
+        TStringSet pairSet;
+        assignValueById(pairSet, const_cast<TStringSet&>(str), positionToId(str, pList[2 * k]));
+        assignValueById(pairSet, const_cast<TStringSet&>(str), positionToId(str, pList[2 * k + 1]));
+        _setDistanceValue(pairMatches[k], pairSet, dist, (TSize) pList[2 * k], (TSize) pList[2 * k + 1], (TSize) nseq, (TSize) 0);
+    }
+
+    _appendPairSegmentMatches(matches, scores, pairMatches, pairScores);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TScore, typename TSegmentMatches, typename TScoreValues, typename TDistance, typename TParallelTag>
+inline void
+appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
+                     String<TSize2, TSpec2> const& pList,
+                     TScore const& score_type,
+                     TSegmentMatches& matches,
+                     TScoreValues& scores,
+                     TDistance& dist,
+                     GlobalPairwiseLibrary,
+                     Tag<TParallelTag> parallelTag)
+{
+    appendSegmentMatches(str, pList, score_type, matches, scores, dist, AlignConfig<>(), GlobalPairwiseLibrary(), parallelTag);
+}
+
 }// namespace SEQAN_NAMESPACE_MAIN
 
 #endif //#ifndef SEQAN_HEADER_...
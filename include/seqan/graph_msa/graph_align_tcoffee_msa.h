@@ -85,7 +85,8 @@ public:
      * @brief Methods for computing guide tre.
      *
      * 0 Neighbor-joining, 1 UPGMA single linkage, 2 UPGMA complete linkage,
-     * 3 UPGMA average linkage, 4 UPGMA weighted average linkage.
+     * 3 UPGMA average linkage, 4 UPGMA weighted average linkage, 5 mBed k-mer embedding
+     * (see @link mbedTree @endlink), which needs no distance matrix of all sequences.
      */
     unsigned build;
 
@@ -229,27 +230,29 @@ void evaluateAlignment(MsaOptions<TAlphabet, TScore> const & msaOpt)
 // Function globalMsaAlignment()
 // --------------------------------------------------------------------------
 
-template <typename TStrSpec, typename TSpec, typename TList, typename TScore, typename TSegmentMatches, typename TScores>
+template <typename TStrSpec, typename TSpec, typename TList, typename TScore, typename TSegmentMatches, typename TScores, typename TParallelTag>
 void _appendSegmentMatches(StringSet<String<AminoAcid, TStrSpec>, Dependent<TSpec> > const & str,
                              TList const & pList,
                              TScore const &,
                              TSegmentMatches & matches,
-                             TScores & scores)
+                             TScores & scores,
+                             Tag<TParallelTag> parallelTag)
 {
     Blosum62 local_score(-1, -8);
-    appendSegmentMatches(str, pList, local_score, matches, scores, LocalPairwiseLibrary());
+    appendSegmentMatches(str, pList, local_score, matches, scores, LocalPairwiseLibrary(), parallelTag);
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-template <typename TValue, typename TStrSpec, typename TSpec, typename TList, typename TScore, typename TSegmentMatches, typename TScores>
+template <typename TValue, typename TStrSpec, typename TSpec, typename TList, typename TScore, typename TSegmentMatches, typename TScores, typename TParallelTag>
 void _appendSegmentMatches(StringSet<String<TValue, TStrSpec>, Dependent<TSpec> > const & str,
                              TList const & pList,
                              TScore const & score_type,
                              TSegmentMatches & matches,
-                             TScores & scores)
+                             TScores & scores,
+                             Tag<TParallelTag> parallelTag)
 {
-    appendSegmentMatches(str, pList, score_type, matches, scores, LocalPairwiseLibrary());
+    appendSegmentMatches(str, pList, score_type, matches, scores, LocalPairwiseLibrary(), parallelTag);
 }
 
 /*!
@@ -257,22 +260,33 @@ void _appendSegmentMatches(StringSet<String<TValue, TStrSpec>, Dependent<TSpec>
  * @headerfile <seqan/graph_msa.h>
  * @brief Compute a global multiple sequence alignment.
  *
- * @signature void globalMsaAlignment(align, score);
- * @signature void globalMsaAlignment(gAlign, score[, options]);
+ * @signature void globalMsaAlignment(align, score[, parallelTag]);
+ * @signature void globalMsaAlignment(gAlign, score[, parallelTag]);
+ * @signature void globalMsaAlignment(gAlign, sequenceSet, sequenceNames, options[, parallelTag]);
  *
- * @param[in,out] gAlign  An @link AlignmentGraph @endlink containing two or more sequences.
- * @param[in,out] align   A @link Align @endlink object with two or more sequences to align.
- * @param[in]     score   The @link Score @endlink to use for computing the alignment.
- * @param[in]     options The @link MsaOptions @endlink to use for the configuration.
+ * @param[in,out] gAlign        An @link AlignmentGraph @endlink containing two or more sequences.
+ * @param[in,out] align         A @link Align @endlink object with two or more sequences to align.
+ * @param[in]     score         The @link Score @endlink to use for computing the alignment.
+ * @param[in]     sequenceSet   The @link StringSet @endlink of sequences to align.
+ * @param[in]     sequenceNames The names of the sequences, used for reading external libraries and guide trees.
+ * @param[in]     options       The @link MsaOptions @endlink to use for the configuration.
+ * @param[in]     parallelTag   Tag to enable/disable multi-threading, one of @link ParallelismTags#Serial @endlink
+ *                              and @link ParallelismTags#Parallel @endlink.  Default: Serial.
  *
  * The resulting alignment is stored in <tt>align</tt>/<tt>gAlign</tt>.
+ *
+ * With @link ParallelismTags#Parallel @endlink the pairwise alignments of the library are computed concurrently and
+ * the progressive alignment aligns independent subtrees of the guide tree concurrently.  The result is the same as
+ * the one of the serial version.
  */
 
-template <typename TStringSet, typename TCargo, typename TSpec, typename TStringSet1, typename TNames, typename TAlphabet, typename TScore>
+template <typename TStringSet, typename TCargo, typename TSpec, typename TStringSet1, typename TNames, typename TAlphabet, typename TScore,
+          typename TParallelTag>
 void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
                         TStringSet1 & sequenceSet,
                         TNames & sequenceNames,
-                        MsaOptions<TAlphabet, TScore> const & msaOpt)
+                        MsaOptions<TAlphabet, TScore> const & msaOpt,
+                        Tag<TParallelTag> parallelTag)
 {
     typedef typename Value<TScore>::Type TScoreValue;
     typedef typename Size<TStringSet>::Type TSize;
@@ -327,16 +341,30 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
         for (; begIt != begItEnd; goNext(begIt))
         {
             if (*begIt == 0)
-                appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, distanceMatrix, GlobalPairwiseLibrary());
+            {
+                // mBed builds its guide tree without the distance matrix of all sequences.
+                if (msaOpt.build == 5)
+                {
+                    Nothing noth;
+                    appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, noth, GlobalPairwiseLibrary(),
+                                         parallelTag);
+                }
+                else
+                {
+                    appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, distanceMatrix,
+                                         GlobalPairwiseLibrary(), parallelTag);
+                }
+            }
             else if (*begIt == 1)
-                _appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores);
+                _appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, parallelTag);
             else if (*begIt == 2)
             {
                 Nothing noth;
-                appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, noth, AlignConfig<true, true, true, true>(), GlobalPairwiseLibrary());
+                appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, noth, AlignConfig<true, true, true, true>(),
+                                     GlobalPairwiseLibrary(), parallelTag);
             }
             else if (*begIt == 3)
-                appendSegmentMatches(seqSet, pList, matches, scores, LcsLibrary());
+                appendSegmentMatches(seqSet, pList, matches, scores, LcsLibrary(), parallelTag);
         }
     }
 
@@ -403,6 +431,11 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
         read(strm_tree, guideTree, sequenceNames, NewickFormat());  // Read newick tree
         strm_tree.close();
     }
+    else if (msaOpt.build == 5)
+    {
+        // The embedding needs no distance matrix
+        mbedTree(seqSet, guideTree);
+    }
     else
     {
         // Check if we have a valid distance matrix
@@ -431,7 +464,7 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
         tripletLibraryExtension(g, guideTree, threshold / 2);
 
     // Progressive Alignment
-    progressiveAlignment(g, guideTree, gAlign);
+    progressiveAlignment(g, guideTree, gAlign, parallelTag);
 
     clear(guideTree);
     clear(g);
@@ -445,9 +478,19 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
     //}
 }
 
-template <typename TStringSet, typename TCargo, typename TSpec, typename TScore>
+template <typename TStringSet, typename TCargo, typename TSpec, typename TStringSet1, typename TNames, typename TAlphabet, typename TScore>
 void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
-                        TScore const & scoreObject)
+                        TStringSet1 & sequenceSet,
+                        TNames & sequenceNames,
+                        MsaOptions<TAlphabet, TScore> const & msaOpt)
+{
+    globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt, Serial());
+}
+
+template <typename TStringSet, typename TCargo, typename TSpec, typename TScore, typename TParallelTag>
+void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
+                        TScore const & scoreObject,
+                        Tag<TParallelTag> parallelTag)
 {
     //typedef typename Value<TStringSet>::Type TString;
     //typedef typename Value<TString>::Type TAlphabet;
@@ -458,20 +501,35 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
     msaOpt.sc = scoreObject;
     appendValue(msaOpt.method, 0);  // Global pairwise
     appendValue(msaOpt.method, 1);  // Local pairwise
-    globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt);
+    globalMsaAlignment(gAlign, sequenceSet, sequenceNames, msaOpt, parallelTag);
 }
 
-template <typename TSource, typename TSpec, typename TScore>
-void globalMsaAlignment(Align<TSource, TSpec> & align,
+template <typename TStringSet, typename TCargo, typename TSpec, typename TScore>
+void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
                         TScore const & scoreObject)
+{
+    globalMsaAlignment(gAlign, scoreObject, Serial());
+}
+
+template <typename TSource, typename TSpec, typename TScore, typename TParallelTag>
+void globalMsaAlignment(Align<TSource, TSpec> & align,
+                        TScore const & scoreObject,
+                        Tag<TParallelTag> parallelTag)
 {
     typedef StringSet<TSource, Dependent<> > TStringSet;
     TStringSet sequenceSet = stringSet(align);
     Graph<Alignment<TStringSet, void, WithoutEdgeId> > gAlign(sequenceSet);
-    globalMsaAlignment(gAlign, scoreObject);
+    globalMsaAlignment(gAlign, scoreObject, parallelTag);
     convertAlignment(gAlign, align);
 }
 
+template <typename TSource, typename TSpec, typename TScore>
+void globalMsaAlignment(Align<TSource, TSpec> & align,
+                        TScore const & scoreObject)
+{
+    globalMsaAlignment(align, scoreObject, Serial());
+}
+
 // TODO(holtgrew): Remove the following?
 
 //////////////////////////////////////////////////////////////////////////////
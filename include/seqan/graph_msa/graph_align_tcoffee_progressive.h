@@ -120,11 +120,16 @@ _createAlignmentGraph(Graph<Alignment<TStringSet, TCargo, TSpec> > const& g,
  * @headerfile <seqan/graph_msa.h>
  * @brief Perform a progressive multiple sequence alignment (MSA).
  *
- * @signature void progressiveAlignment(inputGraph, guideTree, outputGraph);
+ * @signature void progressiveAlignment(inputGraph, guideTree, outputGraph[, parallelTag]);
  *
  * @param[in]  inputGraph  A @link AlignmentGraph @endlink with multiple sequence information.
  * @param[in]  guideTree   A @link Tree @endlink to use as the guide tree.
  * @param[out] outputGraph An @link AlignmentGraph @endlink for the final MSA.
+ * @param[in]  parallelTag Tag to enable/disable multi-threading, one of @link ParallelismTags#Serial @endlink and
+ *                         @link ParallelismTags#Parallel @endlink.  Default: Serial.
+ *
+ * With @link ParallelismTags#Parallel @endlink the guide tree nodes of equal height, i.e. independent subtrees,
+ * are aligned concurrently.  The result is the same as the one of the serial version.
  */
 
 template<typename TStringSet, typename TCargo, typename TSpec, typename TGuideTree, typename TOutGraph>
@@ -182,6 +187,92 @@ progressiveAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
     _createAlignmentGraph(g, segString[rootVertex], gOut);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TStringSet, typename TCargo, typename TSpec, typename TGuideTree, typename TOutGraph>
+inline void
+progressiveAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
+                     TGuideTree& tree,
+                     TOutGraph& gOut,
+                     Serial)
+{
+    progressiveAlignment(g, tree, gOut);
+}
+
+template<typename TStringSet, typename TCargo, typename TSpec, typename TGuideTree, typename TOutGraph>
+inline void
+progressiveAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
+                     TGuideTree& tree,
+                     TOutGraph& gOut,
+                     Parallel)
+{
+    SEQAN_CHECKPOINT
+    typedef Graph<Alignment<TStringSet, TCargo, TSpec> > TGraph;
+    typedef typename Size<TGraph>::Type TSize;
+    typedef typename VertexDescriptor<TGuideTree>::Type TVertexDescriptor;
+    typedef typename Iterator<TGuideTree, BfsIterator>::Type TBfsIterator;
+    typedef typename Iterator<TGuideTree, AdjacencyIterator>::Type TAdjacencyIterator;
+    typedef String<TVertexDescriptor> TVertexString;
+    typedef String<TVertexString> TSegmentString;
+
+    // Initialization
+    TVertexDescriptor rootVertex = getRoot(tree);
+    TSize nVertices = numVertices(tree);
+
+    // Vertices in reversed bfs order
+    TVertexString vertices;
+    resize(vertices, nVertices);
+    typedef typename Iterator<TVertexString, Standard>::Type TVertexIter;
+    TVertexIter itVertEnd = end(vertices, Standard());
+    --itVertEnd;
+    TBfsIterator bfsIt(tree, rootVertex);
+    for(;!atEnd(bfsIt);goNext(bfsIt), --itVertEnd)
+        *itVertEnd = *bfsIt;
+
+    // Children come before their parents, hence the heights are known in time
+    String<TSize> height;
+    resize(height, getIdUpperBound(_getVertexIdManager(tree)), 0);
+    TSize maxHeight = 0;
+    for(TVertexIter itVert = begin(vertices, Standard()); itVert != end(vertices, Standard()); ++itVert) {
+        for(TAdjacencyIterator adjIt(tree, *itVert); !atEnd(adjIt); goNext(adjIt))
+            height[*itVert] = std::max(height[*itVert], height[*adjIt] + 1);
+        maxHeight = std::max(maxHeight, height[*itVert]);
+    }
+
+    // Bucket the vertices by their height, subtrees of the same height are independent
+    String<TVertexString> levels;
+    resize(levels, maxHeight + 1);
+    for(TVertexIter itVert = begin(vertices, Standard()); itVert != end(vertices, Standard()); ++itVert)
+        appendValue(levels[height[*itVert]], *itVert);
+    clear(vertices);
+    clear(height);
+
+    // All Strings of Strings of vertices for each node of the guide tree
+    String<TSegmentString> segString;
+    resize(segString, nVertices);
+
+    // Progressive alignment, level by level
+    for(TSize level = 0; level <= maxHeight; ++level) {
+        TVertexString const & levelVertices = levels[level];
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+        for(int i = 0; i < (int) length(levelVertices); ++i) {
+            TVertexDescriptor v = levelVertices[i];
+            if(isLeaf(tree, v)) _buildLeafString(g, v, segString[v]);
+            else {
+                // Align the two children (Binary tree)
+                TAdjacencyIterator adjIt(tree, v);
+                TVertexDescriptor child1 = *adjIt; goNext(adjIt);
+                heaviestCommonSubsequence(g, segString[child1], segString[*adjIt], segString[v]);
+                clear(segString[child1]);
+                clear(segString[*adjIt]);
+            }
+        }
+    }
+
+    // Create the alignment graph
+    _createAlignmentGraph(g, segString[rootVertex], gOut);
+}
+
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -97,6 +97,7 @@
 #include <seqan/index/index_sa_lss.h>
 #include <seqan/index/index_sa_mm.h>
 #include <seqan/index/index_sa_qsort.h>
+#include <seqan/index/index_sa_sais.h>
 #include <seqan/index/index_sa_bwtwalk.h>
 
 #include <seqan/index/pump_extender3.h>
@@ -147,6 +148,7 @@
 #include <seqan/index/index_fm_rank_dictionary_base.h>
 #include <seqan/index/index_fm_rank_dictionary_naive.h>
 #include <seqan/index/index_fm_rank_dictionary_levels.h>
+#include <seqan/index/index_fm_rank_dictionary_epr.h>
 #include <seqan/index/index_fm_right_array_binary_tree.h>
 #include <seqan/index/index_fm_right_array_binary_tree_iterator.h>
 #include <seqan/index/index_fm_rank_dictionary_wt.h>
@@ -166,6 +168,8 @@
 #include <seqan/index/index_fm_compressed_sa_iterator.h>
 #include <seqan/index/index_fm.h>
 #include <seqan/index/index_fm_stree.h>
+#include <seqan/index/index_bifm.h>
+#include <seqan/index/index_bifm_stree.h>
 
 // ----------------------------------------------------------------------------
 // Suffix tree algorithms.
@@ -226,6 +230,7 @@
 #include <seqan/index/find2_vstree_factory.h>
 #include <seqan/index/find2_index_multi.h>
 #include <seqan/index/find2_functors.h>
+#include <seqan/index/find2_index_approx.h>
 
 // ----------------------------------------------------------------------------
 // Lambda interface.
@@ -0,0 +1,463 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Approximate string matching in a bidirectional index via search schemes.
+//
+// Kucherov G, Salikhov K, Tsur D.  Approximate string matching using a
+// bidirectional index.  Theor. Comput. Sci. 638:145-158, 2016.
+//
+// Kianfar K, Pockrandt C, Torkamandi B, Luo H, Reinert K.  Optimum search
+// schemes for approximate string matching using bidirectional FM-index.
+// bioRxiv 301085, 2018.
+//
+// The needle is split into P parts.  A search processes the parts in the
+// order pi, which extends the matched window to the left or to the right, and
+// bounds the accumulated number of errors after the i-th part by l[i] and
+// u[i].  The searches of a scheme together cover every distribution of at
+// most K errors over the parts, which prunes most of the backtracking tree.
+// ==========================================================================
+
+#ifndef SEQAN_INDEX_FIND2_INDEX_APPROX_H_
+#define SEQAN_INDEX_FIND2_INDEX_APPROX_H_
+
+namespace seqan {
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class OptimalSearch
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class OptimalSearch
+ * @headerfile <seqan/index.h>
+ * @brief A single search of a search scheme.
+ *
+ * @signature template <unsigned N>
+ *            struct OptimalSearch;
+ *
+ * @tparam N The number of parts the needle is split into.
+ *
+ * @var TArray OptimalSearch::pi
+ * @brief The order in which the parts are searched, 1-based.
+ *
+ * @var TArray OptimalSearch::l
+ * @brief Lower bounds on the accumulated number of errors after each part.
+ *
+ * @var TArray OptimalSearch::u
+ * @brief Upper bounds on the accumulated number of errors after each part.
+ */
+
+template <unsigned N>
+struct OptimalSearch
+{
+    unsigned char pi[N];
+    unsigned char l[N];
+    unsigned char u[N];
+};
+
+// ----------------------------------------------------------------------------
+// Class OptimalSearchSchemes
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class OptimalSearchSchemes
+ * @headerfile <seqan/index.h>
+ * @brief The search scheme used to find a needle with up to <tt>maxErrors</tt> errors.
+ *
+ * @signature template <unsigned maxErrors[, typename TSpec]>
+ *            struct OptimalSearchSchemes;
+ *
+ * @tparam maxErrors The maximal number of errors, at most 3.
+ *
+ * The schemes for one and two errors are the optimum schemes of Kianfar et al.  The scheme for three errors
+ * covers every distribution of errors exactly once.
+ *
+ * @var TSearches OptimalSearchSchemes::VALUE
+ * @brief The array of @link OptimalSearch @endlink objects of the scheme.
+ */
+
+template <unsigned maxErrors, typename TSpec = void>
+struct OptimalSearchSchemes;
+
+template <typename TSpec>
+struct OptimalSearchSchemes<0, TSpec>
+{
+    typedef OptimalSearch<1>    TSearch;
+    static const unsigned COUNT = 1;
+    static const TSearch VALUE[COUNT];
+};
+
+template <typename TSpec>
+const OptimalSearch<1> OptimalSearchSchemes<0, TSpec>::VALUE[1] =
+{
+    { {1}, {0}, {0} }
+};
+
+template <typename TSpec>
+struct OptimalSearchSchemes<1, TSpec>
+{
+    typedef OptimalSearch<2>    TSearch;
+    static const unsigned COUNT = 2;
+    static const TSearch VALUE[COUNT];
+};
+
+template <typename TSpec>
+const OptimalSearch<2> OptimalSearchSchemes<1, TSpec>::VALUE[2] =
+{
+    { {1, 2}, {0, 0}, {0, 1} },
+    { {2, 1}, {0, 1}, {0, 1} }
+};
+
+template <typename TSpec>
+struct OptimalSearchSchemes<2, TSpec>
+{
+    typedef OptimalSearch<4>    TSearch;
+    static const unsigned COUNT = 3;
+    static const TSearch VALUE[COUNT];
+};
+
+template <typename TSpec>
+const OptimalSearch<4> OptimalSearchSchemes<2, TSpec>::VALUE[3] =
+{
+    { {2, 1, 3, 4}, {0, 0, 1, 1}, {0, 0, 2, 2} },
+    { {3, 2, 1, 4}, {0, 0, 0, 0}, {0, 1, 1, 2} },
+    { {4, 3, 2, 1}, {0, 0, 0, 2}, {0, 1, 2, 2} }
+};
+
+template <typename TSpec>
+struct OptimalSearchSchemes<3, TSpec>
+{
+    typedef OptimalSearch<5>    TSearch;
+    static const unsigned COUNT = 4;
+    static const TSearch VALUE[COUNT];
+};
+
+template <typename TSpec>
+const OptimalSearch<5> OptimalSearchSchemes<3, TSpec>::VALUE[4] =
+{
+    { {1, 2, 3, 4, 5}, {0, 0, 0, 0, 0}, {0, 3, 3, 3, 3} },
+    { {2, 1, 3, 4, 5}, {0, 1, 1, 1, 1}, {0, 3, 3, 3, 3} },
+    { {3, 2, 1, 4, 5}, {0, 1, 2, 2, 2}, {0, 1, 3, 3, 3} },
+    { {4, 5, 3, 2, 1}, {0, 0, 0, 2, 3}, {0, 0, 1, 2, 3} }
+};
+
+// ----------------------------------------------------------------------------
+// Class OptimalSearchBlocks_
+// ----------------------------------------------------------------------------
+
+// The needle dependent layout of a search: the number of needle characters matched after each part
+// and the direction in which each part is searched.
+template <unsigned N>
+struct OptimalSearchBlocks_
+{
+    unsigned    blockEnd[N];
+    bool        goRight[N];
+    unsigned    start;
+};
+
+// ----------------------------------------------------------------------------
+// Class OptimalSearchNeedleDelegate_
+// ----------------------------------------------------------------------------
+
+// Passes the position of the needle in its string set to the user delegate.
+template <typename TDelegate, typename TNeedleId>
+struct OptimalSearchNeedleDelegate_
+{
+    TDelegate & delegate;
+    TNeedleId   needleId;
+
+    OptimalSearchNeedleDelegate_(TDelegate & delegate, TNeedleId needleId) :
+        delegate(delegate),
+        needleId(needleId)
+    {}
+
+    template <typename TIter, typename TNeedle>
+    void operator()(TIter const & it, TNeedle const & /* needle */, unsigned errors)
+    {
+        delegate(it, needleId, errors);
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _optimalSearchBlocks()
+// ----------------------------------------------------------------------------
+
+template <unsigned N>
+inline void
+_optimalSearchBlocks(OptimalSearchBlocks_<N> & blocks, OptimalSearch<N> const & search, unsigned needleLength)
+{
+    unsigned maxPart = 0;
+    unsigned matched = 0;
+
+    for (unsigned i = 0; i < N; ++i)
+    {
+        unsigned part = search.pi[i] - 1;
+        matched += needleLength * (part + 1) / N - needleLength * part / N;
+        blocks.blockEnd[i] = matched;
+        blocks.goRight[i] = part >= maxPart;
+        maxPart = _max(maxPart, part);
+    }
+
+    // The first part is searched in the direction of the second one.
+    if (N > 1)
+        blocks.goRight[0] = blocks.goRight[1];
+
+    unsigned firstPart = search.pi[0] - 1;
+    blocks.start = blocks.goRight[0] ? needleLength * firstPart / N : needleLength * (firstPart + 1) / N;
+}
+
+// ----------------------------------------------------------------------------
+// Function _optimalSearchGoDown()
+// ----------------------------------------------------------------------------
+
+template <typename TIter, typename TChar>
+inline bool
+_optimalSearchGoDown(TIter & it, TChar c, bool goRight)
+{
+    return goRight ? goDown(it, c, Fwd()) : goDown(it, c, Rev());
+}
+
+// ----------------------------------------------------------------------------
+// Function _optimalSearch()
+// ----------------------------------------------------------------------------
+
+enum OptimalSearchEdit_
+{
+    OPTIMAL_SEARCH_NONE,
+    OPTIMAL_SEARCH_INSERTION,
+    OPTIMAL_SEARCH_DELETION
+};
+
+// Extends the window [left, right) of the needle matched by it by one character.
+template <typename TDelegate, typename TIter, typename TNeedle, unsigned N, typename TDistanceTag>
+inline void
+_optimalSearch(TDelegate & delegate,
+               TIter const & it,
+               TNeedle const & needle,
+               unsigned left,
+               unsigned right,
+               unsigned errors,
+               unsigned minErrors,
+               OptimalSearch<N> const & search,
+               OptimalSearchBlocks_<N> const & blocks,
+               unsigned blockId,
+               OptimalSearchEdit_ lastEdit,
+               TDistanceTag)
+{
+    typedef typename Value<typename Container<TIter>::Type>::Type   TAlphabet;
+
+    // Close all parts that are complete, empty parts are complete right away.
+    while (right - left == blocks.blockEnd[blockId])
+    {
+        if (errors < search.l[blockId])
+            return;
+
+        if (blockId + 1 == N)
+        {
+            if (errors >= minErrors)
+                delegate(it, needle, errors);
+            return;
+        }
+
+        ++blockId;
+        lastEdit = OPTIMAL_SEARCH_NONE;
+    }
+
+    bool goRight = blocks.goRight[blockId];
+    unsigned nextLeft = goRight ? left : left - 1;
+    unsigned nextRight = goRight ? right + 1 : right;
+    TAlphabet needleChar = needle[goRight ? right : left - 1];
+
+    // Match or mismatch.
+    if (errors < search.u[blockId])
+    {
+        for (unsigned ord = 0; ord < ValueSize<TAlphabet>::VALUE; ++ord)
+        {
+            TIter child(it);
+            TAlphabet c = ord;
+            if (_optimalSearchGoDown(child, c, goRight))
+                _optimalSearch(delegate, child, needle, nextLeft, nextRight, errors + (c != needleChar), minErrors,
+                               search, blocks, blockId, OPTIMAL_SEARCH_NONE, TDistanceTag());
+        }
+    }
+    else
+    {
+        TIter child(it);
+        if (_optimalSearchGoDown(child, needleChar, goRight))
+            _optimalSearch(delegate, child, needle, nextLeft, nextRight, errors, minErrors,
+                           search, blocks, blockId, OPTIMAL_SEARCH_NONE, TDistanceTag());
+    }
+
+    if (!IsSameType<TDistanceTag, EditDistance>::VALUE || errors >= search.u[blockId])
+        return;
+
+    // An insertion next to a deletion is never better than a mismatch.
+    if (lastEdit != OPTIMAL_SEARCH_DELETION)
+        _optimalSearch(delegate, it, needle, nextLeft, nextRight, errors + 1, minErrors,
+                       search, blocks, blockId, OPTIMAL_SEARCH_INSERTION, TDistanceTag());
+
+    // Deletions in front of the first or behind the last needle character are never needed.
+    if (lastEdit != OPTIMAL_SEARCH_INSERTION && (goRight ? right > 0 : left < length(needle)))
+    {
+        for (unsigned ord = 0; ord < ValueSize<TAlphabet>::VALUE; ++ord)
+        {
+            TIter child(it);
+            TAlphabet c = ord;
+            if (_optimalSearchGoDown(child, c, goRight))
+                _optimalSearch(delegate, child, needle, left, right, errors + 1, minErrors,
+                               search, blocks, blockId, OPTIMAL_SEARCH_DELETION, TDistanceTag());
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _optimalSearchScheme()
+// ----------------------------------------------------------------------------
+
+template <typename TDelegate, typename TIter, typename TNeedle, unsigned N, unsigned COUNT, typename TDistanceTag>
+inline void
+_optimalSearchScheme(TDelegate & delegate,
+                     TIter const & it,
+                     TNeedle const & needle,
+                     unsigned minErrors,
+                     OptimalSearch<N> const (& scheme)[COUNT],
+                     TDistanceTag)
+{
+    OptimalSearchBlocks_<N> blocks;
+
+    for (unsigned i = 0; i < COUNT; ++i)
+    {
+        _optimalSearchBlocks(blocks, scheme[i], length(needle));
+        _optimalSearch(delegate, it, needle, blocks.start, blocks.start, 0u, minErrors,
+                       scheme[i], blocks, 0u, OPTIMAL_SEARCH_NONE, TDistanceTag());
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function find()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#find
+ * @headerfile <seqan/index.h>
+ * @brief Finds all approximate occurrences of a needle in a bidirectional index using an optimal search scheme.
+ *
+ * @signature void find<minErrors, maxErrors>(delegate, index, needle, distance);
+ * @signature void find<minErrors, maxErrors>(delegate, index, needles, distance[, parallelTag]);
+ *
+ * @tparam minErrors The minimal number of errors of a reported occurrence.
+ * @tparam maxErrors The maximal number of errors of a reported occurrence, at most 3.
+ *
+ * @param[in,out] delegate    A functor called as <tt>delegate(it, needle, errors)</tt> for each occurrence, where
+ *                            <tt>it</tt> is a top-down iterator of the index that represents the occurrence and
+ *                            <tt>errors</tt> is the number of errors.  For a @link StringSet @endlink of needles the
+ *                            delegate receives the position of the needle instead of the needle.  In parallel mode
+ *                            the delegate is called concurrently by multiple threads.
+ * @param[in]     index       A @link BidirectionalIndex @endlink.
+ * @param[in]     needle      The needle to search.
+ * @param[in]     needles     A @link StringSet @endlink of needles to search.
+ * @param[in]     distance    The distance measure, @link HammingDistance @endlink or @link EditDistance @endlink.
+ * @param[in]     parallelTag Tag to search the needles in parallel, one of @link ParallelismTags @endlink.
+ *                            Defaults to <tt>Serial</tt>.
+ *
+ * For the Hamming distance every occurrence is reported exactly once.  For the edit distance an occurrence can be
+ * reported multiple times, with different lengths or numbers of errors, and the number of errors is not necessarily
+ * the edit distance of the occurrence.
+ */
+
+template <unsigned minErrors, unsigned maxErrors, typename TDelegate, typename TText, typename TIndexSpec,
+          typename TNeedle, typename TDistanceTag>
+inline void
+find(TDelegate & delegate,
+     Index<TText, BidirectionalIndex<TIndexSpec> > & index,
+     TNeedle const & needle,
+     TDistanceTag)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >   TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+
+    SEQAN_ASSERT_LEQ(minErrors, maxErrors);
+
+    TIter it(index);
+    _optimalSearchScheme(delegate, it, needle, minErrors, OptimalSearchSchemes<maxErrors>::VALUE, TDistanceTag());
+}
+
+template <unsigned minErrors, unsigned maxErrors, typename TDelegate, typename TText, typename TIndexSpec,
+          typename TNeedle, typename TStringSetSpec, typename TDistanceTag, typename TParallelTag>
+inline void
+find(TDelegate & delegate,
+     Index<TText, BidirectionalIndex<TIndexSpec> > & index,
+     StringSet<TNeedle, TStringSetSpec> const & needles,
+     TDistanceTag,
+     Tag<TParallelTag> const & /* tag */)
+{
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >           TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type             TIter;
+    typedef typename Size<StringSet<TNeedle, TStringSetSpec> >::Type    TSize;
+    typedef typename MakeSigned<TSize>::Type                        TSSize;
+    typedef OptimalSearchNeedleDelegate_<TDelegate, TSize>          TNeedleDelegate;
+
+    SEQAN_ASSERT_LEQ(minErrors, maxErrors);
+
+    // Build the index in advance, the iterators of all threads share it.
+    TIter root(index);
+    TSSize needlesCount = length(needles);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) if (IsSameType<Tag<TParallelTag>, Parallel>::VALUE))
+    for (TSSize needleId = 0; needleId < needlesCount; ++needleId)
+    {
+        TNeedleDelegate needleDelegate(delegate, needleId);
+        _optimalSearchScheme(needleDelegate, root, needles[needleId], minErrors,
+                             OptimalSearchSchemes<maxErrors>::VALUE, TDistanceTag());
+    }
+}
+
+template <unsigned minErrors, unsigned maxErrors, typename TDelegate, typename TText, typename TIndexSpec,
+          typename TNeedle, typename TStringSetSpec, typename TDistanceTag>
+inline void
+find(TDelegate & delegate,
+     Index<TText, BidirectionalIndex<TIndexSpec> > & index,
+     StringSet<TNeedle, TStringSetSpec> const & needles,
+     TDistanceTag)
+{
+    find<minErrors, maxErrors>(delegate, index, needles, TDistanceTag(), Serial());
+}
+
+}
+
+#endif  // SEQAN_INDEX_FIND2_INDEX_APPROX_H_
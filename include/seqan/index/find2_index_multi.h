@@ -177,6 +177,16 @@ struct FinderContext_<TText, TPattern, Multiple<TSpec>, TDelegate>
     {
         delegate(*this);
     }
+
+    // Called by _findBatch() for each needle found.
+    template <typename TIndexIt, typename TNeedleId>
+    inline void
+    operator()(TIndexIt & indexIt, TNeedleId needleId)
+    {
+        _textIterator(baseFinder) = indexIt;
+        _patternIt = needleId;
+        delegate(*this);
+    }
 };
 
 // ============================================================================
@@ -495,6 +505,48 @@ _find(Finder_<TText, TPattern, Multiple<TSpec> > & finder,
     }
 }
 
+// ----------------------------------------------------------------------------
+// Function _find()                                 [Finder; FMIndex; ExecHost]
+// ----------------------------------------------------------------------------
+// Exact search in a FM index interleaves the rank queries of batches of needles, see _findBatch().
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TPattern, typename TDelegate>
+inline void
+_find(Finder_<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, TPattern, Multiple<FinderSTree> > & finder,
+      TPattern & pattern,
+      TDelegate & delegate,
+      ExecHost const & /* tag */)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >                        TIndex;
+    typedef typename Needle<TPattern>::Type                                     TNeedles;
+    typedef typename Size<TNeedles>::Type                                       TSize;
+    typedef FinderContext_<TIndex, TPattern, Multiple<FinderSTree>, TDelegate>  TFinderContext;
+
+    static const TSize CHUNK_SIZE = 1024;
+
+    // Initialize the iterator factory.
+    _initFactory(finder, maxLength(needle(pattern), Parallel()) + 1, omp_get_max_threads());
+
+    TNeedles & needles = needle(pattern);
+    TSize needlesCount = length(needles);
+    __int64 chunksCount = (needlesCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // Instantiate a thread context.
+    // NOTE(esiragusa): Each thread initializes its private context on firstprivate.
+    TFinderContext ctx(finder, delegate);
+    clear(ctx.baseFinder);
+
+    // Find all needles in parallel.
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) firstprivate(ctx))
+    for (__int64 chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        TSize needlesBegin = static_cast<TSize>(chunk * CHUNK_SIZE);
+        TSize needlesEnd = std::min(static_cast<TSize>(needlesBegin + CHUNK_SIZE), needlesCount);
+
+        _findBatch(host(finder._factory), needles, needlesBegin, needlesEnd, ctx);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function _find()                                        [Finder; ExecDevice]
 // ----------------------------------------------------------------------------
@@ -160,6 +160,46 @@ _findImpl(TState & /* indexIt */,
     _findBacktracking(indexIt, needle, needleIt, errors, threshold, delegate, TDistance());
 }
 
+// ----------------------------------------------------------------------------
+// Function find(fmIndex, needles, errors, [](...){}, Backtracking<Exact>(), Parallel());
+// ----------------------------------------------------------------------------
+// The needles are searched in batches interleaving their rank queries, see _findBatch().
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TNeedle_, typename TSSetSpec,
+          typename TThreshold, typename TDelegate, typename TSpec, typename TThreading>
+inline void find(Index<TText, FMIndex<TOccSpec, TIndexSpec> > & index,
+                 StringSet<TNeedle_, TSSetSpec> const & needles,
+                 TThreshold /* threshold */,
+                 TDelegate && delegate,
+                 Backtracking<Exact, TSpec>,
+                 TThreading)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >            TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type             TIndexIt;
+    typedef StringSet<TNeedle_, TSSetSpec> const                    TNeedles;
+    typedef typename Iterator<TNeedles, Rooted>::Type               TNeedlesIt;
+    typedef typename Size<TNeedles>::Type                           TSize;
+
+    static const TSize CHUNK_SIZE = 1024;
+
+    TSize needlesCount = length(needles);
+    __int64 chunksCount = (needlesCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) if (IsSameType<TThreading, Parallel>::VALUE))
+    for (__int64 chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        TSize needlesBegin = static_cast<TSize>(chunk * CHUNK_SIZE);
+        TSize needlesEnd = std::min(static_cast<TSize>(needlesBegin + CHUNK_SIZE), needlesCount);
+
+        auto batchDelegate = [&](TIndexIt & indexIt, TSize needleId)
+        {
+            TNeedlesIt needlesIt = begin(needles, Rooted()) + needleId;
+            delegate(indexIt, needlesIt, TThreshold());
+        };
+        _findBatch(index, needles, needlesBegin, needlesEnd, batchDelegate);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function find(index, index, errors, [](...){}, Backtracking<TDistance>());
 // ----------------------------------------------------------------------------
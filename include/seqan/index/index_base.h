@@ -50,6 +50,8 @@ namespace SEQAN_NAMESPACE_MAIN
     struct LarssonSadakane;
     struct ManberMyers;
     struct SAQSort;
+    template <typename TParallel>
+    struct Sais_;
     struct QGramAlg;
 
     // inverse suffix array construction specs
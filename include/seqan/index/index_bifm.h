@@ -0,0 +1,251 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Bidirectional FM index.
+//
+// Lam TW, Li R, Tam A, Wong S, Wu E, Yiu SM.  High throughput short read
+// alignment via bi-directional BWT.  BIBM 2009, pp. 31-36.
+//
+// The index consists of two unidirectional FM indices, one built on the text
+// and one built on the reversed text.  Backward search in the index of the
+// text extends a pattern to the left, backward search in the index of the
+// reversed text extends it to the right.  The top-down iterator keeps the
+// suffix array ranges of both indices synchronized, see index_bifm_stree.h.
+// ==========================================================================
+
+#ifndef INDEX_BIFM_H_
+#define INDEX_BIFM_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+template <typename TIndexSpec = FMIndex<> >
+struct BidirectionalIndex;
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction DefaultFinder
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+struct DefaultFinder<Index<TText, BidirectionalIndex<TIndexSpec> > >
+{
+    typedef FinderSTree Type;
+};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BidirectionalIndex
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BidirectionalIndex
+ * @extends Index
+ * @headerfile <seqan/index.h>
+ * @brief A bidirectional FM index that can extend patterns to the left and to the right.
+ *
+ * @signature template <typename TText[, typename TIndexSpec]>
+ *            class Index<TText, BidirectionalIndex<TIndexSpec> >;
+ *
+ * @tparam TText      The text type. Types: @link String @endlink, @link StringSet @endlink
+ * @tparam TIndexSpec The specialization of the two underlying unidirectional indices, defaults to
+ *                    @link FMIndex @endlink&lt;&gt;.
+ *
+ * The index consists of two unidirectional indices of type <tt>Index&lt;TText, TIndexSpec&gt;</tt>.  The member
+ * <tt>rev</tt> is built on the text and is used to extend a pattern to the left, the member <tt>fwd</tt> is built on
+ * a reversed copy of the text and is used to extend a pattern to the right.  Its top-down iterator can go down in
+ * both directions, see @link BidirectionalIndex#goDown @endlink.  Occurrences are reported as positions in the
+ * original text.
+ *
+ * @see FMIndex
+ */
+
+template <typename TIndexSpec>
+struct BidirectionalIndex {};
+
+template <typename TText, typename TIndexSpec>
+class Index<TText, BidirectionalIndex<TIndexSpec> >
+{
+public:
+    // Built on the reversed text, extends patterns to the right.
+    Index<TText, TIndexSpec>    fwd;
+    // Built on the text, extends patterns to the left.
+    Index<TText, TIndexSpec>    rev;
+
+    Index() {}
+
+    Index(TText & text) :
+        rev(text)
+    {
+        getFibre(fwd, FibreText()) = text;
+        reverse(getFibre(fwd, FibreText()));
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function getFibre()
+// ----------------------------------------------------------------------------
+
+// The text fibre is the text of the unidirectional index built on the original text.
+template <typename TText, typename TIndexSpec>
+inline typename Fibre<Index<TText, BidirectionalIndex<TIndexSpec> >, FibreText>::Type &
+getFibre(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreText)
+{
+    return getFibre(index.rev, FibreText());
+}
+
+template <typename TText, typename TIndexSpec>
+inline typename Fibre<Index<TText, BidirectionalIndex<TIndexSpec> > const, FibreText>::Type &
+getFibre(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, FibreText)
+{
+    return getFibre(index.rev, FibreText());
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline void clear(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    clear(index.fwd);
+    clear(index.rev);
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool empty(Index<TText, BidirectionalIndex<TIndexSpec> > const & index)
+{
+    return empty(index.fwd) && empty(index.rev);
+}
+
+// ----------------------------------------------------------------------------
+// Function indexCreate()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TParallel>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSALF,
+                        Tag<TParallel> const & parallelTag)
+{
+    return indexCreate(index.fwd, FibreSALF(), parallelTag) &&
+           indexCreate(index.rev, FibreSALF(), parallelTag);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSALF)
+{
+    return indexCreate(index, FibreSALF(), Serial());
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexCreate(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    return indexCreate(index, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function indexSupplied()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > & index, FibreSALF const)
+{
+    return indexSupplied(index.fwd, FibreSALF()) && indexSupplied(index.rev, FibreSALF());
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool indexSupplied(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, FibreSALF const)
+{
+    return indexSupplied(index.fwd, FibreSALF()) && indexSupplied(index.rev, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function open()
+// ----------------------------------------------------------------------------
+
+// The index of the text is stored under fileName, the index of the reversed text under fileName.fwd.
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName, int openMode)
+{
+    String<char> name;
+
+    name = fileName;    append(name, ".fwd");
+    if (!open(index.fwd, toCString(name), openMode)) return false;
+
+    return open(index.rev, fileName, openMode);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool open(Index<TText, BidirectionalIndex<TIndexSpec> > & index, const char * fileName)
+{
+    return open(index, fileName, DefaultOpenMode<Index<TText, BidirectionalIndex<TIndexSpec> > >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function save()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName, int openMode)
+{
+    String<char> name;
+
+    name = fileName;    append(name, ".fwd");
+    if (!save(index.fwd, toCString(name), openMode)) return false;
+
+    return save(index.rev, fileName, openMode);
+}
+
+template <typename TText, typename TIndexSpec>
+inline bool save(Index<TText, BidirectionalIndex<TIndexSpec> > const & index, const char * fileName)
+{
+    return save(index, fileName, DefaultOpenMode<Index<TText, BidirectionalIndex<TIndexSpec> > >::VALUE);
+}
+
+}
+
+#endif  // INDEX_BIFM_H_
@@ -0,0 +1,387 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Top-down iterator of the bidirectional FM index.
+//
+// The iterator consists of one top-down iterator per unidirectional index.
+// Going down in one direction performs a backward search step in the index
+// for that direction.  The suffix array range of the other index is then
+// narrowed to the subrange of suffixes whose next character is the new one:
+// it starts after all occurrences that are followed (in the direction of the
+// extension) by the end of a sequence or by a smaller character.  Those are
+// counted on the BWT range that has just been searched.
+// ==========================================================================
+
+#ifndef INDEX_BIFM_STREE_H_
+#define INDEX_BIFM_STREE_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+/*!
+ * @defgroup BidirectionalIndexDirection Bidirectional Index Direction Tags
+ * @brief Tags to select the direction in which a @link BidirectionalIndex @endlink iterator goes down.
+ *
+ * @tag BidirectionalIndexDirection#Fwd
+ * @headerfile <seqan/index.h>
+ * @brief Extend the represented string to the right.
+ *
+ * @tag BidirectionalIndexDirection#Rev
+ * @headerfile <seqan/index.h>
+ * @brief Extend the represented string to the left.
+ */
+
+struct Fwd_;
+typedef Tag<Fwd_> Fwd;
+
+struct Rev_;
+typedef Tag<Rev_> Rev;
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class Iter                                                 [BidirectionalIndex]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+class Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > >
+{
+public:
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >       TIndex;
+    typedef typename Iterator<Index<TText, TIndexSpec>, TopDown<TSpec> >::Type  TUniIter;
+
+    TIndex const *  index;
+    TUniIter        fwdIter;
+    TUniIter        revIter;
+
+    Iter() : index() {}
+
+    Iter(TIndex & _index) :
+        index(&_index),
+        fwdIter(_index.fwd),
+        revIter(_index.rev)
+    {}
+};
+
+// NOTE: Needed to resolve the ambiguity with the generic ParentLinks iterator.
+template <typename TText, typename TIndexSpec, typename TSpec>
+class Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<ParentLinks<TSpec> > > >
+{
+public:
+    typedef Index<TText, BidirectionalIndex<TIndexSpec> >       TIndex;
+    typedef typename Iterator<Index<TText, TIndexSpec>, TopDown<ParentLinks<TSpec> > >::Type    TUniIter;
+
+    TIndex const *  index;
+    TUniIter        fwdIter;
+    TUniIter        revIter;
+
+    Iter() : index() {}
+
+    Iter(TIndex & _index) :
+        index(&_index),
+        fwdIter(_index.fwd),
+        revIter(_index.rev)
+    {}
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _indexRequireTopDownIteration()                             [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec>
+inline void _indexRequireTopDownIteration(Index<TText, BidirectionalIndex<TIndexSpec> > & index)
+{
+    indexRequire(index, FibreSALF());
+}
+
+// ----------------------------------------------------------------------------
+// Function begin()                                                     [Index]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Iterator<Index<TText, BidirectionalIndex<TIndexSpec> >, TopDown<TSpec> >::Type
+begin(Index<TText, BidirectionalIndex<TIndexSpec> > & index, TopDown<TSpec> const)
+{
+    return typename Iterator<Index<TText, BidirectionalIndex<TIndexSpec> >, TopDown<TSpec> >::Type(index);
+}
+
+// ----------------------------------------------------------------------------
+// Function container()                                              [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline Index<TText, BidirectionalIndex<TIndexSpec> > const &
+container(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return *it.index;
+}
+
+// ----------------------------------------------------------------------------
+// Function goRoot()                                                 [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline void
+goRoot(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it)
+{
+    goRoot(it.fwdIter);
+    goRoot(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function isRoot()                                                 [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool
+isRoot(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return isRoot(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function _goDownChar()                                            [Iterator]
+// ----------------------------------------------------------------------------
+
+// Performs a backward search step with c on srcIt and narrows the range of dstIt accordingly.
+template <typename TUniIter, typename TChar>
+inline bool
+_bidirectionalGoDownChar(TUniIter & srcIt, TUniIter & dstIt, TChar c)
+{
+    typedef typename Container<TUniIter>::Type                      TUniIndex;
+    typedef typename Fibre<TUniIndex, FibreLF>::Type                TLF;
+    typedef typename Value<TUniIndex>::Type                         TAlphabet;
+    typedef typename Size<TUniIndex>::Type                          TSize;
+    typedef Pair<TSize>                                             TRange;
+
+    TLF const & lf = indexLF(container(srcIt));
+    TAlphabet const cAlph = c;
+
+    TRange const srcRange = range(srcIt);
+    TRange const newSrcRange(lf(srcRange.i1, cAlph), lf(srcRange.i2, cAlph));
+
+    if (newSrcRange.i1 >= newSrcRange.i2)
+        return false;
+
+    // Count the occurrences followed by a larger character, the others are followed
+    // by a smaller character or by the end of their sequence.
+    TSize larger = 0;
+    for (unsigned ord = ordValue(cAlph) + 1; ord < ValueSize<TAlphabet>::VALUE; ++ord)
+    {
+        TAlphabet const b = ord;
+        larger += lf(srcRange.i2, b) - lf(srcRange.i1, b);
+    }
+
+    TSize const count = newSrcRange.i2 - newSrcRange.i1;
+    TSize const smaller = (srcRange.i2 - srcRange.i1) - count - larger;
+    TRange const dstRange = range(dstIt);
+
+    _historyPush(srcIt);
+    _historyPush(dstIt);
+
+    value(srcIt).range = newSrcRange;
+    value(srcIt).lastChar = cAlph;
+    value(srcIt).repLen++;
+
+    value(dstIt).range = TRange(dstRange.i1 + smaller, dstRange.i1 + smaller + count);
+    value(dstIt).lastChar = cAlph;
+    value(dstIt).repLen++;
+
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool
+_goDownChar(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it, TChar c, Fwd)
+{
+    return _bidirectionalGoDownChar(it.fwdIter, it.revIter, c);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TChar>
+inline bool
+_goDownChar(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it, TChar c, Rev)
+{
+    return _bidirectionalGoDownChar(it.revIter, it.fwdIter, c);
+}
+
+// ----------------------------------------------------------------------------
+// Function goDown()                                                 [Iterator]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BidirectionalIndex#goDown
+ * @headerfile <seqan/index.h>
+ * @brief Extends the string represented by a bidirectional index iterator to the right or to the left.
+ *
+ * @signature bool goDown(it, c[, dir]);
+ * @signature bool goDown(it, string[, dir]);
+ *
+ * @param[in,out] it     The top-down iterator of a @link BidirectionalIndex @endlink.
+ * @param[in]     c      The character to extend the represented string with.
+ * @param[in]     string The string to extend the represented string with.  It is read from left to right when
+ *                       going down to the right and from right to left when going down to the left, so that the
+ *                       new representative contains <tt>string</tt> in both cases.
+ * @param[in]     dir    The direction, @link BidirectionalIndexDirection#Fwd @endlink to append characters
+ *                       (default) or @link BidirectionalIndexDirection#Rev @endlink to prepend them.
+ *
+ * @return bool <tt>true</tt> if the extended string occurs in the text.  Otherwise the iterator is left unchanged,
+ *              or, for strings, stays at the longest extension that occurs.
+ */
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TObject, typename TDirection>
+inline bool
+goDown(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+       TObject const & c, Tag<TDirection> const dir)
+{
+    return _goDownChar(it, c, dir);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TValue, typename TStringSpec>
+inline bool
+goDown(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+       String<TValue, TStringSpec> const & string, Fwd const)
+{
+    typedef typename Iterator<String<TValue, TStringSpec> const, Standard>::Type    TStringIter;
+
+    TStringIter stringEnd = end(string, Standard());
+    for (TStringIter stringIt = begin(string, Standard()); stringIt != stringEnd; ++stringIt)
+        if (!_goDownChar(it, value(stringIt), Fwd()))
+            return false;
+
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TValue, typename TStringSpec>
+inline bool
+goDown(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it,
+       String<TValue, TStringSpec> const & string, Rev const)
+{
+    typedef typename Iterator<String<TValue, TStringSpec> const, Standard>::Type    TStringIter;
+
+    TStringIter stringBegin = begin(string, Standard());
+    for (TStringIter stringIt = end(string, Standard()); stringIt != stringBegin; --stringIt)
+        if (!_goDownChar(it, value(stringIt - 1), Rev()))
+            return false;
+
+    return true;
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec, typename TObject>
+inline bool
+goDown(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it, TObject const & obj)
+{
+    return goDown(it, obj, Fwd());
+}
+
+// ----------------------------------------------------------------------------
+// Function goUp()                                                   [Iterator]
+// ----------------------------------------------------------------------------
+
+// Undoes the last goDown() regardless of its direction.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool
+goUp(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > & it)
+{
+    return goUp(it.fwdIter) && goUp(it.revIter);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool
+goUp(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<ParentLinks<TSpec> > > > & it)
+{
+    return goUp(it.fwdIter) && goUp(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function repLength()                                              [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+repLength(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return repLength(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function parentEdgeLabel()                                        [Iterator]
+// ----------------------------------------------------------------------------
+
+// Returns the character added by the last goDown() in the given direction.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Value<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+parentEdgeLabel(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it, Fwd)
+{
+    return parentEdgeLabel(it.fwdIter);
+}
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Value<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+parentEdgeLabel(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it, Rev)
+{
+    return parentEdgeLabel(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function countOccurrences()                                       [Iterator]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Size<Index<TText, BidirectionalIndex<TIndexSpec> > >::Type
+countOccurrences(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return countOccurrences(it.revIter);
+}
+
+// ----------------------------------------------------------------------------
+// Function getOccurrences()                                         [Iterator]
+// ----------------------------------------------------------------------------
+
+// The occurrences are taken from the index of the original text.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline typename Infix<typename Fibre<Index<TText, TIndexSpec>, FibreSA>::Type const>::Type
+getOccurrences(Iter<Index<TText, BidirectionalIndex<TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it)
+{
+    return getOccurrences(it.revIter);
+}
+
+}
+
+#endif  // INDEX_BIFM_STREE_H_
@@ -317,6 +317,7 @@ assign(Index<TText, FMIndex<TSpec, TConfig> > & index, Index<TText2, FMIndex<TOc
     assign(indexText(index), indexText(source));
     assign(indexLF(index), indexLF(source));
     assign(indexSA(index), indexSA(source));
+    assign(getFibre(index, FibreKmers()), getFibre(source, FibreKmers()));
 
     // Set the pointer.
     setFibre(indexSA(index), indexLF(index), FibreLF());
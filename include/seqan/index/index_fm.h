@@ -73,6 +73,13 @@ namespace seqan {
  * @brief The <tt>TSentinelsSpec</tt> determines the type of the sentinels in the @link FMIndex @endlink.  In the
  *        default @link FMIndexConfig @endlink object the type of <tt>TSentinelsSpec</tt> is a two level
  *        @link RankDictionary @endlink.
+ *
+ * @var unsigned FMIndexConfig::KMER_LENGTH;
+ * @brief The length of the k-mers whose suffix array ranges are precomputed in the @link FMIndexFibres#FibreKmers
+ *        @endlink table.  The top-down iterator uses the table to skip the first <tt>KMER_LENGTH</tt> backward
+ *        search steps of a pattern.  The table holds <tt>|Σ|^KMER_LENGTH</tt> ranges, zero disables it.  Configs that
+ *        do not declare <tt>KMER_LENGTH</tt> have no table.  A last entry ties the table to its index, a saved table
+ *        that does not match the index it is opened with is ignored.
  */
 template <typename TSpec = void, typename TLengthSum = size_t>
 struct FMIndexConfig
@@ -82,6 +89,7 @@ struct FMIndexConfig
     typedef Levels<TSpec, LevelsRDConfig<LengthSum> >   Sentinels;
 
     static const unsigned SAMPLING =                    10;
+    static const unsigned KMER_LENGTH =                 0;
 };
 
 // ============================================================================
@@ -99,10 +107,12 @@ class FMIndex;
 struct FibreTempSA_;
 struct FibreLF_;
 struct FibreSALF_;
+struct FibreKmers_;
 
 typedef Tag<FibreTempSA_> const         FibreTempSA;
 typedef Tag<FibreLF_> const             FibreLF;
 typedef Tag<FibreSALF_> const           FibreSALF;
+typedef Tag<FibreKmers_> const          FibreKmers;
 
 // ============================================================================
 // Metafunctions
@@ -129,6 +139,10 @@ typedef Tag<FibreSALF_> const           FibreSALF;
  *
  * @tag FMIndexFibres#FibreLF
  * @brief The lf table.
+ *
+ * @tag FMIndexFibres#FibreKmers
+ * @brief The suffix array ranges of all k-mers, see @link FMIndexConfig::KMER_LENGTH @endlink.  The table is built
+ *        from the SA and LF fibres by <tt>indexCreate(index)</tt> or <tt>indexCreate(index, FibreKmers())</tt>.
  */
 
 
@@ -158,6 +172,47 @@ struct Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreTempSA>
 #endif
 };
 
+template <typename TText, typename TSpec, typename TConfig>
+struct Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreKmers>
+{
+    typedef Index<TText, FMIndex<TSpec, TConfig> >          TIndex_;
+    typedef Pair<typename Size<TIndex_>::Type>              TRange_;
+
+    typedef String<TRange_, typename DefaultIndexStringSpec<TText>::Type>   Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction FMIndexKmerLength_
+// ----------------------------------------------------------------------------
+// The KMER_LENGTH of an FMIndex config, 0 if the config does not declare it.
+
+template <typename TConfig>
+struct HasKmerLength_
+{
+    template <unsigned KMER_LENGTH>
+    struct Value_ {};
+
+    template <typename T>
+    static char _test(Value_<T::KMER_LENGTH> *);
+
+    template <typename T>
+    static long _test(...);
+
+    static const bool VALUE = sizeof(_test<TConfig>(0)) == sizeof(char);
+};
+
+template <typename TConfig, bool HAS_KMER_LENGTH = HasKmerLength_<TConfig>::VALUE>
+struct FMIndexKmerLength_
+{
+    static const unsigned VALUE = 0;
+};
+
+template <typename TConfig>
+struct FMIndexKmerLength_<TConfig, true>
+{
+    static const unsigned VALUE = TConfig::KMER_LENGTH;
+};
+
 // ----------------------------------------------------------------------------
 // Metafunction DefaultFinder
 // ----------------------------------------------------------------------------
@@ -203,6 +258,7 @@ public:
     typename Member<Index, FibreText>::Type         text;
     typename Fibre<Index, FibreLF>::Type            lf;
     typename Fibre<Index, FibreSA>::Type            sa;
+    typename Fibre<Index, FibreKmers>::Type         kmers;
 
     Index() {};
 
@@ -226,6 +282,7 @@ inline void clear(Index<TText, FMIndex<TSpec, TConfig> > & index)
     clear(getFibre(index, FibreText()));
     clear(getFibre(index, FibreLF()));
     clear(getFibre(index, FibreSA()));
+    clear(getFibre(index, FibreKmers()));
 }
 
 // ----------------------------------------------------------------------------
@@ -259,6 +316,20 @@ getFibre(Index<TText, FMIndex<TSpec, TConfig> > const & index, FibreLF /*tag*/)
     return index.lf;
 }
 
+template <typename TText, typename TSpec, typename TConfig>
+SEQAN_HOST_DEVICE inline typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreKmers>::Type &
+getFibre(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreKmers /*tag*/)
+{
+    return index.kmers;
+}
+
+template <typename TText, typename TSpec, typename TConfig>
+SEQAN_HOST_DEVICE inline typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreKmers>::Type const &
+getFibre(Index<TText, FMIndex<TSpec, TConfig> > const & index, FibreKmers /*tag*/)
+{
+    return index.kmers;
+}
+
 // ----------------------------------------------------------------------------
 // Function indexLF()
 // ----------------------------------------------------------------------------
@@ -359,16 +430,158 @@ _findFirstIndex(Finder<Index<TText, FMIndex<TSpec, TConfig> >, TSpecFinder> & fi
     }
 }
 
+// ----------------------------------------------------------------------------
+// Function _kmersStamp()
+// ----------------------------------------------------------------------------
+// Returns the last entry of the k-mer table, which ties the table to the SA and LF fibres it was computed from: the
+// length of the suffix array and a fingerprint of the prefix sums and of a fixed number of evenly spaced sampled SA
+// values and BWT entries.  Texts of the same length and composition, e.g. with reordered contigs, differ in their
+// sampled SA values.  The stamp is checked on each open() and thus must not touch more than a few pages of the fibres.
+
+template <typename TText, typename TSpec, typename TConfig>
+inline typename Value<typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreKmers>::Type>::Type
+_kmersStamp(Index<TText, FMIndex<TSpec, TConfig> > const & index)
+{
+    typedef Index<TText, FMIndex<TSpec, TConfig> >          TIndex;
+    typedef typename Fibre<TIndex, FibreSA>::Type           TSA;
+    typedef typename Fibre<TSA, FibreSparseString>::Type    TSparseSA;
+    typedef typename Fibre<TSparseSA, FibreValues>::Type    TSAValues;
+    typedef typename Size<TSAValues>::Type                  TSAValuesSize;
+    typedef typename Fibre<TIndex, FibreLF>::Type           TLF;
+    typedef typename Fibre<TLF, FibrePrefixSums>::Type      TPrefixSums;
+    typedef typename Size<TPrefixSums>::Type                TPrefixSumsSize;
+    typedef typename Fibre<TLF, FibreBwt>::Type             TBwt;
+    typedef typename Size<TSA>::Type                        TSASize;
+    typedef typename Fibre<TIndex, FibreKmers>::Type        TKmers;
+    typedef typename Value<TKmers>::Type                    TRange;
+    typedef typename Value<TRange, 2>::Type                 TSize;
+
+    static const __uint64 PRIME = 1000003u;
+    static const unsigned SAMPLES = 64u;
+
+    TPrefixSums const & sums = getFibre(getFibre(index, FibreLF()), FibrePrefixSums());
+    TBwt const & bwt = getFibre(getFibre(index, FibreLF()), FibreBwt());
+    TSAValues const & saValues = getFibre(getFibre(getFibre(index, FibreSA()), FibreSparseString()), FibreValues());
+
+    __uint64 fingerprint = 0;
+    for (TPrefixSumsSize i = 0; i < length(sums); ++i)
+        fingerprint = fingerprint * PRIME + getValue(sums, i);
+
+    TSAValuesSize saValuesLength = length(saValues);
+    for (unsigned k = 0; k < SAMPLES && k < saValuesLength; ++k)
+    {
+        TSAValuesSize i = static_cast<TSAValuesSize>(static_cast<__uint64>(saValuesLength) * k / SAMPLES);
+        fingerprint = fingerprint * PRIME + getSeqNo(getValue(saValues, i));
+        fingerprint = fingerprint * PRIME + getSeqOffset(getValue(saValues, i));
+    }
+
+    // The BWT has as many entries as the suffix array, a rank dictionary opened from disk does not know its length.
+    TSASize saLength = length(getFibre(index, FibreSA()));
+    for (unsigned k = 0; k < SAMPLES && k < saLength; ++k)
+    {
+        TSASize i = static_cast<TSASize>(static_cast<__uint64>(saLength) * k / SAMPLES);
+        fingerprint = fingerprint * PRIME + ordValue(getValue(bwt, i));
+    }
+
+    return TRange(saLength, static_cast<TSize>(fingerprint ^ (fingerprint >> 32)));
+}
+
+// ----------------------------------------------------------------------------
+// Function _createKmers()
+// ----------------------------------------------------------------------------
+// Stores the range of each k-mer below the node of the iterator, which spells a (depth)-mer with the given code.
+// Children not occurring in the text are skipped and their k-mers keep the empty range.
+
+template <typename TKmers, typename TIter, typename TCode>
+inline void _createKmers(TKmers & kmers, TIter const & it, TCode code, unsigned depth, unsigned kmerLength)
+{
+    typedef typename Container<TIter>::Type                 TIndex;
+    typedef typename Value<TIndex>::Type                    TAlphabet;
+
+    static const unsigned SIGMA = ValueSize<TAlphabet>::VALUE;
+
+    if (depth == kmerLength)
+    {
+        kmers[code] = value(it).range;
+        return;
+    }
+
+    for (unsigned c = 0; c < SIGMA; ++c)
+    {
+        TIter child = it;
+        if (_goDownChar(child, TAlphabet(c)))
+            _createKmers(kmers, child, code * SIGMA + c, depth + 1, kmerLength);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function indexCreate()
 // ----------------------------------------------------------------------------
 
+// Creates the k-mer table from the LF table.
+template <typename TText, typename TSpec, typename TConfig, typename TParallel>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreKmers, Tag<TParallel> const & /* tag */)
+{
+    typedef Index<TText, FMIndex<TSpec, TConfig> >          TIndex;
+    typedef typename Fibre<TIndex, FibreKmers>::Type        TKmers;
+    typedef typename Value<TKmers>::Type                    TRange;
+    typedef typename Value<TIndex>::Type                    TAlphabet;
+    typedef typename Iterator<TIndex, TopDown<> >::Type     TIter;
+
+    static const unsigned SIGMA = ValueSize<TAlphabet>::VALUE;
+    static const unsigned KMER_LENGTH = FMIndexKmerLength_<TConfig>::VALUE;
+
+    TKmers & kmers = getFibre(index, FibreKmers());
+
+    clear(kmers);
+
+    if (KMER_LENGTH == 0 || empty(indexLF(index))) return KMER_LENGTH == 0;
+
+    resize(kmers, Power<SIGMA, KMER_LENGTH>::VALUE + 1, TRange(0, 0), Exact());
+
+    // Each thread fills the k-mers starting with one symbol.
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (int c = 0; c < (int)SIGMA; ++c)
+    {
+        TIter it(index);
+        if (_goDownChar(it, TAlphabet(c)))
+            _createKmers(kmers, it, (__uint64)c, 1u, KMER_LENGTH);
+    }
+
+    back(kmers) = _kmersStamp(index);
+
+    return true;
+}
+
 template <typename TText, typename TSpec, typename TConfig>
-inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF)
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreKmers)
+{
+    return indexCreate(index, FibreKmers(), Serial());
+}
+
+// Creates the LF table from the full suffix array and shares it with the compressed SA.
+template <typename TText, typename TSpec, typename TConfig, typename TSA, typename TParallel>
+inline void _indexCreateLF(Index<TText, FMIndex<TSpec, TConfig> > & index, TSA const & sa,
+                           Tag<TParallel> const & parallelTag)
+{
+    createLF(indexLF(index), indexText(index), sa, parallelTag);
+    setFibre(indexSA(index), indexLF(index), FibreLF());
+}
+
+// Samples the compressed SA from the full suffix array.
+template <typename TText, typename TSpec, typename TConfig, typename TSA, typename TParallel>
+inline void _indexCreateCompressedSA(Index<TText, FMIndex<TSpec, TConfig> > & index, TSA const & sa,
+                                     Tag<TParallel> const & parallelTag)
+{
+    createCompressedSa(indexSA(index), sa, countSequences(indexText(index)), parallelTag);
+}
+
+// The full suffix array is built with Skew7 in an external string, the parallel tag applies to the steps after it.
+template <typename TText, typename TSpec, typename TConfig, typename TParallel>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF, Tag<TParallel> const & parallelTag)
 {
     typedef Index<TText, FMIndex<TSpec, TConfig> >      TIndex;
     typedef typename Fibre<TIndex, FibreTempSA>::Type   TTempSA;
-    typedef typename Size<TIndex>::Type                 TSize;
 
     TText const & text = indexText(index);
 
@@ -381,17 +594,23 @@ inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSAL
     resize(tempSA, lengthSum(text), Exact());
     createSuffixArray(tempSA, text, Skew7());
 
-    // Create the LF table.
-    createLF(indexLF(index), text, tempSA);
+    // Create the LF table and the compressed SA.
+    _indexCreateLF(index, tempSA, parallelTag);
+    _indexCreateCompressedSA(index, tempSA, parallelTag);
 
-    // Set the FMIndex LF as the CompressedSA LF.
-    setFibre(indexSA(index), indexLF(index), FibreLF());
+    return true;
+}
 
-    // Create the compressed SA.
-    TSize numSentinel = countSequences(text);
-    createCompressedSa(indexSA(index), tempSA, numSentinel);
+template <typename TText, typename TSpec, typename TConfig>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSALF)
+{
+    return indexCreate(index, FibreSALF(), Serial());
+}
 
-    return true;
+template <typename TText, typename TSpec, typename TConfig, typename TParallel>
+inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSA, Tag<TParallel> const & parallelTag)
+{
+    return indexCreate(index, FibreSALF(), parallelTag);
 }
 
 template <typename TText, typename TSpec, typename TConfig>
@@ -400,10 +619,11 @@ inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index, FibreSA)
     return indexCreate(index, FibreSALF());
 }
 
+// Creates all fibres, the k-mer table after the SA and LF fibres it is computed from.
 template <typename TText, typename TSpec, typename TConfig>
 inline bool indexCreate(Index<TText, FMIndex<TSpec, TConfig> > & index)
 {
-    return indexCreate(index, FibreSALF());
+    return indexCreate(index, FibreSALF()) && indexCreate(index, FibreKmers());
 }
 
 // ----------------------------------------------------------------------------
@@ -422,11 +642,81 @@ SEQAN_HOST_DEVICE inline bool indexSupplied(Index<TText, FMIndex<TSpec, TConfig>
     return !(empty(getFibre(index, FibreSA())) || empty(getFibre(index, FibreLF())));
 }
 
+// ----------------------------------------------------------------------------
+// Function _dropKmers()
+// ----------------------------------------------------------------------------
+// Empties a k-mer table rejected by _openKmers().  A memory mapped table is closed rather than cleared, as clearing
+// would truncate the file, which fails on indices opened with OPEN_RDONLY.
+
+template <typename TKmers>
+inline void _dropKmers(TKmers & kmers)
+{
+    clear(kmers);
+}
+
+template <typename TValue, typename TConfig>
+inline void _dropKmers(String<TValue, MMap<TConfig> > & kmers)
+{
+    close(kmers);
+}
+
+// ----------------------------------------------------------------------------
+// Function _openKmers()
+// ----------------------------------------------------------------------------
+// Opens the optional k-mer table.  A missing table is left empty, as is a table without one range per k-mer, e.g. written
+// for another alphabet or k-mer length, which would be indexed out of bounds, and a table computed for another index.
+
+template <typename TText, typename TSpec, typename TConfig>
+inline bool _openKmers(Index<TText, FMIndex<TSpec, TConfig> > & index, const char * fileName, int openMode)
+{
+    typedef typename Value<Index<TText, FMIndex<TSpec, TConfig> > >::Type   TAlphabet;
+
+    static const unsigned KMER_LENGTH = FMIndexKmerLength_<TConfig>::VALUE;
+    static const __uint64 KMERS_COUNT = Power<ValueSize<TAlphabet>::VALUE, KMER_LENGTH>::VALUE;
+
+    if (KMER_LENGTH == 0) return true;
+
+    String<char> name;
+    name = fileName;    append(name, ".kmer");
+    if (!open(getFibre(index, FibreKmers()), toCString(name), (openMode & ~OPEN_CREATE) | OPEN_QUIET))
+    {
+        clear(getFibre(index, FibreKmers()));
+        return true;
+    }
+
+    // A table of the wrong size or of another index is dropped, the index is then searched without it.
+    if ((__uint64)length(getFibre(index, FibreKmers())) != KMERS_COUNT + 1 ||
+        back(getFibre(index, FibreKmers())) != _kmersStamp(index))
+        _dropKmers(getFibre(index, FibreKmers()));
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _saveKmers()
+// ----------------------------------------------------------------------------
+// Saves the optional k-mer table.  Without a table, the table of an index previously saved under the same name is
+// removed, otherwise open() would pick it up.
+
+template <typename TText, typename TSpec, typename TConfig>
+inline bool _saveKmers(Index<TText, FMIndex<TSpec, TConfig> > const & index, const char * fileName, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".kmer");
+
+    if (empty(getFibre(index, FibreKmers())))
+        return !fileExists(toCString(name)) || fileUnlink(toCString(name));
+
+    return save(getFibre(index, FibreKmers()), toCString(name), openMode);
+}
+
 // ----------------------------------------------------------------------------
 // Function open()
 // ----------------------------------------------------------------------------
 
 // This function can be used to open a previously saved index.
+// Fibres whose string spec is MMap<> are mapped rather than read; opened with OPEN_RDONLY, the mapping is shared
+// among all processes opening the same index.
 template <typename TText, typename TSpec, typename TConfig>
 inline bool open(Index<TText, FMIndex<TSpec, TConfig> > & index, const char * fileName, int openMode)
 {
@@ -443,7 +733,8 @@ inline bool open(Index<TText, FMIndex<TSpec, TConfig> > & index, const char * fi
 
     setFibre(getFibre(index, FibreSA()), getFibre(index, FibreLF()), FibreLF());
 
-    return true;
+    // The k-mer table is optional, an index saved without it is searched from the root.
+    return _openKmers(index, fileName, openMode);
 }
 
 // This function can be used to open a previously saved index.
@@ -471,7 +762,7 @@ inline bool save(Index<TText, FMIndex<TSpec, TConfig> > const & index, const cha
     name = fileName;    append(name, ".lf");
     if (!save(getFibre(index, FibreLF()), toCString(name), openMode)) return false;
 
-    return true;
+    return _saveKmers(index, fileName, openMode);
 }
 
 // This function can be used to save an index on disk.
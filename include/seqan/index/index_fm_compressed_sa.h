@@ -278,6 +278,8 @@ SEQAN_HOST_DEVICE inline bool empty(CompressedSA<TText, TSpec, TConfig> & compre
  *                               UnsignedIntegerConcept @endlink
  * @param[in] offset             The offset determines how many empty values should be inserted into the compressed suffix array at the
  *                               beginning. This possibility accounts for the sentinel positions of the @link FMIndex @endlink.
+ * @param[in] parallelTag        Tag to enable/disable parallelism, one of <tt>Serial</tt>, <tt>Parallel</tt>, default is
+ *                               <tt>Serial</tt>.
  */
 
 template <typename TText, typename TSpec, typename TConfig, typename TSA, typename TSize>
@@ -331,6 +333,80 @@ void createCompressedSa(CompressedSA<TText, TSpec, TConfig> & compressedSA, TSA
     createCompressedSa(compressedSA, sa, 0);
 }
 
+template <typename TText, typename TSpec, typename TConfig, typename TSA, typename TSize>
+inline void
+createCompressedSa(CompressedSA<TText, TSpec, TConfig> & compressedSA, TSA const & sa, TSize offset,
+                   Serial const & /* tag */)
+{
+    createCompressedSa(compressedSA, sa, offset);
+}
+
+// Reading an External string modifies its shared page cache, so an external suffix array is sampled serially.
+template <typename TText, typename TSpec, typename TConfig, typename TSAValue, typename TSAConfig, typename TSize>
+inline void
+createCompressedSa(CompressedSA<TText, TSpec, TConfig> & compressedSA,
+                   String<TSAValue, External<TSAConfig> > const & sa, TSize offset, Parallel const & /* tag */)
+{
+    createCompressedSa(compressedSA, sa, offset);
+}
+
+// The sampled positions are first marked in a bit string.  The threads process ranges of whole words, then each thread
+// copies the sampled values of its range to the position given by the rank of the range begin.
+template <typename TText, typename TSpec, typename TConfig, typename TSA, typename TSize>
+void createCompressedSa(CompressedSA<TText, TSpec, TConfig> & compressedSA, TSA const & sa, TSize offset,
+                        Parallel const & /* tag */)
+{
+    typedef CompressedSA<TText, TSpec, TConfig>                     TCompressedSA;
+    typedef typename Size<TSA>::Type                                TSASize;
+    typedef typename Fibre<TCompressedSA, FibreSparseString>::Type  TSparseSA;
+    typedef typename Fibre<TSparseSA, FibreIndicators>::Type        TIndicators;
+    typedef typename Fibre<TSparseSA, FibreValues>::Type            TValues;
+    typedef String<bool, Packed<> >                                 TSampled;
+
+    TSparseSA & sparseString = getFibre(compressedSA, FibreSparseString());
+    TIndicators & indicators = getFibre(sparseString, FibreIndicators());
+    TValues & values = getFibre(sparseString, FibreValues());
+
+    TSASize saLen = length(sa);
+    TSASize csaLen = saLen + offset;
+    TSASize const VALUES_PER_WORD = PackedTraits_<TSampled>::VALUES_PER_HOST_VALUE;
+    resize(compressedSA, csaLen, Exact());
+
+    TSampled sampled;
+    resize(sampled, csaLen, Exact());
+
+    Splitter<TSASize> wordSplitter(0, (csaLen + VALUES_PER_WORD - 1) / VALUES_PER_WORD, Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(wordSplitter); ++job)
+    {
+        TSASize beginPos = wordSplitter[job] * VALUES_PER_WORD;
+        TSASize endPos = std::min(static_cast<TSASize>(wordSplitter[job + 1] * VALUES_PER_WORD), csaLen);
+
+        for (TSASize pos = beginPos; pos < endPos; ++pos)
+            assignValue(sampled, pos, pos >= static_cast<TSASize>(offset) &&
+                                      getSeqOffset(getValue(sa, pos - offset)) % TConfig::SAMPLING == 0);
+    }
+
+    createRankDictionary(indicators, sampled, Parallel());
+    clear(sampled);
+    shrinkToFit(sampled);
+
+    resize(values, getRank(indicators, length(sparseString) - 1), Exact());
+
+    Splitter<TSASize> splitter(offset, csaLen, Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        TSASize counter = (splitter[job] == 0) ? 0 : getRank(indicators, splitter[job] - 1);
+
+        for (TSASize pos = splitter[job]; pos < splitter[job + 1]; ++pos)
+            if (getValue(indicators, pos))
+                assignValue(values, counter++, getValue(sa, pos - offset));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function getFibre()
 // ----------------------------------------------------------------------------
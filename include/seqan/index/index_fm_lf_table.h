@@ -167,6 +167,23 @@ struct Fibre<LF<TText, TSpec, TConfig>, FibreTempBwt>
     typedef String<TValue_, External<ExternalConfigLarge<> > >      Type;
 };
 
+// ----------------------------------------------------------------------------
+// Metafunction SAScanTag_
+// ----------------------------------------------------------------------------
+// Reading an External string modifies its shared page cache, so an external suffix array is always scanned serially.
+
+template <typename TSA, typename TParallel>
+struct SAScanTag_
+{
+    typedef TParallel Type;
+};
+
+template <typename TValue, typename TConfig, typename TParallel>
+struct SAScanTag_<String<TValue, External<TConfig> >, TParallel>
+{
+    typedef Serial Type;
+};
+
 // ============================================================================
 // Classes
 // ============================================================================
@@ -453,6 +470,39 @@ _getBwtRank(LF<TText, TSpec, TConfig> const & lf, TPos pos, TValue val)
     return rank;
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchSentinelsRank()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchSentinelsRank(LF<TText, TSpec, TConfig> const & /* lf */, TPos /* pos */) {}
+
+template <typename TText, typename TSSetSpec, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchSentinelsRank(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> const & lf, TPos pos)
+{
+    _prefetchRank(lf.sentinels, pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchBwtRank()
+// ----------------------------------------------------------------------------
+// Prefetches the rank dictionary entries read by _getBwtRank(pos, val).
+
+template <typename TText, typename TSpec, typename TConfig, typename TPos, typename TValue>
+SEQAN_HOST_DEVICE inline void
+_prefetchBwtRank(LF<TText, TSpec, TConfig> const & lf, TPos pos, TValue val)
+{
+    if (pos > 0)
+    {
+        _prefetchRank(lf.bwt, pos - 1);
+
+        if (ordEqual(lf.sentinelSubstitute, val))
+            _prefetchSentinelsRank(lf, pos - 1);
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function _getBwtRank(pos)
 // ----------------------------------------------------------------------------
@@ -584,6 +634,151 @@ _createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOt
     updateRanks(lf.sentinels);
 }
 
+// ----------------------------------------------------------------------------
+// Function _createBwt()                                        [Serial/Parallel]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<TText, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa, Serial const & /* tag */)
+{
+    _createBwt(lf, bwt, text, sa);
+}
+
+// The bwt must be an in-memory string whose values can be written concurrently.
+template <typename TText, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<TText, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa,
+           Parallel const & /* tag */)
+{
+    typedef typename GetValue<TSA>::Type                    TSAValue;
+    typedef typename Size<TSA>::Type                        TSize;
+
+    assignValue(bwt, 0, back(text));
+
+    Splitter<TSize> splitter(0, length(sa), Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        for (TSize i = splitter[job]; i < splitter[job + 1]; ++i)
+        {
+            TSAValue pos = getValue(sa, i);
+
+            if (pos != 0)
+            {
+                assignValue(bwt, i + 1, getValue(text, pos - 1));
+            }
+            else
+            {
+                assignValue(bwt, i + 1, lf.sentinelSubstitute);
+                lf.sentinels = i + 1;
+            }
+        }
+    }
+}
+
+// The sentinel flags are first collected in a bit string.  The threads process ranges of whole words.
+template <typename TText, typename TSSetSpec, typename TSpec, typename TConfig, typename TBwt, typename TOtherText, typename TSA>
+inline void
+_createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOtherText const & text, TSA const & sa,
+           Parallel const & /* tag */)
+{
+    typedef typename Value<TSA>::Type                       TSAValue;
+    typedef typename Size<TSA>::Type                        TSize;
+    typedef String<bool, Packed<> >                         TSentinels;
+
+    TSize seqNum = countSequences(text);
+    TSize bwtLen = seqNum + lengthSum(text);
+    TSize const VALUES_PER_WORD = PackedTraits_<TSentinels>::VALUES_PER_HOST_VALUE;
+
+    TSentinels sentinels;
+    resize(sentinels, bwtLen, Exact());
+
+    // Fill the sentinel positions (they are all at the beginning of the bwt).
+    for (TSize i = 0; i < seqNum; ++i)
+    {
+        assignValue(bwt, i, back(text[seqNum - i - 1]));
+        assignValue(sentinels, i, false);
+    }
+
+    // Compute the rest of the bwt.
+    Splitter<TSize> splitter(0, (bwtLen + VALUES_PER_WORD - 1) / VALUES_PER_WORD, Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        TSize beginPos = std::max(static_cast<TSize>(splitter[job] * VALUES_PER_WORD), seqNum);
+        TSize endPos = std::min(static_cast<TSize>(splitter[job + 1] * VALUES_PER_WORD), bwtLen);
+
+        for (TSize i = beginPos; i < endPos; ++i)
+        {
+            TSAValue pos;    // = SA[i - seqNum];
+            posLocalize(pos, getValue(sa, i - seqNum), stringSetLimits(text));
+
+            if (getSeqOffset(pos) != 0)
+            {
+                assignValue(bwt, i, getValue(getValue(text, getSeqNo(pos)), getSeqOffset(pos) - 1));
+                assignValue(sentinels, i, false);
+            }
+            else
+            {
+                assignValue(bwt, i, lf.sentinelSubstitute);
+                assignValue(sentinels, i, true);
+            }
+        }
+    }
+
+    // Index the sentinel positions for rank queries.
+    createRankDictionary(lf.sentinels, sentinels, Parallel());
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefixSums()                                       [Serial/Parallel]
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TPrefixSums, typename TText>
+inline void _prefixSums(TPrefixSums & sums, TText const & text, Serial const & /* tag */)
+{
+    prefixSums<TValue>(sums, text);
+}
+
+// Each thread counts the symbols of a part of the concatenated text.
+template <typename TValue, typename TPrefixSums, typename TText>
+inline void _prefixSums(TPrefixSums & sums, TText const & text, Parallel const & /* tag */)
+{
+    typedef typename Concatenator<TText const>::Type        TConcat;
+    typedef typename Iterator<TConcat, Standard>::Type      TIter;
+    typedef typename Size<TConcat>::Type                    TSize;
+    typedef String<typename Value<TPrefixSums>::Type>       TLocalSums;
+
+    TConcat const & concatText = concat(text);
+
+    Splitter<TSize> splitter(0, length(concatText), Parallel());
+    String<TLocalSums> localSums;
+    resize(localSums, length(splitter), Exact());
+
+    // Compute symbol frequencies.
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        resize(localSums[job], ValueSize<TValue>::VALUE + 1, 0, Exact());
+
+        TIter it = begin(concatText, Standard()) + splitter[job];
+        TIter itEnd = begin(concatText, Standard()) + splitter[job + 1];
+        for (; it != itEnd; goNext(it))
+            localSums[job][ordValue(static_cast<TValue>(value(it))) + 1]++;
+    }
+
+    resize(sums, ValueSize<TValue>::VALUE + 1, 0, Exact());
+    for (TSize job = 0; job < length(localSums); ++job)
+        for (TSize c = 0; c < length(sums); ++c)
+            sums[c] += localSums[job][c];
+
+    // Cumulate symbol frequencies.
+    partialSum(sums);
+}
+
 // ----------------------------------------------------------------------------
 // Function createLF()
 // ----------------------------------------------------------------------------
@@ -594,29 +789,35 @@ _createBwt(LF<StringSet<TText, TSSetSpec>, TSpec, TConfig> & lf, TBwt & bwt, TOt
  *
  * @brief Creates the LF table
  *
- * @signature void createLF(lfTable, text, sa);
+ * @signature void createLF(lfTable, text, sa[, parallelTag]);
  *
- * @param[out] lfTable The LF table to be constructed.
- * @param[in]  text    The underlying text Types: @link String @endlink.
- * @param[in]  sa      The suffix array of the LF table underlying text. Types: @link String @endlink,
- *                     @link StringSet @endlink.
+ * @param[out] lfTable     The LF table to be constructed.
+ * @param[in]  text        The underlying text Types: @link String @endlink.
+ * @param[in]  sa          The suffix array of the LF table underlying text. Types: @link String @endlink,
+ *                         @link StringSet @endlink.
+ * @param[in]  parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt>, <tt>Parallel</tt>, default is
+ *                         <tt>Serial</tt>.  The parallel construction keeps the temporary bwt in main memory.  An
+ *                         External suffix array is always read serially.
  *
  * @return TReturn Returns a <tt>bool</tt> which is <tt>true</tt> on successes and <tt>false</tt> otherwise.
  */
 // This function creates all table of the lf table given a text and a suffix array.
-template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
-inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa)
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA, typename TParallel>
+inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa,
+                     Tag<TParallel> const & parallelTag)
 {
     typedef LF<TText, TSpec, TConfig>                          TLF;
-    typedef typename Fibre<TLF, FibreTempBwt>::Type            TBwt;
     typedef typename Value<TLF>::Type                          TValue;
     typedef typename Size<TLF>::Type                           TSize;
+    typedef typename If<IsSameType<Tag<TParallel>, Serial>,
+                        typename Fibre<TLF, FibreTempBwt>::Type,
+                        String<TValue> >::Type                 TBwt;
 
     // Clear assuming undefined state.
     clear(lf);
 
     // Compute prefix sum.
-    prefixSums<TValue>(lf.sums, text);
+    _prefixSums<TValue>(lf.sums, text, parallelTag);
 
     // Choose the sentinel substitute.
     _setSentinelSubstitute(lf);
@@ -624,10 +825,10 @@ inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TS
     // Create BWT and mark sentinels.
     TBwt bwt;
     resize(bwt, bwtLength(text), Exact());
-    _createBwt(lf, bwt, text, sa);
+    _createBwt(lf, bwt, text, sa, typename SAScanTag_<TSA, Tag<TParallel> const>::Type());
 
     // Index BWT bwt for rank queries.
-    createRankDictionary(lf.bwt, bwt);
+    createRankDictionary(lf.bwt, bwt, parallelTag);
 
     // Add sentinels to prefix sum.
     TSize sentinelsCount = countSequences(text);
@@ -635,6 +836,12 @@ inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TS
         lf.sums[i] += sentinelsCount;
 }
 
+template <typename TText, typename TSpec, typename TConfig, typename TOtherText, typename TSA>
+inline void createLF(LF<TText, TSpec, TConfig> & lf, TOtherText const & text, TSA const & sa)
+{
+    createLF(lf, text, sa, Serial());
+}
+
 // ----------------------------------------------------------------------------
 // Function open()
 // ----------------------------------------------------------------------------
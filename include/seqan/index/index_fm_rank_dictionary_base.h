@@ -218,10 +218,12 @@ SEQAN_HOST_DEVICE inline bool empty(RankDictionary<TValue, TSpec> const & dict)
  * @headerfile <seqan/index.h>
  * @brief This functions creates the dictionary.
  *
- * @signature void createRankDictionary(dictionary, text);
+ * @signature void createRankDictionary(dictionary, text[, parallelTag]);
  *
- * @param[in]  text       A text to be transfered into a rank dictionary. Types: @link ContainerConcept @endlink
- * @param[out] dictionary The dictionary.
+ * @param[in]  text        A text to be transfered into a rank dictionary. Types: @link ContainerConcept @endlink
+ * @param[out] dictionary  The dictionary.
+ * @param[in]  parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt>, <tt>Parallel</tt>, default is
+ *                         <tt>Serial</tt>.  The text must provide random access.
  */
 
 template <typename TValue, typename TSpec, typename TText>
@@ -243,6 +245,14 @@ createRankDictionary(RankDictionary<TValue, TSpec> & dict, TText const & text)
     updateRanks(dict);
 }
 
+// The generic rank dictionaries are created sequentially.
+template <typename TValue, typename TSpec, typename TText, typename TParallel>
+inline void
+createRankDictionary(RankDictionary<TValue, TSpec> & dict, TText const & text, Tag<TParallel> const & /* tag */)
+{
+    createRankDictionary(dict, text);
+}
+
 // ----------------------------------------------------------------------------
 // Function getRank()
 // ----------------------------------------------------------------------------
@@ -262,6 +272,34 @@ createRankDictionary(RankDictionary<TValue, TSpec> & dict, TText const & text)
  */
 
 
+// ----------------------------------------------------------------------------
+// Function _prefetchCacheLine()
+// ----------------------------------------------------------------------------
+// Hints the processor to load the cache line containing the given address.
+
+template <typename TValue>
+SEQAN_HOST_DEVICE inline void
+_prefetchCacheLine(TValue const * ptr)
+{
+#if defined(__CUDA_ARCH__)
+    ignoreUnusedVariableWarning(ptr);
+#elif defined(PLATFORM_WINDOWS_VS)
+    _mm_prefetch(reinterpret_cast<char const *>(ptr), _MM_HINT_T0);
+#else
+    __builtin_prefetch(ptr);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+// Prefetches the entries read by getRank(dict, pos).  It does nothing by default.
+
+template <typename TValue, typename TSpec, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchRank(RankDictionary<TValue, TSpec> const & /* dict */, TPos /* pos */) {}
+
+
 // ----------------------------------------------------------------------------
 // Function getValue()
 // ----------------------------------------------------------------------------
@@ -304,11 +342,20 @@ createRankDictionary(RankDictionary<TValue, TSpec> & dict, TText const & text)
  *
  * @brief Updates the rank information.
  *
- * @signature void updateRanks(dict)
+ * @signature void updateRanks(dict[, parallelTag])
  *
- * @param dict The @link RankDictionary @endlink.
+ * @param dict        The @link RankDictionary @endlink.
+ * @param parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt>, <tt>Parallel</tt>, default is
+ *                    <tt>Serial</tt>.  Only the @link TwoLevelRankDictionary @endlink is updated in parallel.
  */
 
+template <typename TValue, typename TSpec, typename TParallel>
+inline void
+updateRanks(RankDictionary<TValue, TSpec> & dict, Tag<TParallel> const & /* tag */)
+{
+    updateRanks(dict);
+}
+
 // ----------------------------------------------------------------------------
 // Function length()
 // ----------------------------------------------------------------------------
@@ -0,0 +1,586 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Cache-line interleaved rank dictionary for small alphabets.
+//
+// Pockrandt C, Ehrhardt M, Reinert K.  EPR-Dictionaries: A practical and fast
+// data structure for constant time searches in unidirectional and
+// bidirectional FM indices.  RECOMB 2017, pp. 190-206.
+//
+// Each entry of the ranks fibre fills exactly one 64 byte cache line and holds
+// the symbol counts preceding the line together with the bit-sliced symbols of
+// the line.  A rank query thus touches a single cache line of the fibre plus a
+// tiny table of superblock counts that stays in the first level cache.
+// ==========================================================================
+
+#ifndef INDEX_FM_RANK_DICTIONARY_EPR_H_
+#define INDEX_FM_RANK_DICTIONARY_EPR_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag EPR
+// ----------------------------------------------------------------------------
+
+template <typename TSpec = void, typename TConfig = RDConfig<> >
+struct EPR {};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction Fibre
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig>
+struct Fibre<RankDictionary<TValue, EPR<TSpec, TConfig> >, FibreRanks>
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary_;
+    typedef RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >      TEntry_;
+    typedef typename DefaultIndexStringSpec<TRankDictionary_>::Type TFibreSpec_;
+
+    typedef String<TEntry_, TFibreSpec_>                            Type;
+};
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Struct EPR RankDictionaryEntry_
+// ----------------------------------------------------------------------------
+// The counts are relative to the enclosing superblock and omit the symbol zero, whose count follows from the line
+// position.  Bit b of the symbol at position i of the line is stored in bit (i % 64) of planes[b][i / 64].
+
+template <typename TValue, typename TSpec, typename TConfig>
+struct RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >    TRankDictionary_;
+
+    __uint32    counts[TRankDictionary_::_VALUE_SIZE - 1];
+    __uint64    planes[TRankDictionary_::_BITS_PER_VALUE][TRankDictionary_::_WORDS_PER_PLANE];
+};
+
+// ----------------------------------------------------------------------------
+// Class EPR RankDictionary
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class EPRRankDictionary
+ * @extends RankDictionary
+ * @headerfile <seqan/index.h>
+ *
+ * @brief A cache-line interleaved @link RankDictionary @endlink for small alphabets.
+ *
+ * @signature template <typename TValue, typename TSpec, typename TConfig>
+ *            class RankDictionary<TValue, EPR<TSpec, TConfig> >;
+ *
+ * @tparam TValue  The alphabet type, e.g. <tt>bool</tt>, @link Dna @endlink or @link Dna5 @endlink.
+ *                 Alphabets of up to 9 symbols are supported.
+ * @tparam TSpec   A tag for specialization purposes. Default: <tt>void</tt>
+ * @tparam TConfig The size and fibre configuration. Default: <tt>RDConfig&lt;&gt;</tt>
+ *
+ * Each block of symbols is stored in a single 64 byte cache line together with the symbol counts preceding it, such
+ * that a rank query costs at most one cache miss.  The symbols are stored bit-sliced, a rank query selects the
+ * positions of a symbol with a few logical operations per word and counts them by population count.
+ * When the fibre is allocated in memory, its entries are aligned to cache lines.
+ */
+
+template <typename TValue, typename TSpec, typename TConfig>
+struct RankDictionary<TValue, EPR<TSpec, TConfig> >
+{
+    // ------------------------------------------------------------------------
+    // Constants
+    // ------------------------------------------------------------------------
+
+    static const unsigned _VALUE_SIZE            = ValueSize<TValue>::VALUE;
+    static const unsigned _BITS_PER_VALUE        = Log2<ValueSize<TValue>::VALUE>::VALUE;
+    static const unsigned _BITS_PER_WORD         = BitsPerValue<__uint64>::VALUE;
+    static const unsigned _WORDS_PER_PLANE       = (64 - 4 * (_VALUE_SIZE - 1)) / (8 * _BITS_PER_VALUE);
+    static const unsigned _VALUES_PER_LINE       = _WORDS_PER_PLANE * _BITS_PER_WORD;
+    static const unsigned _LINES_PER_SUPERBLOCK  = MaxValue<__uint32>::VALUE / _VALUES_PER_LINE;
+
+    // ------------------------------------------------------------------------
+    // Fibres
+    // ------------------------------------------------------------------------
+
+    typename Fibre<RankDictionary, FibreRanks>::Type    ranks;
+    String<typename Size<RankDictionary>::Type>         superblocks;
+    typename Size<RankDictionary>::Type                 _length;
+
+    // ------------------------------------------------------------------------
+    // Constructors
+    // ------------------------------------------------------------------------
+
+    RankDictionary() :
+        _length(0)
+    {}
+
+    template <typename TText>
+    RankDictionary(TText const & text) :
+        _length(0)
+    {
+        createRankDictionary(*this, text);
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function allocate()                                    [EPR ranks fibre]
+// ----------------------------------------------------------------------------
+// The entries of the ranks fibre must start at cache line boundaries.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TAllocSpec, typename TSize, typename TUsage>
+inline void
+allocate(String<RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >, Alloc<TAllocSpec> > & /* me */,
+         RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > * & data,
+         TSize count,
+         Tag<TUsage> const &)
+{
+#ifdef PLATFORM_WINDOWS
+    data = (RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > *)
+        _aligned_malloc(count * sizeof(RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >), 64);
+#else
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, 64, count * sizeof(RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >)))
+        ptr = NULL;
+    data = (RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > *) ptr;
+#endif
+
+    if (data == NULL && count > 0)
+        throw std::bad_alloc();
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()                                  [EPR ranks fibre]
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TAllocSpec, typename TSize, typename TUsage>
+inline void
+deallocate(String<RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> >, Alloc<TAllocSpec> > & /* me */,
+           RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > * data,
+           TSize,
+           Tag<TUsage> const)
+{
+#ifdef PLATFORM_WINDOWS
+    _aligned_free((void *) data);
+#else
+    ::free((void *) data);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _getWordMask()
+// ----------------------------------------------------------------------------
+// Returns a word having the bits on at the positions of the symbol c.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TLinePos>
+SEQAN_HOST_DEVICE inline __uint64
+_getWordMask(RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > const & entry, TLinePos wordPos, unsigned c)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >    TRankDictionary;
+
+    __uint64 mask = ~static_cast<__uint64>(0);
+
+    for (unsigned b = 0; b < TRankDictionary::_BITS_PER_VALUE; ++b)
+        mask &= ((c >> b) & 1u) ? entry.planes[b][wordPos] : ~entry.planes[b][wordPos];
+
+    return mask;
+}
+
+// ----------------------------------------------------------------------------
+// Function _getLineRank()
+// ----------------------------------------------------------------------------
+// Returns the number of occurrences of the symbol c within the line up to posInLine included.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPosInLine>
+SEQAN_HOST_DEVICE inline unsigned
+_getLineRank(RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > const & entry, TPosInLine posInLine, unsigned c)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >    TRankDictionary;
+
+    unsigned wordPos   = posInLine / TRankDictionary::_BITS_PER_WORD;
+    unsigned posInWord = posInLine % TRankDictionary::_BITS_PER_WORD;
+
+    unsigned lineRank = 0;
+
+    for (unsigned wordPrevPos = 0; wordPrevPos < TRankDictionary::_WORDS_PER_PLANE; ++wordPrevPos)
+        if (wordPrevPos < wordPos) lineRank += popCount(_getWordMask(entry, wordPrevPos, c));
+
+    // Clear the positions following posInWord.
+    return lineRank + popCount(_getWordMask(entry, wordPos, c) &
+                               (~static_cast<__uint64>(0) >> (TRankDictionary::_BITS_PER_WORD - 1 - posInWord)));
+}
+
+// ----------------------------------------------------------------------------
+// Function _getLineCount()
+// ----------------------------------------------------------------------------
+// Returns the number of occurrences of the symbol c from the superblock begin up to the line begin.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TLinePos>
+SEQAN_HOST_DEVICE inline unsigned
+_getLineCount(RankDictionaryEntry_<TValue, EPR<TSpec, TConfig> > const & entry, TLinePos linePos, unsigned c)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >    TRankDictionary;
+
+    if (c > 0) return entry.counts[c - 1];
+
+    unsigned count = (linePos % TRankDictionary::_LINES_PER_SUPERBLOCK) * TRankDictionary::_VALUES_PER_LINE;
+    for (unsigned d = 0; d < TRankDictionary::_VALUE_SIZE - 1; ++d)
+        count -= entry.counts[d];
+
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _padValues()
+// ----------------------------------------------------------------------------
+// Set values beyond length(dict) but still within the end of the ranks fibre.
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline void _padValues(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    TSize beginPos = length(dict);
+    TSize endPos   = length(dict.ranks) * TRankDictionary::_VALUES_PER_LINE;
+
+    for (TSize pos = beginPos; pos < endPos; ++pos)
+        setValue(dict, pos, TValue());
+}
+
+// ----------------------------------------------------------------------------
+// Function _updateSuperblocks()
+// ----------------------------------------------------------------------------
+// Each superblock count is the previous one plus the counts of the last line of the previous superblock.
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline void _updateSuperblocks(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    static const unsigned SIGMA = TRankDictionary::_VALUE_SIZE;
+
+    TSize superblocksCount = (length(dict.ranks) + TRankDictionary::_LINES_PER_SUPERBLOCK - 1) /
+                             TRankDictionary::_LINES_PER_SUPERBLOCK;
+
+    resize(dict.superblocks, superblocksCount * SIGMA, 0, Exact());
+
+    for (TSize sb = 1; sb < superblocksCount; ++sb)
+    {
+        TSize lastLinePos = sb * TRankDictionary::_LINES_PER_SUPERBLOCK - 1;
+
+        for (unsigned c = 0; c < SIGMA; ++c)
+            dict.superblocks[sb * SIGMA + c] = dict.superblocks[(sb - 1) * SIGMA + c] +
+                                               _getLineCount(dict.ranks[lastLinePos], lastLinePos, c) +
+                                               _getLineRank(dict.ranks[lastLinePos],
+                                                            TRankDictionary::_VALUES_PER_LINE - 1, c);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function getRank()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos, typename TChar>
+SEQAN_HOST_DEVICE inline typename Size<RankDictionary<TValue, EPR<TSpec, TConfig> > const>::Type
+getRank(RankDictionary<TValue, EPR<TSpec, TConfig> > const & dict, TPos pos, TChar c)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> > const      TRankDictionary;
+    typedef typename Fibre<TRankDictionary, FibreRanks>::Type       TFibreRanks;
+    typedef typename Value<TFibreRanks>::Type                       TRankEntry;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    TSize linePos   = pos / TRankDictionary::_VALUES_PER_LINE;
+    TSize posInLine = pos % TRankDictionary::_VALUES_PER_LINE;
+    TSize sbPos     = linePos / TRankDictionary::_LINES_PER_SUPERBLOCK;
+    unsigned ord    = ordValue(static_cast<TValue>(c));
+
+    TRankEntry const & entry = dict.ranks[linePos];
+
+    return dict.superblocks[sbPos * TRankDictionary::_VALUE_SIZE + ord] +
+           _getLineCount(entry, linePos, ord) +
+           _getLineRank(entry, posInLine, ord);
+}
+
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchRank(RankDictionary<TValue, EPR<TSpec, TConfig> > const & dict, TPos pos)
+{
+    _prefetchCacheLine(&dict.ranks[pos / RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE]);
+}
+
+// ----------------------------------------------------------------------------
+// Function getRank(bool)
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline typename Size<RankDictionary<bool, EPR<TSpec, TConfig> > const>::Type
+getRank(RankDictionary<bool, EPR<TSpec, TConfig> > const & dict, TPos pos)
+{
+    return getRank(dict, pos, true);
+}
+
+// ----------------------------------------------------------------------------
+// Function getValue()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline typename Value<RankDictionary<TValue, EPR<TSpec, TConfig> > const>::Type
+getValue(RankDictionary<TValue, EPR<TSpec, TConfig> > const & dict, TPos pos)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    TSize linePos   = pos / TRankDictionary::_VALUES_PER_LINE;
+    TSize posInLine = pos % TRankDictionary::_VALUES_PER_LINE;
+    TSize wordPos   = posInLine / TRankDictionary::_BITS_PER_WORD;
+    TSize posInWord = posInLine % TRankDictionary::_BITS_PER_WORD;
+
+    unsigned ord = 0;
+    for (unsigned b = 0; b < TRankDictionary::_BITS_PER_VALUE; ++b)
+        ord |= static_cast<unsigned>((dict.ranks[linePos].planes[b][wordPos] >> posInWord) & 1u) << b;
+
+    return TValue(ord);
+}
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline typename Value<RankDictionary<TValue, EPR<TSpec, TConfig> > >::Type
+getValue(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TPos pos)
+{
+    return getValue(static_cast<RankDictionary<TValue, EPR<TSpec, TConfig> > const &>(dict), pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function setValue()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos, typename TChar>
+inline void setValue(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TPos pos, TChar c)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    TSize linePos   = pos / TRankDictionary::_VALUES_PER_LINE;
+    TSize posInLine = pos % TRankDictionary::_VALUES_PER_LINE;
+    TSize wordPos   = posInLine / TRankDictionary::_BITS_PER_WORD;
+    TSize posInWord = posInLine % TRankDictionary::_BITS_PER_WORD;
+
+    unsigned ord = ordValue(static_cast<TValue>(c));
+    __uint64 bit = static_cast<__uint64>(1) << posInWord;
+
+    for (unsigned b = 0; b < TRankDictionary::_BITS_PER_VALUE; ++b)
+    {
+        __uint64 & plane = dict.ranks[linePos].planes[b][wordPos];
+        plane = ((ord >> b) & 1u) ? (plane | bit) : (plane & ~bit);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function appendValue()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TChar, typename TExpand>
+inline void appendValue(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TChar c, Tag<TExpand> const tag)
+{
+    resize(dict, length(dict) + 1, tag);
+    setValue(dict, length(dict) - 1, c);
+}
+
+// ----------------------------------------------------------------------------
+// Function updateRanks()
+// ----------------------------------------------------------------------------
+// The counts of each line are computed independently, then cumulated within each superblock.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TParallel>
+inline void updateRanks(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, Tag<TParallel> const & /* tag */)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    static const unsigned SIGMA = TRankDictionary::_VALUE_SIZE;
+
+    if (empty(dict)) return;
+
+    // Clear the uninitialized values.
+    _padValues(dict);
+
+    // Count the symbols within each line.
+    SEQAN_OMP_PRAGMA(parallel for if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (__int64 linePos = 0; linePos < (__int64)length(dict.ranks); ++linePos)
+        for (unsigned c = 1; c < SIGMA; ++c)
+            dict.ranks[linePos].counts[c - 1] = _getLineRank(dict.ranks[linePos],
+                                                             TRankDictionary::_VALUES_PER_LINE - 1, c);
+
+    // Turn the line counts into counts preceding each line within its superblock.
+    __uint32 counts[SIGMA - 1];
+    for (TSize linePos = 0; linePos < length(dict.ranks); ++linePos)
+    {
+        if (linePos % TRankDictionary::_LINES_PER_SUPERBLOCK == 0)
+            std::fill(counts, counts + SIGMA - 1, 0u);
+
+        for (unsigned c = 0; c < SIGMA - 1; ++c)
+            std::swap(counts[c], dict.ranks[linePos].counts[c]);
+
+        for (unsigned c = 0; c < SIGMA - 1; ++c)
+            counts[c] += dict.ranks[linePos].counts[c];
+    }
+
+    _updateSuperblocks(dict);
+}
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline void updateRanks(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict)
+{
+    updateRanks(dict, Serial());
+}
+
+// ----------------------------------------------------------------------------
+// Function createRankDictionary()
+// ----------------------------------------------------------------------------
+// The threads fill disjoint ranges of lines, thus they never write to the same word.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TText, typename TParallel>
+inline void
+createRankDictionary(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TText const & text,
+                     Tag<TParallel> const & parallelTag)
+{
+    typedef RankDictionary<TValue, EPR<TSpec, TConfig> >            TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+    typedef typename Iterator<TText const, Standard>::Type          TTextIterator;
+
+    resize(dict, length(text), Exact());
+
+    Splitter<TSize> splitter(0, length(dict.ranks), parallelTag);
+
+    SEQAN_OMP_PRAGMA(parallel for if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        TSize beginPos = splitter[job] * TRankDictionary::_VALUES_PER_LINE;
+        TSize endPos = std::min(static_cast<TSize>(splitter[job + 1] * TRankDictionary::_VALUES_PER_LINE),
+                                static_cast<TSize>(length(text)));
+
+        TTextIterator textIt = begin(text, Standard()) + beginPos;
+        for (TSize pos = beginPos; pos < endPos; ++pos, ++textIt)
+            setValue(dict, pos, value(textIt));
+    }
+
+    updateRanks(dict, parallelTag);
+}
+
+template <typename TValue, typename TSpec, typename TConfig, typename TText>
+inline void
+createRankDictionary(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TText const & text)
+{
+    createRankDictionary(dict, text, Serial());
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline void clear(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict)
+{
+    clear(dict.ranks);
+    clear(dict.superblocks);
+    dict._length = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline typename Size<RankDictionary<TValue, EPR<TSpec, TConfig> > >::Type
+length(RankDictionary<TValue, EPR<TSpec, TConfig> > const & dict)
+{
+    return dict._length;
+}
+
+// ----------------------------------------------------------------------------
+// Function reserve()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TSize, typename TExpand>
+inline typename Size<RankDictionary<TValue, EPR<TSpec, TConfig> > >::Type
+reserve(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TSize newCapacity, Tag<TExpand> const tag)
+{
+    return reserve(dict.ranks, (newCapacity + RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE - 1) /
+                               RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function resize()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TConfig, typename TSize, typename TExpand>
+inline typename Size<RankDictionary<TValue, EPR<TSpec, TConfig> > >::Type
+resize(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, TSize newLength, Tag<TExpand> const tag)
+{
+    dict._length = newLength;
+    return resize(dict.ranks, (newLength + RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE - 1) /
+                              RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function open()
+// ----------------------------------------------------------------------------
+// Only the ranks fibre is stored, the superblocks are recomputed from it.
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline bool open(RankDictionary<TValue, EPR<TSpec, TConfig> > & dict, const char * fileName, int openMode)
+{
+    if (!open(dict.ranks, fileName, openMode)) return false;
+
+    dict._length = length(dict.ranks) * RankDictionary<TValue, EPR<TSpec, TConfig> >::_VALUES_PER_LINE;
+    _updateSuperblocks(dict);
+
+    return true;
+}
+
+}
+
+#endif  // INDEX_FM_RANK_DICTIONARY_EPR_H_
@@ -749,6 +749,25 @@ getRank(RankDictionary<TValue, Levels<TSpec, TConfig> > const & dict, TPos pos,
            _getValueRank(dict, values, posInBlock, static_cast<TValue>(c));
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchRank()
+// ----------------------------------------------------------------------------
+// The entries are not aligned, thus an entry can span two cache lines.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TPos>
+SEQAN_HOST_DEVICE inline void
+_prefetchRank(RankDictionary<TValue, Levels<TSpec, TConfig> > const & dict, TPos pos)
+{
+    typedef RankDictionary<TValue, Levels<TSpec, TConfig> > const           TRankDictionary;
+    typedef typename Fibre<TRankDictionary, FibreRanks>::Type               TFibreRanks;
+    typedef typename Value<TFibreRanks>::Type                               TRankEntry;
+
+    TRankEntry const & entry = dict.ranks[_toBlockPos(dict, pos)];
+
+    _prefetchCacheLine(&entry);
+    _prefetchCacheLine(reinterpret_cast<char const *>(&entry + 1) - 1);
+}
+
 // ----------------------------------------------------------------------------
 // Function getRank(bool)
 // ----------------------------------------------------------------------------
@@ -857,6 +876,92 @@ inline void updateRanks(RankDictionary<TValue, Levels<TSpec, TConfig> > & dict)
     }
 }
 
+// ----------------------------------------------------------------------------
+// Function updateRanks()                                            [Parallel]
+// ----------------------------------------------------------------------------
+// Each thread cumulates the ranks of a range of blocks starting from zero.  The ranks preceding each range are then
+// added to its blocks.
+
+template <typename TValue, typename TSpec, typename TConfig>
+inline void updateRanks(RankDictionary<TValue, Levels<TSpec, TConfig> > & dict, Parallel const & /* tag */)
+{
+    typedef RankDictionary<TValue, Levels<TSpec, TConfig> >                 TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                            TSize;
+    typedef typename RankDictionaryBlock_<TValue, Levels<TSpec, TConfig> >::Type TBlock;
+
+    if (empty(dict)) return;
+
+    // Clear the uninitialized values.
+    _padValues(dict);
+
+    Splitter<TSize> splitter(0, length(dict.ranks), Parallel());
+
+    // Compute the ranks within each range of blocks.
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        _clearBlockAt(dict, _toPos(dict, splitter[job]));
+
+        for (TSize blockPos = splitter[job]; blockPos + 1 < splitter[job + 1]; ++blockPos)
+        {
+            TSize curr = _toPos(dict, blockPos);
+            TSize next = _toPos(dict, blockPos + 1);
+
+            _blockAt(dict, next) = _blockAt(dict, curr) + _getValuesRanks(dict, next - 1);
+        }
+    }
+
+    // Compute the ranks preceding each range of blocks.
+    String<TBlock> offsets;
+    resize(offsets, length(splitter), Exact());
+    offsets[0] = _blockAt(dict, 0u);
+    for (TSize job = 1; job < length(splitter); ++job)
+    {
+        TSize last = _toPos(dict, splitter[job] - 1);
+        TSize next = _toPos(dict, splitter[job]);
+
+        offsets[job] = offsets[job - 1] + _blockAt(dict, last) + _getValuesRanks(dict, next - 1);
+    }
+
+    // Add the preceding ranks.
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 1; job < (int)length(splitter); ++job)
+        for (TSize blockPos = splitter[job]; blockPos < splitter[job + 1]; ++blockPos)
+            _blockAt(dict, _toPos(dict, blockPos)) = _blockAt(dict, _toPos(dict, blockPos)) + offsets[job];
+}
+
+// ----------------------------------------------------------------------------
+// Function createRankDictionary()                                   [Parallel]
+// ----------------------------------------------------------------------------
+// The threads fill disjoint ranges of blocks, thus they never write to the same word.
+
+template <typename TValue, typename TSpec, typename TConfig, typename TText>
+inline void
+createRankDictionary(RankDictionary<TValue, Levels<TSpec, TConfig> > & dict, TText const & text,
+                     Parallel const & /* tag */)
+{
+    typedef RankDictionary<TValue, Levels<TSpec, TConfig> >         TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+    typedef typename Iterator<TText const, Standard>::Type          TTextIterator;
+
+    resize(dict, length(text), Exact());
+
+    Splitter<TSize> splitter(0, length(dict.ranks), Parallel());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        TSize beginPos = _toPos(dict, splitter[job]);
+        TSize endPos = std::min(static_cast<TSize>(_toPos(dict, splitter[job + 1])), static_cast<TSize>(length(text)));
+
+        TTextIterator textIt = begin(text, Standard()) + beginPos;
+        for (TSize pos = beginPos; pos < endPos; ++pos, ++textIt)
+            setValue(dict, pos, value(textIt));
+    }
+
+    updateRanks(dict, Parallel());
+}
+
 // ----------------------------------------------------------------------------
 // Function length()
 // ----------------------------------------------------------------------------
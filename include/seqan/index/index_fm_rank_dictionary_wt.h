@@ -379,6 +379,16 @@ inline void updateRanks(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > & d
         updateRanks(getFibre(dict, FibreRanks())[i]);
 }
 
+template <typename TValue, typename TSpec, typename TConfig, typename TParallel>
+inline void updateRanks(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > & dict, Tag<TParallel> const & parallelTag)
+{
+    typedef RankDictionary<TValue, WaveletTree<TSpec, TConfig> >        TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                        TSize;
+
+    for (TSize i = 0; i < length(getFibre(dict, FibreRanks())); ++i)
+        updateRanks(getFibre(dict, FibreRanks())[i], parallelTag);
+}
+
 // ----------------------------------------------------------------------------
 // Function createRankDictionary()
 // ----------------------------------------------------------------------------
@@ -401,6 +411,19 @@ createRankDictionary(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > & dict
     createRankDictionary(dict, text, sums);
 }
 
+// The tree nodes are filled sequentially, then the ranks of each node are updated.
+template <typename TValue, typename TSpec, typename TConfig, typename TText, typename TParallel>
+inline void
+createRankDictionary(RankDictionary<TValue, WaveletTree<TSpec, TConfig> > & dict, TText const & text,
+                     Tag<TParallel> const & parallelTag)
+{
+    typename RankDictionaryBlock_<TValue, WaveletTree<TSpec, TConfig> >::Type sums;
+    prefixSums<TValue>(sums, text);
+    createRightArrayBinaryTree(getFibre(dict, FibreTreeStructure()), sums);
+    _fillStructure(dict, text);
+    updateRanks(dict, parallelTag);
+}
+
 // ----------------------------------------------------------------------------
 // Function open()
 // ----------------------------------------------------------------------------
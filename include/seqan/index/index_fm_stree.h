@@ -180,7 +180,9 @@ struct EdgeLabel<Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TSpec
 template <typename TText, typename TOccSpec, typename TIndexSpec>
 SEQAN_HOST_DEVICE inline void _indexRequireTopDownIteration(Index<TText, FMIndex<TOccSpec, TIndexSpec> > & index)
 {
-    indexRequire(index, FibreSALF());
+    // An opened index keeps its fibres, the k-mer table is optional.
+    if (!indexSupplied(index, FibreSALF()))
+        indexCreate(index);
 }
 
 // ----------------------------------------------------------------------------
@@ -263,6 +265,64 @@ _getNodeByChar(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown
     return _range.i1 < _range.i2;
 }
 
+// ----------------------------------------------------------------------------
+// Function _prefetchNodeByChar()                                    [Iterator]
+// ----------------------------------------------------------------------------
+// Prefetches the rank dictionary entries read by _getNodeByChar().
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TSpec, typename TChar>
+SEQAN_HOST_DEVICE inline void
+_prefetchNodeByChar(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it,
+                    typename VertexDescriptor<Index<TText, FMIndex<TOccSpec, TIndexSpec> > >::Type const & vDesc,
+                    TChar c)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef typename Fibre<TIndex, FibreLF>::Type               TLF;
+
+    TIndex const & index = container(it);
+    TLF const & lf = indexLF(index);
+
+    _prefetchBwtRank(lf, range(index, vDesc).i1, c);
+    _prefetchBwtRank(lf, range(index, vDesc).i2, c);
+}
+
+// ----------------------------------------------------------------------------
+// Function _getNodeByKmer()                                         [Iterator]
+// ----------------------------------------------------------------------------
+// Looks up the range reached from the root by the first KMER_LENGTH symbols of the string.  Returns false if the
+// k-mer table cannot be used, i.e. the iterator is not at the root, the table is missing or the string is too short or
+// contains symbols not in the index alphabet, which are left to _getNodeByChar().
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TSpec, typename TString>
+inline bool
+_getNodeByKmer(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<TSpec> > > const & it,
+               TString const & string,
+               Pair<typename Size<Index<TText, FMIndex<TOccSpec, TIndexSpec> > >::Type> & _range)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef typename Fibre<TIndex, FibreKmers>::Type            TKmers;
+    typedef typename Value<TIndex>::Type                        TAlphabet;
+
+    static const unsigned SIGMA = ValueSize<TAlphabet>::VALUE;
+    static const unsigned KMER_LENGTH = FMIndexKmerLength_<TIndexSpec>::VALUE;
+
+    TKmers const & kmers = getFibre(container(it), FibreKmers());
+
+    if (KMER_LENGTH == 0 || empty(kmers) || length(string) < KMER_LENGTH || !isRoot(it)) return false;
+
+    __uint64 code = 0;
+    for (unsigned i = 0; i < KMER_LENGTH; ++i)
+    {
+        unsigned c = ordValue(value(string, i));
+        if (c >= SIGMA || ordValue(TAlphabet(value(string, i))) != c) return false;
+        code = code * SIGMA + c;
+    }
+
+    _range = kmers[code];
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // Function _goDownChar()                                            [Iterator]
 // ----------------------------------------------------------------------------
@@ -345,7 +405,21 @@ _goDownString(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<
     TStringIter stringIt = begin(string, Standard());
     TStringIter stringEnd = end(string, Standard());
 
-    for (lcp = 0; stringIt != stringEnd; ++stringIt, ++lcp)
+    lcp = 0;
+
+    // Jump to the k-mer node, fall back to the backward search if the k-mer does not occur to compute the lcp.
+    // The k-mer table is not available on CUDA.
+#ifndef __CUDA_ARCH__
+    TRange _kmerRange;
+    if (_getNodeByKmer(it, string, _kmerRange) && _kmerRange.i1 < _kmerRange.i2)
+    {
+        value(it).range = _kmerRange;
+        lcp = FMIndexKmerLength_<TIndexSpec>::VALUE;
+        stringIt += lcp;
+    }
+#endif
+
+    for (; stringIt != stringEnd; ++stringIt, ++lcp)
     {
         TRange _range;
 
@@ -367,6 +441,136 @@ _goDownString(Iter<Index<TText, FMIndex<TOccSpec, TIndexSpec> >, VSTree<TopDown<
     return stringIt == stringEnd;
 }
 
+// ----------------------------------------------------------------------------
+// Function _findBatchStart()
+// ----------------------------------------------------------------------------
+// Starts a needle of _findBatch().  Returns true if the needle needs backward search steps, otherwise sets found.
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TIndexIt, typename TNeedle,
+          typename TNeedleSize>
+inline bool
+_findBatchStart(Index<TText, FMIndex<TOccSpec, TIndexSpec> > & index,
+                TNeedle const & needle,
+                TIndexIt & it,
+                TNeedleSize & needlePos,
+                bool & found)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef Pair<typename Size<TIndex>::Type>                   TRange;
+
+    it = TIndexIt(index);
+    found = empty(needle);
+
+    if (found)
+        return false;
+
+    _historyPush(it);
+    needlePos = 0;
+
+    // Skip the first steps by looking up the k-mer.
+    TRange _range;
+    if (_getNodeByKmer(it, needle, _range))
+    {
+        if (_range.i1 >= _range.i2)
+            return false;
+
+        value(it).range = _range;
+        needlePos = FMIndexKmerLength_<TIndexSpec>::VALUE;
+
+        if (needlePos == length(needle))
+        {
+            value(it).repLen += needlePos;
+            value(it).lastChar = back(needle);
+            found = true;
+            return false;
+        }
+    }
+
+    _prefetchNodeByChar(it, value(it), needle[needlePos]);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findBatch()
+// ----------------------------------------------------------------------------
+// Searches the needles [needlesBegin, needlesEnd) exactly and calls delegate(it, needleId) for each needle occurring
+// in the text, in increasing needleId order.  Needles start from their k-mer node if the index has a k-mer table.
+// The backward search of a single needle is a chain of dependent rank queries, each one likely a cache miss.  Hence
+// batches of BATCH_SIZE needles are advanced in lockstep, and the rank dictionary entries needed by the next step of
+// a needle are prefetched while the other needles of the batch are advanced.  The needles of a batch are reported
+// once the whole batch is done, so that short needles do not overtake longer needles with lower ids.
+
+template <typename TText, typename TOccSpec, typename TIndexSpec, typename TNeedles, typename TPos, typename TDelegate>
+inline void
+_findBatch(Index<TText, FMIndex<TOccSpec, TIndexSpec> > & index,
+           TNeedles const & needles,
+           TPos needlesBegin,
+           TPos needlesEnd,
+           TDelegate & delegate)
+{
+    typedef Index<TText, FMIndex<TOccSpec, TIndexSpec> >        TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type         TIndexIt;
+    typedef Pair<typename Size<TIndex>::Type>                   TRange;
+    typedef typename Reference<TNeedles const>::Type            TNeedle;
+    typedef typename Size<typename Value<TNeedles>::Type>::Type TNeedleSize;
+
+    static const unsigned BATCH_SIZE = 16;
+
+    TIndexIt    its[BATCH_SIZE];
+    TNeedleSize needlePos[BATCH_SIZE];
+    bool        running[BATCH_SIZE];
+    bool        found[BATCH_SIZE];
+
+    for (TPos batchBegin = needlesBegin; batchBegin < needlesEnd; batchBegin += BATCH_SIZE)
+    {
+        unsigned batchSize = std::min(static_cast<TPos>(BATCH_SIZE), static_cast<TPos>(needlesEnd - batchBegin));
+        unsigned active = 0;
+
+        for (unsigned slot = 0; slot < batchSize; ++slot)
+        {
+            running[slot] = _findBatchStart(index, needles[batchBegin + slot], its[slot], needlePos[slot],
+                                            found[slot]);
+            active += running[slot];
+        }
+
+        while (active > 0)
+        {
+            for (unsigned slot = 0; slot < batchSize; ++slot)
+            {
+                if (!running[slot]) continue;
+
+                TIndexIt & it = its[slot];
+                TNeedle needle = needles[batchBegin + slot];
+
+                // The entries read here have been prefetched during the previous round.
+                TRange _range;
+                found[slot] = _getNodeByChar(it, value(it), _range, needle[needlePos[slot]]);
+
+                if (found[slot])
+                {
+                    value(it).range = _range;
+
+                    if (++needlePos[slot] < length(needle))
+                    {
+                        _prefetchNodeByChar(it, value(it), needle[needlePos[slot]]);
+                        continue;
+                    }
+
+                    value(it).repLen += length(needle);
+                    value(it).lastChar = back(needle);
+                }
+
+                running[slot] = false;
+                --active;
+            }
+        }
+
+        for (unsigned slot = 0; slot < batchSize; ++slot)
+            if (found[slot])
+                delegate(its[slot], static_cast<TPos>(batchBegin + slot));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Function _goRight()                                               [Iterator]
 // ----------------------------------------------------------------------------
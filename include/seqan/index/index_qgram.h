@@ -1078,6 +1078,70 @@ namespace SEQAN_NAMESPACE_MAIN
             }
     }
 
+    // parallel variants, counters are incremented atomically
+    template < typename TDir, typename TBucketMap, typename TText, typename TShape, typename TStepSize, typename TParallelTag >
+    inline void
+    _qgramCountQGrams(TDir &dir, TBucketMap &bucketMap, TText const &text, TShape shape, TStepSize stepSize, Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TText const, Standard>::Type  TIterator;
+        typedef typename Iterator<TDir, Standard>::Type         TDirIterator;
+        typedef typename Value<TDir>::Type                      TSize;
+
+        if (length(text) < length(shape) || empty(shape)) return;
+        TSize num_qgrams = (length(text) - length(shape)) / stepSize + 1;
+
+        TDirIterator dirBegin = begin(dir, Standard());
+        Splitter<TSize> splitter(0, num_qgrams, parallelTag);
+
+        SEQAN_OMP_PRAGMA(parallel for firstprivate(shape))
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TIterator itText = begin(text, Standard()) + splitter[job] * stepSize;
+            TIterator itTextEnd = begin(text, Standard()) + splitter[job + 1] * stepSize;
+
+            atomicInc(*(dirBegin + requestBucket(bucketMap, hash(shape, itText), parallelTag)), parallelTag);
+            if (stepSize == 1)
+                for (++itText; itText != itTextEnd; ++itText)
+                    atomicInc(*(dirBegin + requestBucket(bucketMap, hashNext(shape, itText), parallelTag)), parallelTag);
+            else
+                for (itText += stepSize; itText != itTextEnd; itText += stepSize)
+                    atomicInc(*(dirBegin + requestBucket(bucketMap, hash(shape, itText), parallelTag)), parallelTag);
+        }
+    }
+
+    template < typename TDir, typename TBucketMap, typename TString, typename TSpec, typename TShape, typename TStepSize, typename TParallelTag >
+    inline void
+    _qgramCountQGrams(TDir &dir, TBucketMap &bucketMap, StringSet<TString, TSpec> const &stringSet, TShape shape, TStepSize stepSize, Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TString const, Standard>::Type    TIterator;
+        typedef typename Iterator<TDir, Standard>::Type             TDirIterator;
+        typedef typename Value<TDir>::Type                          TSize;
+
+        if (empty(shape) || empty(stringSet)) return;
+
+        TDirIterator dirBegin = begin(dir, Standard());
+        Splitter<TSize> seqSplitter(0, length(stringSet), parallelTag);
+
+        SEQAN_OMP_PRAGMA(parallel for firstprivate(shape))
+        for (int job = 0; job < (int)length(seqSplitter); ++job)
+            for (TSize seqNo = seqSplitter[job]; seqNo < seqSplitter[job + 1]; ++seqNo)
+            {
+                TString const &sequence = value(stringSet, seqNo);
+                if (length(sequence) < length(shape)) continue;
+                TSize num_qgrams = (length(sequence) - length(shape)) / stepSize + 1;
+
+                TIterator itText = begin(sequence, Standard());
+                TIterator itTextEnd = itText + num_qgrams * stepSize;
+                atomicInc(*(dirBegin + requestBucket(bucketMap, hash(shape, itText), parallelTag)), parallelTag);
+                if (stepSize == 1)
+                    for (++itText; itText != itTextEnd; ++itText)
+                        atomicInc(*(dirBegin + requestBucket(bucketMap, hashNext(shape, itText), parallelTag)), parallelTag);
+                else
+                    for (itText += stepSize; itText != itTextEnd; itText += stepSize)
+                        atomicInc(*(dirBegin + requestBucket(bucketMap, hash(shape, itText), parallelTag)), parallelTag);
+            }
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     // Counting sort - Step 3: Cumulative sum
     //
@@ -1122,6 +1186,82 @@ namespace SEQAN_NAMESPACE_MAIN
         return sum + prev2Diff;
     }
 
+    // Parallel variant of _qgramCummulativeSum.
+    // Entry i depends on the counters i-1 and i-2, hence the counters preceding each subinterval are saved before any
+    // of them is overwritten.  The offsets of the subintervals are the partial sums of the subinterval sums.
+    template < typename TSize, typename TWithConstraints >
+    inline TSize
+    _qgramEnabledCount(TSize counter, TWithConstraints)
+    {
+        return (TWithConstraints::VALUE && counter == (TSize)-1)? 0: counter;
+    }
+
+    template < typename TDir, typename TWithConstraints, typename TParallelTag >
+    inline typename Value<TDir>::Type
+    _qgramCummulativeSum(TDir &dir, TWithConstraints, Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TDir, Standard>::Type TDirIterator;
+        typedef typename Value<TDir>::Type              TSize;
+        typedef typename Size<TDir>::Type               TDirSize;
+
+        if (empty(dir)) return 0;
+
+        Splitter<TDirSize> splitter(0, length(dir), parallelTag);
+        String<TSize> offsets;
+        String<TSize> prevDiffs;
+        String<TSize> prev2Diffs;
+        resize(offsets, length(splitter) + 1, Exact());
+        resize(prevDiffs, length(splitter), Exact());
+        resize(prev2Diffs, length(splitter), Exact());
+        TSize lastDiff = _qgramEnabledCount(back(dir), TWithConstraints());
+
+        // STEP 1: sum up the enabled counters of each subinterval and save the counters preceding it
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TDirIterator it = begin(dir, Standard()) + splitter[job];
+            TDirIterator itEnd = begin(dir, Standard()) + splitter[job + 1];
+            prevDiffs[job] = (splitter[job] >= 1)? *(it - 1): 0;
+            prev2Diffs[job] = (splitter[job] >= 2)? _qgramEnabledCount(*(it - 2), TWithConstraints()): 0;
+
+            TSize sum = 0;
+            for (; it != itEnd; ++it)
+                sum += _qgramEnabledCount(*it, TWithConstraints());
+            offsets[job + 1] = sum;
+        }
+
+        // STEP 2: offsets[job] is the sum of all enabled counters preceding the subinterval
+        offsets[0] = 0;
+        partialSum(offsets, Serial());
+
+        // STEP 3: compute the cumulative sums within each subinterval as in the serial variant
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TDirIterator it = begin(dir, Standard()) + splitter[job];
+            TDirIterator itEnd = begin(dir, Standard()) + splitter[job + 1];
+            TSize prevDiff = prevDiffs[job];
+            TSize prev2Diff = prev2Diffs[job];
+            TSize sum = offsets[job] - _qgramEnabledCount(prevDiff, TWithConstraints()) - prev2Diff;
+            for (; it != itEnd; ++it)
+            {
+                if (TWithConstraints::VALUE && prevDiff == (TSize)-1)
+                {
+                    sum += prev2Diff;
+                    prev2Diff = 0;
+                    prevDiff = *it;
+                    *it = (TSize)-1;                                // disable bucket
+                } else {
+                    sum += prev2Diff;
+                    prev2Diff = prevDiff;
+                    prevDiff = *it;
+                    *it = sum;
+                }
+            }
+        }
+        return back(offsets) - lastDiff;
+    }
+
     // The first entry is 0.
     // This function is used when Steps 4 and 5 (fill SA, correct disabled buckets) are ommited.
     template < typename TDir, typename TWithConstraints >
@@ -1290,6 +1430,121 @@ namespace SEQAN_NAMESPACE_MAIN
             }
     }
 
+    // parallel variants, the bucket entries are incremented atomically
+    // The order of the occurrences within a bucket depends on the thread schedule, see _qgramSortBuckets.
+    template <
+        typename TSA,
+        typename TText,
+        typename TShape,
+        typename TDir,
+        typename TBucketMap,
+        typename TWithConstraints,
+        typename TStepSize,
+        typename TParallelTag >
+    inline void
+    _qgramFillSuffixArray(
+        TSA &sa,
+        TText const &text,
+        TShape shape,
+        TDir &dir,
+        TBucketMap &bucketMap,
+        TStepSize stepSize,
+        TWithConstraints const,
+        Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TText const, Standard>::Type  TIterator;
+        typedef typename Iterator<TDir, Standard>::Type         TDirIterator;
+        typedef typename Value<TDir>::Type                      TSize;
+
+        if (empty(shape) || length(text) < length(shape)) return;
+        TSize num_qgrams = (length(text) - length(shape)) / stepSize + 1;
+
+        TDirIterator dirBegin1 = begin(dir, Standard()) + 1;
+        Splitter<TSize> splitter(0, num_qgrams, parallelTag);
+
+        SEQAN_OMP_PRAGMA(parallel for firstprivate(shape))
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TSize pos = splitter[job] * stepSize;
+            TSize posEnd = splitter[job + 1] * stepSize;
+            TIterator itText = begin(text, Standard()) + pos;
+
+            TDirIterator bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));     // first hash
+            if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)                           // if bucket is enabled
+                sa[atomicPostInc(*bktPtr, parallelTag)] = pos;
+
+            for (pos += stepSize; pos != posEnd; pos += stepSize)
+            {
+                if (stepSize == 1)
+                    bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, ++itText));   // next hash
+                else
+                    bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText += stepSize));
+                if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)                       // if bucket is enabled
+                    sa[atomicPostInc(*bktPtr, parallelTag)] = pos;
+            }
+        }
+    }
+
+    template <
+        typename TSA,
+        typename TString,
+        typename TSpec,
+        typename TShape,
+        typename TDir,
+        typename TBucketMap,
+        typename TStepSize,
+        typename TWithConstraints,
+        typename TParallelTag >
+    inline void
+    _qgramFillSuffixArray(
+        TSA &sa,
+        StringSet<TString, TSpec> const &stringSet,
+        TShape shape,
+        TDir &dir,
+        TBucketMap &bucketMap,
+        TStepSize stepSize,
+        TWithConstraints const,
+        Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TString const, Standard>::Type    TIterator;
+        typedef typename Iterator<TDir, Standard>::Type             TDirIterator;
+        typedef typename Value<TDir>::Type                          TSize;
+
+        if (empty(shape) || empty(stringSet)) return;
+
+        TDirIterator dirBegin1 = begin(dir, Standard()) + 1;
+        Splitter<TSize> seqSplitter(0, length(stringSet), parallelTag);
+
+        SEQAN_OMP_PRAGMA(parallel for firstprivate(shape))
+        for (int job = 0; job < (int)length(seqSplitter); ++job)
+            for (TSize seqNo = seqSplitter[job]; seqNo < seqSplitter[job + 1]; ++seqNo)
+            {
+                TString const &sequence = value(stringSet, seqNo);
+                if (length(sequence) < length(shape)) continue;
+                TSize num_qgrams = (length(sequence) - length(shape)) / stepSize + 1;
+
+                typename Value<TSA>::Type localPos;
+                assignValueI1(localPos, seqNo);
+                assignValueI2(localPos, 0);
+
+                TIterator itText = begin(sequence, Standard());
+                TDirIterator bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));     // first hash
+                if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)                           // if bucket is enabled
+                    sa[atomicPostInc(*bktPtr, parallelTag)] = localPos;
+
+                for (TSize i = 1; i < num_qgrams; ++i)
+                {
+                    assignValueI2(localPos, i * stepSize);
+                    if (stepSize == 1)
+                        bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, ++itText));   // next hash
+                    else
+                        bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText += stepSize));
+                    if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)                       // if bucket is enabled
+                        sa[atomicPostInc(*bktPtr, parallelTag)] = localPos;
+                }
+            }
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     // Step 5: Correct disabled buckets
     template < typename TDir >
@@ -1310,6 +1565,70 @@ namespace SEQAN_NAMESPACE_MAIN
                 prev = *it;
     }
 
+    template < typename TDir, typename TParallelTag >
+    inline void
+    _qgramPostprocessBuckets(TDir &dir, Tag<TParallelTag> parallelTag)
+    {
+        typedef typename Iterator<TDir, Standard>::Type TDirIterator;
+        typedef typename Value<TDir>::Type              TSize;
+        typedef typename Size<TDir>::Type               TDirSize;
+
+        Splitter<TDirSize> splitter(0, length(dir), parallelTag);
+        String<TSize> last;
+        resize(last, length(splitter), Exact());
+
+        // STEP 1: correct each subinterval, leading disabled buckets remain
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TDirIterator it = begin(dir, Standard()) + splitter[job];
+            TDirIterator itEnd = begin(dir, Standard()) + splitter[job + 1];
+            TSize prev = (job == 0)? 0: (TSize)-1;
+            for (; it != itEnd; ++it)
+                if (*it == (TSize)-1)   // end positions
+                    *it = prev;
+                else
+                    prev = *it;
+            last[job] = prev;
+        }
+
+        for (int job = 1; job < (int)length(splitter); ++job)
+            if (last[job] == (TSize)-1)
+                last[job] = last[job - 1];
+
+        // STEP 2: correct the leading disabled buckets of each subinterval
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (int job = 1; job < (int)length(splitter); ++job)
+        {
+            TDirIterator it = begin(dir, Standard()) + splitter[job];
+            TDirIterator itEnd = begin(dir, Standard()) + splitter[job + 1];
+            for (; it != itEnd && *it == (TSize)-1; ++it)
+                *it = last[job - 1];
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Step 6: Sort buckets (only required after a parallel Step 4)
+    template < typename TSA, typename TDir >
+    inline void
+    _qgramSortBuckets(TSA &, TDir const &, Serial)
+    {}
+
+    template < typename TSA, typename TDir >
+    inline void
+    _qgramSortBuckets(TSA &sa, TDir const &dir, Parallel)
+    {
+        typedef typename Iterator<TSA, Standard>::Type  TSAIterator;
+
+        if (length(dir) < 2 || omp_get_max_threads() < 2) return;
+        TSAIterator saBegin = begin(sa, Standard());
+
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 4096))
+        for (__int64 i = 0; i < (__int64)length(dir) - 1; ++i)
+            if (dir[i] + 1 < dir[i + 1])
+                std::sort(saBegin + dir[i], saBegin + dir[i + 1]);
+    }
+
 
 //////////////////////////////////////////////////////////////////////////////
 /*!
@@ -1317,10 +1636,13 @@ namespace SEQAN_NAMESPACE_MAIN
  * @headerfile <seqan/index.h>
  * @brief Builds a <i>q</i>-gram index on a sequence.
  *
- * @signature void createQGramIndex(index);
+ * @signature void createQGramIndex(index[, parallelTag]);
  * @signature void createQGramIndex(sa, dir, bucketMap, text, shape, stepSize); [DEPRECATED]
  *
  * @param[out] index     The IndexQGram to create.
+ * @param[in]  parallelTag Tag to enable/disable parallelism, one of @link ParallelismTags#Serial @endlink and
+ *                       @link ParallelismTags#Parallel @endlink.  The parallel variant produces the same tables as the
+ *                       serial variant.
  * @param[out] sa        The resulting list in which all <i>q</i>-grams are sorted alphabetically.
  * @param[out] dir       The resulting array that indicates at which position in index the corresponding <i>q</i>-grams
  * @param[in]  bucketMap Stores the <i>q</i>-gram hashes for the openaddressing hash maps, see
@@ -1380,6 +1702,45 @@ namespace SEQAN_NAMESPACE_MAIN
         }
     }
 
+    template < typename TIndex, typename TParallelTag >
+    void createQGramIndex(TIndex &index, Tag<TParallelTag> parallelTag)
+    {
+        typename Fibre<TIndex, QGramText>::Type const &text      = indexText(index);
+        typename Fibre<TIndex, QGramSA>::Type         &sa        = indexSA(index);
+        typename Fibre<TIndex, QGramDir>::Type        &dir       = indexDir(index);
+        typename Fibre<TIndex, QGramShape>::Type      &shape     = indexShape(index);
+        typename Fibre<TIndex, QGramBucketMap>::Type  &bucketMap = index.bucketMap;
+
+        // 1. clear counters
+        _qgramClearDir(dir, bucketMap, parallelTag);
+
+        // 2. count q-grams
+        _qgramCountQGrams(dir, bucketMap, text, shape, getStepSize(index), parallelTag);
+
+        if (_qgramDisableBuckets(index))
+        {
+            // 3. cumulative sum
+            _qgramCummulativeSum(dir, True(), parallelTag);
+
+            // 4. fill suffix array
+            _qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), True(), parallelTag);
+
+            // 5. correct disabled buckets
+            _qgramPostprocessBuckets(dir, parallelTag);
+        }
+        else
+        {
+            // 3. cumulative sum
+            _qgramCummulativeSum(dir, False(), parallelTag);
+
+            // 4. fill suffix array
+            _qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), False(), parallelTag);
+        }
+
+        // 6. restore the text order within the buckets
+        _qgramSortBuckets(sa, dir, parallelTag);
+    }
+
     // DEPRECATED
     // better use createQGramIndex(index) (above)
     template <
@@ -2277,6 +2638,19 @@ std::cout << "reading took " << omp_get_wtime() - start << " seconds.\n";
         return true;
     }
 
+    template <typename TText, typename TShapeSpec, typename TSpec, typename TParallel>
+    inline bool indexCreate(
+        Index<TText, IndexQGram<TShapeSpec, TSpec> > &index,
+        FibreSADir,
+        Tag<TParallel> const & parallelTag)
+    {
+        resize(indexSA(index), _qgramQGramCount(index), Exact());
+        resize(indexDir(index), _fullDirLength(index), Exact());
+        createQGramIndex(index, parallelTag);
+        resize(indexSA(index), back(indexDir(index)), Exact());     // shrink if some buckets were disabled
+        return true;
+    }
+
     template <typename TText, typename TSpec>
     inline bool indexSupplied(Index<TText, TSpec> &index, FibreSADir) {
         return !(empty(getFibre(index, FibreSA())) || empty(getFibre(index, FibreDir())));
@@ -345,6 +345,14 @@ inline bool indexCreate(Index<TText, IndexQGram<TShapeSpec, BucketRefinement> >
     return true;
 }
 
+// The directory and the full SA are created by the serial algorithms.
+template <typename TText, typename TShapeSpec, typename TParallel>
+inline bool indexCreate(Index<TText, IndexQGram<TShapeSpec, BucketRefinement> > & index, FibreSADir,
+                        Tag<TParallel> const & /* tag */)
+{
+    return indexCreate(index, FibreSADir(), Default());
+}
+
 // Works by creating the q-gram directory and quick-sorting the SA bucket-wise.
 //template <typename TText, typename TShapeSpec>
 //inline bool indexCreate(Index<TText, IndexQGram<TShapeSpec, BucketRefinement> > & index, FibreSADir, Default const)
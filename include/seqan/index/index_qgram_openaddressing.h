@@ -38,9 +38,6 @@
 namespace SEQAN_NAMESPACE_MAIN
 {
 
-    struct OpenAddressing_;
-    typedef Tag<OpenAddressing_> OpenAddressing;
-
     template <typename THashValue>
     struct BucketMap
     {
@@ -0,0 +1,865 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// In-memory suffix array construction by induced sorting (SA-IS).
+//
+// Nong G, Zhang S, Chan WH.  Two efficient algorithms for linear time
+// suffix array construction.  IEEE Trans. Comput. 60(10):1471-1484, 2011.
+//
+// The text is followed by a virtual sentinel that is smaller than all
+// characters.  As in the original algorithm, the reduced problem of each
+// recursion level is stored in the suffix array itself.  The parallel
+// variant distributes the classification of the suffix types, the bucket
+// counting, the naming of the LMS substrings and the induced sorting scans
+// among the threads.  The scans process the suffix array in blocks: the
+// entries of a block and the types and characters of their preceding
+// suffixes are read in parallel, the bucket slots are assigned in scan
+// order, and the induced suffixes landing behind the block are written in
+// parallel.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_INDEX_SA_SAIS_H
+#define SEQAN_HEADER_INDEX_SA_SAIS_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag Sais
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag IndexSAAlgorithm#Sais
+ * @headerfile <seqan/index.h>
+ * @brief Suffix array construction by induced sorting (SA-IS) in internal memory.
+ *
+ * @signature typedef Sais_<Serial> Sais;
+ * @signature typedef Sais_<Parallel> ParallelSais;
+ *
+ * Works for single strings and @link StringSet StringSets @endlink.  <tt>ParallelSais</tt> uses OpenMP for the
+ * classification of the suffix types, the bucket counting, the naming of the LMS substrings and the induced sorting
+ * scans.  The scans read blocks of the suffix array in parallel, look up the preceding suffixes in parallel and write
+ * the induced suffixes in parallel; only the assignment of the bucket slots is sequential.  It needs a suffix array
+ * string that can be accessed by several threads, i.e. not an External string.
+ *
+ * The reduced problems of the recursion are stored in the suffix array itself.  Besides the suffix array, the
+ * suffix types take <tt>n/64</tt> words and the bucket pointers <tt>sigma</tt> words, where <tt>sigma</tt> is the
+ * number of distinct LMS substrings, i.e. at most <tt>n/2</tt>, on the recursion levels.  The parallel scans buffer
+ * <tt>3*2^14</tt> words per thread.  For string sets, the suffix array of the text with separators takes
+ * <tt>n</tt> words, where <tt>n</tt> counts the separators, and the separator positions take <tt>n/32</tt> words,
+ * in addition to the suffix array of string set positions.
+ */
+
+template <typename TParallel>
+struct Sais_ {};
+
+typedef Sais_<Serial>   Sais;
+typedef Sais_<Parallel> ParallelSais;
+
+// ----------------------------------------------------------------------------
+// Class SaisText_
+// ----------------------------------------------------------------------------
+
+// Gives access to the ordinal values of the top-level text.
+template <typename TText>
+struct SaisText_
+{
+    TText const & text;
+
+    SaisText_(TText const & text) :
+        text(text)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class SaisStringSetText_
+// ----------------------------------------------------------------------------
+
+// Gives access to the sequences of a string set, each followed by a separator.
+// The separator of sequence i is seqCount - 1 - i, the characters are shifted
+// by seqCount.  The separator positions are marked in a bit string, ranks
+// holds the number of separators before each word of it.
+template <typename TStringSet, typename TSize>
+struct SaisStringSetText_
+{
+    TStringSet const &  stringSet;
+    TSize               seqCount;
+    String<TSize>       seqBegins;
+    String<__uint64>    separators;
+    String<TSize>       ranks;
+
+    SaisStringSetText_(TStringSet const & stringSet) :
+        stringSet(stringSet),
+        seqCount(length(stringSet))
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class SaisRange_
+// ----------------------------------------------------------------------------
+
+// A range of the top-level suffix array.  The recursion stores the reduced
+// suffix array at the front and the reduced text at the back of the suffix
+// array of its caller, all levels access them through this type.
+template <typename TSA>
+struct SaisRange_
+{
+    typedef typename Value<TSA>::Type TSize;
+
+    TSA &   sa;
+    TSize   offset;
+
+    SaisRange_(TSA & sa, TSize offset) :
+        sa(sa),
+        offset(offset)
+    {}
+
+    template <typename TPos>
+    inline typename Reference<TSA>::Type
+    operator[](TPos pos) const
+    {
+        return sa[offset + pos];
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _saisChar()
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TPos>
+inline typename ValueSize<typename Value<TText>::Type>::Type
+_saisChar(SaisText_<TText> const & text, TPos pos)
+{
+    return ordValue(text.text[pos]);
+}
+
+template <typename TSA, typename TPos>
+inline typename Value<TSA>::Type
+_saisChar(SaisRange_<TSA> const & text, TPos pos)
+{
+    return text[pos];
+}
+
+template <typename TString, typename TSpec, typename TSize>
+inline TSize
+_saisStringSetChar(StringSet<TString, TSpec> const & stringSet, String<TSize> const & seqBegins, TSize seqNo,
+                   TSize pos)
+{
+    return ordValue(stringSet[seqNo][pos - seqBegins[seqNo]]);
+}
+
+// The sequences of a ConcatDirect string set are stored consecutively.
+template <typename TString, typename TSpec, typename TSize>
+inline TSize
+_saisStringSetChar(StringSet<TString, Owner<ConcatDirect<TSpec> > > const & stringSet,
+                   String<TSize> const & /* seqBegins */, TSize seqNo, TSize pos)
+{
+    return ordValue(concat(stringSet)[pos - seqNo]);
+}
+
+template <typename TStringSet, typename TSize, typename TPos>
+inline TSize
+_saisChar(SaisStringSetText_<TStringSet, TSize> const & text, TPos pos)
+{
+    __uint64 word = text.separators[pos >> 6];
+
+    // The separators up to and including pos.
+    TSize rank = text.ranks[pos >> 6] + popCount(word & (((__uint64)2 << (pos & 63)) - 1));
+
+    if ((word >> (pos & 63)) & 1u)
+        return text.seqCount - rank;
+
+    return text.seqCount + _saisStringSetChar(text.stringSet, text.seqBegins, rank, static_cast<TSize>(pos));
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisIsS()
+// ----------------------------------------------------------------------------
+
+// The suffix types are stored in a bit string, a set bit marks an S-type suffix.
+template <typename TPos>
+inline bool
+_saisIsS(String<__uint64> const & types, TPos pos)
+{
+    return (types[pos >> 6] >> (pos & 63)) & 1u;
+}
+
+template <typename TPos>
+inline void
+_saisSetS(String<__uint64> & types, TPos pos, bool isS)
+{
+    if (isS)
+        types[pos >> 6] |= (__uint64)1 << (pos & 63);
+    else
+        types[pos >> 6] &= ~((__uint64)1 << (pos & 63));
+}
+
+template <typename TPos>
+inline bool
+_saisIsLms(String<__uint64> const & types, TPos pos)
+{
+    return pos > 0 && _saisIsS(types, pos) && !_saisIsS(types, pos - 1);
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisFill()
+// ----------------------------------------------------------------------------
+
+template <typename TSA, typename TSize, typename TParallel>
+inline void
+_saisFill(SaisRange_<TSA> const & sa, TSize fillBegin, TSize fillEnd, TSize value, Tag<TParallel> const &)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    SEQAN_OMP_PRAGMA(parallel for if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedSize i = fillBegin; i < static_cast<TSignedSize>(fillEnd); ++i)
+        sa[i] = value;
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisClassify()
+// ----------------------------------------------------------------------------
+
+// Computes the suffix types.  The text is split into blocks of whole words
+// that are classified independently assuming that the suffix following a
+// block is L-type.  Afterwards, the trailing runs of equal characters are
+// corrected from right to left.
+template <typename TText, typename TSize, typename TParallel>
+void
+_saisClassify(String<__uint64> & types, TText const & text, TSize n, Tag<TParallel> const & parallelTag)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    TSize words = (n + 63) / 64;
+    resize(types, words, 0, Exact());
+
+    Splitter<TSize> splitter(0, words, parallelTag);
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        TSize blockBegin = splitter[job] * 64;
+        TSize blockEnd = std::min(static_cast<TSize>(splitter[job + 1] * 64), n);
+        if (blockBegin >= blockEnd)
+            continue;
+
+        // The last suffix of the text is L-type as the sentinel is smaller.
+        bool nextIsS = false;
+        for (TSize i = blockEnd - 1; i > blockBegin; --i)
+        {
+            _saisSetS(types, i, nextIsS);
+            nextIsS = _saisChar(text, i - 1) < _saisChar(text, i) ||
+                      (_saisChar(text, i - 1) == _saisChar(text, i) && nextIsS);
+        }
+        _saisSetS(types, blockBegin, nextIsS);
+
+        // The block end is classified correctly only if it is followed by a different character.
+        if (blockEnd < n)
+        {
+            bool isS = _saisChar(text, blockEnd - 1) < _saisChar(text, blockEnd);
+            _saisSetS(types, blockEnd - 1, isS);
+            for (TSize i = blockEnd - 1; i > blockBegin && _saisChar(text, i - 1) == _saisChar(text, i); --i)
+                _saisSetS(types, i - 1, isS);
+        }
+    }
+
+    // Propagate the types of the following blocks into runs of equal characters.
+    for (TSignedSize job = static_cast<TSignedSize>(length(splitter)) - 2; job >= 0; --job)
+    {
+        TSize blockBegin = splitter[job] * 64;
+        TSize blockEnd = std::min(static_cast<TSize>(splitter[job + 1] * 64), n);
+        if (blockBegin >= blockEnd || blockEnd >= n || _saisChar(text, blockEnd - 1) != _saisChar(text, blockEnd))
+            continue;
+
+        bool isS = _saisIsS(types, blockEnd);
+        for (TSize i = blockEnd; i > blockBegin && _saisChar(text, i - 1) == _saisChar(text, i); --i)
+            _saisSetS(types, i - 1, isS);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisCountBuckets()
+// ----------------------------------------------------------------------------
+
+template <typename TBuckets, typename TText, typename TSize>
+void
+_saisCountBuckets(TBuckets & buckets, TText const & text, TSize n, TSize sigma, Serial const &)
+{
+    clear(buckets);
+    resize(buckets, sigma, 0, Exact());
+    for (TSize i = 0; i < n; ++i)
+        ++buckets[_saisChar(text, i)];
+}
+
+// Each thread counts a part of the text, the local counts are summed up
+// afterwards.  Small alphabets only, otherwise the local counters would not
+// pay off.
+template <typename TBuckets, typename TText, typename TSize>
+void
+_saisCountBuckets(TBuckets & buckets, TText const & text, TSize n, TSize sigma, Parallel const &)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    Splitter<TSize> splitter(0, n, Parallel());
+    if (length(splitter) < 2 || sigma * length(splitter) > n)
+    {
+        _saisCountBuckets(buckets, text, n, sigma, Serial());
+        return;
+    }
+
+    String<TBuckets> localBuckets;
+    resize(localBuckets, length(splitter), Exact());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        resize(localBuckets[job], sigma, 0, Exact());
+        for (TSize i = splitter[job]; i < splitter[job + 1]; ++i)
+            ++localBuckets[job][_saisChar(text, i)];
+    }
+
+    clear(buckets);
+    resize(buckets, sigma, 0, Exact());
+    for (TSize job = 0; job < length(splitter); ++job)
+        for (TSize c = 0; c < sigma; ++c)
+            buckets[c] += localBuckets[job][c];
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisBucketBegins() / _saisBucketEnds()
+// ----------------------------------------------------------------------------
+
+// The buckets are counted whenever they are needed, so that no counts are
+// kept during the recursion.
+template <typename TBuckets, typename TText, typename TSize, typename TParallel>
+inline void
+_saisBucketBegins(TBuckets & pointers, TText const & text, TSize n, TSize sigma, Tag<TParallel> const & parallelTag)
+{
+    _saisCountBuckets(pointers, text, n, sigma, parallelTag);
+
+    TSize sum = 0;
+    for (TSize c = 0; c < sigma; ++c)
+    {
+        TSize count = pointers[c];
+        pointers[c] = sum;
+        sum += count;
+    }
+}
+
+template <typename TBuckets, typename TText, typename TSize, typename TParallel>
+inline void
+_saisBucketEnds(TBuckets & pointers, TText const & text, TSize n, TSize sigma, Tag<TParallel> const & parallelTag)
+{
+    _saisCountBuckets(pointers, text, n, sigma, parallelTag);
+
+    TSize sum = 0;
+    for (TSize c = 0; c < sigma; ++c)
+    {
+        sum += pointers[c];
+        pointers[c] = sum;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisInduce()
+// ----------------------------------------------------------------------------
+
+// Induces the order of the L-type suffixes from the sorted LMS suffixes at
+// the ends of their buckets, then the order of the S-type suffixes from the
+// L-type suffixes.
+template <typename TSA, typename TText, typename TSize>
+void
+_saisInduce(SaisRange_<TSA> const & sa, TText const & text, String<__uint64> const & types, TSize n, TSize sigma,
+            Serial const &)
+{
+    TSize const EMPTY = MaxValue<TSize>::VALUE;
+    String<TSize> pointers;
+
+    // The suffix preceding the virtual sentinel is the smallest L-type suffix of its bucket.
+    _saisBucketBegins(pointers, text, n, sigma, Serial());
+    sa[pointers[_saisChar(text, n - 1)]++] = n - 1;
+    for (TSize i = 0; i < n; ++i)
+    {
+        TSize j = sa[i];
+        if (j != EMPTY && j > 0 && !_saisIsS(types, j - 1))
+            sa[pointers[_saisChar(text, j - 1)]++] = j - 1;
+    }
+
+    _saisBucketEnds(pointers, text, n, sigma, Serial());
+    for (TSize i = n; i > 0; --i)
+    {
+        TSize j = sa[i - 1];
+        if (j != EMPTY && j > 0 && _saisIsS(types, j - 1))
+            sa[--pointers[_saisChar(text, j - 1)]] = j - 1;
+    }
+}
+
+// Scans the suffix array in blocks and induces the same order as the serial
+// scans.  The entries of a block and the buckets of their preceding suffixes
+// are read in parallel.  The bucket slots are then assigned in scan order.
+// An entry written into the block during this pass differs from the one read
+// before and is looked up again.  Slots behind the block are written in
+// parallel once the block is done.
+template <typename TSA, typename TText, typename TSize>
+void
+_saisInduce(SaisRange_<TSA> const & sa, TText const & text, String<__uint64> const & types, TSize n, TSize sigma,
+            Parallel const &)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    static const TSize BLOCK_SIZE_PER_THREAD = 1 << 14;
+
+    TSize const EMPTY = MaxValue<TSize>::VALUE;
+    TSize blockSize = BLOCK_SIZE_PER_THREAD * static_cast<TSize>(omp_get_max_threads());
+
+    // The entries of the block when it was read, the buckets of their preceding suffixes and the slots to write.
+    String<TSize> suffixes;
+    String<TSize> buckets;
+    String<TSize> slots;
+    resize(suffixes, std::min(blockSize, n), Exact());
+    resize(buckets, std::min(blockSize, n), Exact());
+    resize(slots, std::min(blockSize, n), Exact());
+
+    String<TSize> pointers;
+
+    // The suffix preceding the virtual sentinel is the smallest L-type suffix of its bucket.
+    _saisBucketBegins(pointers, text, n, sigma, Parallel());
+    sa[pointers[_saisChar(text, n - 1)]++] = n - 1;
+    for (TSize blockBegin = 0; blockBegin < n; )
+    {
+        TSize blockLength = std::min(blockSize, n - blockBegin);
+        TSize blockEnd = blockBegin + blockLength;
+
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (TSignedSize k = 0; k < static_cast<TSignedSize>(blockLength); ++k)
+        {
+            TSize j = sa[blockBegin + k];
+            suffixes[k] = j;
+            buckets[k] = (j != EMPTY && j > 0 && !_saisIsS(types, j - 1)) ? _saisChar(text, j - 1) : EMPTY;
+        }
+
+        for (TSize k = 0; k < blockLength; ++k)
+        {
+            TSize j = sa[blockBegin + k];
+            if (j != suffixes[k])
+            {
+                suffixes[k] = j;
+                buckets[k] = (j != EMPTY && j > 0 && !_saisIsS(types, j - 1)) ? _saisChar(text, j - 1) : EMPTY;
+            }
+
+            slots[k] = EMPTY;
+            if (buckets[k] == EMPTY)
+                continue;
+
+            TSize slot = pointers[buckets[k]]++;
+            if (slot < blockEnd)
+                sa[slot] = j - 1;
+            else
+                slots[k] = slot;
+        }
+
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (TSignedSize k = 0; k < static_cast<TSignedSize>(blockLength); ++k)
+            if (slots[k] != EMPTY)
+                sa[slots[k]] = suffixes[k] - 1;
+
+        blockBegin = blockEnd;
+    }
+
+    _saisBucketEnds(pointers, text, n, sigma, Parallel());
+    for (TSize blockEnd = n; blockEnd > 0; )
+    {
+        TSize blockLength = std::min(blockSize, blockEnd);
+        TSize blockBegin = blockEnd - blockLength;
+
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (TSignedSize k = 0; k < static_cast<TSignedSize>(blockLength); ++k)
+        {
+            TSize j = sa[blockBegin + k];
+            suffixes[k] = j;
+            buckets[k] = (j != EMPTY && j > 0 && _saisIsS(types, j - 1)) ? _saisChar(text, j - 1) : EMPTY;
+        }
+
+        for (TSize k = blockLength; k > 0; --k)
+        {
+            TSize j = sa[blockBegin + k - 1];
+            if (j != suffixes[k - 1])
+            {
+                suffixes[k - 1] = j;
+                buckets[k - 1] = (j != EMPTY && j > 0 && _saisIsS(types, j - 1)) ? _saisChar(text, j - 1) : EMPTY;
+            }
+
+            slots[k - 1] = EMPTY;
+            if (buckets[k - 1] == EMPTY)
+                continue;
+
+            TSize slot = --pointers[buckets[k - 1]];
+            if (slot >= blockBegin)
+                sa[slot] = j - 1;
+            else
+                slots[k - 1] = slot;
+        }
+
+        SEQAN_OMP_PRAGMA(parallel for)
+        for (TSignedSize k = 0; k < static_cast<TSignedSize>(blockLength); ++k)
+            if (slots[k] != EMPTY)
+                sa[slots[k]] = suffixes[k] - 1;
+
+        blockEnd = blockBegin;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisLmsSubstringsDiffer()
+// ----------------------------------------------------------------------------
+
+// Compares the LMS substrings starting at p and q.  The substring ending at
+// the virtual sentinel is unique.
+template <typename TText, typename TSize>
+inline bool
+_saisLmsSubstringsDiffer(TText const & text, String<__uint64> const & types, TSize n, TSize p, TSize q)
+{
+    for (TSize d = 0; ; ++d)
+    {
+        if (p + d == n || q + d == n)
+            return true;
+        if (_saisChar(text, p + d) != _saisChar(text, q + d) || _saisIsS(types, p + d) != _saisIsS(types, q + d))
+            return true;
+        if (d > 0)
+        {
+            bool lmsP = _saisIsLms(types, p + d);
+            bool lmsQ = _saisIsLms(types, q + d);
+            if (lmsP || lmsQ)
+                return !(lmsP && lmsQ);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisNameLmsSubstrings()
+// ----------------------------------------------------------------------------
+
+// The n1 sorted LMS substrings are stored in sa[0..n1).  Stores the name of
+// the LMS substring starting at p in sa[n1 + p/2] and returns the number of
+// distinct names.
+template <typename TSA, typename TText, typename TSize>
+TSize
+_saisNameLmsSubstrings(SaisRange_<TSA> const & sa, TText const & text, String<__uint64> const & types, TSize n,
+                       TSize n1, Serial const &)
+{
+    TSize name = 0;
+    for (TSize i = 0; i < n1; ++i)
+    {
+        TSize pos = sa[i];
+        if (i == 0 || _saisLmsSubstringsDiffer(text, types, n, pos, static_cast<TSize>(sa[i - 1])))
+            ++name;
+        sa[n1 + pos / 2] = name - 1;
+    }
+    return name;
+}
+
+// Each thread marks the first substring of each group of equal substrings in
+// its part of sa[0..n1) and counts the marks.  The names then follow from the
+// counts of the preceding parts.
+template <typename TSA, typename TText, typename TSize>
+TSize
+_saisNameLmsSubstrings(SaisRange_<TSA> const & sa, TText const & text, String<__uint64> const & types, TSize n,
+                       TSize n1, Parallel const &)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    // The parts consist of whole words of marks.
+    String<__uint64> marks;
+    resize(marks, (n1 + 63) / 64, 0, Exact());
+
+    Splitter<TSize> splitter(0, length(marks), Parallel());
+
+    String<TSize> names;
+    resize(names, length(splitter) + 1, 0, Exact());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        TSize partEnd = std::min(static_cast<TSize>(splitter[job + 1] * 64), n1);
+        for (TSize i = splitter[job] * 64; i < partEnd; ++i)
+        {
+            if (i == 0 || _saisLmsSubstringsDiffer(text, types, n, static_cast<TSize>(sa[i]),
+                                                   static_cast<TSize>(sa[i - 1])))
+            {
+                _saisSetS(marks, i, true);
+                ++names[job + 1];
+            }
+        }
+    }
+
+    for (TSize job = 0; job < length(splitter); ++job)
+        names[job + 1] += names[job];
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        TSize name = names[job];
+        TSize partEnd = std::min(static_cast<TSize>(splitter[job + 1] * 64), n1);
+        for (TSize i = splitter[job] * 64; i < partEnd; ++i)
+        {
+            if (_saisIsS(marks, i))
+                ++name;
+            sa[n1 + sa[i] / 2] = name - 1;
+        }
+    }
+
+    return back(names);
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisCore()
+// ----------------------------------------------------------------------------
+
+// Computes the suffix array of text[0..n) over the alphabet [0..sigma).
+template <typename TSA, typename TText, typename TSize, typename TParallel>
+void
+_saisCore(SaisRange_<TSA> const & sa, TText const & text, TSize n, TSize sigma, Tag<TParallel> const & parallelTag)
+{
+    typedef typename MakeSigned<TSize>::Type TSignedSize;
+
+    TSize const EMPTY = MaxValue<TSize>::VALUE;
+
+    if (n == 0)
+        return;
+    if (n == 1)
+    {
+        sa[0] = 0;
+        return;
+    }
+
+    String<__uint64> types;
+    _saisClassify(types, text, n, parallelTag);
+
+    String<TSize> pointers;
+
+    // ------------------------------------------------------------------------
+    // Stage 1: Sort the LMS substrings.
+    // ------------------------------------------------------------------------
+
+    _saisFill(sa, static_cast<TSize>(0), n, EMPTY, parallelTag);
+    _saisBucketEnds(pointers, text, n, sigma, parallelTag);
+    for (TSize i = n - 1; i > 0; --i)
+        if (_saisIsLms(types, i))
+            sa[--pointers[_saisChar(text, i)]] = i;
+    clear(pointers);
+    shrinkToFit(pointers);
+    _saisInduce(sa, text, types, n, sigma, parallelTag);
+
+    // Move the sorted LMS substrings to the front and name them.
+    TSize n1 = 0;
+    for (TSize i = 0; i < n; ++i)
+        if (_saisIsLms(types, static_cast<TSize>(sa[i])))
+            sa[n1++] = sa[i];
+    _saisFill(sa, n1, n, EMPTY, parallelTag);
+    TSize names = _saisNameLmsSubstrings(sa, text, types, n, n1, Tag<TParallel>());
+
+    // The names in text order form the reduced text, move it to the back.
+    for (TSize i = n, j = n; i > n1; --i)
+        if (sa[i - 1] != EMPTY)
+            sa[--j] = sa[i - 1];
+
+    // ------------------------------------------------------------------------
+    // Stage 2: Sort the LMS suffixes, recurse if the names are not unique.
+    // ------------------------------------------------------------------------
+
+    // The reduced suffix array in sa[0..n1) and the reduced text in sa[n-n1..n) do not overlap as n1 <= n/2.
+    SaisRange_<TSA> reducedText(sa.sa, sa.offset + n - n1);
+    if (names < n1)
+    {
+        _saisCore(sa, reducedText, n1, names, parallelTag);
+    }
+    else
+    {
+        SEQAN_OMP_PRAGMA(parallel for if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+        for (TSignedSize i = 0; i < static_cast<TSignedSize>(n1); ++i)
+            sa[reducedText[i]] = i;
+    }
+
+    // Map the reduced suffixes back to their text positions.
+    for (TSize i = 1, j = 0; i < n; ++i)
+        if (_saisIsLms(types, i))
+            reducedText[j++] = i;
+
+    SEQAN_OMP_PRAGMA(parallel for if (IsSameType<Tag<TParallel>, Parallel>::VALUE))
+    for (TSignedSize i = 0; i < static_cast<TSignedSize>(n1); ++i)
+        sa[i] = reducedText[sa[i]];
+
+    // ------------------------------------------------------------------------
+    // Stage 3: Induce the order of all suffixes from the sorted LMS suffixes.
+    // ------------------------------------------------------------------------
+
+    // The i-th smallest LMS suffix moves to a slot right of or at i, hence the slots are filled from the right.
+    _saisFill(sa, n1, n, EMPTY, parallelTag);
+    _saisBucketEnds(pointers, text, n, sigma, parallelTag);
+    for (TSize i = n1; i > 0; --i)
+    {
+        TSize j = sa[i - 1];
+        sa[i - 1] = EMPTY;
+        sa[--pointers[_saisChar(text, j)]] = j;
+    }
+    clear(pointers);
+    shrinkToFit(pointers);
+    _saisInduce(sa, text, types, n, sigma, parallelTag);
+}
+
+// ----------------------------------------------------------------------------
+// Function _saisAlphabetSize()
+// ----------------------------------------------------------------------------
+
+template <typename TText>
+inline typename Size<TText>::Type
+_saisAlphabetSize(TText const & text)
+{
+    typedef typename Value<TText>::Type TValue;
+    typedef typename Size<TText>::Type TSize;
+
+    if (BitsPerValue<TValue>::VALUE <= 16)
+        return ValueSize<TValue>::VALUE;
+
+    TSize sigma = 0;
+    for (TSize i = 0; i < length(text); ++i)
+        sigma = std::max(sigma, static_cast<TSize>(ordValue(text[i]) + 1));
+    return sigma;
+}
+
+// ----------------------------------------------------------------------------
+// Function createSuffixArray()                                          [Sais]
+// ----------------------------------------------------------------------------
+
+template <typename TSA, typename TText, typename TParallel>
+inline void
+createSuffixArray(TSA & sa, TText const & text, Sais_<TParallel> const &)
+{
+    typedef typename Value<TSA>::Type TSize;
+
+    SEQAN_ASSERT_GEQ(length(sa), length(text));
+    SEQAN_ASSERT_LT(static_cast<__uint64>(length(text)), static_cast<__uint64>(MaxValue<TSize>::VALUE));
+
+    SaisText_<TText> saisText(text);
+    _saisCore(SaisRange_<TSA>(sa, 0), saisText, static_cast<TSize>(length(text)),
+              static_cast<TSize>(_saisAlphabetSize(text)), TParallel());
+}
+
+// For string sets, each sequence is terminated by a separator smaller than
+// all characters.  The separators are unique and decrease with the sequence
+// number, such that equal suffixes of different sequences are ordered by
+// descending sequence number as in the other suffix array algorithms.  The
+// text with separators is not built, see SaisStringSetText_.
+template <typename TSA, typename TSize, typename TString, typename TSetSpec, typename TParallel>
+void
+_createSuffixArraySais(TSA & sa, StringSet<TString, TSetSpec> const & stringSet, TSize, Tag<TParallel> const &)
+{
+    typedef StringSet<TString, TSetSpec>                    TStringSet;
+    typedef typename Value<TSA>::Type                       TSAValue;
+    typedef typename MakeSigned<TSize>::Type                TSignedSize;
+
+    TSize seqCount = length(stringSet);
+    TSize n = lengthSum(stringSet) + seqCount;
+    TSize sigma = seqCount + _saisAlphabetSize(concat(stringSet));
+
+    // The begin of sequence i is seqBegins[i], its separator is at seqBegins[i + 1] - 1.
+    SaisStringSetText_<TStringSet, TSize> text(stringSet);
+    resize(text.seqBegins, seqCount + 1, Exact());
+    resize(text.separators, (n + 63) / 64, 0, Exact());
+    resize(text.ranks, length(text.separators), Exact());
+    for (TSize seqNo = 0, pos = 0; seqNo < seqCount; ++seqNo)
+    {
+        text.seqBegins[seqNo] = pos;
+        pos += length(stringSet[seqNo]);
+        _saisSetS(text.separators, pos++, true);
+    }
+    text.seqBegins[seqCount] = n;
+    for (TSize word = 0, rank = 0; word < length(text.separators); ++word)
+    {
+        text.ranks[word] = rank;
+        rank += popCount(text.separators[word]);
+    }
+
+    String<TSize> fullSA;
+    resize(fullSA, n, Exact());
+    _saisCore(SaisRange_<String<TSize> >(fullSA, 0), text, n, sigma, Tag<TParallel>());
+
+    // The separators are the seqCount smallest suffixes, skip them and localize the others.
+    Splitter<TSize> splitter(seqCount, n, Tag<TParallel>());
+
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (TSignedSize job = 0; job < static_cast<TSignedSize>(length(splitter)); ++job)
+    {
+        typedef typename Iterator<String<TSize> const, Standard>::Type TBeginsIter;
+        for (TSize i = splitter[job]; i < splitter[job + 1]; ++i)
+        {
+            TSize pos = fullSA[i];
+            TBeginsIter it = std::upper_bound(begin(text.seqBegins, Standard()), end(text.seqBegins, Standard()),
+                                              pos) - 1;
+            TSAValue & value = sa[i - seqCount];
+            assignValueI1(value, it - begin(text.seqBegins, Standard()));
+            assignValueI2(value, pos - *it);
+        }
+    }
+}
+
+template <typename TSA, typename TString, typename TSetSpec, typename TParallel>
+inline void
+createSuffixArray(TSA & sa, StringSet<TString, TSetSpec> const & stringSet, Sais_<TParallel> const &)
+{
+    SEQAN_ASSERT_GEQ(length(sa), lengthSum(stringSet));
+
+    __uint64 n = lengthSum(stringSet) + length(stringSet);
+    if (n < MaxValue<unsigned>::VALUE)
+        _createSuffixArraySais(sa, stringSet, unsigned(), TParallel());
+    else
+        _createSuffixArraySais(sa, stringSet, __uint64(), TParallel());
+}
+
+}
+
+#endif  // #ifndef SEQAN_HEADER_INDEX_SA_SAIS_H
@@ -840,9 +840,15 @@ inline bool indexCreate(Index<TText, TSpec> & index, FibreSA, Trie)
     template <typename TValue>
     inline bool open(TValue & value, const char *fileName, int openMode)
     {
-        String<TValue, External< ExternalConfigLarge<> > > extString;
-        if (!open(extString, fileName, openMode & ~OPEN_CREATE)) return false;
-        if (!empty(extString)) assign(value, front(extString));
+        // Read the value directly, an External string would write its dirtied page back to the file.
+        File<> file;
+        if (!open(file, fileName, OPEN_RDONLY | (openMode & OPEN_QUIET))) return false;
+        if (static_cast<__uint64>(length(file)) >= sizeof(TValue) && !read(file, &value, 1))
+        {
+            close(file);
+            return false;
+        }
+        close(file);
         return true;
     }
 
@@ -866,6 +872,34 @@ inline bool indexCreate(Index<TText, TSpec> & index, FibreSA, Trie)
         return open(string, fileName, OPEN_RDONLY);
     }
 
+    // In-memory strings are read at once instead of page by page through an External string.
+    template < typename TValue, typename TSpec >
+    inline bool open(String<TValue, Alloc<TSpec> > &string, const char *fileName, int openMode) {
+    SEQAN_CHECKPOINT
+        typedef typename Size<File<> >::Type TFileSize;
+
+        // read() transfers less than 2 GiB per call on some platforms
+        const TFileSize MAX_CHUNK_LENGTH = (1u << 30) / sizeof(TValue);
+
+        File<> file;
+        if (!open(file, fileName, OPEN_RDONLY | (openMode & OPEN_QUIET))) return false;
+
+        TFileSize fileLength = length(file) / sizeof(TValue);
+        resize(string, fileLength, Exact());
+
+        bool success = true;
+        for (TFileSize pos = 0; success && pos < fileLength; pos += MAX_CHUNK_LENGTH)
+            success = read(file, begin(string, Standard()) + pos, std::min(fileLength - pos, MAX_CHUNK_LENGTH));
+
+        close(file);
+        return success;
+    }
+    template < typename TValue, typename TSpec >
+    inline bool open(String<TValue, Alloc<TSpec> > &string, const char *fileName) {
+    SEQAN_CHECKPOINT
+        return open(string, fileName, OPEN_RDONLY);
+    }
+
     template < typename THost, typename TSpec >
     inline bool open(Segment<THost, TSpec> &string, const char *fileName, int openMode) {
     SEQAN_CHECKPOINT
@@ -311,6 +311,22 @@ struct Fibre<Index<StringSet<ContainerView<TText, TViewSpec>, TSSetSpec>, FMInde
     typedef typename View<typename Fibre<Index<StringSet<TText, TSSetSpec>, FMIndex<TSpec, TConfig> > const, FibreSA>::Type>::Type     Type;
 };
 
+// ----------------------------------------------------------------------------
+// Metafunction FibreKmers                                       [FMIndex View]
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TViewSpec, typename TSpec, typename TConfig>
+struct Fibre<Index<ContainerView<TText, TViewSpec>, FMIndex<TSpec, TConfig> >, FibreKmers>
+{
+    typedef typename View<typename Fibre<Index<TText, FMIndex<TSpec, TConfig> >, FibreKmers>::Type>::Type    Type;
+};
+
+template <typename TText, typename TViewSpec, typename TSSetSpec, typename TSpec, typename TConfig>
+struct Fibre<Index<StringSet<ContainerView<TText, TViewSpec>, TSSetSpec>, FMIndex<TSpec, TConfig> >, FibreKmers>
+{
+    typedef typename View<typename Fibre<Index<StringSet<TText, TSSetSpec>, FMIndex<TSpec, TConfig> >, FibreKmers>::Type>::Type   Type;
+};
+
 // ----------------------------------------------------------------------------
 // Metafunction FibrePrefixSums                                       [LF View]
 // ----------------------------------------------------------------------------
@@ -773,6 +789,7 @@ view(Index<TText, FMIndex<TSpec, TConfig> > & index)
     indexText(indexView) = view(indexText(index));
     indexLF(indexView) = view(indexLF(index));
     indexSA(indexView) = view(indexSA(index));
+    getFibre(indexView, FibreKmers()) = view(getFibre(index, FibreKmers()));
 
     return indexView;
 }
@@ -108,12 +108,14 @@ struct NameStoreLess_
  * @endlink.  The query function @link NameStoreCache#nameToId @endlink, the cache can also be modified (and thus
  * updated).
  *
- * @signature template <typename TNameStore[, typename TName]>
+ * @signature template <typename TNameStore[, typename TName[, typename TSpec]]>
  *            class NameStoreCache;
  *
  * @tparam TNameStore The type to use for the name store.  Usually a @link StringSet @endlink of
  *                    @link CharString @endlink.
  * @tparam TName      The type to use for the names, defaults to <tt>Value&lt;TNameStore&gt;::Type</tt>.
+ * @tparam TSpec      The specializing type.  Defaults to <tt>void</tt> (binary search tree), use
+ *                    <tt>OpenAddressing</tt> for a hash table.
  *
  * @section Example
  *
@@ -141,7 +143,9 @@ struct NameStoreLess_
  * @param[in] nameStore A NameStore for which a pointer is stored.
  */
 
-template <typename TNameStore, typename TName = String<typename Value<typename Value<TNameStore>::Type>::Type> >
+template <typename TNameStore,
+          typename TName = String<typename Value<typename Value<TNameStore>::Type>::Type>,
+          typename TSpec = void>
 class NameStoreCache
 {
 public:
@@ -171,6 +175,63 @@ public:
     }
 };
 
+// ----------------------------------------------------------------------------
+// class OpenAddressing NameStoreCache
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class OpenAddressingNameStoreCache OpenAddressing NameStoreCache
+ * @extends NameStoreCache
+ * @headerfile <seqan/misc/name_store_cache.h>
+ * @brief NameStoreCache that uses a hash table with open addressing instead of a binary search tree.
+ *
+ * @signature template <typename TNameStore, typename TName>
+ *            class NameStoreCache<TNameStore, TName, OpenAddressing>;
+ *
+ * @tparam TNameStore The type to use for the name store.
+ * @tparam TName      Unused, only kept for compatibility with the default NameStoreCache.
+ *
+ * Lookups take expected constant time and compare only names with equal hash values.  The table stores the ids of
+ * the names and their hash values and is doubled when it becomes half full.  If a name occurs more than once in the
+ * name store, the id of its first occurrence is returned, as for the default NameStoreCache.
+ *
+ * In contrast to the default NameStoreCache, @link NameStoreCache#getIdByName @endlink does not modify the cache and
+ * can be called from several threads at once.
+ *
+ * The hashed cache can be used for BAM I/O by passing it to the @link BamIOContext @endlink:
+ *
+ * @code{.cpp}
+ * typedef StringSet<CharString>                                    TNameStore;
+ * typedef NameStoreCache<TNameStore, CharString, OpenAddressing>   TNameStoreCache;
+ * typedef BamIOContext<TNameStore, TNameStoreCache>                TBamIOContext;
+ * @endcode
+ */
+
+template <typename TNameStore, typename TName>
+class NameStoreCache<TNameStore, TName, OpenAddressing>
+{
+public:
+    typedef typename Position<TNameStore>::Type TId;
+    typedef unsigned                            THash;
+
+    TNameStore *    nameStore;
+    String<TId>     table;          // ids of the names, maxValue<TId>() marks empty slots
+    String<THash>   hashes;         // hash value of each slot
+    TId             count;          // number of occupied slots
+
+    NameStoreCache() :
+        nameStore(NULL),
+        count(0)
+    {}
+
+    NameStoreCache(TNameStore & nameStore_) :
+        nameStore(&nameStore_),
+        count(0)
+    {
+        refresh(*this);
+    }
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -180,7 +241,107 @@ public:
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// refresh()
+// Function _nameStoreHash()
+// ----------------------------------------------------------------------------
+
+// FNV-1a hash over the ordinal values of a name.
+template <typename TName>
+inline unsigned
+_nameStoreHash(TName const & name)
+{
+    typedef typename Iterator<TName const, Standard>::Type TIter;
+
+    unsigned hash = 2166136261u;
+    TIter itEnd = end(name, Standard());
+    for (TIter it = begin(name, Standard()); it != itEnd; ++it)
+        hash = (hash ^ static_cast<unsigned>(ordValue(*it))) * 16777619u;
+    return hash;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findSlot()
+// ----------------------------------------------------------------------------
+
+// Returns the slot containing name or the empty slot where it would be inserted.
+template <typename TNameStore, typename TName, typename TName2>
+inline typename Size<String<typename Position<TNameStore>::Type> >::Type
+_findSlot(NameStoreCache<TNameStore, TName, OpenAddressing> const & cache, TName2 const & name, unsigned hash)
+{
+    typedef typename Position<TNameStore>::Type     TId;
+    typedef typename Size<String<TId> >::Type       TSize;
+
+    TSize mask = length(cache.table) - 1;
+    TSize slot = hash & mask;
+
+    // linear probing, the table is at most half full
+    while (cache.table[slot] != maxValue<TId>())
+    {
+        if (cache.hashes[slot] == hash && (*cache.nameStore)[cache.table[slot]] == name)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// ----------------------------------------------------------------------------
+// Function _resizeTable()
+// ----------------------------------------------------------------------------
+
+// Resizes the table to newSize slots (a power of 2) and rehashes all entries.
+template <typename TNameStore, typename TName, typename TSize>
+inline void
+_resizeTable(NameStoreCache<TNameStore, TName, OpenAddressing> & cache, TSize newSize)
+{
+    typedef typename Position<TNameStore>::Type     TId;
+
+    String<TId> oldTable;
+    String<unsigned> oldHashes;
+    swap(oldTable, cache.table);
+    swap(oldHashes, cache.hashes);
+
+    resize(cache.table, newSize, maxValue<TId>(), Exact());
+    resize(cache.hashes, newSize, Exact());
+
+    TSize mask = newSize - 1;
+    for (TSize i = 0; i < (TSize)length(oldTable); ++i)
+    {
+        if (oldTable[i] == maxValue<TId>())
+            continue;
+
+        TSize slot = oldHashes[i] & mask;
+        while (cache.table[slot] != maxValue<TId>())
+            slot = (slot + 1) & mask;
+        cache.table[slot] = oldTable[i];
+        cache.hashes[slot] = oldHashes[i];
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _insertName()
+// ----------------------------------------------------------------------------
+
+// Registers the name with the given id, names already in the cache keep their id.
+template <typename TNameStore, typename TName, typename TId>
+inline void
+_insertName(NameStoreCache<TNameStore, TName, OpenAddressing> & cache, TId id)
+{
+    typedef typename Size<String<typename Position<TNameStore>::Type> >::Type TSize;
+
+    if (2 * (cache.count + 1) > length(cache.table))
+        _resizeTable(cache, _max(2 * (TSize)length(cache.table), (TSize)16));
+
+    unsigned hash = _nameStoreHash((*cache.nameStore)[id]);
+    TSize slot = _findSlot(cache, (*cache.nameStore)[id], hash);
+    if (cache.table[slot] == maxValue<typename Position<TNameStore>::Type>())
+    {
+        cache.table[slot] = id;
+        cache.hashes[slot] = hash;
+        ++cache.count;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function host()
 // ----------------------------------------------------------------------------
 
 template <typename TNameStore, typename TName>
@@ -197,6 +358,20 @@ host(NameStoreCache<TNameStore, TName> const & cache)
     return *cache.nameSet.key_comp().nameStore;
 }
 
+template <typename TNameStore, typename TName>
+inline TNameStore &
+host(NameStoreCache<TNameStore, TName, OpenAddressing> & cache)
+{
+    return *cache.nameStore;
+}
+
+template <typename TNameStore, typename TName>
+inline TNameStore &
+host(NameStoreCache<TNameStore, TName, OpenAddressing> const & cache)
+{
+    return *cache.nameStore;
+}
+
 // ----------------------------------------------------------------------------
 // Function clear()
 // ----------------------------------------------------------------------------
@@ -217,6 +392,15 @@ clear(NameStoreCache<TNameStore, TName> &cache)
     cache.nameSet.clear();
 }
 
+template <typename TNameStore, typename TName>
+inline void
+clear(NameStoreCache<TNameStore, TName, OpenAddressing> &cache)
+{
+    clear(cache.table);
+    clear(cache.hashes);
+    cache.count = 0;
+}
+
 // ----------------------------------------------------------------------------
 // Function empty()
 // ----------------------------------------------------------------------------
@@ -239,6 +423,13 @@ empty(NameStoreCache<TNameStore, TName> const &cache)
     return cache.nameSet.empty();
 }
 
+template <typename TNameStore, typename TName>
+inline bool
+empty(NameStoreCache<TNameStore, TName, OpenAddressing> const &cache)
+{
+    return cache.count == 0;
+}
+
 // ----------------------------------------------------------------------------
 // Function refresh()
 // ----------------------------------------------------------------------------
@@ -263,6 +454,25 @@ refresh(NameStoreCache<TNameStore, TName> &cache)
         cache.nameSet.insert(i);
 }
 
+template <typename TNameStore, typename TName>
+inline void
+refresh(NameStoreCache<TNameStore, TName, OpenAddressing> &cache)
+{
+    typedef typename Position<TNameStore>::Type     TId;
+    typedef typename Size<String<TId> >::Type       TSize;
+
+    clear(cache);
+
+    // reserve a table that is at most half full
+    TSize tableSize = 16;
+    while (tableSize < 2 * (TSize)length(*cache.nameStore))
+        tableSize <<= 1;
+    _resizeTable(cache, tableSize);
+
+    for (TId i = 0; i < (TId)length(*cache.nameStore); ++i)
+        _insertName(cache, i);
+}
+
 // ----------------------------------------------------------------------------
 // Function appendName()
 // ----------------------------------------------------------------------------
@@ -293,6 +503,13 @@ void appendName(NameStoreCache<TCNameStore, TCName> & cache, TName const & name)
     cache.nameSet.insert(length(host(cache)) - 1);
 }
 
+template <typename TCNameStore, typename TCName, typename TName>
+void appendName(NameStoreCache<TCNameStore, TCName, OpenAddressing> & cache, TName const & name)
+{
+    appendValue(host(cache), name, Generous());
+    _insertName(cache, length(host(cache)) - 1);
+}
+
 // TODO(holtgrew): Add deprecation annotation for compiler warnings.
 
 // deprecated.
@@ -311,6 +528,14 @@ void appendName(TNameStore &nameStore, TName const & name, NameStoreCache<TCName
     context.nameSet.insert(length(nameStore) - 1);
 }
 
+// deprecated.
+template <typename TNameStore, typename TName, typename TCNameStore, typename TCName>
+void appendName(TNameStore &nameStore, TName const & name, NameStoreCache<TCNameStore, TCName, OpenAddressing> &context)
+{
+    appendValue(nameStore, name, Generous());
+    _insertName(context, length(nameStore) - 1);
+}
+
 // ----------------------------------------------------------------------------
 // Function getIdByName()
 // ----------------------------------------------------------------------------
@@ -379,6 +604,23 @@ getIdByName(TPos & pos, NameStoreCache<TCNameStore, TCName> const & context, TNa
     return false;
 }
 
+template <typename TCNameStore, typename TCName, typename TName, typename TPos>
+inline bool
+getIdByName(TPos & pos, NameStoreCache<TCNameStore, TCName, OpenAddressing> const & context, TName const & name)
+{
+    typedef typename Position<TCNameStore>::Type TId;
+
+    if (empty(context.table))
+        return false;
+
+    TId id = context.table[_findSlot(context, name, _nameStoreHash(name))];
+    if (id == maxValue<TId>())
+        return false;
+
+    pos = id;
+    return true;
+}
+
 // deprecated.
 template <typename TNameStore, typename TName, typename TPos, typename TContext>
 inline bool
@@ -388,9 +630,10 @@ getIdByName(TNameStore const & nameStore, TName const & name, TPos & pos, TConte
 }
 
 // deprecated.
-template<typename TNameStore, typename TName, typename TPos, typename TCNameStore, typename TCName>
+template<typename TNameStore, typename TName, typename TPos, typename TCNameStore, typename TCName, typename TCSpec>
 inline bool
-getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos, NameStoreCache<TCNameStore, TCName> const & context)
+getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos,
+            NameStoreCache<TCNameStore, TCName, TCSpec> const & context)
 {
     return getIdByName(pos, context, name);
 }
@@ -419,9 +662,9 @@ getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos, Na
  */
 
 // Append contig name to name store, if not known already.
-template <typename TNameStore, typename TName, typename TName2>
+template <typename TNameStore, typename TName, typename TSpec, typename TName2>
 typename Position<TNameStore>::Type
-nameToId(NameStoreCache<TNameStore, TName> & cache, TName2 const & name)
+nameToId(NameStoreCache<TNameStore, TName, TSpec> & cache, TName2 const & name)
 {
     typename Size<TNameStore>::Type nameId = 0;
     if (!getIdByName(nameId, cache, name))
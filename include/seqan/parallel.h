@@ -99,4 +99,9 @@
 #include <seqan/parallel/parallel_resource_pool.h>
 #include <seqan/parallel/parallel_serializer.h>
 
+// Task scheduling.
+#ifdef SEQAN_CXX11_STL
+#include <seqan/parallel/parallel_work_stealing.h>
+#endif
+
 #endif  // SEQAN_PARALLEL_H_
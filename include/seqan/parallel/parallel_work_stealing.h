@@ -0,0 +1,647 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Work-stealing thread pool
+// ==========================================================================
+// Each worker thread owns a Chase-Lev deque.  Tasks spawned by a worker are
+// pushed to and popped from the back of its own deque, idle workers steal
+// from the front of the deques of other workers.  Tasks spawned by other
+// threads go through a shared ConcurrentQueue.  A thread waiting for a task
+// group executes pending tasks until the group is finished.
+//
+// D. Chase and Y. Lev.  Dynamic circular work-stealing deque.  SPAA 2005.
+// N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli.  Correct and efficient
+// work-stealing for weak memory models.  PPoPP 2013.
+// ==========================================================================
+
+#ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+#define SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+class ThreadPool;
+class TaskGroup;
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingDeque
+// ----------------------------------------------------------------------------
+/*!
+ * @class WorkStealingDeque
+ * @headerfile <seqan/parallel.h>
+ * @brief Lock-free deque with a single owner and multiple thieves.
+ *
+ * @signature template <typename TValue>
+ *            class WorkStealingDeque;
+ *
+ * @tparam TValue Element type of the deque, must be trivially copyable, e.g. a pointer.
+ *
+ * The owner thread appends and removes elements at the back with @link WorkStealingDeque#appendValue @endlink and
+ * @link WorkStealingDeque#tryPopBack @endlink, any other thread removes elements from the front with @link
+ * WorkStealingDeque#trySteal @endlink.  The ring buffer grows on demand; replaced buffers are kept until the deque is
+ * destroyed as thieves might still read from them.
+ */
+
+template <typename TValue>
+class WorkStealingDeque
+{
+public:
+    struct Buffer_
+    {
+        __int64                 mask;
+        std::atomic<TValue> *   slots;
+
+        explicit
+        Buffer_(__int64 capacity) :
+            mask(capacity - 1),
+            slots(new std::atomic<TValue>[capacity])
+        {}
+
+        ~Buffer_()
+        {
+            delete[] slots;
+        }
+    };
+
+    std::atomic<__int64>    top;
+    std::atomic<__int64>    bottom;
+    std::atomic<Buffer_ *>  buffer;
+    String<Buffer_ *>       retired;
+
+    explicit
+    WorkStealingDeque(__int64 capacity = 64) :
+        top(0),
+        bottom(0),
+        buffer(new Buffer_(capacity))
+    {
+        SEQAN_ASSERT_EQ(capacity & (capacity - 1), 0);
+    }
+
+    ~WorkStealingDeque()
+    {
+        delete buffer.load(std::memory_order_relaxed);
+        for (unsigned i = 0; i < length(retired); ++i)
+            delete retired[i];
+    }
+
+private:
+    WorkStealingDeque(WorkStealingDeque const &);
+    void operator=(WorkStealingDeque const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class TaskGroup
+// ----------------------------------------------------------------------------
+/*!
+ * @class TaskGroup
+ * @headerfile <seqan/parallel.h>
+ * @brief A set of tasks spawned into a @link ThreadPool @endlink that can be waited for.
+ *
+ * @signature class TaskGroup;
+ *
+ * Tasks are added with @link TaskGroup#spawn @endlink, which may also be called from within tasks of the group.
+ * @link TaskGroup#waitFor @endlink returns once all tasks of the group have finished and rethrows the first exception
+ * thrown by a task.  The calling thread executes pending tasks of the pool while waiting.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * ThreadPool pool(4);
+ * TaskGroup group(pool);
+ * for (unsigned i = 0; i < length(jobs); ++i)
+ *     spawn(group, [&, i]() { verify(jobs[i]); });
+ * waitFor(group);
+ * @endcode
+ */
+
+class TaskGroup
+{
+public:
+    ThreadPool &                pool;
+    std::atomic<__uint64>       pending;
+    std::atomic<bool>           failed;
+    std::exception_ptr          exception;
+
+    explicit
+    TaskGroup(ThreadPool & pool) :
+        pool(pool),
+        pending(0),
+        failed(false)
+    {}
+
+    ~TaskGroup()
+    {
+        SEQAN_ASSERT_EQ(pending.load(), 0u);
+    }
+
+private:
+    TaskGroup(TaskGroup const &);
+    void operator=(TaskGroup const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadPoolTask_
+// ----------------------------------------------------------------------------
+
+struct ThreadPoolTask_
+{
+    std::function<void()>   func;
+    TaskGroup &             group;
+
+    template <typename TFunc>
+    ThreadPoolTask_(TaskGroup & group, TFunc && func) :
+        func(std::forward<TFunc>(func)),
+        group(group)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadPool
+// ----------------------------------------------------------------------------
+/*!
+ * @class ThreadPool
+ * @headerfile <seqan/parallel.h>
+ * @brief A pool of worker threads scheduling tasks by work stealing.
+ *
+ * @signature class ThreadPool;
+ *
+ * The pool starts the given number of worker threads on construction and joins them on destruction.  Each worker owns
+ * a @link WorkStealingDeque @endlink, tasks spawned by a worker are executed depth-first by that worker unless they get
+ * stolen by an idle worker.  Idle workers sleep until new tasks are spawned.
+ *
+ * @see TaskGroup
+ */
+
+class ThreadPool
+{
+public:
+    typedef WorkStealingDeque<ThreadPoolTask_ *>    TDeque;
+    typedef ConcurrentQueue<ThreadPoolTask_ *>      TQueue;
+
+    String<TDeque *>            deques;
+    String<std::thread *>       threads;
+    TQueue                      injected;
+
+    std::atomic<__uint64>       queued;
+    std::atomic<unsigned>       sleeping;
+    std::atomic<bool>           stop;
+    std::mutex                  mutex;
+    std::condition_variable     wakeUp;
+
+    explicit
+    ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+
+    ~ThreadPool();
+
+private:
+    ThreadPool(ThreadPool const &);
+    void operator=(ThreadPool const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadPoolWorker_
+// ----------------------------------------------------------------------------
+// The worker the current thread is running for, if any.
+
+struct ThreadPoolWorker_
+{
+    ThreadPool *    pool;
+    unsigned        id;
+    unsigned        seed;
+};
+
+inline ThreadPoolWorker_ & _currentWorker()
+{
+    static thread_local ThreadPoolWorker_ worker = { NULL, 0, 0 };
+    return worker;
+}
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function appendValue()                                   [WorkStealingDeque]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn WorkStealingDeque#appendValue
+ * @brief Appends an element at the back, may only be called by the owner.
+ *
+ * @signature void appendValue(deque, val);
+ *
+ * @param[in,out] deque The WorkStealingDeque.
+ * @param[in]     val   The element to append.
+ */
+
+template <typename TValue, typename TValue2>
+inline void
+appendValue(WorkStealingDeque<TValue> & me, TValue2 SEQAN_FORWARD_CARG val)
+{
+    typedef typename WorkStealingDeque<TValue>::Buffer_ TBuffer;
+
+    __int64 b = me.bottom.load(std::memory_order_relaxed);
+    __int64 t = me.top.load(std::memory_order_acquire);
+    TBuffer * buf = me.buffer.load(std::memory_order_relaxed);
+
+    if (b - t > buf->mask)
+    {
+        TBuffer * newBuf = new TBuffer(2 * (buf->mask + 1));
+        for (__int64 i = t; i < b; ++i)
+            newBuf->slots[i & newBuf->mask].store(buf->slots[i & buf->mask].load(std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+        appendValue(me.retired, buf);
+        me.buffer.store(newBuf, std::memory_order_release);
+        buf = newBuf;
+    }
+
+    buf->slots[b & buf->mask].store(val, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    me.bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Function tryPopBack()                                    [WorkStealingDeque]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn WorkStealingDeque#tryPopBack
+ * @brief Removes the last element, may only be called by the owner.
+ *
+ * @signature bool tryPopBack(val, deque);
+ *
+ * @param[out]    val   The removed element.
+ * @param[in,out] deque The WorkStealingDeque.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty.
+ */
+
+template <typename TValue>
+inline bool
+tryPopBack(TValue & val, WorkStealingDeque<TValue> & me)
+{
+    typedef typename WorkStealingDeque<TValue>::Buffer_ TBuffer;
+
+    __int64 b = me.bottom.load(std::memory_order_relaxed) - 1;
+    TBuffer * buf = me.buffer.load(std::memory_order_relaxed);
+    me.bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    __int64 t = me.top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        me.bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    val = buf->slots[b & buf->mask].load(std::memory_order_relaxed);
+
+    if (t == b)
+    {
+        // The last element, race against the thieves.
+        bool won = me.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        me.bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function trySteal()                                      [WorkStealingDeque]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn WorkStealingDeque#trySteal
+ * @brief Removes the first element, may be called by any thread.
+ *
+ * @signature bool trySteal(val, deque);
+ *
+ * @param[out]    val   The removed element.
+ * @param[in,out] deque The WorkStealingDeque.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty or another thread
+ *              removed the first element concurrently.
+ */
+
+template <typename TValue>
+inline bool
+trySteal(TValue & val, WorkStealingDeque<TValue> & me)
+{
+    typedef typename WorkStealingDeque<TValue>::Buffer_ TBuffer;
+
+    __int64 t = me.top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    __int64 b = me.bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+        return false;
+
+    TBuffer * buf = me.buffer.load(std::memory_order_acquire);
+    val = buf->slots[t & buf->mask].load(std::memory_order_relaxed);
+
+    return me.top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()                                         [WorkStealingDeque]
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline bool
+empty(WorkStealingDeque<TValue> const & me)
+{
+    return me.bottom.load(std::memory_order_relaxed) <= me.top.load(std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Function _runTask()                                             [ThreadPool]
+// ----------------------------------------------------------------------------
+
+inline void
+_runTask(ThreadPoolTask_ * task)
+{
+    TaskGroup & group = task->group;
+
+    try
+    {
+        task->func();
+    }
+    catch (...)
+    {
+        bool expected = false;
+        if (group.failed.compare_exchange_strong(expected, true))
+            group.exception = std::current_exception();
+    }
+
+    delete task;
+    group.pending.fetch_sub(1, std::memory_order_release);
+}
+
+// ----------------------------------------------------------------------------
+// Function _tryGetTask()                                          [ThreadPool]
+// ----------------------------------------------------------------------------
+// Takes a task from the own deque, the shared queue or another worker's deque, in this order.
+
+inline bool
+_tryGetTask(ThreadPoolTask_ * & task, ThreadPool & pool)
+{
+    ThreadPoolWorker_ & worker = _currentWorker();
+    unsigned threadCount = length(pool.deques);
+    bool isWorker = worker.pool == &pool;
+
+    if (isWorker && tryPopBack(task, *pool.deques[worker.id]))
+        return true;
+
+    if (tryPopFront(task, pool.injected))
+        return true;
+
+    if (threadCount == 0)
+        return false;
+
+    // Start at a random victim to spread the thieves.
+    worker.seed = worker.seed * 1103515245u + 12345u;
+    unsigned victim = (worker.seed >> 16) % threadCount;
+    for (unsigned i = 0; i < threadCount; ++i, victim = (victim + 1) % threadCount)
+    {
+        if (isWorker && victim == worker.id)
+            continue;
+        if (trySteal(task, *pool.deques[victim]))
+            return true;
+    }
+
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function _tryRunTask()                                          [ThreadPool]
+// ----------------------------------------------------------------------------
+
+inline bool
+_tryRunTask(ThreadPool & pool)
+{
+    ThreadPoolTask_ * task;
+
+    if (!_tryGetTask(task, pool))
+        return false;
+
+    pool.queued.fetch_sub(1, std::memory_order_relaxed);
+    _runTask(task);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _workerLoop()                                          [ThreadPool]
+// ----------------------------------------------------------------------------
+
+inline void
+_workerLoop(ThreadPool & pool, unsigned id)
+{
+    ThreadPoolWorker_ & worker = _currentWorker();
+    worker.pool = &pool;
+    worker.id = id;
+    worker.seed = id + 1;
+
+    SpinDelay spinDelay;
+    while (true)
+    {
+        if (_tryRunTask(pool))
+        {
+            clear(spinDelay);
+            continue;
+        }
+
+        if (spinDelay.duration <= SpinDelay::LOOPS_BEFORE_YIELD)
+        {
+            waitFor(spinDelay);
+            continue;
+        }
+
+        // Sleep until a task is spawned.  The counters are sequentially consistent: either the spawning thread sees
+        // this thread sleeping or this thread sees the queued task.
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        pool.sleeping.fetch_add(1);
+        while (pool.queued.load() == 0 && !pool.stop.load())
+            pool.wakeUp.wait(lock);
+        pool.sleeping.fetch_sub(1);
+
+        if (pool.stop.load() && pool.queued.load() == 0)
+            return;
+
+        clear(spinDelay);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// ThreadPool Constructor / Destructor
+// ----------------------------------------------------------------------------
+
+inline
+ThreadPool::ThreadPool(unsigned threadCount) :
+    queued(0),
+    sleeping(0),
+    stop(false)
+{
+    if (threadCount == 0)
+        threadCount = 1;
+
+    resize(deques, threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+        deques[i] = new TDeque();
+
+    resize(threads, threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+        threads[i] = new std::thread(_workerLoop, std::ref(*this), i);
+}
+
+inline
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop.store(true);
+    }
+    wakeUp.notify_all();
+
+    for (unsigned i = 0; i < length(threads); ++i)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    for (unsigned i = 0; i < length(deques); ++i)
+        delete deques[i];
+}
+
+// ----------------------------------------------------------------------------
+// Function length()                                               [ThreadPool]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn ThreadPool#length
+ * @brief Returns the number of worker threads.
+ *
+ * @signature unsigned length(pool);
+ */
+
+inline unsigned
+length(ThreadPool const & pool)
+{
+    return length(pool.threads);
+}
+
+// ----------------------------------------------------------------------------
+// Function spawn()                                                 [TaskGroup]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn TaskGroup#spawn
+ * @brief Schedules a task in the thread pool of a task group.
+ *
+ * @signature void spawn(group, func);
+ *
+ * @param[in,out] group The TaskGroup the task belongs to.
+ * @param[in]     func  A callable object without arguments, e.g. a lambda function.
+ *
+ * Tasks spawned by a worker thread of the pool are pushed onto its own deque, tasks spawned by other threads are
+ * enqueued into a queue shared by all workers.
+ */
+
+template <typename TFunc>
+inline void
+spawn(TaskGroup & group, TFunc && func)
+{
+    ThreadPool & pool = group.pool;
+    ThreadPoolWorker_ & worker = _currentWorker();
+    ThreadPoolTask_ * task = new ThreadPoolTask_(group, std::forward<TFunc>(func));
+
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (worker.pool == &pool)
+        appendValue(*pool.deques[worker.id], task);
+    else
+        appendValue(pool.injected, task);
+
+    pool.queued.fetch_add(1);
+
+    if (pool.sleeping.load() > 0)
+    {
+        { std::lock_guard<std::mutex> lock(pool.mutex); }
+        pool.wakeUp.notify_one();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function waitFor()                                               [TaskGroup]
+// ----------------------------------------------------------------------------
+/*!
+ * @fn TaskGroup#waitFor
+ * @brief Waits until all tasks of a group have finished.
+ *
+ * @signature void waitFor(group);
+ *
+ * @param[in,out] group The TaskGroup to wait for.
+ *
+ * The calling thread executes pending tasks of the pool while waiting, hence tasks can wait for nested task groups
+ * without blocking a worker.  If a task of the group threw an exception, the first one is rethrown.
+ */
+
+inline void
+waitFor(TaskGroup & group)
+{
+    SpinDelay spinDelay;
+    while (group.pending.load(std::memory_order_acquire) != 0)
+    {
+        if (_tryRunTask(group.pool))
+            clear(spinDelay);
+        else
+            waitFor(spinDelay);
+    }
+
+    if (group.failed.load())
+    {
+        std::exception_ptr exception = group.exception;
+        group.exception = std::exception_ptr();
+        group.failed.store(false);
+        std::rethrow_exception(exception);
+    }
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
@@ -44,6 +44,7 @@
 #include <seqan/basic.h>
 #include <seqan/stream.h>
 #include <seqan/misc/name_store_cache.h>
+#include <seqan/parallel.h>
 
 // ===========================================================================
 // Sequence File Formats
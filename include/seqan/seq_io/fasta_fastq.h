@@ -417,6 +417,127 @@ inline void readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, T
     skipUntil(iter, TFastqBegin());     // forward to the next '@'
 }
 
+// ----------------------------------------------------------------------------
+// Class SeqRecordScan_
+// ----------------------------------------------------------------------------
+
+// The state of _scanSeqRecord() in a record that continues behind the text scanned so far.
+struct SeqRecordScan_
+{
+    unsigned    stage;      // 0: id line, 1: sequence, 2: '+' line, 3: qualities
+    __uint64    pos;        // offset in the text where to resume scanning
+    __uint64    count;      // number of bases, then number of qualities left
+
+    SeqRecordScan_() : stage(0), pos(0), count(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Function _scanLineEnd()
+// ----------------------------------------------------------------------------
+
+// Move it behind the end of the current line like skipLine() does. Returns false if the line could continue
+// behind end, it is then where to resume.
+inline bool _scanLineEnd(char const * & it, char const * end)
+{
+    char const * lf = static_cast<char const *>(std::memchr(it, '\n', end - it));
+    char const * cr = static_cast<char const *>(std::memchr(it, '\r', ((lf != NULL) ? lf : end) - it));
+
+    if (cr != NULL)
+    {
+        if (cr + 1 == end)
+        {
+            it = cr;                    // '\n' could follow
+            return false;
+        }
+        it = (cr[1] == '\n') ? cr + 2 : cr + 1;
+        return true;
+    }
+    if (lf == NULL)
+    {
+        it = end;
+        return false;
+    }
+    it = lf + 1;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _scanSeqRecord(Fasta)
+// ----------------------------------------------------------------------------
+
+// Scan the record that begins at text + scan.pos up to the position where readRecord() stops reading it, without
+// parsing it. Returns false if the record could continue behind end. The scan is then resumed from scan when more
+// text is appended. This allows to split the input at record boundaries and to parse the records concurrently.
+template <typename TSeqIgnore, typename TQualIgnore>
+inline bool _scanSeqRecord(SeqRecordScan_ & scan, char const * text, char const * end, Fasta)
+{
+    char const * it = text + scan.pos;
+
+    if (scan.stage == 0)                // skip '>' and Fasta id
+    {
+        bool complete = _scanLineEnd(it, end);
+        scan.pos = it - text;
+        if (!complete)
+            return false;
+        scan.stage = 1;
+    }
+
+    // skip Fasta sequence
+    char const * next = static_cast<char const *>(std::memchr(it, '>', end - it));
+    scan.pos = ((next != NULL) ? next : end) - text;
+    return next != NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Function _scanSeqRecord(Fastq)
+// ----------------------------------------------------------------------------
+
+template <typename TSeqIgnore, typename TQualIgnore>
+inline bool _scanSeqRecord(SeqRecordScan_ & scan, char const * text, char const * end, Fastq)
+{
+    TSeqIgnore seqIgnore;
+    TQualIgnore qualIgnore;
+    char const * it = text + scan.pos;
+    bool complete = true;
+
+    if (scan.stage == 0)                // skip '@' and Fastq id
+    {
+        complete = _scanLineEnd(it, end);
+        if (complete)
+            scan.stage = 1;
+    }
+
+    if (complete && scan.stage == 1)    // count the Fastq sequence the same way readRecord() does
+    {
+        char const * plus = static_cast<char const *>(std::memchr(it, '+', end - it));
+        for (char const * stop = (plus != NULL) ? plus : end; it != stop; ++it)
+            if (!seqIgnore(*it))
+                ++scan.count;
+        complete = plus != NULL;
+        if (complete)
+            scan.stage = 2;
+    }
+
+    if (complete && scan.stage == 2)    // skip '+' and optional 2nd Fastq id
+    {
+        complete = _scanLineEnd(it, end);
+        if (complete)
+            scan.stage = 3;
+    }
+
+    if (complete)                       // as many qualities as there are bases, '@' could also be a quality value
+    {
+        for (; scan.count != 0 && it != end; ++it)
+            if (!qualIgnore(*it))
+                --scan.count;
+        complete = scan.count == 0;
+    }
+
+    scan.pos = it - text;
+    return complete;
+}
+
 // ----------------------------------------------------------------------------
 // Function writeRecord(Raw); Qualities inside seq
 // ----------------------------------------------------------------------------
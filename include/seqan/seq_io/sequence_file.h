@@ -223,6 +223,281 @@ readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, FormattedFile
     readRecord(meta, seq, qual, file.iter, file.format);
 }
 
+// ----------------------------------------------------------------------------
+// Function _readSeqRecord()
+// ----------------------------------------------------------------------------
+
+// Parse a record into separate qualities.
+template <typename TIdString, typename TSeqString, typename TQualString, typename TFwdIterator, typename TFormat>
+inline void
+_readSeqRecord(TIdString & meta, TSeqString & seq, TQualString & qual, TFwdIterator & iter, TFormat const & format,
+               True const & /* withQuals */)
+{
+    readRecord(meta, seq, qual, iter, format);
+}
+
+// Parse a record like readRecord(meta, seq, file) does, i.e. the qualities are stored in seq if possible.
+template <typename TIdString, typename TSeqString, typename TQualString, typename TFwdIterator, typename TFormat>
+inline void
+_readSeqRecord(TIdString & meta, TSeqString & seq, TQualString & qual, TFwdIterator & iter, TFormat const & format,
+               False const & /* withQuals */)
+{
+    if (HasQualities<typename Value<TSeqString>::Type>::VALUE)
+    {
+        readRecord(meta, seq, qual, iter, format);
+        assignQualities(seq, qual);
+    }
+    else
+    {
+        readRecord(meta, seq, iter, format);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _readSeqChunk()
+// ----------------------------------------------------------------------------
+
+// Copy whole records from the input into chunk, until it has at least chunkBytes characters or maxRecords records, and
+// return their number. The input is scanned in the buffer of the stream and only consumed up to the end of the
+// records, i.e. the file iterator is left where readRecord() would be.
+template <typename TSeqIgnore, typename TQualIgnore, typename TSpec, typename TFormat>
+inline __uint64
+_readSeqChunk(CharString & chunk,
+              FormattedFile<Fastq, Input, TSpec> & file,
+              __uint64 maxRecords,
+              __uint64 chunkBytes,
+              TFormat const & format)
+{
+    typedef typename FormattedFile<Fastq, Input, TSpec>::TIter  TIter;
+    typedef typename Value<TIter>::Type                         TIValue;
+
+    clear(chunk);
+
+    SeqRecordScan_ scan;
+    __uint64 numRecords = 0;
+    bool inRecord = false;
+    bool done = false;
+
+    while (!done && !atEnd(file.iter))
+    {
+        Range<TIValue const *> ichunk;
+        getChunk(ichunk, file.iter, Input());
+        SEQAN_ASSERT(!empty(ichunk));
+
+        __uint64 consumed = length(chunk);
+        resize(chunk, consumed + (ichunk.end - ichunk.begin), Generous());
+        arrayCopyForward(ichunk.begin, ichunk.end, begin(chunk, Standard()) + consumed);
+
+        char const * text = begin(chunk, Standard());
+        char const * textEnd = end(chunk, Standard());
+        while (true)
+        {
+            if (!inRecord)
+            {
+                // forward to the next record
+                char const * next = static_cast<char const *>(
+                    std::memchr(text + scan.pos, MagicHeader<TFormat>::VALUE[0], textEnd - text - scan.pos));
+                scan.pos = ((next != NULL) ? next : textEnd) - text;
+                if (next == NULL)
+                    break;
+                if (numRecords == maxRecords || (numRecords != 0 && scan.pos >= chunkBytes))
+                {
+                    done = true;
+                    break;
+                }
+                scan.stage = 0;
+                scan.count = 0;
+                inRecord = true;
+            }
+
+            if (!_scanSeqRecord<TSeqIgnore, TQualIgnore>(scan, text, textEnd, format))
+                break;
+            inRecord = false;
+            ++numRecords;
+        }
+
+        // consume the buffer, or up to the next record if the chunk is complete
+        __uint64 chunkEnd = (done) ? scan.pos : length(chunk);
+        resize(chunk, chunkEnd);
+        file.iter += chunkEnd - consumed;
+    }
+
+    // readRecord() reads an incomplete last record up to the end of the file
+    if (inRecord)
+        ++numRecords;
+    return numRecords;
+}
+
+// ----------------------------------------------------------------------------
+// Function _readSeqChunks()
+// ----------------------------------------------------------------------------
+
+// Read up to maxChunks chunks into chunks[first], chunks[first + 1], ... and return their number.  maxRecords is
+// decreased by the number of records read.
+template <typename TSeqIgnore, typename TQualIgnore, typename TSpec, typename TSize, typename TFormat>
+inline int
+_readSeqChunks(String<CharString> & chunks,
+               String<__uint64> & chunkRecords,
+               int first,
+               int maxChunks,
+               FormattedFile<Fastq, Input, TSpec> & file,
+               TSize & maxRecords,
+               __uint64 chunkBytes,
+               TFormat const & format)
+{
+    int numChunks = 0;
+    for (; numChunks < maxChunks && maxRecords > 0; ++numChunks)
+    {
+        __uint64 numRecords = _readSeqChunk<TSeqIgnore, TQualIgnore>(chunks[first + numChunks], file,
+                                                                     (__uint64)maxRecords, chunkBytes, format);
+        if (numRecords == 0)
+            break;  // Only whitespace was left at the end of the file.
+        chunkRecords[first + numChunks] = numRecords;
+        maxRecords -= numRecords;
+    }
+    return numChunks;
+}
+
+// ----------------------------------------------------------------------------
+// Function _readRecordsChunked()
+// ----------------------------------------------------------------------------
+
+// The input is read in batches of chunks of whole records and the chunks are parsed in parallel.  While a batch is
+// parsed, one thread reads the next batch and then helps parsing.  Each chunk is parsed into its own string sets,
+// which are appended to the result in file order.
+template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet, typename TSpec, typename TSize,
+          typename TFormat, typename TWithQuals>
+inline void
+_readRecordsChunked(TIdStringSet & meta,
+                    TSeqStringSet & seq,
+                    TQualStringSet & qual,
+                    FormattedFile<Fastq, Input, TSpec> & file,
+                    TSize maxRecords,
+                    TFormat const & format,
+                    TWithQuals const & withQuals)
+{
+    typedef typename SeqFileBuffer_<TSeqStringSet, TSpec>::Type     TSeqBuffer;
+    typedef typename Value<TSeqBuffer>::Type                        TSeqAlphabet;
+    typedef typename If<Or<TWithQuals, HasQualities<TSeqAlphabet> >,
+                        char, TSeqAlphabet>::Type                   TQualAlphabet;
+    typedef typename FastaIgnoreFunctor_<TSeqAlphabet>::Type        TSeqIgnore;
+    typedef typename FastaIgnoreFunctor_<TQualAlphabet>::Type       TQualIgnore;
+    typedef typename Iterator<CharString, Rooted>::Type             TRawIter;
+
+    int numThreads = omp_get_max_threads();
+    int maxChunks = 4 * numThreads;
+    __uint64 chunkBytes = 1u << 20;
+
+    // The chunks of the batch parsed and of the batch read, which swap places after each batch.
+    String<CharString> chunks;
+    String<__uint64> chunkRecords;
+    String<TIdStringSet> blockMeta;
+    String<TSeqStringSet> blockSeq;
+    String<TQualStringSet> blockQual;
+    resize(chunks, 2 * maxChunks, Exact());
+    resize(chunkRecords, 2 * maxChunks, Exact());
+    resize(blockMeta, maxChunks, Exact());
+    resize(blockSeq, maxChunks, Exact());
+    resize(blockQual, maxChunks, Exact());
+
+    int first = 0;
+    int numChunks = _readSeqChunks<TSeqIgnore, TQualIgnore>(chunks, chunkRecords, first, maxChunks, file, maxRecords,
+                                                            chunkBytes, format);
+    while (numChunks > 0)
+    {
+        int nextFirst = maxChunks - first;
+        int nextNumChunks = 0;
+
+        // Exceptions must not leave the parallel region, we rethrow the one of the first broken chunk.
+        // An error while reading the next batch comes after all chunks of this one.
+        ParallelError_ parallelError(numChunks + 1);
+        SEQAN_OMP_PRAGMA(parallel)
+        {
+            SEQAN_OMP_PRAGMA(single nowait)
+            {
+                SEQAN_TRY
+                {
+                    nextNumChunks = _readSeqChunks<TSeqIgnore, TQualIgnore>(chunks, chunkRecords, nextFirst,
+                                                                            maxChunks, file, maxRecords, chunkBytes,
+                                                                            format);
+                }
+                SEQAN_CATCH(...)
+                {
+                    SEQAN_OMP_PRAGMA(critical (readRecordsError))
+                    _storeCurrentException(parallelError, numChunks);
+                }
+            }
+
+            CharString metaBuffer;
+            TSeqBuffer seqBuffer;
+            CharString qualBuffer;
+
+            SEQAN_OMP_PRAGMA(for schedule(dynamic))
+            for (int b = 0; b < numChunks; ++b)
+            {
+                clear(blockMeta[b]);
+                clear(blockSeq[b]);
+                clear(blockQual[b]);
+                SEQAN_TRY
+                {
+                    TRawIter iter = begin(chunks[first + b], Rooted());
+                    for (__uint64 i = 0; i < chunkRecords[first + b]; ++i)
+                    {
+                        _readSeqRecord(metaBuffer, seqBuffer, qualBuffer, iter, format, withQuals);
+                        appendValue(blockMeta[b], metaBuffer);
+                        appendValue(blockSeq[b], seqBuffer);
+                        if (TWithQuals::VALUE)
+                            appendValue(blockQual[b], qualBuffer);
+                    }
+                }
+                SEQAN_CATCH(...)
+                {
+                    SEQAN_OMP_PRAGMA(critical (readRecordsError))
+                    _storeCurrentException(parallelError, b);
+                }
+            }
+        }
+
+        // Concatenate the chunks in file order, up to the last record read successfully.
+        for (int b = 0; b < numChunks && b <= parallelError.pos; ++b)
+        {
+            for (unsigned i = 0; i < length(blockMeta[b]); ++i)
+                appendValue(meta, blockMeta[b][i]);
+            for (unsigned i = 0; i < length(blockSeq[b]); ++i)
+                appendValue(seq, blockSeq[b][i]);
+            for (unsigned i = 0; i < length(blockQual[b]); ++i)
+                appendValue(qual, blockQual[b][i]);
+        }
+        _rethrowException(parallelError);
+
+        first = nextFirst;
+        numChunks = nextNumChunks;
+    }
+}
+
+// Use the chunked reader for Fasta and Fastq files if more than one thread is available.
+template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet, typename TSpec, typename TSize,
+          typename TWithQuals>
+inline bool
+_readRecordsChunked(TIdStringSet & meta,
+                    TSeqStringSet & seq,
+                    TQualStringSet & qual,
+                    FormattedFile<Fastq, Input, TSpec> & file,
+                    TSize maxRecords,
+                    TWithQuals const & withQuals)
+{
+    if (omp_get_max_threads() < 2)
+        return false;
+
+    if (isEqual(file.format, Fastq()))
+        _readRecordsChunked(meta, seq, qual, file, maxRecords, Fastq(), withQuals);
+    else if (isEqual(file.format, Fasta()))
+        _readRecordsChunked(meta, seq, qual, file, maxRecords, Fasta(), withQuals);
+    else
+        return false;
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // Function readRecords()
 // ----------------------------------------------------------------------------
@@ -231,6 +506,11 @@ readRecord(TIdString & meta, TSeqString & seq, TQualString & qual, FormattedFile
  * @fn SeqFileIn#readRecords
  * @brief Read many @link FormattedFileRecordConcept @endlink from a @link SeqFileIn @endlink object.
  * @signature void readRecords(metas, seqs, quals, fileIn, numRecord);
+ *
+ * If OpenMP is enabled and more than one thread is available, FASTA and FASTQ files are read in chunks of whole
+ * records that are parsed in parallel.  One thread reads the next chunks while the others parse.
+ * The records are appended in file order, as with the sequential reader.
+ *
  * @see SeqFileIn#readRecord
  */
 
@@ -256,6 +536,10 @@ inline void readRecords(TIdStringSet & meta,
 {
     typedef typename SeqFileBuffer_<TSeqStringSet, TSpec>::Type TSeqBuffer;
 
+    StringSet<CharString> noQuals;
+    if (_readRecordsChunked(meta, seq, noQuals, file, maxRecords, False()))
+        return;
+
     TSeqBuffer seqBuffer;
 
     // reuse the memory of context(file).buffer for seqBuffer (which has a different type but same sizeof(Alphabet))
@@ -301,6 +585,9 @@ inline void readRecords(TIdStringSet & meta,
 {
     typedef typename SeqFileBuffer_<TSeqStringSet, TSpec>::Type TSeqBuffer;
 
+    if (_readRecordsChunked(meta, seq, qual, file, maxRecords, True()))
+        return;
+
     TSeqBuffer seqBuffer;
 
     // reuse the memory of context(file).buffer for seqBuffer (which has a different type but same sizeof(Alphabet))
@@ -924,6 +924,7 @@ arrayCopyForward(Iter<TPackedString, Packed<TSpec> > source_begin,
             // words need not to be shifted
             arrayCopyForward(hostIterator(source_begin), hostIterator(source_end), hostIterator(target_begin));
             hostIterator(target_begin) += hostIterator(source_end) - hostIterator(source_begin);
+            hostIterator(source_begin) = hostIterator(source_end);
         }
     }
 
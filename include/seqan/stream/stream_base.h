@@ -61,6 +61,13 @@ namespace seqan {
  * @headerfile <seqan/stream.h>
  * @brief File compression using the popular <a href="http://gzip.org">gzip</a> format.
  * @signature typedef Tag<GZFile_> GZFile;
+ *
+ * @section Remarks
+ *
+ * Files are written as a series of independently compressed gzip members, each with an extra subfield
+ * <tt>SZ</tt> storing its size.  Any gzip file can be read, but only members with such a size, i.e. an
+ * <tt>SZ</tt> or BGZF <tt>BC</tt> subfield, are decompressed in parallel.  Files written by gzip are
+ * decompressed by one thread at a time.
  */
 
 struct GZFile_;
@@ -135,13 +142,14 @@ char const * FileExtensions<GZFile, T>::VALUE[2] =
 template <typename T>
 struct FileExtensions<BgzfFile, T>
 {
-    static char const * VALUE[2];
+    static char const * VALUE[3];
 };
 
 template <typename T>
-char const * FileExtensions<BgzfFile, T>::VALUE[2] =
+char const * FileExtensions<BgzfFile, T>::VALUE[3] =
 {
     ".bgzf",      // default output extension
+    ".bgz",       // bgzip's alternative extension, e.g. .vcf.bgz
     ".bam"        // BAM files are bgzf compressed
 
     // if you add extensions here, extend getBasename() below
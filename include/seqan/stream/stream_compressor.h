@@ -43,6 +43,7 @@
 #endif
 
 #include <algorithm>    // copy
+#include <vector>
 
 namespace seqan {
 
@@ -91,6 +92,17 @@ struct CompressionContext<BgzfFile>:
     unsigned char headerPos;
 };
 
+// We write gzip files as a series of independent members (like pigz -i or bgzip) so that blocks can be
+// (de)compressed in parallel. Each member header has an extra subfield 'SZ' that stores the total size of the
+// member, which allows a reader to split the file into members without inflating it.
+template <>
+struct DefaultPageSize<GZFile>
+{
+    static const unsigned BLOCK_HEADER_LENGTH = 20;
+    static const unsigned BLOCK_FOOTER_LENGTH = 8;
+    static const unsigned VALUE = 128 * 1024;       // same default block size as pigz
+};
+
 template <typename T>
 struct MagicHeader<BgzfFile, T>
 {
@@ -305,55 +317,97 @@ _bgzfPack32(char * buffer, unsigned value)
 }
 
 
+// Deflate the source behind the headerLength bytes of a gzip member header and append the member footer with the
+// CRC and the uncompressed size.  Returns the total length of the member.
 template <typename TDestValue, typename TDestCapacity, typename TSourceValue, typename TSourceLength>
 inline TDestCapacity
-_compressBlock(TDestValue *dstBegin,   TDestCapacity dstCapacity,
-               TSourceValue *srcBegin, TSourceLength srcLength, CompressionContext<BgzfFile> & ctx)
+_compressGZipMember(TDestValue *dstBegin,   TDestCapacity dstCapacity, size_t headerLength,
+                    TSourceValue *srcBegin, TSourceLength srcLength, CompressionContext<GZFile> & ctx)
 {
-    const size_t BLOCK_HEADER_LENGTH = DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH;
-    const size_t BLOCK_FOOTER_LENGTH = DefaultPageSize<BgzfFile>::BLOCK_FOOTER_LENGTH;
+    const size_t BLOCK_FOOTER_LENGTH = DefaultPageSize<GZFile>::BLOCK_FOOTER_LENGTH;
 
-    SEQAN_ASSERT_GT(dstCapacity, BLOCK_HEADER_LENGTH + BLOCK_FOOTER_LENGTH);
+    SEQAN_ASSERT_GT(dstCapacity, headerLength + BLOCK_FOOTER_LENGTH);
     SEQAN_ASSERT_EQ(sizeof(TDestValue), 1u);
     SEQAN_ASSERT_EQ(sizeof(unsigned), 4u);
 
-    // 1. COPY HEADER
-
-    std::copy(&MagicHeader<BgzfFile>::VALUE[0], &MagicHeader<BgzfFile>::VALUE[BLOCK_HEADER_LENGTH], dstBegin);
-
-
-    // 2. COMPRESS
+    // 1. COMPRESS
 
     compressInit(ctx);
     ctx.strm.next_in = (Bytef *)(srcBegin);
-    ctx.strm.next_out = (Bytef *)(dstBegin + BLOCK_HEADER_LENGTH);
+    ctx.strm.next_out = (Bytef *)(dstBegin + headerLength);
     ctx.strm.avail_in = srcLength * sizeof(TSourceValue);
-    ctx.strm.avail_out = dstCapacity - BLOCK_HEADER_LENGTH - BLOCK_FOOTER_LENGTH;
+    ctx.strm.avail_out = dstCapacity - headerLength - BLOCK_FOOTER_LENGTH;
 
     int status = deflate(&ctx.strm, Z_FINISH);
     if (status != Z_STREAM_END)
     {
         deflateEnd(&ctx.strm);
-        throw IOError("Deflation failed. Compressed BGZF data is too big.");
+        throw IOError("Deflation failed. Compressed GZip data is too big.");
     }
 
     status = deflateEnd(&ctx.strm);
     if (status != Z_OK)
-        throw IOError("BGZF deflateEnd() failed.");
+        throw IOError("GZip deflateEnd() failed.");
 
 
-    // 3. APPEND FOOTER
+    // 2. APPEND FOOTER
 
-    // Set compressed length into buffer, compute CRC and write CRC into buffer.
+    // Compute CRC and write CRC and uncompressed length into buffer.
 
     size_t len = dstCapacity - ctx.strm.avail_out;
-    _bgzfPack16(dstBegin + 16, len - 1);
 
     dstBegin += len - BLOCK_FOOTER_LENGTH;
     _bgzfPack32(dstBegin, crc32(crc32(0u, NULL, 0u), (Bytef *)(srcBegin), srcLength * sizeof(TSourceValue)));
     _bgzfPack32(dstBegin + 4, srcLength * sizeof(TSourceValue));
 
-    return dstCapacity - ctx.strm.avail_out;
+    return len;
+}
+
+template <typename TDestValue, typename TDestCapacity, typename TSourceValue, typename TSourceLength>
+inline TDestCapacity
+_compressBlock(TDestValue *dstBegin,   TDestCapacity dstCapacity,
+               TSourceValue *srcBegin, TSourceLength srcLength, CompressionContext<BgzfFile> & ctx)
+{
+    const size_t BLOCK_HEADER_LENGTH = DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH;
+
+    // 1. COPY HEADER
+
+    std::copy(&MagicHeader<BgzfFile>::VALUE[0], &MagicHeader<BgzfFile>::VALUE[BLOCK_HEADER_LENGTH], dstBegin);
+
+    // 2. COMPRESS AND APPEND FOOTER
+
+    size_t len = _compressGZipMember(dstBegin, dstCapacity, BLOCK_HEADER_LENGTH, srcBegin, srcLength, ctx);
+
+    // 3. SET BLOCK SIZE
+
+    _bgzfPack16(dstBegin + 16, len - 1);
+    return len;
+}
+
+template <typename TDestValue, typename TDestCapacity, typename TSourceValue, typename TSourceLength>
+inline TDestCapacity
+_compressBlock(TDestValue *dstBegin,   TDestCapacity dstCapacity,
+               TSourceValue *srcBegin, TSourceLength srcLength, CompressionContext<GZFile> & ctx)
+{
+    const size_t BLOCK_HEADER_LENGTH = DefaultPageSize<GZFile>::BLOCK_HEADER_LENGTH;
+
+    // 1. WRITE HEADER (gzip header with FEXTRA and our 'SZ' subfield)
+
+    const char header[16] =
+    {
+        MagicHeader<GZFile>::VALUE[0], MagicHeader<GZFile>::VALUE[1], MagicHeader<GZFile>::VALUE[2],
+        4, 0, 0, 0, 0, 0, '\xff', 8, 0, 'S', 'Z', 4, 0
+    };
+    std::copy(&header[0], &header[16], dstBegin);
+
+    // 2. COMPRESS AND APPEND FOOTER
+
+    size_t len = _compressGZipMember(dstBegin, dstCapacity, BLOCK_HEADER_LENGTH, srcBegin, srcLength, ctx);
+
+    // 3. SET MEMBER SIZE
+
+    _bgzfPack32(dstBegin + 16, len);
+    return len;
 }
 
 inline void
@@ -482,6 +536,81 @@ _decompressBlock(TDestValue *dstBegin,   TDestCapacity dstCapacity,
     return (dstCapacity - ctx.strm.avail_out) / sizeof(TDestValue);
 }
 
+// Inflate the deflate data of a gzip member followed by its 8 byte footer, i.e. everything behind the header, into
+// dst behind dstOffset.  The uncompressed size in the footer is only a hint for the size of dst, as it is stored
+// modulo 2^32 and might be corrupt.  dst is enlarged while inflating instead.
+template <typename TDestValue, typename TDestAlloc, typename TSourceValue, typename TSourceLength>
+inline size_t
+_decompressBlock(std::vector<TDestValue, TDestAlloc> & dst, size_t dstOffset,
+                 TSourceValue *srcBegin, TSourceLength srcLength, CompressionContext<GZFile> & ctx)
+{
+    const size_t BLOCK_FOOTER_LENGTH = DefaultPageSize<GZFile>::BLOCK_FOOTER_LENGTH;
+    // deflate compresses by at most this factor
+    const size_t MAX_DEFLATE_RATIO = 1032;
+    // the chunk size for zlib calls, which take 32 bit lengths
+    const size_t MAX_CHUNK_SIZE = 1u << 30;
+
+    SEQAN_ASSERT_EQ(sizeof(TDestValue), 1u);
+    SEQAN_ASSERT_EQ(sizeof(TSourceValue), 1u);
+    SEQAN_ASSERT_EQ(sizeof(unsigned), 4u);
+
+    if ((size_t)srcLength < BLOCK_FOOTER_LENGTH)
+        throw IOError("GZip member too short.");
+
+    size_t compressedLen = srcLength - BLOCK_FOOTER_LENGTH;
+    TSourceValue *footer = srcBegin + compressedLen;
+
+    // 1. DECOMPRESS
+
+    size_t expectedSize = std::min((size_t)_bgzfUnpack32(footer + 4), MAX_DEFLATE_RATIO * compressedLen);
+    if (dst.size() <= dstOffset + expectedSize)
+        dst.resize(dstOffset + expectedSize + 1);
+
+    decompressInit(ctx);
+    ctx.strm.next_in = (Bytef *)(srcBegin);
+    ctx.strm.avail_in = compressedLen;
+
+    size_t size = 0;
+    while (true)
+    {
+        if (size == dst.size() - dstOffset)
+            dst.resize(dstOffset + 2 * size);
+
+        size_t chunkSize = std::min(dst.size() - dstOffset - size, MAX_CHUNK_SIZE);
+        ctx.strm.next_out = (Bytef *)(&dst[0] + dstOffset + size);
+        ctx.strm.avail_out = chunkSize;
+
+        int status = inflate(&ctx.strm, Z_FINISH);
+        size += chunkSize - ctx.strm.avail_out;
+
+        if (status == Z_STREAM_END)
+            break;
+        if ((status != Z_OK && status != Z_BUF_ERROR) || (ctx.strm.avail_in == 0 && ctx.strm.avail_out != 0))
+        {
+            inflateEnd(&ctx.strm);
+            throw IOError("Inflation of GZip member failed.");
+        }
+    }
+
+    if (inflateEnd(&ctx.strm) != Z_OK)
+        throw IOError("GZip inflateEnd() failed.");
+
+
+    // 2. CHECK FOOTER
+
+    unsigned crc = crc32(0u, NULL, 0u);
+    for (size_t pos = 0; pos < size; pos += MAX_CHUNK_SIZE)
+        crc = crc32(crc, (Bytef *)(&dst[0] + dstOffset + pos), std::min(size - pos, MAX_CHUNK_SIZE));
+
+    if (_bgzfUnpack32(footer) != crc)
+        throw IOError("GZip wrong checksum.");
+
+    if (_bgzfUnpack32(footer + 4) != (unsigned)size)
+        throw IOError("GZip size mismatch.");
+
+    return size;
+}
+
 #endif  // #if SEQAN_HAS_ZLIB
 
 }  // namespace seqan
@@ -43,6 +43,7 @@
 #if SEQAN_HAS_ZLIB
 #include "zipstream/zipstream.h"
 #include "zipstream/bgzfstream.h"
+#include "zipstream/gzipstream.h"
 #endif
 
 #if SEQAN_HAS_BZIP2
@@ -114,6 +115,31 @@ SEQAN_CONCEPT_IMPL((basic_bgzf_istream<Elem, Tr, ElemA, ByteT, ByteAT>), (InputS
 template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
 SEQAN_CONCEPT_IMPL((basic_bgzf_ostream<Elem, Tr, ElemA, ByteT, ByteAT>), (OutputStreamConcept));
 
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Value<basic_gzip_istream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Value<std::basic_istream<Elem, Tr> > {};
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Position<basic_gzip_istream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Position<std::basic_istream<Elem, Tr> > {};
+
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Value<basic_gzip_ostream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Value<std::basic_ostream<Elem, Tr> > {};
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+struct Position<basic_gzip_ostream<Elem, Tr, ElemA, ByteT, ByteAT> > :
+    Position<std::basic_ostream<Elem, Tr> > {};
+
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+SEQAN_CONCEPT_IMPL((basic_gzip_istream<Elem, Tr, ElemA, ByteT, ByteAT>), (InputStreamConcept));
+
+template <typename Elem, typename Tr, typename ElemA, typename ByteT, typename ByteAT>
+SEQAN_CONCEPT_IMPL((basic_gzip_ostream<Elem, Tr, ElemA, ByteT, ByteAT>), (OutputStreamConcept));
+
 #endif
 
 // --------------------------------------------------------------------------
@@ -127,16 +153,17 @@ struct VirtualStreamSwitch_
 };
 
 #if SEQAN_HAS_ZLIB
+// gzip files are written block-parallel as multi-member gzip files, members with a known size are read in parallel
 template <typename TValue>
 struct VirtualStreamSwitch_<TValue, Input, GZFile>
 {
-    typedef zlib_stream::basic_zip_istream<TValue> Type;
+    typedef basic_gzip_istream<TValue> Type;
 };
 
 template <typename TValue>
 struct VirtualStreamSwitch_<TValue, Output, GZFile>
 {
-    typedef zlib_stream::basic_zip_ostream<TValue> Type;
+    typedef basic_gzip_ostream<TValue> Type;
 };
 
 template <typename TValue>
@@ -207,6 +234,13 @@ struct VirtualStreamContext_:
     {
         this->streamBuf = stream.rdbuf();
     }
+
+    template <typename TObject>
+    VirtualStreamContext_(TObject &object, size_t numThreads):
+        stream(object, numThreads)
+    {
+        this->streamBuf = stream.rdbuf();
+    }
 };
 
 // special case: no compression, we simply forward the file stream
@@ -245,23 +279,27 @@ public:
     TStreamBuffer           *streamBuf;
     TVirtualStreamContext   *context;
     TFormat                 format;
+    size_t                  numThreads;             // threads of the gzip (de)compressor, 0 for its default
 
     VirtualStream():
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        numThreads(0)
     {}
 
     VirtualStream(TStreamBuffer &streamBuf):
         TStream(NULL),
         streamBuf(streamBuf),
-        context()
+        context(),
+        numThreads(0)
     {}
 
     VirtualStream(TStream &stream):
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        numThreads(0)
     {
         open(*this, stream);
     }
@@ -270,7 +308,8 @@ public:
                   int openMode = DefaultOpenMode<VirtualStream>::VALUE):
         TStream(NULL),
         streamBuf(),
-        context()
+        context(),
+        numThreads(0)
     {
         open(*this, fileName, openMode);
     }
@@ -392,8 +431,11 @@ struct VirtualStreamFactoryContext_<VirtualStream<TValue, TDirection, TTraits> >
     typedef typename TVirtualStream::TStream            TStream;
 
     TStream &stream;
-    VirtualStreamFactoryContext_(TStream &stream):
-        stream(stream) {}
+    size_t numThreads;
+
+    VirtualStreamFactoryContext_(TStream &stream, size_t numThreads):
+        stream(stream),
+        numThreads(numThreads) {}
 };
 
 template <typename TVirtualStream>
@@ -417,6 +459,18 @@ tagApply(VirtualStreamFactoryContext_<VirtualStream<TValue, TDirection, TTraits>
     return new VirtualStreamContext_<TValue, TDirection, Tag<TFormat> >(ctx.stream);
 }
 
+#if SEQAN_HAS_ZLIB
+// gzip files are (de)compressed with the thread count of the VirtualStream, if set
+template <typename TValue, typename TDirection, typename TTraits>
+inline VirtualStreamContextBase_<TValue> *
+tagApply(VirtualStreamFactoryContext_<VirtualStream<TValue, TDirection, TTraits> > &ctx, GZFile)
+{
+    if (ctx.numThreads == 0)
+        return new VirtualStreamContext_<TValue, TDirection, GZFile>(ctx.stream);
+    return new VirtualStreamContext_<TValue, TDirection, GZFile>(ctx.stream, ctx.numThreads);
+}
+#endif
+
 
 template <typename TContext>
 inline typename Value<TContext>::Type
@@ -455,6 +509,26 @@ inline bool _guessFormat(VirtualStream<TValue, Output> &, TStream &, TCompressio
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// Function _isTabixFilename()
+// ----------------------------------------------------------------------------
+
+// Files of the formats that tabix indexes (VCF, BED, GFF/GTF) with gzip extension.  These are typically
+// compressed with bgzip, other .gz files might start with a BGZF block but continue with arbitrary gzip members.
+template <typename TFilename>
+inline bool
+_isTabixFilename(TFilename const & fileName)
+{
+    typedef typename Value<TFilename>::Type                                     TValue;
+    typedef ModifiedString<TFilename const, ModView<FunctorLowcase<TValue> > >    TLowcase;
+
+    TLowcase lowcaseFileName(fileName);
+
+    return endsWith(lowcaseFileName, ".vcf.gz") || endsWith(lowcaseFileName, ".bed.gz") ||
+           endsWith(lowcaseFileName, ".gff.gz") || endsWith(lowcaseFileName, ".gff3.gz") ||
+           endsWith(lowcaseFileName, ".gtf.gz");
+}
+
 // ----------------------------------------------------------------------------
 // Function _getUncompressedBasename()
 // ----------------------------------------------------------------------------
@@ -467,7 +541,7 @@ _getUncompressedBasename(TFilename const & fileName, TFormat const & format)
     return getBasename(fileName, format);
 }
 
-// make sure not to only cut the ".bgzf" extension and not ".bam"
+// make sure to only cut the ".bgzf" and ".bgz" extensions and not ".bam"
 template <typename TFilename>
 inline typename Prefix<TFilename const>::Type
 _getUncompressedBasename(TFilename const & fileName, BgzfFile const &)
@@ -479,6 +553,12 @@ _getUncompressedBasename(TFilename const & fileName, BgzfFile const &)
 
     if (endsWith(lowcaseFileName, ".bgzf"))
         return prefix(fileName, length(fileName) - 5);
+    if (endsWith(lowcaseFileName, ".bgz"))
+        return prefix(fileName, length(fileName) - 4);
+
+    // tabix files are read as BGZF, see open()
+    if (_isTabixFilename(fileName))
+        return prefix(fileName, length(fileName) - 3);
 
     return prefix(fileName, length(fileName));
 }
@@ -528,7 +608,7 @@ open(VirtualStream<TValue, TDirection, TTraits> &stream, TStream &fileStream, TC
         return open(stream, stream.bufferedStream, compressionType);
     }
 
-    VirtualStreamFactoryContext_<TVirtualStream> ctx(fileStream);
+    VirtualStreamFactoryContext_<TVirtualStream> ctx(fileStream, stream.numThreads);
 
     // try to detect/verify format
     if (!_guessFormat(stream, fileStream, compressionType))
@@ -585,7 +665,16 @@ open(VirtualStream<TValue, TDirection, TTraits> &stream,
     else
         guessFormatFromFilename(fileName, stream.format);       // read/write from/to a file (with extension)
 
-    VirtualStreamFactoryContext_<TVirtualStream> ctx(stream.file);
+#if SEQAN_HAS_ZLIB
+    // BGZF files are valid gzip files, e.g. tabix-indexed .vcf.gz files.  Read them as
+    // BGZF to support virtual offsets in position() and setPosition().
+    BgzfFile bgzf;
+    if (IsSameType<TDirection, Input>::VALUE && isEqual(stream.format, GZFile()) &&
+        _isTabixFilename(fileName) && _guessFormat(stream, stream.file, bgzf))
+        assign(stream.format, bgzf);
+#endif
+
+    VirtualStreamFactoryContext_<TVirtualStream> ctx(stream.file, stream.numThreads);
 
     // create a new (un)zipper buffer
     stream.context = tagApply(ctx, stream.format);
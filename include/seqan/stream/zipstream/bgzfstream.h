@@ -396,6 +396,7 @@ public:
 
                 DecompressionJob &job = streamBuf->jobs[jobId];
                 size_t tailLen = 0;
+                bool loaded = false;
 
                 // typically the idle queue contains only ready jobs
                 // however, if seek() fast forwards running jobs into the todoQueue
@@ -464,6 +465,7 @@ public:
 
                         streamBuf->serializer.fileOfs += BGZF_BLOCK_HEADER_LENGTH + tailLen;
                         job.ready = false;
+                        loaded = true;
 
                     eofSkip:
                         streamBuf->serializer.istream.clear(
@@ -482,7 +484,9 @@ public:
                     }
                 }
 
-                if (!job.ready)
+                // A job that is ready when queued can already be recycled and reloaded by another thread,
+                // so only decompress blocks loaded above.
+                if (loaded)
                 {
                     // decompress block
                     job.size = _decompressBlock(
@@ -564,11 +568,12 @@ public:
                 this->gptr(),
                 &putbackBuffer[0]);
 
-        if (currentJobId >= 0)
-            appendValue(todoQueue, currentJobId);
-
         while (true)
         {
+            // recycle the previous job, including empty blocks skipped below
+            if (currentJobId >= 0)
+                appendValue(todoQueue, currentJobId);
+
             if (!popFront(currentJobId, runningQueue))
             {
                 currentJobId = -1;
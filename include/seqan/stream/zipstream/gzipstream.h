@@ -0,0 +1,957 @@
+/*
+zipstream Library License:
+--------------------------
+
+The zlib/libpng License Copyright (c) 2003 Jonathan de Halleux.
+
+This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose, including commercial applications, and to alter it and redistribute it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution
+
+*/
+
+// Parallel block-wise compression of (multi-member) gzip files.
+//
+// The writer cuts the input into blocks of DefaultPageSize<GZFile>::VALUE bytes and deflates them concurrently
+// into independent gzip members (like pigz -i).  The concatenation of the members is a valid gzip file.  Each
+// member header carries the extra subfield 'SZ' with the total member size, such that a reader can distribute
+// the members to threads without inflating them.
+//
+// The reader decompresses members with a known size (our 'SZ' or the BGZF 'BC' subfield) in parallel.
+// Members of unknown size, e.g. written by gzip or concatenated from such files, are inflated sequentially in
+// chunks by the thread that reads them, under the serializer lock.  Hence, arbitrary single- and multi-member
+// gzip files can be read, but only SZ or BC tagged ones are read in parallel.  The end of an untagged member is
+// only known after inflating it, scanning for the next header would also stop at gzip magic bytes within the
+// deflated data.
+//
+// Both use GZIP_DEFAULT_THREADS threads unless another number is given, e.g. via VirtualStream::numThreads.
+// The parsing of the (de)compressed data is mostly the bottleneck, more threads rarely pay off.
+
+#ifndef SEQAN_STREAM_ZIPSTREAM_GZIPSTREAM_H_
+#define SEQAN_STREAM_ZIPSTREAM_GZIPSTREAM_H_
+
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <zlib.h>
+#include "zutil.h"
+
+namespace seqan {
+
+const size_t GZIP_DEFAULT_THREADS = 2;
+
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gzip_streambuf : public std::basic_streambuf<Elem, Tr>
+{
+public:
+    typedef std::basic_ostream<Elem, Tr>& ostream_reference;
+    typedef ElemA char_allocator_type;
+    typedef ByteT byte_type;
+    typedef ByteAT byte_allocator_type;
+    typedef byte_type* byte_buffer_type;
+    typedef typename Tr::char_type char_type;
+    typedef typename Tr::int_type int_type;
+
+    typedef ConcurrentQueue<size_t, Suspendable<Limit> > TJobQueue;
+
+    struct OutputBuffer
+    {
+        std::vector<char>   buffer;
+        size_t              size;
+
+        OutputBuffer() :
+            buffer(compressBound(DefaultPageSize<GZFile>::VALUE) +
+                   DefaultPageSize<GZFile>::BLOCK_HEADER_LENGTH +
+                   DefaultPageSize<GZFile>::BLOCK_FOOTER_LENGTH),
+            size(0)
+        {}
+    };
+
+    struct BufferWriter
+    {
+        ostream_reference ostream;
+
+        BufferWriter(ostream_reference ostream) :
+            ostream(ostream)
+        {}
+
+        bool operator() (OutputBuffer const & outputBuffer)
+        {
+            ostream.write(&outputBuffer.buffer[0], outputBuffer.size);
+            return ostream.good();
+        }
+    };
+
+    struct CompressionJob
+    {
+        typedef std::vector<char_type, char_allocator_type> TBuffer;
+
+        TBuffer         buffer;
+        size_t          size;
+        OutputBuffer    *outputBuffer;
+
+        CompressionJob() :
+            buffer(DefaultPageSize<GZFile>::VALUE / sizeof(char_type), 0),
+            size(0),
+            outputBuffer(NULL)
+        {}
+    };
+
+    // string of recycable jobs
+    size_t                  numThreads;
+    size_t                  numJobs;
+    size_t                  numMembers;
+    String<CompressionJob>  jobs;
+    TJobQueue               jobQueue;
+    TJobQueue               idleQueue;
+    Serializer<
+        OutputBuffer,
+        BufferWriter>       serializer;
+
+    size_t                  currentJobId;
+    bool                    currentJobAvail;
+
+
+    struct CompressionThread
+    {
+        basic_gzip_streambuf            *streamBuf;
+        CompressionContext<GZFile>      compressionCtx;
+
+        void operator()()
+        {
+            ScopedReadLock<TJobQueue> readLock(streamBuf->jobQueue);
+            ScopedWriteLock<TJobQueue> writeLock(streamBuf->idleQueue);
+
+            // wait for a new job to become available
+            bool success = true;
+            while (success)
+            {
+                size_t jobId = -1;
+                if (!popFront(jobId, streamBuf->jobQueue))
+                    return;
+
+                CompressionJob &job = streamBuf->jobs[jobId];
+
+                // compress block with zlib
+                job.outputBuffer->size = _compressBlock(
+                    &job.outputBuffer->buffer[0], job.outputBuffer->buffer.size(),
+                    &job.buffer[0], job.size, compressionCtx);
+
+                success = releaseValue(streamBuf->serializer, job.outputBuffer);
+                appendValue(streamBuf->idleQueue, jobId);
+            }
+        }
+    };
+
+    // array of worker threads
+    Thread<CompressionThread>   *threads;
+
+    basic_gzip_streambuf(ostream_reference ostream_,
+                         size_t numThreads = GZIP_DEFAULT_THREADS,
+                         size_t jobsPerThread = 8) :
+        numThreads(numThreads),
+        numJobs(numThreads * jobsPerThread),
+        numMembers(0),
+        jobQueue(numJobs),
+        idleQueue(numJobs),
+        serializer(ostream_, numThreads * jobsPerThread)
+    {
+        resize(jobs, numJobs, Exact());
+        currentJobId = 0;
+
+        lockWriting(jobQueue);
+        lockReading(idleQueue);
+        setReaderWriterCount(jobQueue, numThreads, 1);
+        setReaderWriterCount(idleQueue, 1, numThreads);
+
+        for (unsigned i = 0; i < numJobs; ++i)
+        {
+            bool success = appendValue(idleQueue, i);
+            ignoreUnusedVariableWarning(success);
+            SEQAN_ASSERT(success);
+        }
+
+        threads = new Thread<CompressionThread>[numThreads];
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            threads[i].worker.streamBuf = this;
+            run(threads[i]);
+        }
+
+        currentJobAvail = popFront(currentJobId, idleQueue);
+        SEQAN_ASSERT(currentJobAvail);
+
+        CompressionJob &job = jobs[currentJobId];
+        job.outputBuffer = aquireValue(serializer);
+        this->setp(&job.buffer[0], &job.buffer[0] + (job.buffer.size() - 1));
+    }
+
+    ~basic_gzip_streambuf()
+    {
+        // flush the remaining data, an empty file still needs one (empty) member to be a valid gzip file
+        flush(numMembers == 0);
+
+        unlockWriting(jobQueue);
+        unlockReading(idleQueue);
+
+        for (unsigned i = 0; i < numThreads; ++i)
+            waitFor(threads[i]);
+        delete[] threads;
+    }
+
+    bool compressBuffer(size_t size)
+    {
+        // submit current job
+        if (currentJobAvail)
+        {
+            jobs[currentJobId].size = size;
+            appendValue(jobQueue, currentJobId);
+            ++numMembers;
+        }
+
+        // recycle existing idle job
+        if (!(currentJobAvail = popFront(currentJobId, idleQueue)))
+            return false;
+
+        jobs[currentJobId].outputBuffer = aquireValue(serializer);
+
+        return serializer;
+    }
+
+    int_type overflow(int_type c)
+    {
+        int w = static_cast<int>(this->pptr() - this->pbase());
+        if (c != EOF)
+        {
+            *this->pptr() = c;
+            ++w;
+        }
+        if (compressBuffer(w))
+        {
+            CompressionJob &job = jobs[currentJobId];
+            this->setp(&job.buffer[0], &job.buffer[0] + (job.buffer.size() - 1));
+            return c;
+        }
+        else
+        {
+            return EOF;
+        }
+    }
+
+    std::streamsize flush(bool flushEmptyBuffer = false)
+    {
+        int w = static_cast<int>(this->pptr() - this->pbase());
+        if ((w != 0 || flushEmptyBuffer) && compressBuffer(w))
+        {
+            CompressionJob &job = jobs[currentJobId];
+            this->setp(&job.buffer[0], &job.buffer[0] + (job.buffer.size() - 1));
+        }
+        else
+        {
+            w = 0;
+        }
+
+        // wait for running compressor threads
+        waitForMinSize(idleQueue, numJobs - 1);
+
+        serializer.worker.ostream.flush();
+        return w;
+    }
+
+    int sync()
+    {
+        if (this->pptr() != this->pbase())
+        {
+            int c = overflow(EOF);
+            if (c == EOF)
+                return -1;
+        }
+        return 0;
+    }
+
+    /// returns a reference to the output stream
+    ostream_reference get_ostream() const    { return serializer.worker.ostream; };
+};
+
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_ungzip_streambuf :
+    public std::basic_streambuf<Elem, Tr>
+{
+public:
+    typedef std::basic_istream<Elem, Tr>& istream_reference;
+    typedef ElemA char_allocator_type;
+    typedef ByteT byte_type;
+    typedef ByteAT byte_allocator_type;
+    typedef byte_type* byte_buffer_type;
+    typedef typename Tr::char_type char_type;
+    typedef typename Tr::int_type int_type;
+
+    typedef std::vector<char_type, char_allocator_type>     TBuffer;
+    typedef std::vector<byte_type, byte_allocator_type>     TInputBuffer;
+    typedef ConcurrentQueue<int, Suspendable<Limit> >       TJobQueue;
+
+    static const size_t MAX_PUTBACK = 4;
+
+    // The serializer reads the compressed stream member by member.  It is only accessed under its lock.
+    struct Serializer
+    {
+        istream_reference           istream;
+        Mutex                       lock;
+        IOError                     *error;
+        TInputBuffer                inputBuffer;        // compressed data read ahead from istream
+        size_t                      inputPos;
+        size_t                      inputEnd;
+        CompressionContext<GZFile>  streamCtx;          // inflates members of unknown size
+        bool                        inMember;           // are we inside a member of unknown size?
+        unsigned                    memberCrc;
+        bool                        firstMember;        // is the next header the first one of the stream?
+        bool                        eof;
+
+        Serializer(istream_reference istream) :
+            istream(istream),
+            lock(false),
+            error(NULL),
+            inputBuffer(DefaultPageSize<GZFile>::VALUE),
+            inputPos(0),
+            inputEnd(0),
+            inMember(false),
+            memberCrc(0),
+            firstMember(true),
+            eof(false)
+        {}
+
+        ~Serializer()
+        {
+            if (inMember)
+                inflateEnd(&streamCtx.strm);
+            delete error;
+        }
+
+        bool fill()
+        {
+            inputEnd = std::copy(&inputBuffer[0] + inputPos, &inputBuffer[0] + inputEnd, &inputBuffer[0]) -
+                       &inputBuffer[0];
+            inputPos = 0;
+            istream.read((char*)&inputBuffer[0] + inputEnd, inputBuffer.size() - inputEnd);
+            size_t numRead = istream.gcount();
+            inputEnd += numRead;
+            return numRead != 0;
+        }
+
+        bool read(byte_type *dst, size_t len)
+        {
+            while (len != 0)
+            {
+                if (inputPos == inputEnd && !fill())
+                    return false;
+                size_t chunk = std::min(len, inputEnd - inputPos);
+                dst = std::copy(&inputBuffer[0] + inputPos, &inputBuffer[0] + inputPos + chunk, dst);
+                inputPos += chunk;
+                len -= chunk;
+            }
+            return true;
+        }
+
+        // Reads the header of the next member. Returns false at the end of the stream.
+        // memberLen is the number of bytes behind the header if known, otherwise 0.
+        // Like gzip(1), data after the last member that is not a gzip member (e.g. zero padding of tar or dd) ends
+        // the stream, only an invalid first header is an error.
+        bool readHeader(size_t & memberLen)
+        {
+            const unsigned char FLG_FHCRC = 2;
+            const unsigned char FLG_FEXTRA = 4;
+            const unsigned char FLG_FNAME = 8;
+            const unsigned char FLG_FCOMMENT = 16;
+
+            if (inputPos == inputEnd && !fill())
+                return false;
+
+            bool first = firstMember;
+            firstMember = false;
+
+            byte_type header[10];
+            size_t magicLen = 0;
+            for (; magicLen < 3; ++magicLen)
+                if (!read(header + magicLen, 1) || header[magicLen] != MagicHeader<GZFile>::VALUE[magicLen])
+                    break;
+
+            if (magicLen < 3)
+            {
+                if (first)
+                    throw IOError("Invalid GZip member header.");
+                inputPos = inputEnd;
+                return false;
+            }
+
+            if (!read(header + 3, sizeof(header) - 3))
+                throw IOError("Unexpected end of GZip header.");
+
+            unsigned char flags = header[3];
+            size_t headerLen = sizeof(header);
+            size_t totalLen = 0;
+            byte_type buffer[4];
+
+            if (flags & FLG_FEXTRA)
+            {
+                if (!read(buffer, 2))
+                    throw IOError("Unexpected end of GZip header.");
+                size_t extraLen = _bgzfUnpack16(buffer);
+                headerLen += 2 + extraLen;
+
+                // scan subfields for the total member size
+                while (extraLen >= 4)
+                {
+                    if (!read(buffer, 4))
+                        throw IOError("Unexpected end of GZip header.");
+                    size_t fieldLen = std::min((size_t)_bgzfUnpack16(buffer + 2), extraLen - 4);
+                    extraLen -= 4 + fieldLen;
+
+                    char si1 = buffer[0], si2 = buffer[1];
+                    if (fieldLen <= sizeof(buffer) && !read(buffer, fieldLen))
+                        throw IOError("Unexpected end of GZip header.");
+
+                    if (si1 == 'S' && si2 == 'Z' && fieldLen == 4)
+                        totalLen = _bgzfUnpack32(buffer);
+                    else if (si1 == 'B' && si2 == 'C' && fieldLen == 2)
+                        totalLen = _bgzfUnpack16(buffer) + 1u;
+                    else if (fieldLen > sizeof(buffer))
+                        for (; fieldLen != 0; --fieldLen)
+                            if (!read(buffer, 1))
+                                throw IOError("Unexpected end of GZip header.");
+                }
+                for (; extraLen != 0; --extraLen)
+                    if (!read(buffer, 1))
+                        throw IOError("Unexpected end of GZip header.");
+            }
+
+            for (unsigned char flag = FLG_FNAME; flag <= FLG_FCOMMENT; flag <<= 1)
+                if (flags & flag)
+                    do
+                    {
+                        if (!read(buffer, 1))
+                            throw IOError("Unexpected end of GZip header.");
+                        ++headerLen;
+                    }
+                    while (buffer[0] != 0);
+
+            if (flags & FLG_FHCRC)
+            {
+                if (!read(buffer, 2))
+                    throw IOError("Unexpected end of GZip header.");
+                headerLen += 2;
+            }
+
+            memberLen = 0;
+            if (totalLen != 0)
+            {
+                if (totalLen < headerLen + DefaultPageSize<GZFile>::BLOCK_FOOTER_LENGTH)
+                    throw IOError("GZip member size mismatch.");
+                memberLen = totalLen - headerLen;
+            }
+            return true;
+        }
+
+        // Inflates the next chunk of a member of unknown size.
+        size_t inflateChunk(char_type *dst, size_t capacity)
+        {
+            CompressionContext<GZFile> &ctx = streamCtx;
+            ctx.strm.next_out = (Bytef *)dst;
+            ctx.strm.avail_out = capacity * sizeof(char_type);
+
+            while (ctx.strm.avail_out != 0)
+            {
+                if (inputPos == inputEnd && !fill())
+                    throw IOError("Unexpected end of GZip member.");
+
+                ctx.strm.next_in = (Bytef *)&inputBuffer[inputPos];
+                ctx.strm.avail_in = inputEnd - inputPos;
+                int status = inflate(&ctx.strm, Z_NO_FLUSH);
+                inputPos = inputEnd - ctx.strm.avail_in;
+
+                if (status == Z_STREAM_END)
+                {
+                    inMember = false;
+                    break;
+                }
+                if (status != Z_OK)
+                    throw IOError("Inflation of GZip member failed.");
+            }
+
+            size_t size = capacity * sizeof(char_type) - ctx.strm.avail_out;
+            memberCrc = crc32(memberCrc, (Bytef *)dst, size);
+
+            if (!inMember)
+            {
+                // check footer
+                byte_type footer[8];
+                if (!read(footer, sizeof(footer)))
+                    throw IOError("Unexpected end of GZip member.");
+                if (_bgzfUnpack32(footer) != memberCrc)
+                    throw IOError("GZip wrong checksum.");
+                if (_bgzfUnpack32(footer + 4) != (unsigned)ctx.strm.total_out)
+                    throw IOError("GZip size mismatch.");
+                if (inflateEnd(&ctx.strm) != Z_OK)
+                    throw IOError("GZip inflateEnd() failed.");
+            }
+            return size / sizeof(char_type);
+        }
+    };
+
+    Serializer serializer;
+
+    struct DecompressionJob
+    {
+        TInputBuffer    inputBuffer;
+        TBuffer         buffer;
+        __int64         size;
+
+        CriticalSection cs;
+        Condition       readyEvent;
+        bool            ready;
+
+        DecompressionJob() :
+            buffer(MAX_PUTBACK + DefaultPageSize<GZFile>::VALUE / sizeof(char_type), 0),
+            size(0),
+            readyEvent(cs),
+            ready(true)
+        {}
+
+        DecompressionJob(DecompressionJob const &other) :
+            inputBuffer(other.inputBuffer),
+            buffer(other.buffer),
+            size(other.size),
+            readyEvent(cs),
+            ready(other.ready)
+        {}
+    };
+
+    // string of recycable jobs
+    size_t                      numThreads;
+    size_t                      numJobs;
+    String<DecompressionJob>    jobs;
+    TJobQueue                   runningQueue;
+    TJobQueue                   todoQueue;
+    int                         currentJobId;
+
+    struct DecompressionThread
+    {
+        basic_ungzip_streambuf          *streamBuf;
+        CompressionContext<GZFile>      compressionCtx;
+
+        void setError(IOError const & e)
+        {
+            ScopedLock<Mutex> scopedLock(streamBuf->serializer.lock);
+            if (streamBuf->serializer.error == NULL)
+                streamBuf->serializer.error = new IOError(e);
+        }
+
+        void operator()()
+        {
+            ScopedReadLock<TJobQueue> readLock(streamBuf->todoQueue);
+            ScopedWriteLock<TJobQueue> writeLock(streamBuf->runningQueue);
+
+            Serializer &serializer = streamBuf->serializer;
+
+            // wait for a new job to become available
+            while (true)
+            {
+                int jobId = -1;
+                if (!popFront(jobId, streamBuf->todoQueue))
+                    return;
+
+                DecompressionJob &job = streamBuf->jobs[jobId];
+                bool loaded = false;
+
+                {
+                    ScopedLock<Mutex> scopedLock(serializer.lock);
+
+                    if (serializer.error != NULL)
+                        return;
+
+                    job.size = -1;
+
+                    SEQAN_TRY
+                    {
+                        if (!serializer.eof && !serializer.inMember)
+                        {
+                            size_t memberLen = 0;
+                            if (!serializer.readHeader(memberLen))
+                            {
+                                serializer.eof = true;
+                            }
+                            else if (memberLen != 0)
+                            {
+                                // member of known size, load it and inflate it concurrently
+                                job.inputBuffer.resize(memberLen);
+                                if (!serializer.read(&job.inputBuffer[0], memberLen))
+                                    throw IOError("Unexpected end of GZip member.");
+                                job.ready = false;
+                                loaded = true;
+                            }
+                            else
+                            {
+                                // member of unknown size, inflate it chunk-wise in stream order
+                                decompressInit(serializer.streamCtx);
+                                serializer.inMember = true;
+                                serializer.memberCrc = crc32(0u, NULL, 0u);
+                            }
+                        }
+
+                        if (!serializer.eof && serializer.inMember)
+                            job.size = serializer.inflateChunk(&job.buffer[0] + MAX_PUTBACK,
+                                                               job.buffer.size() - MAX_PUTBACK);
+                    }
+                    SEQAN_CATCH(IOError const & e)
+                    {
+                        serializer.error = new IOError(e);
+                        return;
+                    }
+
+                    if (!appendValue(streamBuf->runningQueue, jobId))
+                    {
+                        // signal that job is ready
+                        {
+                            ScopedLock<CriticalSection> lock(job.cs);
+                            job.ready = true;
+                            signal(job.readyEvent);
+                        }
+                        return;
+                    }
+                }
+
+                // A job that is ready when queued can already be recycled and reloaded by another thread,
+                // so only inflate members loaded above.
+                if (loaded)
+                {
+                    SEQAN_TRY
+                    {
+                        // decompress block, the buffer is enlarged as needed
+                        job.size = _decompressBlock(job.buffer, MAX_PUTBACK,
+                                                    &job.inputBuffer[0], job.inputBuffer.size(), compressionCtx);
+                    }
+                    SEQAN_CATCH(IOError const & e)
+                    {
+                        setError(e);
+                    }
+
+                    // signal that job is ready
+                    {
+                        ScopedLock<CriticalSection> lock(job.cs);
+                        job.ready = true;
+                        signal(job.readyEvent);
+                    }
+                }
+            }
+        }
+    };
+
+    // array of worker threads
+    Thread<DecompressionThread> *threads;
+    TBuffer                     putbackBuffer;
+
+    basic_ungzip_streambuf(istream_reference istream_,
+                           size_t numThreads = GZIP_DEFAULT_THREADS,
+                           size_t jobsPerThread = 8) :
+        serializer(istream_),
+        numThreads(numThreads),
+        numJobs(numThreads * jobsPerThread),
+        runningQueue(numJobs),
+        todoQueue(numJobs),
+        putbackBuffer(MAX_PUTBACK)
+    {
+        resize(jobs, numJobs, Exact());
+        currentJobId = -1;
+
+        lockReading(runningQueue);
+        lockWriting(todoQueue);
+        setReaderWriterCount(runningQueue, 1, numThreads);
+        setReaderWriterCount(todoQueue, numThreads, 1);
+
+        for (unsigned i = 0; i < numJobs; ++i)
+        {
+            bool success = appendValue(todoQueue, i);
+            ignoreUnusedVariableWarning(success);
+            SEQAN_ASSERT(success);
+        }
+
+        threads = new Thread<DecompressionThread>[numThreads];
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            threads[i].worker.streamBuf = this;
+            run(threads[i]);
+        }
+    }
+
+    ~basic_ungzip_streambuf()
+    {
+        unlockWriting(todoQueue);
+        unlockReading(runningQueue);
+
+        for (unsigned i = 0; i < numThreads; ++i)
+            waitFor(threads[i]);
+        delete[] threads;
+    }
+
+    int_type underflow()
+    {
+        // no need to use the next buffer?
+        if (this->gptr() && this->gptr() < this->egptr())
+            return Tr::to_int_type(*this->gptr());
+
+        size_t putback = this->gptr() - this->eback();
+        if (putback > MAX_PUTBACK)
+            putback = MAX_PUTBACK;
+
+        // save at most MAX_PUTBACK characters from previous page to putback buffer
+        if (putback != 0)
+            std::copy(
+                this->gptr() - putback,
+                this->gptr(),
+                &putbackBuffer[0]);
+
+        while (true)
+        {
+            // recycle the previous job, including empty chunks skipped below
+            if (currentJobId >= 0)
+                appendValue(todoQueue, currentJobId);
+
+            if (!popFront(currentJobId, runningQueue))
+            {
+                currentJobId = -1;
+                SEQAN_ASSERT(serializer.error != NULL);
+                if (serializer.error != NULL)
+                    throw *serializer.error;
+                return EOF;
+            }
+
+            DecompressionJob &job = jobs[currentJobId];
+
+            // wait for the end of decompression
+            {
+                ScopedLock<CriticalSection> lock(job.cs);
+                if (!job.ready)
+                    waitFor(job.readyEvent);
+            }
+
+            // restore putback buffer
+            if (putback != 0)
+                std::copy(
+                    &putbackBuffer[0],
+                    &putbackBuffer[0] + putback,
+                    &job.buffer[0] + (MAX_PUTBACK - putback));
+
+            size_t size = (job.size != -1)? job.size : 0;
+
+            // reset buffer pointers
+            this->setg(
+                  &job.buffer[0] + (MAX_PUTBACK - putback),     // beginning of putback area
+                  &job.buffer[0] + MAX_PUTBACK,                 // read position
+                  &job.buffer[0] + (MAX_PUTBACK + size));       // end of buffer
+
+            if (job.size == -1)
+            {
+                ScopedLock<Mutex> scopedLock(serializer.lock);
+                if (serializer.error != NULL)
+                    throw *serializer.error;
+                return EOF;
+            }
+            else if (job.size > 0)
+                return Tr::to_int_type(*this->gptr());      // return next character
+        }
+    }
+
+    /// returns the compressed input istream
+    istream_reference get_istream()    { return serializer.istream;};
+};
+
+/* \brief Base class for parallel gzip ostreams
+
+Contains a basic_gzip_streambuf.
+*/
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gzip_ostreambase : virtual public std::basic_ios<Elem,Tr>
+{
+public:
+    typedef std::basic_ostream<Elem, Tr>& ostream_reference;
+    typedef basic_gzip_streambuf<
+        Elem,
+        Tr,
+        ElemA,
+        ByteT,
+        ByteAT
+        > gzip_streambuf_type;
+
+    basic_gzip_ostreambase(ostream_reference ostream_, size_t numThreads)
+        : m_buf(ostream_, numThreads)
+    {
+        this->init(&m_buf );
+    };
+
+    /// returns the underlying zip ostream object
+    gzip_streambuf_type* rdbuf() { return &m_buf; };
+
+private:
+    gzip_streambuf_type m_buf;
+};
+
+/* \brief Base class for parallel gzip istreams
+
+Contains a basic_ungzip_streambuf.
+*/
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gzip_istreambase : virtual public std::basic_ios<Elem,Tr>
+{
+public:
+    typedef std::basic_istream<Elem, Tr>& istream_reference;
+    typedef basic_ungzip_streambuf<
+        Elem,
+        Tr,
+        ElemA,
+        ByteT,
+        ByteAT
+        > ungzip_streambuf_type;
+
+    basic_gzip_istreambase(istream_reference istream_, size_t numThreads)
+        : m_buf(istream_, numThreads)
+    {
+        this->init(&m_buf );
+    };
+
+    /// returns the underlying unzip istream object
+    ungzip_streambuf_type* rdbuf() { return &m_buf; };
+
+private:
+    ungzip_streambuf_type m_buf;
+};
+
+/*brief A parallel gzip ostream
+
+This class is a ostream decorator that compresses blocks of the written data concurrently
+with numThreads threads into independent gzip members.  The data is completely flushed in
+the destructor.
+
+Example:
+\code
+ofstream file("reads.fq.gz", std::ios::binary);
+gzip_ostream zipper(file);
+zipper << ">seq1\nACGT\n";
+\endcode
+*/
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gzip_ostream :
+    public basic_gzip_ostreambase<Elem,Tr,ElemA,ByteT,ByteAT>,
+    public std::basic_ostream<Elem,Tr>
+{
+public:
+    typedef basic_gzip_ostreambase<
+        Elem,Tr,ElemA,ByteT,ByteAT> gzip_ostreambase_type;
+    typedef std::basic_ostream<Elem,Tr> ostream_type;
+    typedef ostream_type& ostream_reference;
+
+    basic_gzip_ostream(ostream_reference ostream_, size_t numThreads = GZIP_DEFAULT_THREADS)
+    :
+        gzip_ostreambase_type(ostream_, numThreads),
+        ostream_type(gzip_ostreambase_type::rdbuf())
+    {}
+
+    /// flush inner buffer and zipper buffer
+    basic_gzip_ostream<Elem,Tr>& zflush()
+    {
+        this->flush(); this->rdbuf()->flush(); return *this;
+    };
+
+#ifdef _WIN32
+private:
+    void _Add_vtordisp1() { } // Required to avoid VC++ warning C4250
+    void _Add_vtordisp2() { } // Required to avoid VC++ warning C4250
+#endif
+};
+
+/* \brief A parallel gzip istream
+
+This class is a istream decorator that decompresses single- or multi-member gzip data.
+Members with a known compressed size, i.e. with an 'SZ' or BGZF 'BC' extra subfield, are inflated
+concurrently with numThreads threads.  Other members are inflated sequentially.
+
+Simlpe example:
+\code
+ifstream file("reads.fq.gz", std::ios::binary);
+gzip_istream unzipper(file);
+std::string line;
+std::getline(unzipper, line);
+\endcode
+*/
+template<
+    typename Elem,
+    typename Tr = std::char_traits<Elem>,
+    typename ElemA = std::allocator<Elem>,
+    typename ByteT = char,
+    typename ByteAT = std::allocator<ByteT>
+>
+class basic_gzip_istream :
+    public basic_gzip_istreambase<Elem,Tr,ElemA,ByteT,ByteAT>,
+    public std::basic_istream<Elem,Tr>
+{
+public:
+    typedef basic_gzip_istreambase<
+        Elem,Tr,ElemA,ByteT,ByteAT> gzip_istreambase_type;
+    typedef std::basic_istream<Elem,Tr> istream_type;
+    typedef istream_type& istream_reference;
+
+    basic_gzip_istream(istream_reference istream_, size_t numThreads = GZIP_DEFAULT_THREADS)
+      :
+        gzip_istreambase_type(istream_, numThreads),
+        istream_type(gzip_istreambase_type::rdbuf())
+    {};
+
+#ifdef _WIN32
+private:
+    void _Add_vtordisp1() { } // Required to avoid VC++ warning C4250
+    void _Add_vtordisp2() { } // Required to avoid VC++ warning C4250
+#endif
+};
+
+/// A typedef for basic_gzip_ostream<char>
+typedef basic_gzip_ostream<char> gzip_ostream;
+/// A typedef for basic_gzip_istream<char>
+typedef basic_gzip_istream<char> gzip_istream;
+
+}  // namespace seqan
+
+#endif  // SEQAN_STREAM_ZIPSTREAM_GZIPSTREAM_H_
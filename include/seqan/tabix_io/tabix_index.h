@@ -0,0 +1,816 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tabix index (samtools-style .tbi) for BGZF-compressed, position-sorted
+// text files, i.e. VCF, BED and GFF/GTF.  The index works on the lines of
+// the file and only needs the column layout of the format, see
+// _tabixSetPreset().  Offsets are BGZF virtual offsets as returned by
+// position() of a FormattedFile reading from a BGZF stream.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_TABIX_IO_TABIX_INDEX_H_
+#define INCLUDE_SEQAN_TABIX_IO_TABIX_INDEX_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class TabixIndex
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class TabixIndex
+ * @headerfile <seqan/tabix_io.h>
+ * @brief Access to tabix indices of BGZF-compressed VCF, BED and GFF files.
+ *
+ * @signature class TabixIndex;
+ *
+ * The index is compatible with the <tt>.tbi</tt> files written by the samtools <tt>tabix</tt> program.  It can be
+ * built from a position-sorted file with @link TabixIndex#buildIndex @endlink, stored with
+ * @link TabixIndex#save @endlink, loaded with @link TabixIndex#open @endlink and used to seek to a region with
+ * @link TabixIndex#jumpToRegion @endlink.
+ *
+ * The file to index must be compressed with BGZF (e.g. with <tt>bgzip</tt> or by writing to a file with the
+ * extension <tt>.bgzf</tt> or <tt>.bgz</tt>), plain gzip or uncompressed files do not support random access.
+ *
+ * @see VcfFileIn
+ * @see BedFileIn
+ * @see GffFileIn
+ */
+
+/*!
+ * @fn TabixIndex::TabixIndex
+ * @brief Constructor.
+ *
+ * @signature TabixIndex::TabixIndex();
+ *
+ * @section Remarks
+ *
+ * Only the default constructor is provided.
+ */
+
+class TabixIndex
+{
+public:
+    typedef std::map<__uint32, String<Pair<__uint64, __uint64> > > TBinIndex_;
+    typedef String<__uint64> TLinearIndex_;
+
+    // Values of the format field, TBI_UCSC is a flag for 0-based, half-open coordinates.
+    enum
+    {
+        TBI_GENERIC = 0,
+        TBI_SAM = 1,
+        TBI_VCF = 2,
+        TBI_UCSC = 0x10000
+    };
+
+    // 1<<14 is the size of the minimum bin.
+    static const __int32 TBI_LIDX_SHIFT = 14;
+    // The bins cover the positions below 1<<29.
+    static const __int32 TBI_MAX_POS = 1 << 29;
+
+    // Column layout of the indexed file (1-based, colEnd == 0 if there is no end column).
+    __int32 _format;
+    __int32 _colSeq;
+    __int32 _colBeg;
+    __int32 _colEnd;
+    __int32 _meta;
+    __int32 _skip;
+
+    // The sequence names in the order of their first occurrence in the file.
+    StringSet<CharString> _seqNames;
+    std::map<CharString, __int32> _seqIds;
+
+    String<TBinIndex_> _binIndices;
+    String<TLinearIndex_> _linearIndices;
+
+    TabixIndex() :
+        _format(TBI_GENERIC), _colSeq(1), _colBeg(2), _colEnd(3), _meta('#'), _skip(0)
+    {}
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#clear
+ * @brief Remove all sequences, bins and linear indices from a tabix index.
+ *
+ * @signature void clear(index);
+ *
+ * @param[in,out] index The @link TabixIndex @endlink to clear.
+ */
+
+inline void
+clear(TabixIndex & index)
+{
+    clear(index._seqNames);
+    index._seqIds.clear();
+    clear(index._binIndices);
+    clear(index._linearIndices);
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixSetPreset()
+// ----------------------------------------------------------------------------
+
+// The column layouts are the "vcf", "bed" and "gff" presets of the tabix program.
+
+inline void
+_tabixSetPreset(TabixIndex & index, Vcf)
+{
+    index._format = TabixIndex::TBI_VCF;
+    index._colSeq = 1;
+    index._colBeg = 2;
+    index._colEnd = 0;
+    index._meta = '#';
+    index._skip = 0;
+}
+
+inline void
+_tabixSetPreset(TabixIndex & index, Bed)
+{
+    index._format = TabixIndex::TBI_GENERIC | TabixIndex::TBI_UCSC;
+    index._colSeq = 1;
+    index._colBeg = 2;
+    index._colEnd = 3;
+    index._meta = '#';
+    index._skip = 0;
+}
+
+inline void
+_tabixSetPreset(TabixIndex & index, Gff)
+{
+    index._format = TabixIndex::TBI_GENERIC;
+    index._colSeq = 1;
+    index._colBeg = 4;
+    index._colEnd = 5;
+    index._meta = '#';
+    index._skip = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixReg2Bin()
+// ----------------------------------------------------------------------------
+
+// Smallest bin that completely contains [beg, end), same binning scheme as in BAI.
+
+inline __uint32
+_tabixReg2Bin(__uint32 beg, __uint32 end)
+{
+    --end;
+    if (beg >> 14 == end >> 14) return 4681 + (beg >> 14);
+    if (beg >> 17 == end >> 17) return  585 + (beg >> 17);
+    if (beg >> 20 == end >> 20) return   73 + (beg >> 20);
+    if (beg >> 23 == end >> 23) return    9 + (beg >> 23);
+    if (beg >> 26 == end >> 26) return    1 + (beg >> 26);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixReg2Bins()
+// ----------------------------------------------------------------------------
+
+// All bins that may contain entries overlapping [beg, end).
+
+inline void
+_tabixReg2Bins(String<__uint32> & list, __uint32 beg, __uint32 end)
+{
+    unsigned k;
+    if (beg >= end) return;
+    if (end >= (__uint32)TabixIndex::TBI_MAX_POS) end = TabixIndex::TBI_MAX_POS;
+    --end;
+    appendValue(list, 0);
+    for (k =    1 + (beg>>26); k <=    1 + (end>>26); ++k) appendValue(list, k);
+    for (k =    9 + (beg>>23); k <=    9 + (end>>23); ++k) appendValue(list, k);
+    for (k =   73 + (beg>>20); k <=   73 + (end>>20); ++k) appendValue(list, k);
+    for (k =  585 + (beg>>17); k <=  585 + (end>>17); ++k) appendValue(list, k);
+    for (k = 4681 + (beg>>14); k <= 4681 + (end>>14); ++k) appendValue(list, k);
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixParseInterval()
+// ----------------------------------------------------------------------------
+
+// Extract sequence name and the 0-based, half-open interval of a data line.  For VCF, the end is given by the length
+// of the REF column or by an END entry in the INFO column.
+
+inline bool
+_tabixParseInterval(CharString & seqName,
+                    __int32 & beginPos,
+                    __int32 & endPos,
+                    CharString const & line,
+                    TabixIndex const & index)
+{
+    typedef Infix<CharString const>::Type TInfix;
+
+    bool isVcf = (index._format & 0xffff) == TabixIndex::TBI_VCF;
+    bool hasSeq = false;
+    bool hasBeg = false;
+    bool hasEnd = false;
+    __int32 refLength = 1;
+    TInfix info;
+
+    __int32 col = 1;
+    unsigned colBegin = 0;
+    for (unsigned i = 0; i <= length(line); ++i)
+    {
+        if (i != length(line) && line[i] != '\t')
+            continue;
+
+        TInfix field = infix(line, colBegin, i);
+        if (col == index._colSeq)
+        {
+            seqName = field;
+            hasSeq = true;
+        }
+        else if (col == index._colBeg)
+        {
+            if (!lexicalCast(beginPos, field))
+                return false;
+            hasBeg = true;
+        }
+        else if (col == index._colEnd)
+        {
+            if (!lexicalCast(endPos, field))
+                return false;
+            hasEnd = true;
+        }
+        else if (isVcf && col == 4)
+        {
+            refLength = length(field);
+        }
+        else if (isVcf && col == 8)
+        {
+            info = field;
+        }
+
+        colBegin = i + 1;
+        ++col;
+    }
+
+    if (!hasSeq || !hasBeg)
+        return false;
+
+    // Convert 1-based begin positions to 0-based ones, end positions are then exclusive already.
+    if (!(index._format & TabixIndex::TBI_UCSC))
+        --beginPos;
+
+    if (isVcf)
+    {
+        endPos = beginPos + refLength;
+
+        for (unsigned i = 0; i + 4 < length(info); ++i)
+        {
+            if ((i == 0 || info[i - 1] == ';') && infix(info, i, i + 4) == "END=")
+            {
+                unsigned j = i + 4;
+                while (j < length(info) && info[j] != ';')
+                    ++j;
+                __int32 infoEndPos = 0;
+                if (lexicalCast(infoEndPos, infix(info, i + 4, j)))
+                    endPos = infoEndPos;
+                break;
+            }
+        }
+    }
+    else if (!hasEnd)
+    {
+        endPos = beginPos + 1;
+    }
+
+    if (beginPos < 0)
+        return false;
+    if (endPos <= beginPos)
+        endPos = beginPos + 1;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixAddChunk()
+// ----------------------------------------------------------------------------
+
+inline void
+_tabixAddChunk(TabixIndex::TBinIndex_ & binIndex, __uint32 bin, __uint64 chunkBeg, __uint64 chunkEnd)
+{
+    appendValue(binIndex[bin], Pair<__uint64>(chunkBeg, chunkEnd));
+}
+
+// ----------------------------------------------------------------------------
+// Function _tabixIsTextFormat()
+// ----------------------------------------------------------------------------
+
+// Tabix indexes text lines, BCF files of a VcfFileIn cannot be indexed.
+template <typename TFormat>
+inline bool
+_tabixIsTextFormat(TFormat const &)
+{
+    return true;
+}
+
+inline bool
+_tabixIsTextFormat(Bcf const &)
+{
+    return false;
+}
+
+template <typename TTagList>
+inline bool
+_tabixIsTextFormat(TagSelector<TTagList> const & format)
+{
+    return !isEqual(format, Bcf());
+}
+
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#buildIndex
+ * @brief Build a tabix index for a BGZF-compressed VCF, BED or GFF file.
+ *
+ * @signature bool buildIndex(index, file);
+ *
+ * @param[out]    index The @link TabixIndex @endlink to build.
+ * @param[in,out] file  The @link VcfFileIn @endlink, @link BedFileIn @endlink or @link GffFileIn @endlink to index.
+ *                      The file is read from its current position up to its end.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file is not BGZF-compressed, a data line cannot be
+ *              parsed, an entry reaches beyond position 2^29 or the file is not sorted by sequence and begin position.
+ *
+ * Header and comment lines starting with <tt>'#'</tt> are skipped.  Entries of the same sequence must be contiguous
+ * and sorted by begin position.
+ */
+
+template <typename TFormat, typename TSpec>
+inline bool
+buildIndex(TabixIndex & index, FormattedFile<TFormat, Input, TSpec> & file)
+{
+    typedef TabixIndex::TLinearIndex_ TLinearIndex;
+    typedef Iterator<TLinearIndex, Standard>::Type TLinearIndexIter;
+
+    clear(index);
+    _tabixSetPreset(index, TFormat());
+
+    // Virtual offsets can only be obtained from BGZF-compressed text files.
+    if (!isEqual(format(file.stream), BgzfFile()) || !_tabixIsTextFormat(file.format))
+        return false;
+
+    CharString line;
+    CharString seqName;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+    __int32 rID = -1;
+    __int32 prevBeginPos = 0;
+    __uint32 currBin = MaxValue<__uint32>::VALUE;
+    __uint64 chunkBeg = 0;
+    __uint64 lineEnd = 0;
+    __int32 lineNo = 0;
+
+    while (!atEnd(file))
+    {
+        __uint64 lineBeg = position(file);
+        clear(line);
+        readLine(line, file.iter);
+        lineEnd = position(file);
+
+        if (lineNo++ < index._skip || empty(line) || line[0] == index._meta)
+            continue;
+
+        if (!_tabixParseInterval(seqName, beginPos, endPos, line, index))
+            return false;
+        if (beginPos >= TabixIndex::TBI_MAX_POS || endPos > TabixIndex::TBI_MAX_POS)
+            return false;  // The entry cannot be binned.
+
+        // A new sequence starts, close the current chunk of the previous one.
+        if (rID < 0 || seqName != index._seqNames[rID])
+        {
+            if (currBin != MaxValue<__uint32>::VALUE)
+                _tabixAddChunk(index._binIndices[rID], currBin, chunkBeg, lineBeg);
+
+            if (index._seqIds.find(seqName) != index._seqIds.end())
+                return false;  // The sequence occurred before, file is not sorted.
+
+            rID = length(index._seqNames);
+            index._seqIds[seqName] = rID;
+            appendValue(index._seqNames, seqName);
+            resize(index._binIndices, rID + 1);
+            resize(index._linearIndices, rID + 1);
+            currBin = MaxValue<__uint32>::VALUE;
+            prevBeginPos = 0;
+        }
+
+        if (beginPos < prevBeginPos)
+            return false;  // File is not sorted by begin position.
+        prevBeginPos = beginPos;
+
+        // Update the linear index, i.e. the smallest offset of an entry overlapping each 16kb window.
+        TLinearIndex & linearIndex = index._linearIndices[rID];
+        unsigned windowBeg = beginPos >> TabixIndex::TBI_LIDX_SHIFT;
+        unsigned windowEnd = (endPos - 1) >> TabixIndex::TBI_LIDX_SHIFT;
+        if (length(linearIndex) <= windowEnd)
+            resize(linearIndex, windowEnd + 1, MaxValue<__uint64>::VALUE);
+        for (unsigned w = windowBeg; w <= windowEnd; ++w)
+            if (linearIndex[w] == MaxValue<__uint64>::VALUE)
+                linearIndex[w] = lineBeg;
+
+        // Extend the current chunk or start a new one if the bin changes.
+        __uint32 bin = _tabixReg2Bin(beginPos, endPos);
+        if (bin != currBin)
+        {
+            if (currBin != MaxValue<__uint32>::VALUE)
+                _tabixAddChunk(index._binIndices[rID], currBin, chunkBeg, lineBeg);
+            currBin = bin;
+            chunkBeg = lineBeg;
+        }
+    }
+
+    if (currBin != MaxValue<__uint32>::VALUE)
+        _tabixAddChunk(index._binIndices[rID], currBin, chunkBeg, lineEnd);
+
+    // Windows without overlapping entries get the offset of the previous window (or the first entry).
+    for (unsigned i = 0; i < length(index._linearIndices); ++i)
+    {
+        TLinearIndexIter it = begin(index._linearIndices[i], Standard());
+        TLinearIndexIter itEnd = end(index._linearIndices[i], Standard());
+        __uint64 offset = MaxValue<__uint64>::VALUE;
+        for (TLinearIndexIter itFirst = it; itFirst != itEnd && offset == MaxValue<__uint64>::VALUE; ++itFirst)
+            offset = *itFirst;
+        for (; it != itEnd; ++it)
+        {
+            if (*it == MaxValue<__uint64>::VALUE)
+                *it = offset;
+            else
+                offset = *it;
+        }
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function jumpToRegion()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#jumpToRegion
+ * @brief Seek in a BGZF-compressed VCF, BED or GFF file using a tabix index.
+ *
+ * You provide a region <tt>[pos, posEnd)</tt> on the sequence <tt>seqName</tt> that you want to jump to and the
+ * function jumps to the first entry overlapping this region, if any.
+ *
+ * @signature bool jumpToRegion(file, hasEntries, seqName, pos, posEnd, index);
+ *
+ * @param[in,out] file       The @link VcfFileIn @endlink, @link BedFileIn @endlink or @link GffFileIn @endlink to
+ *                           jump with.
+ * @param[out]    hasEntries A <tt>bool</tt> that is set true if the region <tt>[pos, posEnd)</tt> has any entries.
+ * @param[in]     seqName    The name of the sequence to jump to.
+ * @param[in]     pos        The 0-based begin of the region to jump to (<tt>__int32</tt>).
+ * @param[in]     posEnd     The 0-based end of the region to jump to (<tt>__int32</tt>).
+ * @param[in]     index      The @link TabixIndex @endlink to use for the jumping.
+ *
+ * @return bool true if seeking was successful, false if not.
+ *
+ * @section Remarks
+ *
+ * This function fails if <tt>seqName</tt> is not in the index or <tt>pos</tt>/<tt>posEnd</tt> are invalid.
+ *
+ * Reading continues from the first overlapping entry, the records behind it are not filtered.  They may end before
+ * <tt>pos</tt> (e.g. after a long deletion), so check the overlap of each record yourself and stop reading at the
+ * first record that starts at or behind <tt>posEnd</tt> or lies on another sequence.
+ */
+
+template <typename TFormat, typename TSpec, typename TSeqName>
+inline bool
+jumpToRegion(FormattedFile<TFormat, Input, TSpec> & file,
+             bool & hasEntries,
+             TSeqName const & seqName,
+             __int32 pos,
+             __int32 posEnd,
+             TabixIndex const & index)
+{
+    typedef TabixIndex::TBinIndex_ TBinIndex;
+    typedef TabixIndex::TLinearIndex_ TLinearIndex;
+    typedef Iterator<String<__uint32>, Standard>::Type TCandidateIter;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
+    hasEntries = false;
+    if (!isEqual(format(file.stream), BgzfFile()) || !_tabixIsTextFormat(file.format))
+        return false;
+    if (pos < 0 || posEnd <= pos)
+        return false;  // Cannot seek to invalid region.
+
+    std::map<CharString, __int32>::const_iterator idIt = index._seqIds.find(seqName);
+    if (idIt == index._seqIds.end())
+        return false;  // Cannot seek to unknown sequence.
+    __int32 rID = idIt->second;
+
+    // ------------------------------------------------------------------------
+    // Compute offset in BGZF file.
+    // ------------------------------------------------------------------------
+
+    // Retrieve the smallest required offset from the linear index.
+    TLinearIndex const & linearIndex = index._linearIndices[rID];
+    unsigned windowIdx = pos >> TabixIndex::TBI_LIDX_SHIFT;
+    if (windowIdx >= length(linearIndex))
+        return true;  // No entry ends behind pos.
+    __uint64 linearMinOffset = linearIndex[windowIdx];
+
+    // The first overlapping entry is in one of the chunks of the candidate bins that end behind the linear offset.
+    String<__uint32> candidateBins;
+    _tabixReg2Bins(candidateBins, pos, posEnd);
+
+    __uint64 offset = MaxValue<__uint64>::VALUE;
+    TBinIndex const & binIndex = index._binIndices[rID];
+    for (TCandidateIter it = begin(candidateBins, Standard()); it != end(candidateBins, Standard()); ++it)
+    {
+        TBinIndex::const_iterator mIt = binIndex.find(*it);
+        if (mIt == binIndex.end())
+            continue;  // Candidate is not in index!
+
+        for (TChunkIter itC = begin(mIt->second, Standard()); itC != end(mIt->second, Standard()); ++itC)
+            if (itC->i2 > linearMinOffset)
+                offset = std::min(offset, std::max(itC->i1, linearMinOffset));
+    }
+
+    if (offset == MaxValue<__uint64>::VALUE)
+        return true;  // No candidate chunk.
+
+    // ------------------------------------------------------------------------
+    // Scan to the first overlapping entry.
+    // ------------------------------------------------------------------------
+
+    if (!setPosition(file, offset))
+        return false;  // Error while seeking.
+
+    CharString line;
+    CharString lineSeqName;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+    while (!atEnd(file))
+    {
+        __uint64 lineBeg = position(file);
+        clear(line);
+        readLine(line, file.iter);
+
+        if (empty(line) || line[0] == index._meta)
+            continue;
+
+        if (!_tabixParseInterval(lineSeqName, beginPos, endPos, line, index))
+            return false;
+
+        if (lineSeqName != index._seqNames[rID] || beginPos >= posEnd)
+            break;  // Cannot find overlapping entries any more.
+
+        if (endPos > pos)
+        {
+            // Found the first overlapping entry, jump back to it.
+            hasEntries = true;
+            return setPosition(file, lineBeg);
+        }
+    }
+
+    // Finding no overlapping entry is not an error, hasEntries is false.
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function open()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#open
+ * @brief Load a tabix index from a given file name.
+ *
+ * @signature bool open(index, filename);
+ *
+ * @param[in,out] index    Target data structure.
+ * @param[in]     filename Path to the <tt>.tbi</tt> file to load. Types: char const *
+ *
+ * @return        bool     Returns <tt>true</tt> on success, false otherwise.
+ */
+
+inline bool
+open(TabixIndex & index, char const * filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::in);
+    if (!file.good())
+        return false;  // Could not open file.
+
+    // Tabix indices are BGZF-compressed, the compression is detected from the stream.
+    VirtualStream<char, Input> fin;
+    if (!open(fin, file))
+        return false;
+
+    clear(index);
+
+    // Read magic number.
+    CharString buffer;
+    resize(buffer, 4);
+    fin.read(&buffer[0], 4);
+    if (!fin.good())
+        return false;
+    if (buffer != "TBI\1")
+        return false;  // Magic number is wrong.
+
+    __int32 nRef = 0;
+    fin.read(reinterpret_cast<char *>(&nRef), 4);
+    fin.read(reinterpret_cast<char *>(&index._format), 4);
+    fin.read(reinterpret_cast<char *>(&index._colSeq), 4);
+    fin.read(reinterpret_cast<char *>(&index._colBeg), 4);
+    fin.read(reinterpret_cast<char *>(&index._colEnd), 4);
+    fin.read(reinterpret_cast<char *>(&index._meta), 4);
+    fin.read(reinterpret_cast<char *>(&index._skip), 4);
+    __int32 lNames = 0;
+    fin.read(reinterpret_cast<char *>(&lNames), 4);
+    if (!fin.good() || nRef < 0 || lNames < 0)
+        return false;
+
+    // Read the zero-terminated sequence names.
+    resize(buffer, lNames);
+    if (lNames > 0)
+        fin.read(&buffer[0], lNames);
+    if (!fin.good())
+        return false;
+    for (__int32 i = 0, nameBeg = 0; i < lNames; ++i)
+    {
+        if (buffer[i] != '\0')
+            continue;
+        index._seqIds[infix(buffer, nameBeg, i)] = length(index._seqNames);
+        appendValue(index._seqNames, infix(buffer, nameBeg, i));
+        nameBeg = i + 1;
+    }
+    if ((__int32)length(index._seqNames) != nRef)
+        return false;
+
+    resize(index._linearIndices, nRef);
+    resize(index._binIndices, nRef);
+
+    for (int i = 0; i < nRef; ++i)  // For each reference.
+    {
+        // Read bin index.
+        __int32 nBin = 0;
+        fin.read(reinterpret_cast<char *>(&nBin), 4);
+        if (!fin.good())
+            return false;
+        for (int j = 0; j < nBin; ++j)  // For each bin.
+        {
+            __uint32 bin = 0;
+            fin.read(reinterpret_cast<char *>(&bin), 4);
+            __int32 nChunk = 0;
+            fin.read(reinterpret_cast<char *>(&nChunk), 4);
+            if (!fin.good())
+                return false;
+
+            String<Pair<__uint64, __uint64> > & chunkBegEnds = index._binIndices[i][bin];
+            reserve(chunkBegEnds, nChunk);
+            for (int k = 0; k < nChunk; ++k)  // For each chunk;
+            {
+                __uint64 chunkBeg = 0;
+                __uint64 chunkEnd = 0;
+                fin.read(reinterpret_cast<char *>(&chunkBeg), 8);
+                fin.read(reinterpret_cast<char *>(&chunkEnd), 8);
+                if (!fin.good())
+                    return false;
+                appendValue(chunkBegEnds, Pair<__uint64>(chunkBeg, chunkEnd));
+            }
+        }
+
+        // Read linear index.
+        __int32 nIntv = 0;
+        fin.read(reinterpret_cast<char *>(&nIntv), 4);
+        if (!fin.good())
+            return false;
+        resize(index._linearIndices[i], nIntv);
+        if (nIntv > 0)
+            fin.read(reinterpret_cast<char *>(&index._linearIndices[i][0]), 8 * nIntv);
+        if (!fin.good())
+            return false;
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function save()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#save
+ * @brief Save a tabix index to a given file name.
+ *
+ * @signature bool save(index, filename);
+ *
+ * @param[in] index    The @link TabixIndex @endlink to save.
+ * @param[in] filename Path to the <tt>.tbi</tt> file to write. Types: char const *
+ *
+ * @return    bool     Returns <tt>true</tt> on success, false otherwise.
+ */
+
+inline bool
+save(TabixIndex const & index, char const * filename)
+{
+    typedef TabixIndex::TBinIndex_ TBinIndex;
+    typedef Iterator<String<Pair<__uint64, __uint64> > const, Standard>::Type TChunkIter;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::out);
+    if (!file.good())
+        return false;  // Could not open file.
+
+    VirtualStream<char, Output> out;
+    if (!open(out, file, BgzfFile()))
+        return false;
+
+    SEQAN_ASSERT_EQ(length(index._binIndices), length(index._seqNames));
+    SEQAN_ASSERT_EQ(length(index._linearIndices), length(index._seqNames));
+
+    // Write header.
+    out.write("TBI\1", 4);
+    __int32 nRef = length(index._seqNames);
+    out.write(reinterpret_cast<char const *>(&nRef), 4);
+    out.write(reinterpret_cast<char const *>(&index._format), 4);
+    out.write(reinterpret_cast<char const *>(&index._colSeq), 4);
+    out.write(reinterpret_cast<char const *>(&index._colBeg), 4);
+    out.write(reinterpret_cast<char const *>(&index._colEnd), 4);
+    out.write(reinterpret_cast<char const *>(&index._meta), 4);
+    out.write(reinterpret_cast<char const *>(&index._skip), 4);
+
+    // Write the zero-terminated sequence names.
+    __int32 lNames = lengthSum(index._seqNames) + nRef;
+    out.write(reinterpret_cast<char const *>(&lNames), 4);
+    for (__int32 i = 0; i < nRef; ++i)
+    {
+        out.write(toCString(index._seqNames[i]), length(index._seqNames[i]));
+        out.put('\0');
+    }
+
+    for (__int32 i = 0; i < nRef; ++i)
+    {
+        // Write out binning index.
+        TBinIndex const & binIndex = index._binIndices[i];
+        __int32 nBin = binIndex.size();
+        out.write(reinterpret_cast<char const *>(&nBin), 4);
+        for (TBinIndex::const_iterator itB = binIndex.begin(); itB != binIndex.end(); ++itB)
+        {
+            out.write(reinterpret_cast<char const *>(&itB->first), 4);
+            __int32 nChunk = length(itB->second);
+            out.write(reinterpret_cast<char const *>(&nChunk), 4);
+            for (TChunkIter itC = begin(itB->second, Standard()); itC != end(itB->second, Standard()); ++itC)
+            {
+                out.write(reinterpret_cast<char const *>(&itC->i1), 8);
+                out.write(reinterpret_cast<char const *>(&itC->i2), 8);
+            }
+        }
+
+        // Write out linear index.
+        __int32 nIntv = length(index._linearIndices[i]);
+        out.write(reinterpret_cast<char const *>(&nIntv), 4);
+        if (nIntv > 0)
+            out.write(reinterpret_cast<char const *>(&index._linearIndices[i][0]), 8 * nIntv);
+    }
+
+    bool success = out.good();
+    close(out);
+    return success && file.good();  // false on error, true on success.
+}
+
+}  // namespace seqan
+
+#endif  // INCLUDE_SEQAN_TABIX_IO_TABIX_INDEX_H_
@@ -41,6 +41,9 @@
 // Prerequisites.
 // ===========================================================================
 
+#include <cstring>
+#include <map>
+
 #include <seqan/basic.h>
 #include <seqan/file.h>
 #include <seqan/sequence.h>
@@ -56,9 +59,15 @@
 #include <seqan/vcf_io/vcf_record.h>
 
 #include <seqan/vcf_io/vcf_io_context.h>
+#include <seqan/vcf_io/bcf_typed_values.h>
+#include <seqan/vcf_io/vcf_genotypes.h>
 #include <seqan/vcf_io/read_vcf.h>
 #include <seqan/vcf_io/write_vcf.h>
 
 #include <seqan/vcf_io/vcf_file.h>
 
+// The Bcf tag is declared in vcf_file.h.
+#include <seqan/vcf_io/read_bcf.h>
+#include <seqan/vcf_io/write_bcf.h>
+
 #endif  // SEQAN_INCLUDE_SEQAN_VCF_IO_H_
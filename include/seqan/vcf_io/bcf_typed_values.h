@@ -0,0 +1,279 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Decoding of BCF2 typed values, shared by the BCF reader and the genotype
+// accessors of VcfRecord.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_BCF_TYPED_VALUES_H_
+#define SEQAN_INCLUDE_SEQAN_VCF_IO_BCF_TYPED_VALUES_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// Sentinel values of BCF2 typed values.  Narrower integer types are widened
+// to 32 bit when decoding, floats are handled by their bit patterns.
+const __int32  BCF_INT32_MISSING    = MinValue<__int32>::VALUE;
+const __int32  BCF_INT32_VECTOR_END = MinValue<__int32>::VALUE + 1;
+const __uint32 BCF_FLOAT_MISSING    = 0x7F800001;
+const __uint32 BCF_FLOAT_VECTOR_END = 0x7F800002;
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _bcfCheckRemaining()
+// ----------------------------------------------------------------------------
+
+// Throw if fewer than size bytes are left before itEnd, the end of the current section.
+inline void
+_bcfCheckRemaining(char const * it, char const * itEnd, __int64 size)
+{
+    if (size < 0 || itEnd - it < size)
+        SEQAN_THROW(ParseError("Unexpected end of BCF record."));
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfReadPod()
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline TValue
+_bcfReadPod(char const * & it)
+{
+    TValue value;
+    std::memcpy(&value, it, sizeof(TValue));
+    it += sizeof(TValue);
+    return value;
+}
+
+template <typename TValue>
+inline TValue
+_bcfReadPod(char const * & it, char const * itEnd)
+{
+    _bcfCheckRemaining(it, itEnd, sizeof(TValue));
+    return _bcfReadPod<TValue>(it);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfTypeSize()
+// ----------------------------------------------------------------------------
+
+inline unsigned
+_bcfTypeSize(unsigned type)
+{
+    switch (type)
+    {
+        case BCF_TYPE_INT8:
+        case BCF_TYPE_CHAR:
+            return 1;
+        case BCF_TYPE_INT16:
+            return 2;
+        case BCF_TYPE_INT32:
+        case BCF_TYPE_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfReadInt()
+// ----------------------------------------------------------------------------
+
+inline __int32
+_bcfReadInt(char const * & it, char const * itEnd, unsigned type)
+{
+    switch (type)
+    {
+        case BCF_TYPE_INT8:
+        {
+            __int8 value = _bcfReadPod<__int8>(it, itEnd);
+            if (value == -128)
+                return BCF_INT32_MISSING;
+            if (value == -127)
+                return BCF_INT32_VECTOR_END;
+            return value;
+        }
+        case BCF_TYPE_INT16:
+        {
+            __int16 value = _bcfReadPod<__int16>(it, itEnd);
+            if (value == -32768)
+                return BCF_INT32_MISSING;
+            if (value == -32767)
+                return BCF_INT32_VECTOR_END;
+            return value;
+        }
+        case BCF_TYPE_INT32:
+            return _bcfReadPod<__int32>(it, itEnd);
+        default:
+            SEQAN_THROW(ParseError("Invalid integer type in BCF record."));
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfReadTypeDescriptor()
+// ----------------------------------------------------------------------------
+
+// A typed value starts with a byte holding the type in its lower and the
+// number of values in its upper 4 bits.  Counts of 15 and more follow as a
+// typed integer.
+inline void
+_bcfReadTypeDescriptor(unsigned & type, __int32 & count, char const * & it, char const * itEnd)
+{
+    unsigned char descriptor = _bcfReadPod<unsigned char>(it, itEnd);
+    type = descriptor & 0x0f;
+    count = descriptor >> 4;
+    if (count == 15)
+    {
+        unsigned countType;
+        __int32 countCount;
+        _bcfReadTypeDescriptor(countType, countCount, it, itEnd);
+        count = _bcfReadInt(it, itEnd, countType);
+        if (count < 0)
+            SEQAN_THROW(ParseError("Invalid value count in BCF record."));
+    }
+}
+
+inline __int32
+_bcfReadTypedInt(char const * & it, char const * itEnd)
+{
+    unsigned type;
+    __int32 count;
+    _bcfReadTypeDescriptor(type, count, it, itEnd);
+    if (count != 1)
+        SEQAN_THROW(ParseError("Expected a single integer in BCF record."));
+    return _bcfReadInt(it, itEnd, type);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfAppendValues()
+// ----------------------------------------------------------------------------
+
+// Append count typed values as comma-separated text.  Returns false if the
+// vector is empty, i.e. the value is absent.
+template <typename TTarget>
+inline bool
+_bcfAppendValues(TTarget & target, char const * & it, char const * itEnd, unsigned type, __int32 count)
+{
+    _bcfCheckRemaining(it, itEnd, (__int64)count * _bcfTypeSize(type));
+
+    if (type == BCF_TYPE_CHAR)
+    {
+        char const * itBegin = it;
+        char const * itEnd = it + count;
+        for (; it != itEnd && *it != '\0'; ++it)
+            appendValue(target, *it);
+        bool present = (it != itBegin);
+        it = itEnd;
+        return present;
+    }
+
+    unsigned size = _bcfTypeSize(type);
+    for (__int32 i = 0; i < count; ++i)
+    {
+        if (type == BCF_TYPE_FLOAT)
+        {
+            __uint32 bits = _bcfReadPod<__uint32>(it, itEnd);
+            if (bits == BCF_FLOAT_VECTOR_END)
+            {
+                it += (count - i - 1) * size;
+                return i != 0;
+            }
+            if (i != 0)
+                appendValue(target, ',');
+            if (bits == BCF_FLOAT_MISSING)
+            {
+                appendValue(target, '.');
+            }
+            else
+            {
+                float value;
+                std::memcpy(&value, &bits, sizeof(float));
+                appendNumber(target, value);
+            }
+        }
+        else
+        {
+            __int32 value = _bcfReadInt(it, itEnd, type);
+            if (value == BCF_INT32_VECTOR_END)
+            {
+                it += (count - i - 1) * size;
+                return i != 0;
+            }
+            if (i != 0)
+                appendValue(target, ',');
+            if (value == BCF_INT32_MISSING)
+                appendValue(target, '.');
+            else
+                appendNumber(target, value);
+        }
+    }
+    return count != 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfAppendGenotype()
+// ----------------------------------------------------------------------------
+
+// Genotype alleles are stored as (allele + 1) << 1 | phased, 0 is a missing allele.
+template <typename TTarget>
+inline bool
+_bcfAppendGenotype(TTarget & target, char const * & it, char const * itEnd, unsigned type, __int32 count)
+{
+    unsigned size = _bcfTypeSize(type);
+    _bcfCheckRemaining(it, itEnd, (__int64)count * size);
+    for (__int32 i = 0; i < count; ++i)
+    {
+        __int32 value = _bcfReadInt(it, itEnd, type);
+        if (value == BCF_INT32_VECTOR_END)
+        {
+            it += (count - i - 1) * size;
+            return i != 0;
+        }
+        if (i != 0)
+            appendValue(target, (value & 1) ? '|' : '/');
+        if (value == BCF_INT32_MISSING || (value >> 1) == 0)
+            appendValue(target, '.');
+        else
+            appendNumber(target, (value >> 1) - 1);
+    }
+    return count != 0;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_BCF_TYPED_VALUES_H_
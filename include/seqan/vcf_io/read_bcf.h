@@ -0,0 +1,377 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Reading of BCF2 files.  BCF records are decoded into the textual fields of
+// VcfRecord, so both formats share the same record API.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_VCF_READ_BCF_H_
+#define SEQAN_INCLUDE_SEQAN_VCF_READ_BCF_H_
+
+namespace seqan {
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _bcfHeaderField()
+// ----------------------------------------------------------------------------
+
+// Extract the value of the field key from a structured header value like
+// <ID=DP,Number=1,Type=Integer,Description="Read depth">.
+inline bool
+_bcfHeaderField(CharString & result, CharString const & value, char const * key)
+{
+    size_t len = length(value);
+    size_t keyLen = std::strlen(key);
+    clear(result);
+
+    if (len < 2u || value[0] != '<')
+        return false;
+
+    for (size_t i = 1; i < len; )
+    {
+        // Find the end of the field starting at i, skipping quoted commas.
+        size_t j = i;
+        bool inQuotes = false;
+        for (; j < len && (inQuotes || (value[j] != ',' && value[j] != '>')); ++j)
+        {
+            if (value[j] == '"')
+                inQuotes = !inQuotes;
+            else if (inQuotes && value[j] == '\\')
+                ++j;
+        }
+        j = std::min(j, len);
+
+        if (j > i + keyLen && value[i + keyLen] == '=' && prefix(infix(value, i, j), keyLen) == key)
+        {
+            result = infix(value, i + keyLen + 1, j);
+            return true;
+        }
+        i = j + 1;
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfBuildDictionary()
+// ----------------------------------------------------------------------------
+
+template <typename TKey>
+inline __int32
+_bcfAddKey(BcfDictionary_ & dict, TKey const & key, __int32 idx)
+{
+    std::map<CharString, __int32>::const_iterator it = dict.ids.find(key);
+    if (it != dict.ids.end())
+        return it->second;
+
+    if (idx < 0)
+        idx = length(dict.keys);
+    if (idx >= (__int32)length(dict.keys))
+    {
+        resize(dict.keys, idx + 1);
+        resize(dict.infoTypes, idx + 1, (__int8)BCF_TYPE_UNKNOWN);
+        resize(dict.formatTypes, idx + 1, (__int8)BCF_TYPE_UNKNOWN);
+    }
+    dict.keys[idx] = key;
+    dict.ids[dict.keys[idx]] = idx;
+    return idx;
+}
+
+inline __int8
+_bcfTypeFromHeader(CharString const & type)
+{
+    if (type == "Integer")
+        return BCF_TYPE_INT32;
+    if (type == "Float")
+        return BCF_TYPE_FLOAT;
+    if (type == "Flag")
+        return BCF_TYPE_NULL;
+    return BCF_TYPE_CHAR;
+}
+
+// Assign keys to the IDs of the FILTER, INFO, and FORMAT lines in the order of
+// their appearance or as given by IDX, like htslib does.
+inline void
+_bcfBuildDictionary(BcfDictionary_ & dict, VcfHeader const & header)
+{
+    clear(dict);
+    _bcfAddKey(dict, "PASS", 0);
+
+    CharString id;
+    CharString buffer;
+    for (unsigned i = 0; i < length(header); ++i)
+    {
+        bool isInfo = header[i].key == "INFO";
+        bool isFormat = header[i].key == "FORMAT";
+        if (!isInfo && !isFormat && header[i].key != "FILTER")
+            continue;
+        if (!_bcfHeaderField(id, header[i].value, "ID"))
+            continue;
+
+        __int32 idx = -1;
+        if (_bcfHeaderField(buffer, header[i].value, "IDX"))
+            idx = lexicalCast<__int32>(buffer);
+        idx = _bcfAddKey(dict, id, idx);
+
+        if (isInfo || isFormat)
+        {
+            __int8 type = BCF_TYPE_CHAR;
+            if (_bcfHeaderField(buffer, header[i].value, "Type"))
+                type = _bcfTypeFromHeader(buffer);
+            if (isInfo)
+                dict.infoTypes[idx] = type;
+            else
+                dict.formatTypes[idx] = type;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfKey()
+// ----------------------------------------------------------------------------
+
+inline CharString const &
+_bcfKey(BcfDictionary_ const & dict, __int32 idx)
+{
+    if (idx < 0 || idx >= (__int32)length(dict.keys) || empty(dict.keys[idx]))
+        SEQAN_THROW(ParseError("Unknown key in BCF record."));
+    return dict.keys[idx];
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfSplitFormat()
+// ----------------------------------------------------------------------------
+
+// Read the keys of the FORMAT fields in the individual part [data, dataEnd) of a BCF record into format and store the
+// positions of their type descriptors in fieldBegins.  The values of all samples are checked to be within the part.
+inline void
+_bcfSplitFormat(CharString & format,
+                String<__uint32> & fieldBegins,
+                char const * data,
+                char const * dataEnd,
+                unsigned nFmt,
+                unsigned nSample,
+                BcfDictionary_ const & dict)
+{
+    char const * it = data;
+    unsigned type;
+    __int32 count;
+
+    clear(fieldBegins);
+    for (unsigned j = 0; j < nFmt; ++j)
+    {
+        __int32 idx = _bcfReadTypedInt(it, dataEnd);
+        if (j != 0)
+            appendValue(format, ':');
+        append(format, _bcfKey(dict, idx));
+
+        appendValue(fieldBegins, it - data);
+        _bcfReadTypeDescriptor(type, count, it, dataEnd);
+        if (count != 0 && _bcfTypeSize(type) == 0)
+            SEQAN_THROW(ParseError("Invalid value type in BCF record."));
+        __int64 size = (__int64)nSample * count * _bcfTypeSize(type);
+        _bcfCheckRemaining(it, dataEnd, size);
+        it += size;
+    }
+
+    if (nFmt == 0)
+        format = ".";
+    if (it != dataEnd)
+        SEQAN_THROW(ParseError("Invalid BCF record."));
+}
+
+// ----------------------------------------------------------------------------
+// Function readHeader()                                            [VcfHeader]
+// ----------------------------------------------------------------------------
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readHeader(VcfHeader & header,
+           VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Bcf const & /*tag*/)
+{
+    // Read BCF magic string, followed by the minor version (1 or 2).
+    String<char, Array<4> > magic;
+    read(magic, iter, 4);
+    if (magic != "BCF\2")
+        SEQAN_THROW(ParseError("Not in BCF format."));
+    char minorVersion;
+    readRawPod(minorVersion, iter);
+    if (minorVersion != '\1' && minorVersion != '\2')
+        SEQAN_THROW(ParseError("Unsupported BCF version."));
+
+    // Read the text header, including null padding.
+    __uint32 lText;
+    readRawPod(lText, iter);
+    CharString & text = context.buffer;
+    clear(text);
+    write(text, iter, lText);
+    cropAfterFirst(text, EqualsChar<'\0'>());
+
+    // The text header is a VCF header, contigs and samples are numbered in order of appearance.
+    Iterator<CharString, Rooted>::Type it = begin(text);
+    readHeader(header, context, it, Vcf());
+    _bcfBuildDictionary(context._bcfDictionary, header);
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecord()                                            [VcfRecord]
+// ----------------------------------------------------------------------------
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+readRecord(VcfRecord & record,
+           VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+           TForwardIter & iter,
+           Bcf const & /*tag*/)
+{
+    BcfDictionary_ const & dict = context._bcfDictionary;
+    CharString & buffer = context.buffer;
+    unsigned type;
+    __int32 count;
+
+    clear(record);
+
+    __uint32 lShared;
+    __uint32 lIndiv;
+    readRawPod(lShared, iter);
+    readRawPod(lIndiv, iter);
+
+    // fail, if we read "BCF\2" (did you miss to call readHeader(header, bcfFile) first?)
+    if (lShared == 0x02464342)
+        SEQAN_THROW(ParseError("Unexpected BCF header encountered."));
+    if (lShared < 24u)
+        SEQAN_THROW(ParseError("Invalid BCF record."));
+
+    clear(buffer);
+    write(buffer, iter, (size_t)lShared + lIndiv);
+    char const * it = begin(buffer, Standard());
+
+    // Every typed read is checked against the end of its section, the shared
+    // or the individual part of the record.
+    char const * itIndivEnd = end(buffer, Standard());
+    char const * itSharedEnd = it + std::min((size_t)lShared, length(buffer));
+    char const * itEnd = itSharedEnd;
+
+    // CHROM, POS, rlen (implied by REF and INFO/END), and QUAL (missing is MISSING_QUAL).
+    record.rID = _bcfReadPod<__int32>(it, itEnd);
+    record.beginPos = _bcfReadPod<__int32>(it, itEnd);
+    _bcfReadPod<__int32>(it, itEnd);
+    record.qual = _bcfReadPod<float>(it, itEnd);
+
+    __uint32 nAlleleInfo = _bcfReadPod<__uint32>(it, itEnd);
+    __uint32 nFmtSample = _bcfReadPod<__uint32>(it, itEnd);
+    unsigned nAllele = nAlleleInfo >> 16;
+    unsigned nInfo = nAlleleInfo & 0xffff;
+    unsigned nSample = nFmtSample & 0xffffff;
+    unsigned nFmt = nFmtSample >> 24;
+
+    // ID
+    _bcfReadTypeDescriptor(type, count, it, itEnd);
+    if (!_bcfAppendValues(record.id, it, itEnd, type, count))
+        record.id = ".";
+
+    // REF and ALT
+    for (unsigned i = 0; i < nAllele; ++i)
+    {
+        _bcfReadTypeDescriptor(type, count, it, itEnd);
+        if (i > 1)
+            appendValue(record.alt, ',');
+        _bcfAppendValues((i == 0) ? record.ref : record.alt, it, itEnd, type, count);
+    }
+    if (nAllele < 2)
+        record.alt = ".";
+
+    // FILTER
+    _bcfReadTypeDescriptor(type, count, it, itEnd);
+    _bcfCheckRemaining(it, itEnd, (__int64)count * _bcfTypeSize(type));
+    for (__int32 i = 0; i < count; ++i)
+    {
+        __int32 idx = _bcfReadInt(it, itEnd, type);
+        if (idx == BCF_INT32_VECTOR_END)
+        {
+            it += (count - i - 1) * _bcfTypeSize(type);
+            break;
+        }
+        if (i != 0)
+            appendValue(record.filter, ';');
+        append(record.filter, _bcfKey(dict, idx));
+    }
+    if (empty(record.filter))
+        record.filter = ".";
+
+    // INFO
+    for (unsigned i = 0; i < nInfo; ++i)
+    {
+        __int32 idx = _bcfReadTypedInt(it, itEnd);
+        _bcfReadTypeDescriptor(type, count, it, itEnd);
+        if (i != 0)
+            appendValue(record.info, ';');
+        append(record.info, _bcfKey(dict, idx));
+        if (type != BCF_TYPE_NULL && count != 0)
+        {
+            appendValue(record.info, '=');
+            _bcfAppendValues(record.info, it, itEnd, type, count);
+        }
+    }
+    if (nInfo == 0)
+        record.info = ".";
+
+    it = itSharedEnd;
+    itEnd = itIndivEnd;
+
+    // The samples, stored field by field.
+    if (nSample == 0)
+        return;
+
+    _bcfSplitFormat(record.format, record._bcfFieldBegins, it, itEnd, nFmt, nSample, dict);
+
+    // Keep the typed values, they are decoded or formatted on demand.
+    if (context.lazyGenotypes)
+    {
+        record._bcfGenotypeData = infix(buffer, it - begin(buffer, Standard()), length(buffer));
+        record._bcfNumSamples = nSample;
+        return;
+    }
+
+    int genotypeIdx = _vcfFormatFieldIdx(record.format, "GT");
+    resize(record.genotypeInfos, nSample);
+    for (unsigned s = 0; s < nSample; ++s)
+        _bcfAppendGenotypeInfo(record.genotypeInfos[s], it, itEnd, record._bcfFieldBegins, genotypeIdx, s);
+    clear(record._bcfFieldBegins);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_VCF_READ_BCF_H_
@@ -229,6 +229,14 @@ readRecord(VcfRecord & record,
         SEQAN_THROW(EmptyFieldError("FORMAT"));
     skipOne(iter);
 
+    // The sample columns are only delimited, they are split into fields on demand.
+    if (context.lazyGenotypes)
+    {
+        readLine(record._genotypeData, iter);
+        _vcfSplitGenotypes(record, length(sampleNames(context)));
+        return;
+    }
+
     // The samples.
     unsigned numSamples = length(sampleNames(context));
     for (unsigned i = 0; i < numSamples; ++i)
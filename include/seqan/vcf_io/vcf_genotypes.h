@@ -0,0 +1,534 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Access to the genotype information of VcfRecord, for records read with
+// split or with lazy genotypes, and for the typed values of BCF records.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_GENOTYPES_H_
+#define SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_GENOTYPES_H_
+
+namespace seqan {
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _vcfHasLazyGenotypes()
+// ----------------------------------------------------------------------------
+
+inline bool
+_vcfHasLazyGenotypes(VcfRecord const & record)
+{
+    return empty(record.genotypeInfos) && !empty(record._genotypeData);
+}
+
+// ----------------------------------------------------------------------------
+// Function _vcfHasBcfGenotypes()
+// ----------------------------------------------------------------------------
+
+// BCF records read with lazy genotypes keep the typed values of their samples.
+inline bool
+_vcfHasBcfGenotypes(VcfRecord const & record)
+{
+    return empty(record.genotypeInfos) && record._bcfNumSamples != 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _vcfSplitGenotypes()
+// ----------------------------------------------------------------------------
+
+// Compute the end positions of the sample columns of a lazily read record.  This is done when reading the record, so
+// that the const accessors below do not modify it.  Like the eager reader, this requires a non-empty column for each
+// of the numSamples samples of the header and cuts off additional columns.
+inline void
+_vcfSplitGenotypes(VcfRecord & record, unsigned numSamples)
+{
+    typedef Iterator<CharString const, Standard>::Type TIter;
+
+    clear(record._genotypeEnds);
+    if (numSamples == 0)
+    {
+        clear(record._genotypeData);
+        return;
+    }
+
+    TIter itBegin = begin(record._genotypeData, Standard());
+    TIter itEnd = end(record._genotypeData, Standard());
+    TIter itColumn = itBegin;
+    for (TIter it = itBegin; ; ++it)
+    {
+        if (it != itEnd && *it != '\t')
+            continue;
+
+        if (it == itColumn)
+        {
+            char buffer[30];    // == 9 (GENOTYPE_) + 20 (#digits in MIN_INT64) + 1 (trailing zero)
+            sprintf(buffer, "GENOTYPE_%u", (unsigned)length(record._genotypeEnds) + 1);
+            SEQAN_THROW(EmptyFieldError(buffer));
+        }
+        appendValue(record._genotypeEnds, it - itBegin);
+
+        if (length(record._genotypeEnds) == numSamples)
+            break;
+        if (it == itEnd)
+            SEQAN_THROW(ParseError("Unexpected end of line, the VCF record has fewer sample columns than the header."));
+        itColumn = it + 1;
+    }
+    resize(record._genotypeData, back(record._genotypeEnds));
+}
+
+// ----------------------------------------------------------------------------
+// Function numGenotypeInfos()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecord#numGenotypeInfos
+ * @brief Return the number of sample columns of a VcfRecord.
+ *
+ * @signature unsigned numGenotypeInfos(record);
+ *
+ * @param[in] record The VcfRecord to query.
+ *
+ * @return unsigned The number of sample columns, also for records read with lazy genotypes.
+ */
+
+inline unsigned
+numGenotypeInfos(VcfRecord const & record)
+{
+    if (_vcfHasBcfGenotypes(record))
+        return record._bcfNumSamples;
+    if (!_vcfHasLazyGenotypes(record))
+        return length(record.genotypeInfos);
+
+    return length(record._genotypeEnds);
+}
+
+// ----------------------------------------------------------------------------
+// Function _vcfGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+// Return the string holding the column of a sample and its begin and end position therein.
+inline CharString const &
+_vcfGenotypeInfo(size_t & beginPos, size_t & endPos, VcfRecord const & record, unsigned sampleIdx)
+{
+    SEQAN_ASSERT_NOT_MSG(_vcfHasBcfGenotypes(record), "BCF sample columns have to be formatted.");
+
+    if (!_vcfHasLazyGenotypes(record))
+    {
+        beginPos = 0;
+        endPos = length(record.genotypeInfos[sampleIdx]);
+        return record.genotypeInfos[sampleIdx];
+    }
+
+    beginPos = (sampleIdx == 0) ? 0 : record._genotypeEnds[sampleIdx - 1] + 1;
+    endPos = record._genotypeEnds[sampleIdx];
+    return record._genotypeData;
+}
+
+// ----------------------------------------------------------------------------
+// Function getGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecord#getGenotypeInfo
+ * @brief Return the genotype information of a sample.
+ *
+ * @signature TInfix getGenotypeInfo(record, sampleIdx);
+ *
+ * @param[in] record    The VcfRecord to query.
+ * @param[in] sampleIdx The index of the sample, smaller than @link VcfRecord#numGenotypeInfos @endlink.
+ *
+ * @return TInfix The sample column, e.g. <tt>"0|1:48:8"</tt>, as an infix of a @link CharString @endlink.
+ *
+ * BCF records read with lazy genotypes hold no text, use @link VcfRecord#appendGenotypeInfo @endlink for them.
+ */
+
+inline Infix<CharString const>::Type
+getGenotypeInfo(VcfRecord const & record, unsigned sampleIdx)
+{
+    size_t beginPos;
+    size_t endPos;
+    CharString const & host = _vcfGenotypeInfo(beginPos, endPos, record, sampleIdx);
+    return infix(host, beginPos, endPos);
+}
+
+// ----------------------------------------------------------------------------
+// Function _vcfFormatFieldIdx()
+// ----------------------------------------------------------------------------
+
+// Return the index of key in the colon-separated FORMAT field or -1 if it is missing.
+template <typename TKey>
+inline int
+_vcfFormatFieldIdx(CharString const & format, TKey const & key)
+{
+    size_t fieldBegin = 0;
+    int fieldIdx = 0;
+    for (size_t i = 0; i <= length(format); ++i)
+    {
+        if (i != length(format) && format[i] != ':')
+            continue;
+        if (infix(format, fieldBegin, i) == key)
+            return fieldIdx;
+        fieldBegin = i + 1;
+        ++fieldIdx;
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfFormatField()
+// ----------------------------------------------------------------------------
+
+// Return the begin of the values of the fieldIdx-th FORMAT field in the individual part [data, dataEnd) of a BCF
+// record, and the type and number of values per sample.
+inline char const *
+_bcfFormatField(unsigned & type, __int32 & count, char const * data, char const * dataEnd,
+                String<__uint32> const & fieldBegins, unsigned fieldIdx)
+{
+    char const * it = data + fieldBegins[fieldIdx];
+    _bcfReadTypeDescriptor(type, count, it, dataEnd);
+    return it;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfAppendGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+// Append the column of a sample in VCF notation.  Absent fields are written as '.' if a present field follows and
+// are omitted otherwise, a column without present fields is '.'.
+template <typename TTarget>
+inline void
+_bcfAppendGenotypeInfo(TTarget & target, char const * data, char const * dataEnd,
+                       String<__uint32> const & fieldBegins, int genotypeIdx, unsigned sampleIdx)
+{
+    unsigned type;
+    __int32 count;
+    size_t infoBegin = length(target);
+    size_t infoEnd = infoBegin;
+
+    for (unsigned j = 0; j < length(fieldBegins); ++j)
+    {
+        char const * it = _bcfFormatField(type, count, data, dataEnd, fieldBegins, j);
+        it += (size_t)sampleIdx * count * _bcfTypeSize(type);
+
+        if (j != 0)
+            appendValue(target, ':');
+        bool present = ((int)j == genotypeIdx) ? _bcfAppendGenotype(target, it, dataEnd, type, count) :
+                                                 _bcfAppendValues(target, it, dataEnd, type, count);
+        if (present)
+            infoEnd = length(target);
+        else
+            appendValue(target, '.');
+    }
+
+    resize(target, infoEnd);
+    if (infoEnd == infoBegin)
+        appendValue(target, '.');
+}
+
+// ----------------------------------------------------------------------------
+// Function appendGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecord#appendGenotypeInfo
+ * @brief Append the genotype information of a sample to a string.
+ *
+ * @signature void appendGenotypeInfo(target, record, sampleIdx);
+ *
+ * @param[in,out] target    The @link String @endlink to append to.
+ * @param[in]     record    The VcfRecord to query.
+ * @param[in]     sampleIdx The index of the sample, smaller than @link VcfRecord#numGenotypeInfos @endlink.
+ *
+ * Works for all records.  The columns of BCF records read with lazy genotypes are formatted from their typed values.
+ */
+
+template <typename TTarget>
+inline void
+appendGenotypeInfo(TTarget & target, VcfRecord const & record, unsigned sampleIdx)
+{
+    if (!_vcfHasBcfGenotypes(record))
+    {
+        append(target, getGenotypeInfo(record, sampleIdx));
+        return;
+    }
+
+    _bcfAppendGenotypeInfo(target, begin(record._bcfGenotypeData, Standard()), end(record._bcfGenotypeData, Standard()),
+                           record._bcfFieldBegins, _vcfFormatFieldIdx(record.format, "GT"), sampleIdx);
+}
+
+// ----------------------------------------------------------------------------
+// Function _vcfFormatField()
+// ----------------------------------------------------------------------------
+
+// Narrow [beginPos, endPos) from a sample column to its fieldIdx-th field, which is empty if absent.
+inline void
+_vcfFormatField(size_t & beginPos, size_t & endPos, CharString const & host, int fieldIdx)
+{
+    for (; fieldIdx > 0 && beginPos != endPos; ++beginPos)
+        if (host[beginPos] == ':')
+            --fieldIdx;
+
+    size_t fieldEnd = beginPos;
+    while (fieldEnd != endPos && host[fieldEnd] != ':')
+        ++fieldEnd;
+    endPos = fieldEnd;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfGetGenotypes()
+// ----------------------------------------------------------------------------
+
+// Decode the typed GT values of a BCF record, the codes are stored like in BCF.  The vectors are decoded with their
+// stored length first and then compacted to the ploidy.
+template <typename TSpec>
+inline unsigned
+_bcfGetGenotypes(String<__int32, TSpec> & codes, VcfRecord const & record, int fieldIdx)
+{
+    char const * data = begin(record._bcfGenotypeData, Standard());
+    char const * dataEnd = end(record._bcfGenotypeData, Standard());
+    unsigned type;
+    __int32 count;
+    char const * it = _bcfFormatField(type, count, data, dataEnd, record._bcfFieldBegins, fieldIdx);
+    unsigned size = _bcfTypeSize(type);
+    unsigned numSamples = record._bcfNumSamples;
+
+    unsigned ploidy = 0;
+    resize(codes, (size_t)numSamples * count, -1);
+    for (unsigned s = 0; s < numSamples; ++s)
+    {
+        for (__int32 i = 0; i < count; ++i)
+        {
+            __int32 value = _bcfReadInt(it, dataEnd, type);
+            if (value == BCF_INT32_VECTOR_END)
+            {
+                it += (count - i - 1) * size;
+                break;
+            }
+
+            // A missing value is a missing allele, the first allele has no phase.
+            if (value == BCF_INT32_MISSING)
+                value = 0;
+            if (i == 0)
+                value &= ~1;
+            codes[(size_t)s * count + i] = value;
+            ploidy = std::max(ploidy, (unsigned)i + 1);
+        }
+    }
+
+    for (unsigned s = 0; s < numSamples && ploidy != (unsigned)count; ++s)
+        for (unsigned i = 0; i < ploidy; ++i)
+            codes[(size_t)s * ploidy + i] = codes[(size_t)s * count + i];
+    resize(codes, (size_t)numSamples * ploidy);
+    return ploidy;
+}
+
+// ----------------------------------------------------------------------------
+// Function getGenotypes()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecord#getGenotypes
+ * @brief Decode the GT field of all samples into allele codes.
+ *
+ * @signature unsigned getGenotypes(codes, record);
+ *
+ * @param[out] codes  A @link String @endlink of <tt>__int32</tt> with <tt>ploidy</tt> codes per sample.  An allele
+ *                    <tt>a</tt> is stored as <tt>(a + 1) &lt;&lt; 1 | phased</tt>, as in BCF, where <tt>phased</tt>
+ *                    is 1 if the allele is preceded by <tt>'|'</tt>.  A missing allele <tt>'.'</tt> keeps its phase
+ *                    bit, i.e. it is 0 or 1, e.g. <tt>".|."</tt> is decoded as 0, 1.  Samples with fewer alleles
+ *                    are padded with -1.
+ * @param[in]  record The VcfRecord to decode.
+ *
+ * @return unsigned The ploidy, i.e. the maximal number of alleles of a sample, 0 if there is no GT field.
+ *
+ * The whole column is decoded in one call, without splitting lazily read records into their fields.  The typed
+ * values of BCF records read with lazy genotypes are decoded directly.
+ */
+
+template <typename TSpec>
+inline unsigned
+getGenotypes(String<__int32, TSpec> & codes, VcfRecord const & record)
+{
+    clear(codes);
+    int fieldIdx = _vcfFormatFieldIdx(record.format, "GT");
+    if (fieldIdx < 0)
+        return 0;
+    if (_vcfHasBcfGenotypes(record))
+        return _bcfGetGenotypes(codes, record, fieldIdx);
+
+    unsigned numSamples = numGenotypeInfos(record);
+    size_t beginPos;
+    size_t endPos;
+
+    // Determine the ploidy.
+    unsigned ploidy = 0;
+    for (unsigned s = 0; s < numSamples; ++s)
+    {
+        CharString const & host = _vcfGenotypeInfo(beginPos, endPos, record, s);
+        _vcfFormatField(beginPos, endPos, host, fieldIdx);
+        if (beginPos == endPos)
+            continue;
+
+        unsigned numAlleles = 1;
+        for (size_t i = beginPos; i != endPos; ++i)
+            if (host[i] == '/' || host[i] == '|')
+                ++numAlleles;
+        ploidy = std::max(ploidy, numAlleles);
+    }
+
+    resize(codes, numSamples * ploidy, -1);
+    for (unsigned s = 0; s < numSamples; ++s)
+    {
+        CharString const & host = _vcfGenotypeInfo(beginPos, endPos, record, s);
+        _vcfFormatField(beginPos, endPos, host, fieldIdx);
+        if (beginPos == endPos)
+            continue;
+
+        __int32 phased = 0;
+        size_t alleleBegin = beginPos;
+        unsigned k = s * ploidy;
+        for (size_t i = beginPos; i <= endPos; ++i)
+        {
+            if (i != endPos && host[i] != '/' && host[i] != '|')
+                continue;
+
+            __int32 allele = -1;
+            if (infix(host, alleleBegin, i) != ".")
+                allele = lexicalCast<__int32>(infix(host, alleleBegin, i));
+            codes[k++] = (allele + 1) << 1 | phased;
+
+            if (i != endPos)
+                phased = (host[i] == '|');
+            alleleBegin = i + 1;
+        }
+    }
+    return ploidy;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfGetFormatInts()
+// ----------------------------------------------------------------------------
+
+// Decode the first typed value of each sample of a BCF record.  Integers are converted directly, other values are
+// converted from their text like in VCF records.
+template <typename TInteger, typename TSpec>
+inline void
+_bcfGetFormatInts(String<TInteger, TSpec> & values, VcfRecord const & record, int fieldIdx)
+{
+    char const * data = begin(record._bcfGenotypeData, Standard());
+    char const * dataEnd = end(record._bcfGenotypeData, Standard());
+    unsigned type;
+    __int32 count;
+    char const * it = _bcfFormatField(type, count, data, dataEnd, record._bcfFieldBegins, fieldIdx);
+    unsigned size = _bcfTypeSize(type);
+    if (count == 0)
+        return;
+
+    CharString buffer;
+    for (unsigned s = 0; s < length(values); ++s, it += count * size)
+    {
+        char const * itValue = it;
+        if (type == BCF_TYPE_INT8 || type == BCF_TYPE_INT16 || type == BCF_TYPE_INT32)
+        {
+            __int32 value = _bcfReadInt(itValue, dataEnd, type);
+            if (value != BCF_INT32_MISSING && value != BCF_INT32_VECTOR_END)
+                values[s] = value;
+            continue;
+        }
+
+        clear(buffer);
+        _bcfAppendValues(buffer, itValue, dataEnd, type, count);
+        cropAfterFirst(buffer, EqualsChar<','>());
+        if (!empty(buffer) && buffer != ".")
+            values[s] = lexicalCast<TInteger>(buffer);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function getFormatInts()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecord#getFormatInts
+ * @brief Decode an integer FORMAT field of all samples, e.g. DP or GQ.
+ *
+ * @signature bool getFormatInts(values, record, key);
+ *
+ * @param[out] values A @link String @endlink of integers with one value per sample.  Only the first value of each
+ *                    sample is decoded.  Missing and absent values are <tt>MinValue&lt;TInteger&gt;::VALUE</tt>.
+ * @param[in]  record The VcfRecord to decode.
+ * @param[in]  key    The key of the FORMAT field, e.g. <tt>"DP"</tt>.
+ *
+ * @return bool <tt>false</tt> if the FORMAT field of the record does not contain <tt>key</tt>.
+ *
+ * The whole column is decoded in one call, without splitting lazily read records into their fields.  The typed
+ * values of BCF records read with lazy genotypes are decoded directly.
+ */
+
+template <typename TInteger, typename TSpec, typename TKey>
+inline bool
+getFormatInts(String<TInteger, TSpec> & values, VcfRecord const & record, TKey const & key)
+{
+    clear(values);
+    int fieldIdx = _vcfFormatFieldIdx(record.format, key);
+    if (fieldIdx < 0)
+        return false;
+
+    unsigned numSamples = numGenotypeInfos(record);
+    resize(values, numSamples, MinValue<TInteger>::VALUE);
+    if (_vcfHasBcfGenotypes(record))
+    {
+        _bcfGetFormatInts(values, record, fieldIdx);
+        return true;
+    }
+
+    size_t beginPos;
+    size_t endPos;
+    for (unsigned s = 0; s < numSamples; ++s)
+    {
+        CharString const & host = _vcfGenotypeInfo(beginPos, endPos, record, s);
+        _vcfFormatField(beginPos, endPos, host, fieldIdx);
+
+        size_t valueEnd = beginPos;
+        while (valueEnd != endPos && host[valueEnd] != ',')
+            ++valueEnd;
+        if (valueEnd != beginPos && infix(host, beginPos, valueEnd) != ".")
+            values[s] = lexicalCast<TInteger>(infix(host, beginPos, valueEnd));
+    }
+    return true;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_GENOTYPES_H_
@@ -41,6 +41,43 @@ namespace seqan {
 // Classes
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Class BcfDictionary_
+// ----------------------------------------------------------------------------
+
+// Value types of BCF2 typed values.  BCF_TYPE_UNKNOWN marks keys that are not
+// declared for INFO or FORMAT in the header.
+enum BcfType_
+{
+    BCF_TYPE_UNKNOWN = -1,
+    BCF_TYPE_NULL    = 0,
+    BCF_TYPE_INT8    = 1,
+    BCF_TYPE_INT16   = 2,
+    BCF_TYPE_INT32   = 3,
+    BCF_TYPE_FLOAT   = 5,
+    BCF_TYPE_CHAR    = 7
+};
+
+// The BCF2 string dictionary maps the IDs of the FILTER, INFO, and FORMAT
+// header lines to the integer keys used in BCF records ("PASS" is always 0).
+// The declared value types are needed to encode textual INFO and FORMAT fields.
+struct BcfDictionary_
+{
+    StringSet<CharString>           keys;
+    std::map<CharString, __int32>   ids;
+    String<__int8>                  infoTypes;
+    String<__int8>                  formatTypes;
+};
+
+inline void
+clear(BcfDictionary_ & dict)
+{
+    clear(dict.keys);
+    dict.ids.clear();
+    clear(dict.infoTypes);
+    clear(dict.formatTypes);
+}
+
 // ----------------------------------------------------------------------------
 // Class VcfIOContext
 // ----------------------------------------------------------------------------
@@ -67,6 +104,19 @@ namespace seqan {
  * Default constructor or construction with references to contig and sample names.
  */
 
+/*!
+ * @var bool VcfIOContext::lazyGenotypes
+ * @brief Keep the sample columns of VCF and BCF records unsplit, defaults to <tt>false</tt>.
+ *
+ * If set, @link VcfRecord::genotypeInfos @endlink stays empty when reading records.  The sample columns of VCF records
+ * are kept in one buffer whose column boundaries are found while reading.  @link VcfRecord#getGenotypeInfo @endlink
+ * returns a column as an infix of this buffer and does not modify the record.  BCF records keep the typed values of
+ * their samples, @link VcfRecord#appendGenotypeInfo @endlink formats a column of both kinds of records.  Whole FORMAT
+ * columns can be decoded with @link VcfRecord#getGenotypes @endlink and @link VcfRecord#getFormatInts @endlink, for
+ * BCF records without formatting text.  This saves an allocation per sample and record if only some or none of the
+ * genotype information is needed.
+ */
+
 template <typename TNameStore_        = StringSet<CharString>,
           typename TNameStoreCache_   = NameStoreCache<TNameStore_>,
           typename TStorageSpec       = Owner<> >
@@ -89,6 +139,14 @@ public:
 
     CharString              buffer;
 
+    // Keep the sample columns unsplit when reading records.
+    bool                    lazyGenotypes;
+
+    // BCF key dictionary and scratch buffers for encoding BCF records.
+    BcfDictionary_          _bcfDictionary;
+    CharString              _bcfBuffer;
+    String<__int32>         _bcfValues;
+
     VcfIOContext() :
         _contigNames(TNameStoreMember()),
         _contigNamesCache(ifSwitch(typename IsPointer<TNameStoreCacheMember>::Type(),
@@ -97,7 +155,8 @@ public:
         _sampleNames(TNameStoreMember()),
         _sampleNamesCache(ifSwitch(typename IsPointer<TNameStoreCacheMember>::Type(),
                                  (TNameStoreCache*)NULL,
-                                 _sampleNames))
+                                 _sampleNames)),
+        lazyGenotypes(false)
     {}
 
     VcfIOContext(TNameStore & nameStore_, TNameStoreCache & nameStoreCache_) :
@@ -108,7 +167,8 @@ public:
         _sampleNames(TNameStoreMember()),
         _sampleNamesCache(ifSwitch(typename IsPointer<TNameStoreCacheMember>::Type(),
                                  (TNameStoreCache*)NULL,
-                                 _sampleNames))
+                                 _sampleNames)),
+        lazyGenotypes(false)
     {}
 
     template <typename TOtherStorageSpec>
@@ -120,7 +180,8 @@ public:
         _sampleNames(_referenceCast<typename Parameter_<TNameStoreMember>::Type>(sampleNames(other))),
         _sampleNamesCache(ifSwitch(typename IsPointer<TNameStoreCacheMember>::Type(),
                                  &sampleNamesCache(other),
-                                 _sampleNames))
+                                 _sampleNames)),
+        lazyGenotypes(other.lazyGenotypes)
     {}
 };
 
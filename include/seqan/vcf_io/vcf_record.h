@@ -93,6 +93,10 @@ namespace seqan {
  * @var VariableType VcfRecord::genotypeInfos
  * @brief Genotype information, as in VCF file (@link StringSet @endlink<@link CharString @endlink>).
  *
+ * Empty if the record was read with lazy genotypes, see @link VcfIOContext::lazyGenotypes @endlink.  Use
+ * @link VcfRecord#numGenotypeInfos @endlink and @link VcfRecord#appendGenotypeInfo @endlink to access the genotype
+ * information of all kinds of records.
+ *
  * @var VariableType VcfRecord::info
  * @brief Value of the INFO field, empty if "." in VCF file (@link CharString @endlink).
  *
@@ -153,8 +157,20 @@ public:
     // The genotype infos.
     StringSet<CharString> genotypeInfos;
 
+    // The tab-separated sample columns if genotypes are read lazily, and
+    // the end positions of the columns.
+    CharString _genotypeData;
+    String<__uint32> _genotypeEnds;
+
+    // The individual part of BCF records, i.e. the typed values of the
+    // samples stored field by field, the positions of the type descriptors of
+    // the fields therein, and the number of samples.
+    CharString _bcfGenotypeData;
+    String<__uint32> _bcfFieldBegins;
+    __uint32 _bcfNumSamples;
+
     // Default constructor.
-    VcfRecord() : rID(INVALID_REFID), beginPos(INVALID_POS), qual(MISSING_QUAL())
+    VcfRecord() : rID(INVALID_REFID), beginPos(INVALID_POS), qual(MISSING_QUAL()), _bcfNumSamples(0)
     {}
 
     // Actually this is IEEE NaN.
@@ -195,6 +211,11 @@ inline void clear(VcfRecord & record)
     clear(record.info);
     clear(record.format);
     clear(record.genotypeInfos);
+    clear(record._genotypeData);
+    clear(record._genotypeEnds);
+    clear(record._bcfGenotypeData);
+    clear(record._bcfFieldBegins);
+    record._bcfNumSamples = 0;
 }
 
 }  // namespace seqan
@@ -0,0 +1,611 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Writing of BCF2 files.  The textual INFO and FORMAT fields of VcfRecord are
+// encoded as typed values according to the types declared in the header.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_VCF_WRITE_BCF_H_
+#define SEQAN_INCLUDE_SEQAN_VCF_WRITE_BCF_H_
+
+namespace seqan {
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteTypeDescriptor()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget>
+inline void _bcfWriteTypedInt(TTarget & target, __int32 value);
+
+template <typename TTarget>
+inline void
+_bcfWriteTypeDescriptor(TTarget & target, unsigned type, size_t count)
+{
+    if (count < 15u)
+    {
+        writeValue(target, (char)(count << 4 | type));
+    }
+    else
+    {
+        writeValue(target, (char)(15 << 4 | type));
+        _bcfWriteTypedInt(target, (__int32)count);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfIntType()
+// ----------------------------------------------------------------------------
+
+// Return the smallest integer type that can hold all values, the lowest 8
+// values of each type are reserved.
+inline unsigned
+_bcfIntType(__int32 minValue, __int32 maxValue)
+{
+    if (minValue >= -120 && maxValue <= 127)
+        return BCF_TYPE_INT8;
+    if (minValue >= -32760 && maxValue <= 32767)
+        return BCF_TYPE_INT16;
+    return BCF_TYPE_INT32;
+}
+
+template <typename TValues>
+inline unsigned
+_bcfIntType(TValues const & values)
+{
+    __int32 minValue = 0;
+    __int32 maxValue = 0;
+    for (unsigned i = 0; i < length(values); ++i)
+    {
+        if (values[i] == BCF_INT32_MISSING || values[i] == BCF_INT32_VECTOR_END)
+            continue;
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+    return _bcfIntType(minValue, maxValue);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteInt()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget>
+inline void
+_bcfWriteInt(TTarget & target, unsigned type, __int32 value)
+{
+    if (type == BCF_TYPE_INT8)
+    {
+        if (value == BCF_INT32_MISSING)
+            value = -128;
+        else if (value == BCF_INT32_VECTOR_END)
+            value = -127;
+        appendRawPod(target, (__int8)value);
+    }
+    else if (type == BCF_TYPE_INT16)
+    {
+        if (value == BCF_INT32_MISSING)
+            value = -32768;
+        else if (value == BCF_INT32_VECTOR_END)
+            value = -32767;
+        appendRawPod(target, (__int16)value);
+    }
+    else
+    {
+        appendRawPod(target, value);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteTypedInt()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget>
+inline void
+_bcfWriteTypedInt(TTarget & target, __int32 value)
+{
+    unsigned type = _bcfIntType(value, value);
+    _bcfWriteTypeDescriptor(target, type, 1);
+    _bcfWriteInt(target, type, value);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteTypedInts()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TValues>
+inline void
+_bcfWriteTypedInts(TTarget & target, TValues const & values)
+{
+    if (empty(values))
+    {
+        writeValue(target, (char)BCF_TYPE_NULL);
+        return;
+    }
+    unsigned type = _bcfIntType(values);
+    _bcfWriteTypeDescriptor(target, type, length(values));
+    for (unsigned i = 0; i < length(values); ++i)
+        _bcfWriteInt(target, type, values[i]);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteTypedString()
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TString>
+inline void
+_bcfWriteTypedString(TTarget & target, TString const & str)
+{
+    _bcfWriteTypeDescriptor(target, BCF_TYPE_CHAR, length(str));
+    write(target, str);
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfKeyId()
+// ----------------------------------------------------------------------------
+
+inline __int32
+_bcfKeyId(BcfDictionary_ const & dict, CharString const & key)
+{
+    std::map<CharString, __int32>::const_iterator it = dict.ids.find(key);
+    if (it == dict.ids.end())
+        SEQAN_THROW(ParseError(std::string("Key not declared in VCF header: ") + toCString(key)));
+    return it->second;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfAppendNumbers()
+// ----------------------------------------------------------------------------
+
+// Append the comma-separated numbers of str to values, floats are stored as
+// their bit patterns.  Returns the number of appended values.
+template <typename TValues, typename TString>
+inline unsigned
+_bcfAppendNumbers(TValues & values, TString const & str, unsigned type, CharString & buffer)
+{
+    unsigned count = 0;
+    size_t tokenBegin = 0;
+    for (size_t i = 0; i <= length(str); ++i)
+    {
+        if (i != length(str) && str[i] != ',')
+            continue;
+
+        buffer = infix(str, tokenBegin, i);
+        tokenBegin = i + 1;
+        ++count;
+
+        if (buffer == "." || empty(buffer))
+        {
+            appendValue(values, (type == BCF_TYPE_FLOAT) ? (__int32)BCF_FLOAT_MISSING : BCF_INT32_MISSING);
+        }
+        else if (type == BCF_TYPE_FLOAT)
+        {
+            float value = lexicalCast<float>(buffer);
+            __int32 bits;
+            std::memcpy(&bits, &value, sizeof(float));
+            appendValue(values, bits);
+        }
+        else
+        {
+            appendValue(values, lexicalCast<__int32>(buffer));
+        }
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfAppendGenotype()
+// ----------------------------------------------------------------------------
+
+// Append the alleles of a genotype like 0/1 or 1|. as (allele + 1) << 1 | phased.
+template <typename TValues, typename TString>
+inline unsigned
+_bcfAppendGenotype(TValues & values, TString const & str)
+{
+    unsigned count = 0;
+    __int32 phased = 0;
+    size_t tokenBegin = 0;
+    for (size_t i = 0; i <= length(str); ++i)
+    {
+        if (i != length(str) && str[i] != '/' && str[i] != '|')
+            continue;
+
+        __int32 allele = -1;
+        if (infix(str, tokenBegin, i) != ".")
+            allele = lexicalCast<__int32>(infix(str, tokenBegin, i));
+        appendValue(values, (allele + 1) << 1 | phased);
+        ++count;
+
+        if (i != length(str))
+            phased = (str[i] == '|');
+        tokenBegin = i + 1;
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _bcfWriteGenotypeData()
+// ----------------------------------------------------------------------------
+
+// Write the typed values of a BCF record read with lazy genotypes without converting them.  Only the keys are
+// renumbered for the dictionary of the output, and the samples are truncated or padded to nSample.
+template <typename TTarget>
+inline unsigned
+_bcfWriteGenotypeData(TTarget & target, VcfRecord const & record, BcfDictionary_ const & dict, unsigned nSample)
+{
+    char const * data = begin(record._bcfGenotypeData, Standard());
+    char const * dataEnd = end(record._bcfGenotypeData, Standard());
+    unsigned nCopy = std::min((unsigned)record._bcfNumSamples, nSample);
+    unsigned type;
+    __int32 count;
+    CharString key;
+
+    size_t tokenBegin = 0;
+    for (unsigned j = 0; j < length(record._bcfFieldBegins); ++j)
+    {
+        size_t tokenEnd = tokenBegin;
+        while (tokenEnd != length(record.format) && record.format[tokenEnd] != ':')
+            ++tokenEnd;
+        key = infix(record.format, tokenBegin, tokenEnd);
+        tokenBegin = tokenEnd + 1;
+
+        __int32 idx = _bcfKeyId(dict, key);
+        if (dict.formatTypes[idx] == BCF_TYPE_UNKNOWN)
+            SEQAN_THROW(ParseError(std::string("FORMAT key not declared in VCF header: ") + toCString(key)));
+        _bcfWriteTypedInt(target, idx);
+
+        // The type descriptor and the values of the copied samples.
+        char const * fieldBegin = data + record._bcfFieldBegins[j];
+        char const * it = _bcfFormatField(type, count, data, dataEnd, record._bcfFieldBegins, j);
+        write(target, fieldBegin, (it - fieldBegin) + (size_t)nCopy * count * _bcfTypeSize(type));
+
+        for (size_t k = (size_t)(nSample - nCopy) * count; k != 0; --k)
+        {
+            if (type == BCF_TYPE_CHAR)
+                writeValue(target, '\0');
+            else if (type == BCF_TYPE_FLOAT)
+                _bcfWriteInt(target, BCF_TYPE_INT32, (__int32)BCF_FLOAT_VECTOR_END);
+            else
+                _bcfWriteInt(target, type, BCF_INT32_VECTOR_END);
+        }
+    }
+    return length(record._bcfFieldBegins);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeHeader()                                           [VcfHeader]
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+writeHeader(TTarget & target,
+            VcfHeader const & header,
+            VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+            Bcf const & /*tag*/)
+{
+    // BCF records refer to FILTER keys and contigs by their index in the text
+    // header, so make sure that PASS and all contigs are declared there.
+    VcfHeader textHeader;
+    CharString id;
+    bool hasPass = false;
+    unsigned numContigs = 0;
+    for (unsigned i = 0; i < length(header); ++i)
+    {
+        if (header[i].key == "FILTER" && _bcfHeaderField(id, header[i].value, "ID") && id == "PASS")
+            hasPass = true;
+        else if (header[i].key == "contig")
+            ++numContigs;
+    }
+
+    unsigned i = 0;
+    if (!empty(header) && header[0].key == "fileformat")
+        appendValue(textHeader, header[i++]);
+    if (!hasPass)
+        appendValue(textHeader, VcfHeaderRecord("FILTER", "<ID=PASS,Description=\"All filters passed\">"));
+    for (; i < length(header); ++i)
+        appendValue(textHeader, header[i]);
+    for (i = numContigs; i < length(contigNames(context)); ++i)
+    {
+        id = "<ID=";
+        append(id, contigNames(context)[i]);
+        appendValue(id, '>');
+        appendValue(textHeader, VcfHeaderRecord("contig", id));
+    }
+
+    CharString & text = context.buffer;
+    clear(text);
+    writeHeader(text, textHeader, context, Vcf());
+    appendValue(text, '\0');
+
+    write(target, "BCF\2\2");
+    appendRawPod(target, (__uint32)length(text));
+    write(target, text);
+
+    _bcfBuildDictionary(context._bcfDictionary, textHeader);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecord()                                           [VcfRecord]
+// ----------------------------------------------------------------------------
+
+template <typename TTarget, typename TNameStore, typename TNameStoreCache, typename TStorageSpec>
+inline void
+writeRecord(TTarget & target,
+            VcfRecord const & record,
+            VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+            Bcf const & /*tag*/)
+{
+    typedef Infix<CharString const>::Type TInfix;
+
+    BcfDictionary_ const & dict = context._bcfDictionary;
+    CharString & shared = context.buffer;
+    CharString & indiv = context._bcfBuffer;
+    String<__int32> & values = context._bcfValues;
+    CharString key;
+    CharString buffer;
+
+    clear(shared);
+    clear(indiv);
+
+    // CHROM, POS, rlen, and QUAL, the counts are filled in below.
+    __int32 rlen = length(record.ref);
+    __uint32 nAllele = 1;
+    __uint32 nInfo = 0;
+    __uint32 nFmt = 0;
+    __uint32 nSample = length(sampleNames(context));
+
+    appendRawPod(shared, (__int32)record.rID);
+    appendRawPod(shared, (__int32)record.beginPos);
+    appendRawPod(shared, rlen);
+    if (record.qual != record.qual)  // only way to test for nan
+        appendRawPod(shared, BCF_FLOAT_MISSING);
+    else
+        appendRawPod(shared, record.qual);
+    appendRawPod(shared, (__uint32)0);
+    appendRawPod(shared, (__uint32)0);
+
+    // ID
+    if (record.id == ".")
+        _bcfWriteTypedString(shared, "");
+    else
+        _bcfWriteTypedString(shared, record.id);
+
+    // REF and ALT
+    _bcfWriteTypedString(shared, record.ref);
+    if (!empty(record.alt) && record.alt != ".")
+    {
+        size_t tokenBegin = 0;
+        for (size_t i = 0; i <= length(record.alt); ++i)
+        {
+            if (i != length(record.alt) && record.alt[i] != ',')
+                continue;
+            _bcfWriteTypedString(shared, infix(record.alt, tokenBegin, i));
+            tokenBegin = i + 1;
+            ++nAllele;
+        }
+    }
+
+    // FILTER
+    clear(values);
+    if (!empty(record.filter) && record.filter != ".")
+    {
+        size_t tokenBegin = 0;
+        for (size_t i = 0; i <= length(record.filter); ++i)
+        {
+            if (i != length(record.filter) && record.filter[i] != ';')
+                continue;
+            key = infix(record.filter, tokenBegin, i);
+            appendValue(values, _bcfKeyId(dict, key));
+            tokenBegin = i + 1;
+        }
+    }
+    _bcfWriteTypedInts(shared, values);
+
+    // INFO
+    if (!empty(record.info) && record.info != ".")
+    {
+        size_t tokenBegin = 0;
+        for (size_t i = 0; i <= length(record.info); ++i)
+        {
+            if (i != length(record.info) && record.info[i] != ';')
+                continue;
+
+            size_t valueBegin = tokenBegin;
+            while (valueBegin < i && record.info[valueBegin] != '=')
+                ++valueBegin;
+            key = infix(record.info, tokenBegin, valueBegin);
+            TInfix value = infix(record.info, std::min(valueBegin + 1, i), i);
+            tokenBegin = i + 1;
+
+            __int32 idx = _bcfKeyId(dict, key);
+            __int8 type = dict.infoTypes[idx];
+            if (type == BCF_TYPE_UNKNOWN)
+                SEQAN_THROW(ParseError(std::string("INFO key not declared in VCF header: ") + toCString(key)));
+
+            _bcfWriteTypedInt(shared, idx);
+            if (valueBegin == i || type == BCF_TYPE_NULL)
+            {
+                writeValue(shared, (char)BCF_TYPE_NULL);
+            }
+            else if (type == BCF_TYPE_INT32)
+            {
+                clear(values);
+                _bcfAppendNumbers(values, value, type, buffer);
+                _bcfWriteTypedInts(shared, values);
+                // Like htslib, an END before POS is ignored and rlen stays the REF length.
+                if (key == "END" && length(values) == 1u && values[0] != BCF_INT32_MISSING &&
+                    values[0] > record.beginPos)
+                    rlen = values[0] - record.beginPos;
+            }
+            else if (type == BCF_TYPE_FLOAT)
+            {
+                clear(values);
+                _bcfAppendNumbers(values, value, type, buffer);
+                _bcfWriteTypeDescriptor(shared, BCF_TYPE_FLOAT, length(values));
+                for (unsigned k = 0; k < length(values); ++k)
+                    _bcfWriteInt(shared, BCF_TYPE_INT32, values[k]);
+            }
+            else
+            {
+                _bcfWriteTypedString(shared, value);
+            }
+            ++nInfo;
+        }
+    }
+
+    // FORMAT and the samples, stored field by field.
+    if (nSample != 0 && _vcfHasBcfGenotypes(record))
+    {
+        nFmt = _bcfWriteGenotypeData(indiv, record, dict, nSample);
+    }
+    else if (nSample != 0 && !empty(record.format) && record.format != ".")
+    {
+        // Current field and end of its converted values in each sample,
+        // positions are relative to the string returned by _vcfGenotypeInfo().
+        unsigned nInfos = std::min(numGenotypeInfos(record), (unsigned)nSample);
+        String<Pair<size_t> > fields;
+        String<size_t> valuesEnd;
+        resize(fields, nSample, Pair<size_t>(0, 0));
+        resize(valuesEnd, nSample);
+        size_t sampleBegin;
+        size_t sampleEnd;
+        for (unsigned s = 0; s < nInfos; ++s)
+        {
+            _vcfGenotypeInfo(sampleBegin, sampleEnd, record, s);
+            fields[s].i1 = sampleBegin;
+        }
+
+        size_t tokenBegin = 0;
+        for (size_t j = 0; j <= length(record.format); ++j)
+        {
+            if (j != length(record.format) && record.format[j] != ':')
+                continue;
+            key = infix(record.format, tokenBegin, j);
+            tokenBegin = j + 1;
+
+            __int32 idx = _bcfKeyId(dict, key);
+            __int8 type = dict.formatTypes[idx];
+            if (type == BCF_TYPE_UNKNOWN)
+                SEQAN_THROW(ParseError(std::string("FORMAT key not declared in VCF header: ") + toCString(key)));
+            bool isGenotype = (key == "GT");
+            if (isGenotype)
+                type = BCF_TYPE_INT32;
+            else if (type == BCF_TYPE_NULL)
+                type = BCF_TYPE_CHAR;
+
+            // Locate the field in each sample, convert numbers, and determine the vector length.
+            size_t maxCount = 0;
+            clear(values);
+            for (unsigned s = 0; s < nSample; ++s)
+            {
+                size_t fieldBegin = fields[s].i1;
+                size_t fieldEnd = fieldBegin;
+                if (s < nInfos)
+                {
+                    CharString const & host = _vcfGenotypeInfo(sampleBegin, sampleEnd, record, s);
+                    while (fieldEnd < sampleEnd && host[fieldEnd] != ':')
+                        ++fieldEnd;
+                }
+                fields[s] = Pair<size_t>(fieldBegin, fieldEnd);
+
+                if (fieldBegin != fieldEnd)
+                {
+                    TInfix field = infix(_vcfGenotypeInfo(sampleBegin, sampleEnd, record, s), fieldBegin, fieldEnd);
+                    if (isGenotype)
+                        maxCount = std::max(maxCount, (size_t)_bcfAppendGenotype(values, field));
+                    else if (type == BCF_TYPE_CHAR)
+                        maxCount = std::max(maxCount, (size_t)length(field));
+                    else
+                        maxCount = std::max(maxCount, (size_t)_bcfAppendNumbers(values, field, type, buffer));
+                }
+                valuesEnd[s] = length(values);
+            }
+
+            // Write the values, absent and shorter vectors are padded.
+            _bcfWriteTypedInt(indiv, idx);
+            if (type == BCF_TYPE_CHAR)
+            {
+                _bcfWriteTypeDescriptor(indiv, BCF_TYPE_CHAR, maxCount);
+                for (unsigned s = 0; s < nSample; ++s)
+                {
+                    size_t fieldLength = fields[s].i2 - fields[s].i1;
+                    if (fieldLength != 0)
+                        write(indiv, infix(_vcfGenotypeInfo(sampleBegin, sampleEnd, record, s),
+                                           fields[s].i1, fields[s].i2));
+                    for (; fieldLength < maxCount; ++fieldLength)
+                        writeValue(indiv, '\0');
+                }
+            }
+            else
+            {
+                __int32 vectorEnd = BCF_INT32_VECTOR_END;
+                unsigned valueType = BCF_TYPE_INT32;
+                if (type == BCF_TYPE_FLOAT)
+                    vectorEnd = BCF_FLOAT_VECTOR_END;
+                else
+                    valueType = _bcfIntType(values);
+
+                _bcfWriteTypeDescriptor(indiv, (type == BCF_TYPE_FLOAT) ? (unsigned)BCF_TYPE_FLOAT : valueType, maxCount);
+                for (unsigned s = 0, k = 0; s < nSample; ++s)
+                {
+                    size_t count = valuesEnd[s] - k;
+                    for (; k < valuesEnd[s]; ++k)
+                        _bcfWriteInt(indiv, valueType, values[k]);
+                    for (; count < maxCount; ++count)
+                        _bcfWriteInt(indiv, valueType, vectorEnd);
+                }
+            }
+
+            // Advance to the next field of each sample.
+            for (unsigned s = 0; s < nSample; ++s)
+                fields[s].i1 = fields[s].i2 + 1;
+            ++nFmt;
+        }
+    }
+
+    // Fill in rlen and the counts.
+    __uint32 nAlleleInfo = nAllele << 16 | nInfo;
+    __uint32 nFmtSample = nFmt << 24 | nSample;
+    std::memcpy(begin(shared, Standard()) + 8, &rlen, 4);
+    std::memcpy(begin(shared, Standard()) + 16, &nAlleleInfo, 4);
+    std::memcpy(begin(shared, Standard()) + 20, &nFmtSample, 4);
+
+    appendRawPod(target, (__uint32)length(shared));
+    appendRawPod(target, (__uint32)length(indiv));
+    write(target, shared);
+    write(target, indiv);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_VCF_WRITE_BCF_H_
@@ -137,14 +137,24 @@ writeRecord(TTarget & target,
     else
         write(target, record.format);
 
-    // The samples.
-    for (unsigned i = 0; i < length(record.genotypeInfos); ++i)
+    // The samples, the typed values of BCF records are formatted first.
+    unsigned numSamples = numGenotypeInfos(record);
+    for (unsigned i = 0; i < numSamples; ++i)
     {
         writeValue(target, '\t');
-        if (empty(record.genotypeInfos[i]))
+        if (_vcfHasBcfGenotypes(record))
+        {
+            clear(context.buffer);
+            appendGenotypeInfo(context.buffer, record, i);
+            write(target, context.buffer);
+            continue;
+        }
+
+        Infix<CharString const>::Type genotypeInfo = getGenotypeInfo(record, i);
+        if (empty(genotypeInfo))
             writeValue(target, '.');
         else
-            write(target, record.genotypeInfos[i]);
+            write(target, genotypeInfo);
     }
     writeValue(target, '\n');
 }
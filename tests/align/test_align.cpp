@@ -58,6 +58,8 @@
 #include "test_alignment_algorithms_local.h"
 #include "test_alignment_algorithms_local_banded.h"
 #include "test_alignment_algorithms_dynamic_gap.h"
+#include "test_alignment_algorithms_batch.h"
+#include "test_alignment_algorithms_local_striped.h"
 #include "test_align_global_alignment_specialized.h"
 
 #include "test_align_alignment_operations.h"
@@ -593,6 +595,20 @@ SEQAN_BEGIN_TESTSUITE(test_align)
 //    SEQAN_CALL_TEST(test_alignment_algorithms_fragments_gaps_suboptimal_affine_banded);
 
 
+    // ----------------------------------------------------------------------------
+    // Test batch alignments.
+    // ----------------------------------------------------------------------------
+
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_dna);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_protein);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_long);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_local);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_align);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_dna);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_protein);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_embedded);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_overflow);
+
     // ----------------------------------------------------------------------------
     // Test specialized alignments.
     // ----------------------------------------------------------------------------
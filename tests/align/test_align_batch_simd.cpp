@@ -0,0 +1,55 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Runs the batch and striped alignment tests with the vectorized DP.  This
+// test is compiled with SSE4.1 and, if available, with AVX2 enabled, see
+// CMakeLists.txt.
+// ==========================================================================
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+
+#include "test_alignment_algorithms_batch.h"
+#include "test_alignment_algorithms_local_striped.h"
+
+SEQAN_BEGIN_TESTSUITE(test_align_batch_simd)
+{
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_dna);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_protein);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_global_long);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_local);
+    SEQAN_CALL_TEST(test_alignment_algorithms_batch_align);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_dna);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_protein);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_embedded);
+    SEQAN_CALL_TEST(test_alignment_algorithms_local_striped_overflow);
+}
+SEQAN_END_TESTSUITE
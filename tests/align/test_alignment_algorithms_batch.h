@@ -0,0 +1,236 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the batch interfaces of global and local alignments.  The
+// scores of the batch calls are compared against the scalar DP.
+// ==========================================================================
+
+#ifndef TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
+#define TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+#include <seqan/random.h>
+
+// ==========================================================================
+// Helpers
+// ==========================================================================
+
+// Fill seqSetH and seqSetV with random pairs of lengths in [minLen, maxLen].
+// The vertical sequence is a mutated copy of the horizontal one.  Note that
+// the scalar banded DP does not handle horizontal sequences of length 1, so
+// the tests use minLen >= 2.
+template <typename TSequence, typename TRng>
+void testAlignBatchFillSets(seqan::StringSet<TSequence> & seqSetH,
+                            seqan::StringSet<TSequence> & seqSetV,
+                            TRng & rng,
+                            unsigned count,
+                            int minLen,
+                            int maxLen)
+{
+    using namespace seqan;
+
+    typedef typename Value<TSequence>::Type TAlphabet;
+
+    Pdf<Uniform<int> > pdfLen(minLen, maxLen);
+    Pdf<Uniform<int> > pdfChar(0, ValueSize<TAlphabet>::VALUE - 1);
+    Pdf<Uniform<int> > pdfEdit(0, 9);
+
+    clear(seqSetH);
+    clear(seqSetV);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        TSequence seqH, seqV;
+        int len = pickRandomNumber(rng, pdfLen);
+        for (int j = 0; j < len; ++j)
+            appendValue(seqH, TAlphabet(pickRandomNumber(rng, pdfChar)));
+        for (int j = 0; j < len; ++j)
+        {
+            int edit = pickRandomNumber(rng, pdfEdit);
+            if (edit == 0)          // substitution
+                appendValue(seqV, TAlphabet(pickRandomNumber(rng, pdfChar)));
+            else if (edit == 1)     // insertion
+            {
+                appendValue(seqV, seqH[j]);
+                appendValue(seqV, TAlphabet(pickRandomNumber(rng, pdfChar)));
+            }
+            else if (edit != 2)     // match, 2 is a deletion
+                appendValue(seqV, seqH[j]);
+        }
+        appendValue(seqSetH, seqH);
+        appendValue(seqSetV, seqV);
+    }
+}
+
+template <typename TSequence, typename TScore, typename TAlignConfig>
+void testAlignBatchCompareGlobal(seqan::StringSet<TSequence> const & seqSetH,
+                                 seqan::StringSet<TSequence> const & seqSetV,
+                                 TScore const & scoringScheme,
+                                 TAlignConfig const & alignConfig)
+{
+    using namespace seqan;
+
+    String<int> scores = globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig);
+    SEQAN_ASSERT_EQ(length(scores), length(seqSetH));
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+        SEQAN_ASSERT_EQ(scores[i], globalAlignmentScore(seqSetH[i], seqSetV[i], scoringScheme, alignConfig));
+
+    String<int> bandedScores = globalAlignmentScore(seqSetH, seqSetV, scoringScheme, alignConfig, -7, 5);
+    SEQAN_ASSERT_EQ(length(bandedScores), length(seqSetH));
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+        SEQAN_ASSERT_EQ(bandedScores[i],
+                        globalAlignmentScore(seqSetH[i], seqSetV[i], scoringScheme, alignConfig, -7, 5));
+}
+
+template <typename TSequence, typename TScore>
+void testAlignBatchCompareLocal(seqan::StringSet<TSequence> const & seqSetH,
+                                seqan::StringSet<TSequence> const & seqSetV,
+                                TScore const & scoringScheme)
+{
+    using namespace seqan;
+
+    String<int> scores = localAlignmentScore(seqSetH, seqSetV, scoringScheme);
+    String<int> bandedScores = localAlignmentScore(seqSetH, seqSetV, scoringScheme, -4, 6);
+    SEQAN_ASSERT_EQ(length(scores), length(seqSetH));
+    SEQAN_ASSERT_EQ(length(bandedScores), length(seqSetH));
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+    {
+        Align<TSequence> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), seqSetH[i]);
+        assignSource(row(align, 1), seqSetV[i]);
+        SEQAN_ASSERT_EQ(scores[i], localAlignment(align, scoringScheme));
+        SEQAN_ASSERT_EQ(bandedScores[i], localAlignment(align, scoringScheme, -4, 6));
+    }
+}
+
+// ==========================================================================
+// Tests
+// ==========================================================================
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_global_dna)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(42);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 77, 2, 60);
+
+    Score<int, Simple> linearScore(2, -3, -2);
+    Score<int, Simple> affineScore(2, -3, -1, -5);
+
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, linearScore, AlignConfig<>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, affineScore, AlignConfig<>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, linearScore, AlignConfig<true, false, false, true>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, affineScore, AlignConfig<true, false, false, true>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, affineScore, AlignConfig<false, true, true, false>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, affineScore, AlignConfig<true, true, true, true>());
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_global_protein)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(23);
+    StringSet<Peptide> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 41, 2, 80);
+
+    Blosum62 blosum(-1, -11);
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, blosum, AlignConfig<>());
+    testAlignBatchCompareGlobal(seqSetH, seqSetV, blosum, AlignConfig<false, true, true, false>());
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_global_long)
+{
+    using namespace seqan;
+
+    // The scores of these pairs do not fit into 16 bit lanes.
+    Rng<MersenneTwister> rng(7);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 9, 2500, 3000);
+
+    Score<int, Simple> affineScore(5, -4, -2, -10);
+    String<int> scores = globalAlignmentScore(seqSetH, seqSetV, affineScore);
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+        SEQAN_ASSERT_EQ(scores[i], globalAlignmentScore(seqSetH[i], seqSetV[i], affineScore));
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_local)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(13);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 53, 2, 50);
+
+    testAlignBatchCompareLocal(seqSetH, seqSetV, Score<int, Simple>(2, -3, -2));
+    testAlignBatchCompareLocal(seqSetH, seqSetV, Score<int, Simple>(2, -3, -1, -5));
+
+    StringSet<Peptide> pepSetH, pepSetV;
+    testAlignBatchFillSets(pepSetH, pepSetV, rng, 19, 2, 70);
+    testAlignBatchCompareLocal(pepSetH, pepSetV, Blosum62(-1, -11));
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_batch_align)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(5);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 10, 2, 30);
+
+    Score<int, Simple> scoringScheme(2, -3, -1, -5);
+    String<Align<Dna5String> > alignSet;
+    resize(alignSet, length(seqSetH));
+    for (unsigned i = 0; i < length(alignSet); ++i)
+    {
+        resize(rows(alignSet[i]), 2);
+        assignSource(row(alignSet[i], 0), seqSetH[i]);
+        assignSource(row(alignSet[i], 1), seqSetV[i]);
+    }
+
+    String<int> scores = globalAlignment(alignSet, scoringScheme);
+    String<int> batchScores = globalAlignmentScore(seqSetH, seqSetV, scoringScheme);
+    SEQAN_ASSERT_EQ(length(scores), length(alignSet));
+    for (unsigned i = 0; i < length(alignSet); ++i)
+    {
+        Align<Dna5String> align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), seqSetH[i]);
+        assignSource(row(align, 1), seqSetV[i]);
+        SEQAN_ASSERT_EQ(scores[i], globalAlignment(align, scoringScheme));
+        SEQAN_ASSERT_EQ(scores[i], batchScores[i]);
+        SEQAN_ASSERT(row(alignSet[i], 0) == row(align, 0));
+        SEQAN_ASSERT(row(alignSet[i], 1) == row(align, 1));
+    }
+}
+
+#endif  // #ifndef TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_BATCH_H_
@@ -0,0 +1,169 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the striped local alignment.  The scores and alignments are
+// compared against the scalar DP.
+// ==========================================================================
+
+#ifndef TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
+#define TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/align.h>
+#include <seqan/random.h>
+
+// ==========================================================================
+// Helpers
+// ==========================================================================
+
+template <typename TSequence, typename TScore>
+void testAlignStripedCompare(TSequence const & seqH, TSequence const & seqV, TScore const & scoringScheme)
+{
+    using namespace seqan;
+
+    Align<TSequence> align, alignScalar;
+    resize(rows(align), 2);
+    assignSource(row(align, 0), seqH);
+    assignSource(row(align, 1), seqV);
+    resize(rows(alignScalar), 2);
+    assignSource(row(alignScalar, 0), seqH);
+    assignSource(row(alignScalar, 1), seqV);
+
+    // Without the Striped tag, the scalar DP is used.
+    int scoreScalar = localAlignment(alignScalar, scoringScheme);
+
+    SEQAN_ASSERT_EQ(localAlignmentScore(seqH, seqV, scoringScheme), scoreScalar);
+    SEQAN_ASSERT_EQ(localAlignmentScore(seqH, seqV, scoringScheme, Striped()), scoreScalar);
+    SEQAN_ASSERT_EQ(localAlignment(align, scoringScheme, Striped()), scoreScalar);
+
+    // The alignments must be the same, too.
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        SEQAN_ASSERT_EQ(clippedBeginPosition(row(align, i)), clippedBeginPosition(row(alignScalar, i)));
+        SEQAN_ASSERT_EQ(clippedEndPosition(row(align, i)), clippedEndPosition(row(alignScalar, i)));
+    }
+    std::stringstream ss, ssScalar;
+    ss << align;
+    ssScalar << alignScalar;
+    SEQAN_ASSERT_EQ(ss.str(), ssScalar.str());
+}
+
+// ==========================================================================
+// Tests
+// ==========================================================================
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_dna)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(17);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 40, 1, 300);
+
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+    {
+        testAlignStripedCompare(seqSetH[i], seqSetV[i], Score<int, Simple>(2, -3, -2));
+        testAlignStripedCompare(seqSetH[i], seqSetV[i], Score<int, Simple>(2, -3, -1, -5));
+        // Adjacent insertions and deletions are cheaper than mismatches.
+        testAlignStripedCompare(seqSetH[i], seqSetV[i], Score<int, Simple>(3, -9, -1, -1));
+    }
+
+    SEQAN_ASSERT_EQ(localAlignmentScore(Dna5String(), Dna5String("ACGT"), Score<int, Simple>(2, -3, -2), Striped()), 0);
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_protein)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(19);
+    StringSet<Peptide> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 20, 1, 200);
+
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+        testAlignStripedCompare(seqSetH[i], seqSetV[i], Blosum62(-1, -11));
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_embedded)
+{
+    using namespace seqan;
+
+    // Short local alignments in long sequences, only a small part of the
+    // matrix is computed with traceback.
+    Rng<MersenneTwister> rng(23);
+    Pdf<Uniform<int> > pdfChar(0, 3);
+    Pdf<Uniform<int> > pdfPos(0, 1800);
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        Dna5String seqH, seqV;
+        for (unsigned j = 0; j < 2000; ++j)
+            appendValue(seqH, Dna5(pickRandomNumber(rng, pdfChar)));
+        for (unsigned j = 0; j < 30; ++j)
+            appendValue(seqV, Dna5(pickRandomNumber(rng, pdfChar)));
+        append(seqV, infix(seqH, pickRandomNumber(rng, pdfPos), 1850 + i * 10));
+        for (unsigned j = 0; j < length(seqV); j += 17)
+            seqV[j] = Dna5((ordValue(seqV[j]) + 1) % 4);
+        erase(seqV, 60);
+        insertValue(seqV, 80, Dna5('A'));
+        for (unsigned j = 0; j < 30; ++j)
+            appendValue(seqV, Dna5(pickRandomNumber(rng, pdfChar)));
+
+        testAlignStripedCompare(seqH, seqV, Score<int, Simple>(2, -3, -2));
+        testAlignStripedCompare(seqH, seqV, Score<int, Simple>(2, -3, -1, -5));
+        testAlignStripedCompare(seqV, seqH, Score<int, Simple>(2, -3, -1, -5));
+    }
+}
+
+SEQAN_DEFINE_TEST(test_alignment_algorithms_local_striped_overflow)
+{
+    using namespace seqan;
+
+    // The scores overflow the 8 bit lanes and, for the longest pair, the
+    // 16 bit lanes, too.
+    Rng<MersenneTwister> rng(29);
+    StringSet<Dna5String> seqSetH, seqSetV;
+    testAlignBatchFillSets(seqSetH, seqSetV, rng, 3, 1000, 1200);
+    appendValue(seqSetH, "");
+    appendValue(seqSetV, "");
+    for (unsigned i = 0; i < 7000; ++i)
+    {
+        appendValue(back(seqSetH), Dna5(i % 4));
+        appendValue(back(seqSetV), Dna5(i % 4));
+    }
+
+    for (unsigned i = 0; i < length(seqSetH); ++i)
+        testAlignStripedCompare(seqSetH[i], seqSetV[i], Score<int, Simple>(5, -4, -2, -10));
+    SEQAN_ASSERT_EQ(localAlignmentScore(back(seqSetH), back(seqSetV), Score<int, Simple>(5, -4, -2, -10), Striped()),
+                    35000);
+}
+
+#endif  // #ifndef TESTS_ALIGN_TEST_ALIGNMENT_ALGORITHMS_LOCAL_STRIPED_H_
@@ -36,6 +36,7 @@
 #define TESTS_BAM_IO_TEST_EASY_BAM_IO_H_
 
 #include <sstream>
+#include <fstream>
 
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
@@ -237,6 +238,78 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_file_bam_read_ex1)
     SEQAN_ASSERT_EQ(counts[1], 1806);
 }
 
+// readRecords() decodes batches of records in parallel, it must give the same results as readRecord().
+void testBamIOBamFileReadRecordsBatch(char const * filePath)
+{
+    seqan::BamFileIn bamIOSeq(filePath);
+    seqan::BamFileIn bamIOPar(filePath);
+    seqan::BamHeader header;
+    readHeader(header, bamIOSeq);
+    readHeader(header, bamIOPar);
+
+    seqan::ClassTest::ScopedNumThreads numThreads(4);
+
+    seqan::BamAlignmentRecord record;
+    seqan::String<seqan::BamAlignmentRecord> records;
+    size_t numRecords = 0;
+    while (!atEnd(bamIOPar))
+    {
+        size_t batchSize = readRecords(records, bamIOPar, 500);
+        for (size_t i = 0; i < batchSize; ++i, ++numRecords)
+        {
+            SEQAN_ASSERT_NOT(atEnd(bamIOSeq));
+            readRecord(record, bamIOSeq);
+            SEQAN_ASSERT_EQ(records[i].qName, record.qName);
+            SEQAN_ASSERT_EQ(records[i].flag, record.flag);
+            SEQAN_ASSERT_EQ(records[i].rID, record.rID);
+            SEQAN_ASSERT_EQ(records[i].beginPos, record.beginPos);
+            SEQAN_ASSERT_EQ(records[i].mapQ, record.mapQ);
+            SEQAN_ASSERT(records[i].cigar == record.cigar);
+            SEQAN_ASSERT_EQ(records[i].rNextId, record.rNextId);
+            SEQAN_ASSERT_EQ(records[i].pNext, record.pNext);
+            SEQAN_ASSERT_EQ(records[i].tLen, record.tLen);
+            SEQAN_ASSERT_EQ(records[i].seq, record.seq);
+            SEQAN_ASSERT_EQ(records[i].qual, record.qual);
+            SEQAN_ASSERT_EQ(records[i].tags, record.tags);
+        }
+    }
+    SEQAN_ASSERT(atEnd(bamIOSeq));
+    SEQAN_ASSERT_GT(numRecords, 0u);
+    SEQAN_ASSERT(contigNames(context(bamIOPar)) == contigNames(context(bamIOSeq)));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_file_bam_read_records_batch)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/bam_io/ex1.bam");
+
+    testBamIOBamFileReadRecordsBatch(toCString(filePath));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_file_sam_read_records_batch)
+{
+    // Without @SQ lines, the contig names are registered while reading the records.
+    seqan::CharString tmpPath = SEQAN_TEMP_FILENAME();
+    append(tmpPath, ".sam");
+    {
+        std::ofstream samFile(toCString(tmpPath));
+        samFile << "@HD\tVN:1.3\n";
+        char const * names[] = { "chr3", "chr1", "chr3", "chr2", "*" };
+        for (unsigned i = 0; i < 2000; ++i)
+        {
+            char const * rName = names[(i * 7) % 5];
+            char const * rNext = (i % 3 == 0) ? "=" : names[(i * 3 + 1) % 5];
+            if (i == 1234)
+                rName = "chrX";
+            samFile << "READ" << i << "\t" << (i % 4) << "\t" << rName << "\t" << (i + 1) << "\t60\t"
+                    << "4M1I5M\t" << rNext << "\t" << (i + 31) << "\t40\tACGTACGTAC\t!!!!!!!!!!"
+                    << "\tNM:i:" << (i % 5) << "\n";
+        }
+    }
+
+    testBamIOBamFileReadRecordsBatch(toCString(tmpPath));
+}
+
 // ---------------------------------------------------------------------------
 // Write Header
 // ---------------------------------------------------------------------------
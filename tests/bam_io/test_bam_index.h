@@ -80,4 +80,414 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai)
     SEQAN_ASSERT_NOT(found);
 }
 
+// Build a BAI index of a coordinate-sorted BAM file in memory, one chunk per run of alignments in the same bin.
+inline void buildBaiTestIndex(seqan::BamIndex<seqan::Bai> & index, char const * bamFilename)
+{
+    using namespace seqan;
+
+    BamFileIn bamFile(bamFilename);
+    BamHeader header;
+    readHeader(header, bamFile);
+
+    resize(index._binIndices, length(contigNames(context(bamFile))));
+    resize(index._linearIndices, length(contigNames(context(bamFile))));
+
+    BamAlignmentRecord record;
+    while (!atEnd(bamFile))
+    {
+        __uint64 beginOffset = position(bamFile);
+        readRecord(record, bamFile);
+        __uint64 endOffset = position(bamFile);
+
+        __int32 recordEnd = record.beginPos + std::max(getAlignmentLengthInRef(record), (unsigned)1);
+        String<Pair<__uint64, __uint64> > & chunks =
+            index._binIndices[record.rID][_reg2Bin(record.beginPos, recordEnd)].chunkBegEnds;
+        if (!empty(chunks) && back(chunks).i2 == beginOffset)
+            back(chunks).i2 = endOffset;
+        else
+            appendValue(chunks, Pair<__uint64, __uint64>(beginOffset, endOffset));
+
+        String<__uint64> & linearIndex = index._linearIndices[record.rID];
+        unsigned lastWindow = (recordEnd - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+        if (length(linearIndex) <= lastWindow)
+            resize(linearIndex, lastWindow + 1, 0u);
+        for (unsigned w = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT; w <= lastWindow; ++w)
+            if (linearIndex[w] == 0u)
+                linearIndex[w] = beginOffset;
+    }
+}
+
+// Write a coordinate-sorted BAM file with a reference longer than the BAI limit of 2^29 bases.
+//
+// chr1 (800 Mbp) has an alignment of length 100 every 200 kbp and a spliced alignment [300000000, 300100100),
+// chr2 has an alignment every 1 kbp, followed by 5 unaligned reads.
+inline void writeCsiTestBam(std::string const & path)
+{
+    using namespace seqan;
+
+    typedef BamHeaderRecord::TTag TTag;
+
+    BamFileOut bamFile(path.c_str());
+    appendValue(contigNames(context(bamFile)), "chr1");
+    appendValue(contigLengths(context(bamFile)), 800000000);
+    appendValue(contigNames(context(bamFile)), "chr2");
+    appendValue(contigLengths(context(bamFile)), 100000);
+
+    BamHeader header;
+    BamHeaderRecord firstRecord;
+    firstRecord.type = BAM_HEADER_FIRST;
+    appendValue(firstRecord.tags, TTag("VN", "1.4"));
+    appendValue(firstRecord.tags, TTag("SO", "coordinate"));
+    appendValue(header, firstRecord);
+    writeHeader(bamFile, header);
+
+    BamAlignmentRecord record;
+    record.seq = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+    appendValue(record.cigar, CigarElement<>('M', 100));
+    for (unsigned k = 0; k < 4000; ++k)
+    {
+        record.qName = "r";
+        record.rID = 0;
+        record.beginPos = 200000 * k;
+        writeRecord(bamFile, record);
+
+        if (record.beginPos == 300000000)
+        {
+            BamAlignmentRecord spliced = record;
+            spliced.qName = "spliced";
+            clear(spliced.cigar);
+            appendValue(spliced.cigar, CigarElement<>('M', 50));
+            appendValue(spliced.cigar, CigarElement<>('N', 100000));
+            appendValue(spliced.cigar, CigarElement<>('M', 50));
+            writeRecord(bamFile, spliced);
+        }
+    }
+    for (unsigned k = 0; k < 100; ++k)
+    {
+        record.rID = 1;
+        record.beginPos = 1000 * k;
+        writeRecord(bamFile, record);
+    }
+
+    BamAlignmentRecord unaligned;
+    unaligned.qName = "unaligned";
+    unaligned.flag = BAM_FLAG_UNMAPPED;
+    unaligned.seq = "ACGT";
+    for (unsigned k = 0; k < 5; ++k)
+        writeRecord(bamFile, unaligned);
+}
+
+// Check the first alignments overlapping some regions of the CSI test BAM file.
+inline void testCsiJumpToRegion(char const * bamFilename, seqan::BamIndex<seqan::Csi> const & csiIndex)
+{
+    using namespace seqan;
+
+    BamFileIn bamFile(bamFilename);
+    BamHeader header;
+    readHeader(header, bamFile);
+
+    BamAlignmentRecord record;
+    bool hasAlignments = false;
+
+    // Behind the 512 Mbp limit of BAI.
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 600000050, 600000060, csiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.rID, 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 600000000);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 600000100, 600200000, csiIndex));
+    SEQAN_ASSERT_NOT(hasAlignments);
+
+    // The spliced alignment is the first one overlapping its intron.
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 300050000, 300050010, csiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 300000000);
+    SEQAN_ASSERT_EQ(record.qName, "spliced");
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 300200000);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 1, 5000, 5001, csiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.rID, 1);
+    SEQAN_ASSERT_EQ(record.beginPos, 5000);
+
+    // Compare with the expected first alignments of a range of regions on chr1.
+    for (__int32 pos = 0; pos < 800000000; pos += 1234567)
+    {
+        __int32 posEnd = pos + 50000;
+        __int32 expected = pos / 200000 * 200000;
+        if (expected + 100 <= pos)
+            expected += 200000;
+        bool inIntron = pos >= 300000100 && pos < 300100100;
+
+        SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, pos, posEnd, csiIndex));
+        SEQAN_ASSERT_EQ(hasAlignments, inIntron || (expected < posEnd && expected < 800000000));
+        if (!hasAlignments)
+            continue;
+        readRecord(record, bamFile);
+        SEQAN_ASSERT_EQ(record.rID, 0);
+        SEQAN_ASSERT_EQ(record.beginPos, inIntron ? 300000000 : expected);
+    }
+
+    SEQAN_ASSERT_NOT(jumpToRegion(bamFile, hasAlignments, 2, 1, 10, csiIndex));
+    SEQAN_ASSERT_NOT(hasAlignments);
+
+    SEQAN_ASSERT(jumpToOrphans(bamFile, hasAlignments, csiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.rID, -1);
+    SEQAN_ASSERT_EQ(record.qName, "unaligned");
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_csi)
+{
+    using namespace seqan;
+
+    std::string bamFilename = (std::string)SEQAN_TEMP_FILENAME() + ".bam";
+    std::string csiFilename = bamFilename + ".csi";
+    writeCsiTestBam(bamFilename);
+
+    // The depth is chosen to cover chr1.
+    BamIndex<Csi> csiIndex;
+    SEQAN_ASSERT(buildIndex(csiIndex, bamFilename.c_str()));
+    SEQAN_ASSERT_EQ(csiIndex._minShift, 14);
+    SEQAN_ASSERT_EQ(csiIndex._depth, 6);
+    SEQAN_ASSERT_EQ(length(csiIndex._binIndices), 2u);
+    SEQAN_ASSERT_EQ(getUnalignedCount(csiIndex), 5u);
+
+    // Load the written index.
+    BamIndex<Csi> loaded;
+    SEQAN_ASSERT(open(loaded, csiFilename.c_str()));
+    SEQAN_ASSERT_EQ(loaded._minShift, 14);
+    SEQAN_ASSERT_EQ(loaded._depth, 6);
+    SEQAN_ASSERT_EQ(getUnalignedCount(loaded), 5u);
+    SEQAN_ASSERT_EQ(length(loaded._binIndices), 2u);
+    for (unsigned i = 0; i < length(loaded._binIndices); ++i)
+    {
+        SEQAN_ASSERT_EQ(loaded._binIndices[i].size(), csiIndex._binIndices[i].size());
+        BamIndex<Csi>::TBinIndex_::const_iterator it1 = csiIndex._binIndices[i].begin();
+        BamIndex<Csi>::TBinIndex_::const_iterator it2 = loaded._binIndices[i].begin();
+        for (; it1 != csiIndex._binIndices[i].end(); ++it1, ++it2)
+        {
+            SEQAN_ASSERT_EQ(it1->first, it2->first);
+            SEQAN_ASSERT_EQ(it1->second.loffset, it2->second.loffset);
+            SEQAN_ASSERT(it1->second.chunkBegEnds == it2->second.chunkBegEnds);
+        }
+    }
+
+    testCsiJumpToRegion(bamFilename.c_str(), loaded);
+
+    // Finer bins with more levels.
+    BamIndex<Csi> fineIndex(12, 7);
+    SEQAN_ASSERT(buildIndex(fineIndex, bamFilename.c_str()));
+    SEQAN_ASSERT_EQ(fineIndex._depth, 7);
+    testCsiJumpToRegion(bamFilename.c_str(), fineIndex);
+
+    // The BAI binning scheme cannot cover chr1.
+    BamIndex<Csi> baiLikeIndex(14, 5);
+    SEQAN_ASSERT_NOT(buildIndex(baiLikeIndex, bamFilename.c_str()));
+}
+
+// Collects the begin positions of the alignments of each region.
+struct CollectBeginPositions_
+{
+    template <typename TRegion, typename TRecords>
+    void operator()(seqan::String<__int32> & result, TRegion const & /*region*/, TRecords const & records) const
+    {
+        for (unsigned i = 0; i < length(records); ++i)
+            appendValue(result, records[i].beginPos);
+    }
+};
+
+// Compare processRegions() with a sequential scan of the whole file.
+template <typename TIndexSpec>
+inline void testBamProcessRegions(char const * bamFilename, seqan::BamIndex<TIndexSpec> const & index, __int32 windowSize)
+{
+    using namespace seqan;
+
+    BamFileIn bamFile(bamFilename);
+    BamHeader header;
+    readHeader(header, bamFile);
+
+    String<GenomicRegion> regions;
+    partitionContigs(regions, context(bamFile), windowSize);
+    SEQAN_ASSERT_GT(length(regions), 1u);
+
+    String<String<__int32> > expected;
+    resize(expected, length(regions));
+    BamAlignmentRecord record;
+    while (!atEnd(bamFile))
+    {
+        readRecord(record, bamFile);
+        if (record.rID < 0)
+            continue;
+        __int32 recordEnd = record.beginPos + std::max(getAlignmentLengthInRef(record), (unsigned)1);
+        for (unsigned i = 0; i < length(regions); ++i)
+            if (regions[i].rID == record.rID && regions[i].beginPos < recordEnd && record.beginPos < regions[i].endPos)
+                appendValue(expected[i], record.beginPos);
+    }
+
+    String<String<__int32> > results;
+    processRegions(results, bamFilename, regions, index, CollectBeginPositions_());
+    SEQAN_ASSERT_EQ(length(results), length(regions));
+    for (unsigned i = 0; i < length(regions); ++i)
+        SEQAN_ASSERT(results[i] == expected[i]);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_process_regions)
+{
+    using namespace seqan;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/tests/bam_io/small.bam");
+    CharString baiFilename = bamFilename;
+    append(baiFilename, ".bai");
+
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(open(baiIndex, toCString(baiFilename)));
+    testBamProcessRegions(toCString(bamFilename), baiIndex, 3);
+
+    // A spliced alignment spans several windows of chr1.
+    std::string csiBamFilename = (std::string)SEQAN_TEMP_FILENAME() + ".bam";
+    writeCsiTestBam(csiBamFilename);
+    BamIndex<Csi> csiIndex;
+    SEQAN_ASSERT(buildIndex(csiIndex, csiBamFilename.c_str()));
+    testBamProcessRegions(csiBamFilename.c_str(), csiIndex, 25000000);
+
+    // Regions given by name, the results are in the order of the regions.
+    String<GenomicRegion> regions;
+    resize(regions, 3);
+    regions[0].seqName = "chr2";
+    regions[0].beginPos = 1000;
+    regions[0].endPos = 3000;
+    regions[1].seqName = "chr1";
+    regions[1].beginPos = 300050000;
+    regions[1].endPos = 300060000;
+    regions[2].seqName = "chrUnknown";
+    String<String<__int32> > results;
+    processRegions(results, csiBamFilename.c_str(), regions, csiIndex, CollectBeginPositions_());
+    SEQAN_ASSERT_EQ(length(results), 3u);
+    SEQAN_ASSERT_EQ(length(results[0]), 2u);
+    SEQAN_ASSERT_EQ(results[0][0], 1000);
+    SEQAN_ASSERT_EQ(results[0][1], 2000);
+    SEQAN_ASSERT_EQ(length(results[1]), 1u);
+    SEQAN_ASSERT_EQ(results[1][0], 300000000);
+    SEQAN_ASSERT_EQ(length(results[2]), 0u);
+
+    // Errors are rethrown in the calling thread.
+    bool thrown = false;
+    try
+    {
+        processRegions(results, "not-existing.bam", regions, csiIndex, CollectBeginPositions_());
+    }
+    catch (IOError const &)
+    {
+        thrown = true;
+    }
+    SEQAN_ASSERT(thrown);
+
+    // A region on a reference the index does not cover is an error, not an empty region.
+    resize(regions, 1);
+    regions[0].rID = length(csiIndex._binIndices);
+    regions[0].beginPos = 0;
+    regions[0].endPos = 1000;
+    thrown = false;
+    try
+    {
+        processRegions(results, csiBamFilename.c_str(), regions, csiIndex, CollectBeginPositions_());
+    }
+    catch (IOError const &)
+    {
+        thrown = true;
+    }
+    SEQAN_ASSERT(thrown);
+}
+
+// The first alignment overlapping a region can begin left of alignments of other candidate bins that begin left
+// of the region, but do not overlap it.
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai_jump_to_region)
+{
+    using namespace seqan;
+
+    std::string bamFilename = (std::string)SEQAN_TEMP_FILENAME() + ".bam";
+    {
+        BamFileOut bamFile(bamFilename.c_str());
+        appendValue(contigNames(context(bamFile)), "chr1");
+        appendValue(contigLengths(context(bamFile)), 200000);
+        BamHeader header;
+        writeHeader(bamFile, header);
+
+        // The alignments [0, 100000), [49200, 49210), [50010, 50020) and [120000, 120010).
+        __int32 const beginPos[] = { 0, 49200, 50010, 120000 };
+        unsigned const cigarLength[] = { 100000, 10, 10, 10 };
+        BamAlignmentRecord record;
+        record.rID = 0;
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            record.qName = "r";
+            record.beginPos = beginPos[k];
+            clear(record.cigar);
+            appendValue(record.cigar, CigarElement<>('M', cigarLength[k]));
+            writeRecord(bamFile, record);
+        }
+    }
+
+    BamIndex<Bai> baiIndex;
+    buildBaiTestIndex(baiIndex, bamFilename.c_str());
+    SEQAN_ASSERT_EQ(baiIndex._binIndices[0].size(), 3u);
+
+    BamFileIn bamFile(bamFilename.c_str());
+    BamHeader header;
+    readHeader(header, bamFile);
+
+    BamAlignmentRecord record;
+    bool hasAlignments = false;
+
+    // The long alignment is the first one overlapping the region, not the one of the rightmost chunk left of it.
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 50000, 50100, baiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 0);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 49205, 49206, baiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 0);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 110000, 130000, baiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 120000);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 100000, 110000, baiIndex));
+    SEQAN_ASSERT_NOT(hasAlignments);
+
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 150000, 200000, baiIndex));
+    SEQAN_ASSERT_NOT(hasAlignments);
+
+    // An empty region is looked up like its single position.
+    SEQAN_ASSERT(jumpToRegion(bamFile, hasAlignments, 0, 49205, 49205, baiIndex));
+    SEQAN_ASSERT(hasAlignments);
+    readRecord(record, bamFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 0);
+
+    // processRegions() reads the long alignment in each region it overlaps.
+    String<GenomicRegion> regions;
+    partitionContigs(regions, context(bamFile), 50000);
+    String<String<__int32> > results;
+    processRegions(results, bamFilename.c_str(), regions, baiIndex, CollectBeginPositions_());
+    SEQAN_ASSERT_EQ(length(results), 4u);
+    SEQAN_ASSERT_EQ(length(results[0]), 2u);
+    SEQAN_ASSERT_EQ(length(results[1]), 2u);
+    SEQAN_ASSERT_EQ(results[1][0], 0);
+    SEQAN_ASSERT_EQ(results[1][1], 50010);
+    SEQAN_ASSERT_EQ(length(results[2]), 1u);
+    SEQAN_ASSERT_EQ(results[2][0], 120000);
+    SEQAN_ASSERT_EQ(length(results[3]), 0u);
+}
+
 #endif  // TESTS_BAM_IO_TEST_BAM_INDEX_H_
@@ -161,6 +161,7 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_file_size);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_records);
+    SEQAN_CALL_TEST(test_bam_io_bam_file_sam_read_records_batch);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_sam_write_records);
 
@@ -168,6 +169,7 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_records);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_ex1);
+    SEQAN_CALL_TEST(test_bam_io_bam_file_bam_read_records_batch);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_write_records);
     SEQAN_CALL_TEST(test_bam_io_bam_file_bam_file_seek);
@@ -177,6 +179,9 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
 
     // Test BAM indices.
     SEQAN_CALL_TEST(test_bam_io_bam_index_bai);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_bai_jump_to_region);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_csi);
+    SEQAN_CALL_TEST(test_bam_io_bam_process_regions);
 #endif
 }
 SEQAN_END_TESTSUITE
@@ -55,6 +55,7 @@
 
 #include "test_find_hamming.h"
 #include "test_find_myers_banded.h"
+#include "test_find_myers_batch.h"
 
 using namespace std;
 using namespace seqan;
@@ -1750,6 +1751,11 @@ SEQAN_BEGIN_TESTSUITE(test_find) {
     // Testing MyersUkkonen with large needle and manual score limit.
     SEQAN_CALL_TEST(test_regression_rmbench);
 
+    // Testing the batch verification of needle/text pairs.
+    SEQAN_CALL_TEST(test_find_myers_batch_example);
+    SEQAN_CALL_TEST(test_find_myers_batch_dna);
+    SEQAN_CALL_TEST(test_find_myers_batch_dna5);
+
     // Call all tests.
     SEQAN_CALL_TEST(test_find_online_Simple);
     SEQAN_CALL_TEST(test_find_online_Horspool);
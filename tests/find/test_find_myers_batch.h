@@ -0,0 +1,187 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the batch Myers verification.  The results are compared to the
+// MyersUkkonen pattern applied to each needle/text pair.
+// ==========================================================================
+
+#ifndef TESTS_FIND_TEST_FIND_MYERS_BATCH_H_
+#define TESTS_FIND_TEST_FIND_MYERS_BATCH_H_
+
+#include <seqan/basic.h>
+#include <seqan/find.h>
+#include <seqan/random.h>
+
+// Creates random needles of the given lengths and texts that contain a mutated
+// copy of their needle between random flanks.
+template <typename TSequence, typename TRng>
+void testFindMyersBatchFillSets(seqan::StringSet<TSequence> & texts,
+                                seqan::StringSet<TSequence> & needles,
+                                TRng & rng,
+                                unsigned count,
+                                int minLen,
+                                int maxLen)
+{
+    using namespace seqan;
+
+    typedef typename Value<TSequence>::Type TAlphabet;
+
+    Pdf<Uniform<int> > pdfLen(minLen, maxLen);
+    Pdf<Uniform<int> > pdfFlank(0, 40);
+    Pdf<Uniform<int> > pdfChar(0, ValueSize<TAlphabet>::VALUE - 1);
+    Pdf<Uniform<int> > pdfEdit(0, 15);
+
+    clear(texts);
+    clear(needles);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        TSequence needle, text;
+        int len = pickRandomNumber(rng, pdfLen);
+        for (int j = 0; j < len; ++j)
+            appendValue(needle, TAlphabet(pickRandomNumber(rng, pdfChar)));
+
+        for (int j = pickRandomNumber(rng, pdfFlank); j > 0; --j)
+            appendValue(text, TAlphabet(pickRandomNumber(rng, pdfChar)));
+        for (int j = 0; j < len; ++j)
+        {
+            int edit = pickRandomNumber(rng, pdfEdit);
+            if (edit == 0)          // substitution
+                appendValue(text, TAlphabet(pickRandomNumber(rng, pdfChar)));
+            else if (edit == 1)     // insertion
+            {
+                appendValue(text, needle[j]);
+                appendValue(text, TAlphabet(pickRandomNumber(rng, pdfChar)));
+            }
+            else if (edit != 2)     // match, 2 is a deletion
+                appendValue(text, needle[j]);
+        }
+        for (int j = pickRandomNumber(rng, pdfFlank); j > 0; --j)
+            appendValue(text, TAlphabet(pickRandomNumber(rng, pdfChar)));
+
+        appendValue(needles, needle);
+        appendValue(texts, text);
+    }
+}
+
+template <typename TSequence, typename TParallelTag>
+void testFindMyersBatchCompare(seqan::StringSet<TSequence> const & texts,
+                               seqan::StringSet<TSequence> const & needles,
+                               int minScore,
+                               TParallelTag parallelTag)
+{
+    using namespace seqan;
+
+    String<unsigned> endPositions;
+    String<int> scores;
+    findMyersBatch(endPositions, scores, texts, needles, minScore, parallelTag);
+
+    SEQAN_ASSERT_EQ(length(endPositions), length(texts));
+    SEQAN_ASSERT_EQ(length(scores), length(texts));
+
+    for (unsigned i = 0; i < length(texts); ++i)
+    {
+        unsigned expectedEnd = 0;
+        int expectedScore = minScore - 1;
+
+        Finder<TSequence const> finder(texts[i]);
+        Pattern<TSequence, MyersUkkonen> pattern(needles[i]);
+        while (find(finder, pattern, minScore))
+            if (getScore(pattern) > expectedScore)
+            {
+                expectedScore = getScore(pattern);
+                expectedEnd = endPosition(finder);
+            }
+
+        SEQAN_ASSERT_EQ(scores[i], expectedScore);
+        SEQAN_ASSERT_EQ(endPositions[i], expectedEnd);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_find_myers_batch_example)
+{
+    using namespace seqan;
+
+    StringSet<DnaString> texts;
+    StringSet<DnaString> needles;
+    appendValue(texts, "AAAACGTTGCAAAA");
+    appendValue(needles, "CGTAGC");
+    appendValue(texts, "TTTTTTTT");
+    appendValue(needles, "CGTAGC");
+    appendValue(texts, "ACGTACGT");
+    appendValue(needles, "");
+
+    String<unsigned> endPositions;
+    String<int> scores;
+    findMyersBatch(endPositions, scores, texts, needles, -1);
+
+    SEQAN_ASSERT_EQ(length(endPositions), 3u);
+    SEQAN_ASSERT_EQ(scores[0], -1);
+    SEQAN_ASSERT_EQ(endPositions[0], 10u);
+    SEQAN_ASSERT_EQ(scores[1], -2);
+    SEQAN_ASSERT_EQ(endPositions[1], 0u);
+    SEQAN_ASSERT_EQ(scores[2], -2);
+    SEQAN_ASSERT_EQ(endPositions[2], 0u);
+}
+
+SEQAN_DEFINE_TEST(test_find_myers_batch_dna)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(42);
+    StringSet<DnaString> texts;
+    StringSet<DnaString> needles;
+
+    testFindMyersBatchFillSets(texts, needles, rng, 100, 1, 32);
+    testFindMyersBatchCompare(texts, needles, -3, Serial());
+    testFindMyersBatchCompare(texts, needles, 0, Serial());
+
+    testFindMyersBatchFillSets(texts, needles, rng, 100, 33, 64);
+    testFindMyersBatchCompare(texts, needles, -6, Serial());
+
+    testFindMyersBatchFillSets(texts, needles, rng, 100, 1, 150);
+    testFindMyersBatchCompare(texts, needles, -8, Serial());
+    testFindMyersBatchCompare(texts, needles, -8, Parallel());
+}
+
+SEQAN_DEFINE_TEST(test_find_myers_batch_dna5)
+{
+    using namespace seqan;
+
+    Rng<MersenneTwister> rng(7);
+    StringSet<Dna5String> texts;
+    StringSet<Dna5String> needles;
+
+    testFindMyersBatchFillSets(texts, needles, rng, 123, 1, 80);
+    testFindMyersBatchCompare(texts, needles, -5, Serial());
+    testFindMyersBatchCompare(texts, needles, -5, Parallel());
+}
+
+#endif  // TESTS_FIND_TEST_FIND_MYERS_BATCH_H_
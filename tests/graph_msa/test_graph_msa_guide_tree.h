@@ -174,6 +174,120 @@ Test_UpgmaGuideTree(int seed) {
     }
 }
 
+// Returns the leaves below each inner vertex, i.e. the tree up to the numbering of the inner vertices.
+std::set<std::vector<bool> > testMbedGuideTreeClusters(seqan::Graph<seqan::Tree<double> > & tree)
+{
+    using namespace seqan;
+
+    typedef Graph<Tree<double> > TTree;
+    typedef Iterator<TTree, BfsIterator>::Type TBfsIterator;
+    typedef Iterator<TTree, AdjacencyIterator>::Type TAdjacencyIterator;
+
+    unsigned n = (numVertices(tree) + 1) / 2;
+    String<unsigned> vertices;
+    for (TBfsIterator it(tree, getRoot(tree)); !atEnd(it); goNext(it))
+        appendValue(vertices, *it);
+
+    std::vector<std::vector<bool> > leaves(numVertices(tree), std::vector<bool>(n, false));
+    std::set<std::vector<bool> > clusters;
+    for (unsigned i = length(vertices); i > 0; --i)
+    {
+        unsigned v = vertices[i - 1];
+        if (isLeaf(tree, v))
+            leaves[v][v] = true;
+        for (TAdjacencyIterator it(tree, v); !atEnd(it); goNext(it))
+            for (unsigned j = 0; j < n; ++j)
+                if (leaves[*it][j])
+                    leaves[v][j] = true;
+        clusters.insert(leaves[v]);
+    }
+    return clusters;
+}
+
+void Test_MbedGuideTree()
+{
+    using namespace seqan;
+
+    typedef Graph<Tree<double> > TTree;
+    typedef VertexDescriptor<TTree>::Type TVertexDescriptor;
+    typedef Iterator<TTree, BfsIterator>::Type TBfsIterator;
+
+    Rng<MersenneTwister> rng(42);
+    Pdf<Uniform<int> > pdfChar(0, 3);
+    Pdf<Uniform<int> > pdfEdit(0, 9);
+
+    // Families of mutated copies of random ancestors
+    StringSet<DnaString> seqs;
+    for (unsigned family = 0; family < 15; ++family)
+    {
+        DnaString ancestor;
+        for (unsigned i = 0; i < 80; ++i)
+            appendValue(ancestor, Dna(pickRandomNumber(rng, pdfChar)));
+        for (unsigned member = 0; member < 20; ++member)
+        {
+            DnaString seq = ancestor;
+            for (unsigned i = 0; i < length(seq); ++i)
+                if (pickRandomNumber(rng, pdfEdit) == 0)
+                    seq[i] = Dna(pickRandomNumber(rng, pdfChar));
+            appendValue(seqs, seq);
+        }
+    }
+
+    // Up to 100 sequences the tree is the UPGMA tree of the k-mer distances
+    {
+        StringSet<DnaString, Dependent<> > smallSet;
+        for (unsigned i = 0; i < 30; ++i)
+            appendValue(smallSet, seqs[i * 10]);
+        TTree mbed;
+        mbedTree(smallSet, mbed);
+
+        Graph<Alignment<StringSet<DnaString, Dependent<> > > > g(smallSet);
+        String<double> distanceMatrix;
+        getDistanceMatrix(g, distanceMatrix, KmerDistance());
+        TTree upgma;
+        upgmaTree(distanceMatrix, upgma, UpgmaWeightAvg());
+
+        SEQAN_ASSERT_EQ(numVertices(mbed), numVertices(upgma));
+        SEQAN_ASSERT_EQ(getRoot(mbed), getRoot(upgma));
+        SEQAN_ASSERT(testMbedGuideTreeClusters(mbed) == testMbedGuideTreeClusters(upgma));
+    }
+
+    // Larger sets are clustered, the tree is a binary tree with the sequences as leaves
+    TTree mbed;
+    mbedTree(seqs, mbed);
+    unsigned n = length(seqs);
+    SEQAN_ASSERT_EQ(numVertices(mbed), 2 * n - 1);
+    String<unsigned> leafCount;
+    resize(leafCount, 2 * n - 1, 0);
+    for (TBfsIterator it(mbed, getRoot(mbed)); !atEnd(it); goNext(it))
+    {
+        TVertexDescriptor v = *it;
+        if (isLeaf(mbed, v))
+        {
+            SEQAN_ASSERT_LT(v, n);
+            ++leafCount[v];
+        }
+        else
+        {
+            SEQAN_ASSERT_GEQ(v, n);
+            SEQAN_ASSERT_EQ(outDegree(mbed, v), 2u);
+        }
+    }
+    for (unsigned i = 0; i < n; ++i)
+        SEQAN_ASSERT_EQ(leafCount[i], 1u);
+
+    // Few and empty sequences
+    StringSet<DnaString> tiny;
+    appendValue(tiny, "ACGTACGT");
+    mbedTree(tiny, mbed);
+    SEQAN_ASSERT_EQ(numVertices(mbed), 1u);
+    SEQAN_ASSERT_EQ(getRoot(mbed), 0u);
+    appendValue(tiny, "");
+    appendValue(tiny, "AC");
+    mbedTree(tiny, mbed);
+    SEQAN_ASSERT_EQ(numVertices(mbed), 5u);
+}
+
 SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_neighbour_joining)
 {
     Test_GuideTree_NeighbourJoining();
@@ -203,4 +317,9 @@ SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_upgma_max)
         Test_UpgmaGuideTree<seqan::UpgmaMax>(i);
 }
 
+SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_mbed)
+{
+    Test_MbedGuideTree();
+}
+
 #endif  // #ifndef TESTS_TEST_GRAPH_MSA_GUIDE_TREE_H_
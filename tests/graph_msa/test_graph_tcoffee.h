@@ -439,6 +439,75 @@ void Test_Progressive() {
 }
 
 
+void Test_ParallelMsa() {
+    typedef String<AminoAcid> TSequence;
+    typedef StringSet<TSequence, Owner<> > TSequenceSet;
+    typedef StringSet<TSequence, Dependent<> > TDependentSequenceSet;
+    typedef Graph<Alignment<TDependentSequenceSet, void, WithoutEdgeId> > TGraph;
+
+    TSequenceSet seqSet;
+    appendValue(seqSet, "GARFIELDTHELASTFATCAT");
+    appendValue(seqSet, "GARFIELDTHEFASTCAT");
+    appendValue(seqSet, "GARFIELDTHEVERYFASTCAT");
+    appendValue(seqSet, "THEFATCAT");
+    appendValue(seqSet, "GARFIELDTHELASTFATMOUSE");
+    appendValue(seqSet, "GARFIELDTHEFASTMOUSE");
+    appendValue(seqSet, "GARFIELDTHEVERYFASTMOUSE");
+    appendValue(seqSet, "THEFATMOUSE");
+    appendValue(seqSet, "ODIETHEDOG");
+    appendValue(seqSet, "ODIETHEFASTDOG");
+    StringSet<String<char> > nameSet;
+    for (unsigned i = 0; i < length(seqSet); ++i)
+        appendValue(nameSet, "seq");
+
+    // The libraries are identical
+    Blosum62 score_type(-1,-11);
+    String<unsigned int> pList;
+    selectPairs(seqSet, pList);
+    {
+        String<Fragment<> > matches, parMatches;
+        String<int> scores, parScores;
+        String<double> distanceMatrix, parDistanceMatrix;
+        TDependentSequenceSet depSet(seqSet);
+        appendSegmentMatches(depSet, pList, score_type, matches, scores, distanceMatrix, GlobalPairwiseLibrary());
+        appendSegmentMatches(depSet, pList, score_type, parMatches, parScores, parDistanceMatrix, GlobalPairwiseLibrary(), Parallel());
+        appendSegmentMatches(depSet, pList, score_type, matches, scores, LocalPairwiseLibrary());
+        appendSegmentMatches(depSet, pList, score_type, parMatches, parScores, LocalPairwiseLibrary(), Parallel());
+        appendSegmentMatches(depSet, pList, matches, scores, LcsLibrary());
+        appendSegmentMatches(depSet, pList, parMatches, parScores, LcsLibrary(), Parallel());
+
+        SEQAN_ASSERT_EQ(length(matches), length(parMatches));
+        for (unsigned i = 0; i < length(matches); ++i)
+        {
+            SEQAN_ASSERT_EQ(matches[i].seqId1, parMatches[i].seqId1);
+            SEQAN_ASSERT_EQ(matches[i].begin1, parMatches[i].begin1);
+            SEQAN_ASSERT_EQ(matches[i].seqId2, parMatches[i].seqId2);
+            SEQAN_ASSERT_EQ(matches[i].begin2, parMatches[i].begin2);
+            SEQAN_ASSERT_EQ(matches[i].len, parMatches[i].len);
+        }
+        SEQAN_ASSERT(scores == parScores);
+        SEQAN_ASSERT(distanceMatrix == parDistanceMatrix);
+    }
+
+    // The alignments are identical
+    MsaOptions<AminoAcid, Blosum62> msaOpt;
+    msaOpt.sc = score_type;
+    appendValue(msaOpt.method, 0);
+    appendValue(msaOpt.method, 1);
+    for (msaOpt.build = 0; msaOpt.build < 6; ++msaOpt.build)
+    {
+        TGraph gAlign, parGAlign;
+        globalMsaAlignment(gAlign, seqSet, nameSet, msaOpt);
+        globalMsaAlignment(parGAlign, seqSet, nameSet, msaOpt, Parallel());
+
+        std::stringstream out, parOut;
+        write(out, gAlign, nameSet, FastaFormat());
+        write(parOut, parGAlign, nameSet, FastaFormat());
+        SEQAN_ASSERT_EQ(out.str(), parOut.str());
+    }
+}
+
+
 void Test_ReversableFragments() {
     typedef unsigned int TSize;
     typedef String<Dna> TSequence;
@@ -491,6 +560,10 @@ SEQAN_DEFINE_TEST(test_progressive)
 {
     Test_Progressive();
 }
+SEQAN_DEFINE_TEST(test_parallel_msa)
+{
+    Test_ParallelMsa();
+}
 SEQAN_DEFINE_TEST(test_reversable_fragments)
 {
     Test_ReversableFragments();
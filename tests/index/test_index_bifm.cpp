@@ -0,0 +1,477 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+
+#include <seqan/basic.h>
+#include <seqan/index.h>
+#include <seqan/parallel.h>
+
+#include "test_index_helpers.h"
+
+using namespace seqan;
+
+// ==========================================================================
+// Types
+// ==========================================================================
+
+template <typename TSpec = void, typename TLengthSum = size_t>
+struct SmallLVFMIndexConfig : FMIndexConfig<TSpec, TLengthSum>
+{
+    typedef TLengthSum                                  LengthSum;
+    typedef Levels<TSpec, LevelsRDConfig<LengthSum> >   Bwt;
+    typedef Naive<TSpec, RDConfig<LengthSum> >          Sentinels;
+};
+
+typedef FMIndex<void, SmallLVFMIndexConfig<> >  SmallLVFMIndex;
+
+typedef
+    TagList<Index<DnaString, BidirectionalIndex<> >,
+    TagList<Index<StringSet<DnaString>, BidirectionalIndex<> >,
+    TagList<Index<StringSet<DnaString>, BidirectionalIndex<SmallLVFMIndex> >,
+    TagList<Index<Dna5String, BidirectionalIndex<> >,
+    TagList<Index<StringSet<Dna5String>, BidirectionalIndex<> >
+    > > > > >
+    BidirectionalIndexTypes;
+
+// ==========================================================================
+// Test Classes
+// ==========================================================================
+
+template <typename TIndex_>
+class BidirectionalIndexTest : public Test
+{
+public:
+    typedef TIndex_                                 TIndex;
+    typedef typename Fibre<TIndex, FibreText>::Type TText;
+    typedef typename Value<typename Concatenator<TText>::Type>::Type TAlphabet;
+    typedef String<TAlphabet>                       TString;
+    typedef typename SAValue<TIndex>::Type          TSAValue;
+    typedef Pair<TSAValue, unsigned>                TOcc;
+
+    TText       text;
+    TIndex      index;
+    Rng<MersenneTwister> rng;
+
+    BidirectionalIndexTest() : rng(42) {}
+
+    void setUp()
+    {
+        _generate(text);
+        index = TIndex(text);
+        indexCreate(index);
+    }
+
+    void _generate(TString & str)
+    {
+        generateText(str, 3000u);
+    }
+
+    void _generate(StringSet<TString> & set)
+    {
+        generateText(set, 30u, 200u);
+    }
+};
+
+SEQAN_TYPED_TEST_CASE(BidirectionalIndexTest, BidirectionalIndexTypes);
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+template <typename TSeq>
+inline TSeq const & _textSeq(TSeq const & text, unsigned)
+{
+    return text;
+}
+
+template <typename TSeq, typename TSpec>
+inline TSeq const & _textSeq(StringSet<TSeq, TSpec> const & text, unsigned seqNo)
+{
+    return text[seqNo];
+}
+
+template <typename TSAValue>
+inline void _setOcc(TSAValue & pos, unsigned, unsigned offset)
+{
+    pos = offset;
+}
+
+template <typename T1, typename T2, typename TPack>
+inline void _setOcc(Pair<T1, T2, TPack> & pos, unsigned seqNo, unsigned offset)
+{
+    pos = Pair<T1, T2, TPack>(seqNo, offset);
+}
+
+template <typename TSeq1, typename TSeq2>
+inline unsigned _editDistance(TSeq1 const & a, TSeq2 const & b)
+{
+    String<unsigned> col;
+    resize(col, length(b) + 1);
+    for (unsigned j = 0; j <= length(b); ++j)
+        col[j] = j;
+
+    for (unsigned i = 1; i <= length(a); ++i)
+    {
+        unsigned diag = col[0];
+        col[0] = i;
+        for (unsigned j = 1; j <= length(b); ++j)
+        {
+            unsigned up = col[j];
+            col[j] = _min(_min(col[j] + 1, col[j - 1] + 1), diag + (a[i - 1] == b[j - 1] ? 0u : 1u));
+            diag = up;
+        }
+    }
+    return col[length(b)];
+}
+
+// Draws a needle from the text and applies up to maxErrors random edits.
+template <typename TNeedle, typename TText, typename TRng>
+inline void _randomNeedle(TNeedle & needle, TText const & text, TRng & rng, unsigned needleLength, unsigned edits,
+                          bool indels)
+{
+    typedef typename Value<TNeedle>::Type TValue;
+
+    unsigned seqNo;
+    do
+        seqNo = pickRandomNumber(rng) % countSequences(text);
+    while (length(_textSeq(text, seqNo)) < needleLength);
+
+    unsigned pos = pickRandomNumber(rng) % (length(_textSeq(text, seqNo)) - needleLength + 1);
+    needle = infix(_textSeq(text, seqNo), pos, pos + needleLength);
+
+    for (unsigned e = 0; e < edits; ++e)
+    {
+        unsigned i = pickRandomNumber(rng) % length(needle);
+        unsigned op = indels ? pickRandomNumber(rng) % 3 : 0;
+        if (op == 0)
+            needle[i] = TValue(pickRandomNumber(rng) % ValueSize<TValue>::VALUE);
+        else if (op == 1)
+            erase(needle, i);
+        else
+            insertValue(needle, i, TValue(pickRandomNumber(rng) % ValueSize<TValue>::VALUE));
+    }
+}
+
+template <typename TOccs>
+struct CollectOccurrences_
+{
+    TOccs & occs;
+
+    CollectOccurrences_(TOccs & occs) : occs(occs) {}
+
+    template <typename TIter, typename TNeedle>
+    void operator()(TIter const & it, TNeedle const &, unsigned errors)
+    {
+        typedef typename Value<TOccs>::Type TOcc;
+
+        for (unsigned i = 0; i < countOccurrences(it); ++i)
+        {
+            TOcc occ;
+            occ.i1 = getOccurrences(it)[i];
+            occ.i2 = errors;
+            occ.i3 = repLength(it);
+            SEQAN_OMP_PRAGMA(critical (collect_occurrences))
+            appendValue(occs, occ);
+        }
+    }
+};
+
+template <typename TOccs>
+struct CollectNeedleOccurrences_
+{
+    TOccs & occs;
+
+    CollectNeedleOccurrences_(TOccs & occs) : occs(occs) {}
+
+    template <typename TIter, typename TNeedleId>
+    void operator()(TIter const & it, TNeedleId needleId, unsigned errors)
+    {
+        typedef typename Value<TOccs>::Type TOcc;
+
+        for (unsigned i = 0; i < countOccurrences(it); ++i)
+        {
+            TOcc occ(getOccurrences(it)[i], errors, needleId);
+            SEQAN_OMP_PRAGMA(critical (collect_occurrences))
+            appendValue(occs, occ);
+        }
+    }
+};
+
+template <typename TFixture, unsigned minErrors, unsigned maxErrors>
+inline void _testFindHamming(TFixture & fixture)
+{
+    typedef typename TFixture::TSAValue                 TSAValue;
+    typedef Pair<TSAValue, unsigned>                    TOcc;
+    typedef Triple<TSAValue, unsigned, unsigned>        TOccLen;
+
+    for (unsigned trial = 0; trial < 20; ++trial)
+    {
+        typename TFixture::TString needle;
+        _randomNeedle(needle, fixture.text, fixture.rng, 5 + trial, trial % (maxErrors + 1), false);
+
+        String<TOcc> expected;
+        for (unsigned seqNo = 0; seqNo < countSequences(fixture.text); ++seqNo)
+        {
+            typename TFixture::TString const & seq = _textSeq(fixture.text, seqNo);
+            for (unsigned pos = 0; pos + length(needle) <= length(seq); ++pos)
+            {
+                unsigned errors = 0;
+                for (unsigned i = 0; i < length(needle); ++i)
+                    errors += seq[pos + i] != needle[i];
+                if (errors >= minErrors && errors <= maxErrors)
+                {
+                    TOcc occ;
+                    _setOcc(occ.i1, seqNo, pos);
+                    occ.i2 = errors;
+                    appendValue(expected, occ);
+                }
+            }
+        }
+
+        String<TOccLen> found;
+        CollectOccurrences_<String<TOccLen> > delegate(found);
+        find<minErrors, maxErrors>(delegate, fixture.index, needle, HammingDistance());
+
+        String<TOcc> actual;
+        for (unsigned i = 0; i < length(found); ++i)
+        {
+            SEQAN_ASSERT_EQ(found[i].i3, length(needle));
+            appendValue(actual, TOcc(found[i].i1, found[i].i2));
+        }
+
+        std::sort(begin(expected, Standard()), end(expected, Standard()));
+        std::sort(begin(actual, Standard()), end(actual, Standard()));
+        SEQAN_ASSERT(actual == expected);
+    }
+}
+
+template <typename TFixture, unsigned maxErrors>
+inline void _testFindEdit(TFixture & fixture)
+{
+    typedef typename TFixture::TSAValue                 TSAValue;
+    typedef Triple<TSAValue, unsigned, unsigned>        TOccLen;
+
+    for (unsigned trial = 0; trial < 10; ++trial)
+    {
+        typename TFixture::TString needle;
+        _randomNeedle(needle, fixture.text, fixture.rng, 8 + trial, trial % (maxErrors + 1), true);
+
+        String<TOccLen> found;
+        CollectOccurrences_<String<TOccLen> > delegate(found);
+        find<0, maxErrors>(delegate, fixture.index, needle, EditDistance());
+
+        // Every reported occurrence is a real one.
+        for (unsigned i = 0; i < length(found); ++i)
+        {
+            unsigned seqNo = getSeqNo(found[i].i1);
+            unsigned pos = getSeqOffset(found[i].i1);
+            typename TFixture::TString const & seq = _textSeq(fixture.text, seqNo);
+            SEQAN_ASSERT_LEQ(pos + found[i].i3, length(seq));
+            SEQAN_ASSERT_LEQ(_editDistance(infix(seq, pos, pos + found[i].i3), needle), found[i].i2);
+            SEQAN_ASSERT_LEQ(found[i].i2, maxErrors);
+        }
+
+        // Every occurrence contains a reported one.
+        for (unsigned seqNo = 0; seqNo < countSequences(fixture.text); ++seqNo)
+        {
+            typename TFixture::TString const & seq = _textSeq(fixture.text, seqNo);
+            for (unsigned pos = 0; pos < length(seq); ++pos)
+            {
+                for (unsigned len = (length(needle) > maxErrors) ? length(needle) - maxErrors : 0;
+                     len <= length(needle) + maxErrors && pos + len <= length(seq); ++len)
+                {
+                    if (_editDistance(infix(seq, pos, pos + len), needle) > maxErrors)
+                        continue;
+
+                    bool contained = false;
+                    for (unsigned i = 0; i < length(found) && !contained; ++i)
+                        contained = getSeqNo(found[i].i1) == seqNo &&
+                                    getSeqOffset(found[i].i1) >= pos &&
+                                    getSeqOffset(found[i].i1) + found[i].i3 <= pos + len;
+                    SEQAN_ASSERT(contained);
+                }
+            }
+        }
+    }
+}
+
+// ==========================================================================
+// Tests
+// ==========================================================================
+
+// --------------------------------------------------------------------------
+// Test goDown()
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, GoDown)
+{
+    typedef typename TestFixture::TIndex                            TIndex;
+    typedef typename Iterator<TIndex, TopDown<> >::Type             TIter;
+    typedef typename Iterator<TIndex, TopDown<ParentLinks<> > >::Type   TParentLinksIter;
+    typedef typename TestFixture::TSAValue                          TSAValue;
+
+    for (unsigned trial = 0; trial < 200; ++trial)
+    {
+        typename TestFixture::TString substring;
+        _randomNeedle(substring, this->text, this->rng, 1 + trial % 12, 0, false);
+
+        // Grow the substring from a random position by random left and right extensions.
+        TIter it(this->index);
+        TParentLinksIter parentIt(this->index);
+        unsigned left = pickRandomNumber(this->rng) % length(substring);
+        unsigned right = left;
+        while (right - left < length(substring))
+        {
+            bool goRight = left == 0 || (right < length(substring) && pickRandomNumber(this->rng) % 2);
+            if (goRight)
+            {
+                SEQAN_ASSERT(goDown(it, substring[right], Fwd()));
+                SEQAN_ASSERT(goDown(parentIt, substring[right], Fwd()));
+                SEQAN_ASSERT_EQ(parentEdgeLabel(it, Fwd()), substring[right]);
+                ++right;
+            }
+            else
+            {
+                SEQAN_ASSERT(goDown(it, substring[left - 1], Rev()));
+                SEQAN_ASSERT(goDown(parentIt, substring[left - 1], Rev()));
+                SEQAN_ASSERT_EQ(parentEdgeLabel(it, Rev()), substring[left - 1]);
+                --left;
+            }
+            SEQAN_ASSERT_EQ(repLength(it), right - left);
+            SEQAN_ASSERT_EQ(countOccurrences(it.fwdIter), countOccurrences(it.revIter));
+        }
+
+        String<TSAValue> expected;
+        for (unsigned seqNo = 0; seqNo < countSequences(this->text); ++seqNo)
+        {
+            typename TestFixture::TString const & seq = _textSeq(this->text, seqNo);
+            for (unsigned pos = 0; pos + length(substring) <= length(seq); ++pos)
+                if (infix(seq, pos, pos + length(substring)) == substring)
+                {
+                    TSAValue occ;
+                    _setOcc(occ, seqNo, pos);
+                    appendValue(expected, occ);
+                }
+        }
+
+        String<TSAValue> actual;
+        for (unsigned i = 0; i < countOccurrences(it); ++i)
+            appendValue(actual, getOccurrences(it)[i]);
+        std::sort(begin(expected, Standard()), end(expected, Standard()));
+        std::sort(begin(actual, Standard()), end(actual, Standard()));
+        SEQAN_ASSERT(actual == expected);
+
+        // The string overloads read the string from left to right in both directions.
+        TIter fwdIt(this->index);
+        TIter revIt(this->index);
+        SEQAN_ASSERT(goDown(fwdIt, substring, Fwd()));
+        SEQAN_ASSERT(goDown(revIt, substring, Rev()));
+        SEQAN_ASSERT_EQ(countOccurrences(fwdIt), length(expected));
+        SEQAN_ASSERT_EQ(countOccurrences(revIt), length(expected));
+
+        // Going up restores both ranges.
+        while (!isRoot(parentIt))
+            SEQAN_ASSERT(goUp(parentIt));
+        SEQAN_ASSERT_EQ(repLength(parentIt), 0u);
+        SEQAN_ASSERT_EQ(countOccurrences(parentIt.fwdIter), countOccurrences(parentIt.revIter));
+    }
+}
+
+// --------------------------------------------------------------------------
+// Test find() with Hamming distance
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, FindHamming)
+{
+    _testFindHamming<TestFixture, 0, 0>(*this);
+    _testFindHamming<TestFixture, 0, 1>(*this);
+    _testFindHamming<TestFixture, 0, 2>(*this);
+    _testFindHamming<TestFixture, 0, 3>(*this);
+    _testFindHamming<TestFixture, 1, 2>(*this);
+    _testFindHamming<TestFixture, 3, 3>(*this);
+}
+
+// --------------------------------------------------------------------------
+// Test find() with edit distance
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, FindEdit)
+{
+    _testFindEdit<TestFixture, 0>(*this);
+    _testFindEdit<TestFixture, 1>(*this);
+    _testFindEdit<TestFixture, 2>(*this);
+}
+
+// --------------------------------------------------------------------------
+// Test find() with multiple needles
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(BidirectionalIndexTest, FindParallel)
+{
+    typedef typename TestFixture::TSAValue                  TSAValue;
+    typedef Triple<TSAValue, unsigned, unsigned>            TOccLen;
+
+    StringSet<typename TestFixture::TString> needles;
+    resize(needles, 50);
+    for (unsigned i = 0; i < length(needles); ++i)
+        _randomNeedle(needles[i], this->text, this->rng, 15, i % 3, false);
+
+    String<TOccLen> serial;
+    for (unsigned i = 0; i < length(needles); ++i)
+    {
+        String<TOccLen> found;
+        CollectOccurrences_<String<TOccLen> > delegate(found);
+        find<0, 2>(delegate, this->index, needles[i], HammingDistance());
+        for (unsigned j = 0; j < length(found); ++j)
+            appendValue(serial, TOccLen(found[j].i1, found[j].i2, i));
+    }
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    // The delegate receives the needle id in place of the needle.
+    String<TOccLen> parallel;
+    CollectNeedleOccurrences_<String<TOccLen> > delegate(parallel);
+    find<0, 2>(delegate, this->index, needles, HammingDistance(), Parallel());
+
+    std::sort(begin(serial, Standard()), end(serial, Standard()));
+    std::sort(begin(parallel, Standard()), end(parallel, Standard()));
+    SEQAN_ASSERT(parallel == serial);
+}
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+int main(int argc, char const ** argv)
+{
+    TestSystem::init(argc, argv);
+    return TestSystem::runAll();
+}
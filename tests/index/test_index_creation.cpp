@@ -43,6 +43,7 @@
 #include <seqan/seq_io.h>
 #include <seqan/index.h>
 #include <seqan/pipe.h>
+#include <seqan/random.h>
 
 #include "test_index_helpers.h"
 #include "test_index_creation.h"
@@ -57,6 +58,7 @@ SEQAN_BEGIN_TESTSUITE(test_index)
     SEQAN_CALL_TEST(testIndexModifiedStringViewEsa);
     SEQAN_CALL_TEST(testIndexModifiedStringViewFM);
     SEQAN_CALL_TEST(testIssue519);
+    SEQAN_CALL_TEST(testIndexCreationSais);
     SEQAN_CALL_TEST(testIndexCreation);
 }
 SEQAN_END_TESTSUITE
@@ -126,6 +126,80 @@ SEQAN_DEFINE_TEST(testIssue519)
 //                  << suffix(getValue(strSet, getSeqNo(*iterSet)), getSeqOffset(*iterSet)) << std::endl;
 }
 
+template <typename TText, typename TAlgTag>
+void testIndexCreationSaisCompare(TText const & text, TAlgTag const & algTag)
+{
+    typedef Index<TText, IndexEsa<> > TIndex;
+
+    TIndex index1(text);
+    TIndex index2(text);
+
+    indexCreate(index1, EsaSA(), SAQSort());
+    indexCreate(index2, EsaSA(), algTag);
+
+    SEQAN_ASSERT_EQ(indexSA(index1), indexSA(index2));
+}
+
+SEQAN_DEFINE_TEST(testIndexCreationSais)
+{
+    // Repetitive texts have deep recursions and long runs of equal characters.
+    DnaString text;
+    for (unsigned i = 0; i < 1000; ++i)
+        appendValue(text, (i % 7 == 0) ? 'C' : 'A');
+    testIndexCreationSaisCompare(text, Sais());
+    testIndexCreationSaisCompare(text, ParallelSais());
+
+    resize(text, 300, Dna('G'));
+    testIndexCreationSaisCompare(text, Sais());
+    testIndexCreationSaisCompare(text, ParallelSais());
+
+    CharString chars = "mississippi";
+    testIndexCreationSaisCompare(chars, Sais());
+    testIndexCreationSaisCompare(chars, ParallelSais());
+
+    // Equal suffixes of different sequences and empty sequences.
+    StringSet<CharString> strSet;
+    appendValue(strSet, "bananamama");
+    appendValue(strSet, "bananajoe");
+    appendValue(strSet, "");
+    appendValue(strSet, "joesmama");
+    appendValue(strSet, "mama");
+    testIndexCreationSaisCompare(strSet, Sais());
+    testIndexCreationSaisCompare(strSet, ParallelSais());
+
+    Rng<MersenneTwister> rng(42);
+    StringSet<DnaString> dnaSet;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        DnaString seq;
+        unsigned len = pickRandomNumber(rng, Pdf<Uniform<int> >(0, 200));
+        for (unsigned j = 0; j < len; ++j)
+            appendValue(seq, Dna(pickRandomNumber(rng, Pdf<Uniform<int> >(0, 1))));
+        appendValue(dnaSet, seq);
+    }
+    testIndexCreationSaisCompare(dnaSet, Sais());
+    testIndexCreationSaisCompare(dnaSet, ParallelSais());
+
+    // A larger text with repeats spanning the blocks of the parallel scans.
+    CharString longText;
+    for (unsigned i = 0; i < 20000; ++i)
+        appendValue(longText, (char)('a' + pickRandomNumber(rng, Pdf<Uniform<int> >(0, 3))));
+    append(longText, prefix(longText, 5000));
+    resize(longText, length(longText) + 3000, 'z');
+    append(longText, prefix(longText, 10000));
+
+    String<unsigned> sa;
+    resize(sa, length(longText));
+    createSuffixArray(sa, longText, Sais());
+    SEQAN_ASSERT(isSuffixArray(sa, longText));
+    blank(sa);
+    {
+        ClassTest::ScopedNumThreads numThreads(2);
+        createSuffixArray(sa, longText, ParallelSais());
+    }
+    SEQAN_ASSERT(isSuffixArray(sa, longText));
+}
+
 SEQAN_DEFINE_TEST(testIndexCreation)
 {
     typedef String<char>        TText;
@@ -181,6 +255,18 @@ SEQAN_DEFINE_TEST(testIndexCreation)
         std::cout << "suffix array creation (internal SAQSort) failed." << std::endl;
     }
 
+    blank(sa);
+    createSuffixArray(sa, text, Sais());
+    if (!isSuffixArray(sa, text)) {
+        std::cout << "suffix array creation (internal Sais) failed." << std::endl;
+    }
+
+    blank(sa);
+    createSuffixArray(sa, text, ParallelSais());
+    if (!isSuffixArray(sa, text)) {
+        std::cout << "suffix array creation (internal ParallelSais) failed." << std::endl;
+    }
+
 //    blank(sa);
 //    createSuffixArray(sa, text, QSQGSR(), 3);
 //    if (!isSuffixArray(sa, text)) {
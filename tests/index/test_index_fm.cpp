@@ -65,6 +65,41 @@ struct SmallLVFMIndexConfig : FMIndexConfig<TSpec, TLengthSum>
     typedef Naive<TSpec, RDConfig<LengthSum> >          Sentinels;
 };
 
+template <typename TSpec = void, typename TLengthSum = size_t>
+struct SmallEPRFMIndexConfig : FMIndexConfig<TSpec, TLengthSum>
+{
+    typedef TLengthSum                                  LengthSum;
+    typedef EPR<TSpec, RDConfig<LengthSum> >            Bwt;
+    typedef Naive<TSpec, RDConfig<LengthSum> >          Sentinels;
+};
+
+// A config written before KMER_LENGTH existed, which does not derive from FMIndexConfig.
+template <typename TSpec = void, typename TLengthSum = size_t>
+struct PlainFMIndexConfig
+{
+    typedef TLengthSum                                  LengthSum;
+    typedef Levels<TSpec, LevelsRDConfig<LengthSum> >   Bwt;
+    typedef Naive<TSpec, RDConfig<LengthSum> >          Sentinels;
+
+    static const unsigned SAMPLING =                    10;
+};
+
+template <typename TSpec = void, typename TLengthSum = size_t>
+struct KmerFMIndexConfig : SmallLVFMIndexConfig<TSpec, TLengthSum>
+{
+    static const unsigned KMER_LENGTH = 4;
+};
+
+template <typename TSpec = void, typename TLengthSum = size_t>
+struct MMapFMIndexConfig : FMIndexConfig<TSpec, TLengthSum>
+{
+    typedef TLengthSum                                          LengthSum;
+    typedef Levels<TSpec, LevelsRDConfig<LengthSum, MMap<> > >  Bwt;
+    typedef Naive<TSpec, RDConfig<LengthSum, MMap<> > >         Sentinels;
+
+    static const unsigned KMER_LENGTH = 4;
+};
+
 // --------------------------------------------------------------------------
 // FMIndex Specs
 // --------------------------------------------------------------------------
@@ -72,6 +107,10 @@ struct SmallLVFMIndexConfig : FMIndexConfig<TSpec, TLengthSum>
 typedef FMIndex<void, WTFMIndexConfig<> >       WTFMIndex;
 typedef FMIndex<void, SmallWTFMIndexConfig<> >  SmallWTFMIndex;
 typedef FMIndex<void, SmallLVFMIndexConfig<> >  SmallLVFMIndex;
+typedef FMIndex<void, SmallEPRFMIndexConfig<> > SmallEPRFMIndex;
+typedef FMIndex<void, PlainFMIndexConfig<> >    PlainFMIndex;
+typedef FMIndex<void, KmerFMIndexConfig<> >     KmerFMIndex;
+typedef FMIndex<void, MMapFMIndexConfig<> >     MMapFMIndex;
 
 // --------------------------------------------------------------------------
 // FMIndex Types
@@ -82,8 +121,11 @@ typedef
     TagList<Index<CharString, WTFMIndex>,
     TagList<Index<StringSet<CharString>, WTFMIndex>,
     TagList<Index<StringSet<CharString>, SmallWTFMIndex>,
-    TagList<Index<StringSet<DnaString>, SmallLVFMIndex>
-    > > > > >
+    TagList<Index<StringSet<DnaString>, SmallLVFMIndex>,
+    TagList<Index<StringSet<DnaString>, SmallEPRFMIndex>,
+    TagList<Index<StringSet<DnaString>, KmerFMIndex>,
+    TagList<Index<StringSet<DnaString>, PlainFMIndex>
+    > > > > > > > >
     FMIndexTypes2;
 
 // ========================================================================== 
@@ -108,6 +150,15 @@ class CSATest : public FibreTest<TFMIndex, FibreSA> {};
 
 SEQAN_TYPED_TEST_CASE(CSATest, FMIndexTypes2);
 
+// --------------------------------------------------------------------------
+// Class FMIndexFindTest
+// --------------------------------------------------------------------------
+
+template <typename TFMIndex>
+class FMIndexFindTest : public IndexTest<TFMIndex> {};
+
+SEQAN_TYPED_TEST_CASE(FMIndexFindTest, FMIndexTypes2);
+
 // ==========================================================================
 // LFTable Tests
 // ========================================================================== 
@@ -151,6 +202,39 @@ SEQAN_TYPED_TEST(LFTest, IsSentinel)
     SEQAN_ASSERT_EQ(sentinels, countSequences(this->text));
 }
 
+// --------------------------------------------------------------------------
+// Test createLF(Parallel)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(LFTest, CreateLFParallel)
+{
+    typedef typename TestFixture::TIndex                        TIndex;
+    typedef typename TestFixture::TFibre                        TLF;
+    typedef typename Value<TLF>::Type                           TValue;
+    typedef typename Size<TLF>::Type                            TSize;
+    typedef String<typename SAValue<TIndex>::Type>              TSA;
+
+    // An External suffix array is scanned serially, so the SA is kept in main memory.
+    TSA sa;
+    resize(sa, lengthSum(this->text), Exact());
+    createSuffixArray(sa, this->text, Skew7());
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    TLF lf;
+    createLF(lf, this->text, sa, Parallel());
+
+    SEQAN_ASSERT_EQ(lf.sums, this->fibre.sums);
+    SEQAN_ASSERT_EQ(lf.sentinelSubstitute, this->fibre.sentinelSubstitute);
+
+    for (TSize pos = 0; pos < bwtLength(this->text); ++pos)
+    {
+        SEQAN_ASSERT_EQ(isSentinel(lf, pos), isSentinel(this->fibre, pos));
+        for (TSize c = 0; c < ValueSize<TValue>::VALUE; ++c)
+            SEQAN_ASSERT_EQ(lf(pos, TValue(c)), this->fibre(pos, TValue(c)));
+    }
+}
+
 // ==========================================================================
 // CompressedSA Tests
 // ==========================================================================
@@ -170,6 +254,32 @@ SEQAN_TYPED_TEST(CSATest, IndexSA)
 //    SEQAN_ASSERT(isSuffixArray(this->fibre, this->text));
 }
 
+// --------------------------------------------------------------------------
+// Test indexCreate(Parallel)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(CSATest, IndexCreateParallel)
+{
+    typedef typename TestFixture::TIndex                            TIndex;
+    typedef typename TestFixture::TFibre                            TSA;
+    typedef typename Size<TSA>::Type                                TSize;
+    typedef typename Fibre<TSA, FibreSparseString>::Type            TSparseSA;
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    TIndex index(this->text);
+    indexCreate(index, FibreSALF(), Parallel());
+
+    TSparseSA & serialSparseSA = getFibre(this->fibre, FibreSparseString());
+    TSparseSA & parallelSparseSA = getFibre(indexSA(index), FibreSparseString());
+
+    SEQAN_ASSERT_EQ(length(indexSA(index)), length(this->fibre));
+    SEQAN_ASSERT(getFibre(parallelSparseSA, FibreValues()) == getFibre(serialSparseSA, FibreValues()));
+    for (TSize pos = 0; pos < length(this->fibre); ++pos)
+        SEQAN_ASSERT_EQ(getValue(getFibre(parallelSparseSA, FibreIndicators()), pos),
+                        getValue(getFibre(serialSparseSA, FibreIndicators()), pos));
+}
+
 // --------------------------------------------------------------------------
 // Test getValue()
 // --------------------------------------------------------------------------
@@ -193,6 +303,295 @@ SEQAN_TYPED_TEST(CSATest, BeginEnd)
     SEQAN_ASSERT_EQ(position(itEnd), static_cast<TPos>(length(this->fibre)));
 }
 
+// ==========================================================================
+// Find Tests
+// ==========================================================================
+
+// --------------------------------------------------------------------------
+// Test find(Backtracking<Exact>, Parallel)
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(FMIndexFindTest, FindBatch)
+{
+    typedef typename TestFixture::TIndex                            TIndex;
+    typedef typename TestFixture::TValue                            TValue;
+    typedef typename Iterator<TIndex, TopDown<> >::Type             TIndexIt;
+    typedef typename Size<TIndex>::Type                             TSize;
+    typedef Pair<TSize>                                             TRange;
+    typedef StringSet<String<TValue> >                              TNeedles;
+    typedef typename Iterator<TNeedles const, Rooted>::Type         TNeedlesIt;
+
+    TIndex index(this->text);
+    indexCreate(index, FibreSALF());
+
+    // Take substrings of the text and random strings, including empty ones.
+    TNeedles needles;
+    Rng<MersenneTwister> rng(42);
+    for (unsigned i = 0; i < 3000; ++i)
+    {
+        unsigned needleLength = pickRandomNumber(rng) % 12;
+        String<TValue> needle;
+        if (i % 2)
+        {
+            for (unsigned j = 0; j < needleLength; ++j)
+                appendValue(needle, TValue(pickRandomNumber(rng) % ValueSize<TValue>::VALUE));
+        }
+        else
+        {
+            unsigned beginPos = pickRandomNumber(rng) % (lengthSum(this->text) - needleLength);
+            needle = infix(concat(this->text), beginPos, beginPos + needleLength);
+        }
+        appendValue(needles, needle);
+    }
+
+    // Search each needle on its own.
+    String<TRange> ranges;
+    resize(ranges, length(needles), TRange(0, 0));
+    for (unsigned needleId = 0; needleId < length(needles); ++needleId)
+    {
+        TIndexIt it(index);
+        if (goDown(it, needles[needleId]))
+            ranges[needleId] = value(it).range;
+    }
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    String<TRange> batchRanges;
+    resize(batchRanges, length(needles), TRange(0, 0));
+    find(index, needles, 0u, [&](TIndexIt & it, TNeedlesIt const & needlesIt, unsigned errors)
+    {
+        SEQAN_ASSERT_EQ(errors, 0u);
+        SEQAN_ASSERT_EQ(repLength(it), length(value(needlesIt)));
+        batchRanges[position(needlesIt)] = value(it).range;
+    },
+    Backtracking<Exact>(), Parallel());
+
+    SEQAN_ASSERT(batchRanges == ranges);
+}
+
+// --------------------------------------------------------------------------
+// Test find(Backtracking<Exact>, Serial) reports the needles in order
+// --------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(FMIndexFindTest, FindBatchOrder)
+{
+    typedef typename TestFixture::TIndex                            TIndex;
+    typedef typename TestFixture::TValue                            TValue;
+    typedef typename Iterator<TIndex, TopDown<> >::Type             TIndexIt;
+    typedef StringSet<String<TValue> >                              TNeedles;
+    typedef typename Iterator<TNeedles const, Rooted>::Type         TNeedlesIt;
+    typedef typename Position<TNeedles>::Type                       TNeedleId;
+
+    TIndex index(this->text);
+    indexCreate(index, FibreSALF());
+
+    // Take prefixes of the text of mixed lengths, so that short needles finish before longer ones.
+    // The FM index is searched backwards, hence the needles are reversed.
+    static const unsigned needleLengths[] = { 40, 5, 20, 0, 12, 4, 33, 1 };
+    TNeedles needles;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        String<TValue> needle = prefix(concat(this->text), needleLengths[i % 8]);
+        reverse(needle);
+        appendValue(needles, needle);
+    }
+
+    String<TNeedleId> needleIds;
+    find(index, needles, 0u, [&](TIndexIt & /* it */, TNeedlesIt const & needlesIt, unsigned /* errors */)
+    {
+        appendValue(needleIds, position(needlesIt));
+    },
+    Backtracking<Exact>(), Serial());
+
+    SEQAN_ASSERT_EQ(length(needleIds), length(needles));
+    for (TNeedleId needleId = 0; needleId < length(needleIds); ++needleId)
+        SEQAN_ASSERT_EQ(needleIds[needleId], needleId);
+}
+
+// --------------------------------------------------------------------------
+// Test goDown() with k-mer table
+// --------------------------------------------------------------------------
+
+SEQAN_TEST(FMIndexKmersTest, GoDown)
+{
+    typedef StringSet<DnaString>                                    TText;
+    typedef Index<TText, KmerFMIndex>                               TKmerIndex;
+    typedef Index<TText, SmallLVFMIndex>                            TIndex;
+    typedef Iterator<TKmerIndex, TopDown<> >::Type                  TKmerIndexIt;
+    typedef Iterator<TIndex, TopDown<> >::Type                      TIndexIt;
+
+    Rng<MersenneTwister> rng(7);
+
+    TText text;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        DnaString seq;
+        for (unsigned j = 0; j < 500; ++j)
+            appendValue(seq, Dna(pickRandomNumber(rng) % 4));
+        appendValue(text, seq);
+    }
+
+    TKmerIndex kmerIndex(text);
+    TIndex index(text);
+    indexCreate(kmerIndex, FibreSALF());
+    indexCreate(index, FibreSALF());
+
+    // The k-mer table is a separate step.
+    SEQAN_ASSERT(empty(getFibre(kmerIndex, FibreKmers())));
+    SEQAN_ASSERT(indexCreate(kmerIndex, FibreKmers()));
+    SEQAN_ASSERT(indexCreate(index, FibreKmers()));
+
+    SEQAN_ASSERT_EQ(length(getFibre(kmerIndex, FibreKmers())), 257u);
+    SEQAN_ASSERT(empty(getFibre(index, FibreKmers())));
+
+    // The k-mer table must survive a save/open round trip.
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    SEQAN_ASSERT(save(kmerIndex, toCString(fileName)));
+    TKmerIndex openedIndex;
+    SEQAN_ASSERT(open(openedIndex, toCString(fileName)));
+    SEQAN_ASSERT(getFibre(openedIndex, FibreKmers()) == getFibre(kmerIndex, FibreKmers()));
+
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        DnaString needle;
+        unsigned needleLength = pickRandomNumber(rng) % 10;
+        for (unsigned j = 0; j < needleLength; ++j)
+            appendValue(needle, Dna(pickRandomNumber(rng) % 4));
+
+        TKmerIndexIt kmerIt(openedIndex);
+        TIndexIt it(index);
+        unsigned kmerLcp = 0;
+        unsigned lcp = 0;
+
+        SEQAN_ASSERT_EQ(_goDownString(kmerIt, needle, kmerLcp), _goDownString(it, needle, lcp));
+        SEQAN_ASSERT_EQ(kmerLcp, lcp);
+        SEQAN_ASSERT_EQ(repLength(kmerIt), repLength(it));
+        if (lcp)
+        {
+            SEQAN_ASSERT(value(kmerIt).range == value(it).range);
+            SEQAN_ASSERT_EQ(value(kmerIt).lastChar, value(it).lastChar);
+        }
+    }
+
+    // A k-mer table of another length, e.g. of another k-mer length, is dropped and the index is searched without it.
+    Fibre<TKmerIndex, FibreKmers>::Type foreignKmers = getFibre(kmerIndex, FibreKmers());
+    resize(foreignKmers, 64u);
+    CharString kmerFileName = fileName;
+    append(kmerFileName, ".kmer");
+    SEQAN_ASSERT(save(foreignKmers, toCString(kmerFileName)));
+    TKmerIndex foreignIndex;
+    SEQAN_ASSERT(open(foreignIndex, toCString(fileName)));
+    SEQAN_ASSERT(empty(getFibre(foreignIndex, FibreKmers())));
+
+    TKmerIndexIt foreignIt(foreignIndex);
+    TIndexIt it(index);
+    DnaString needle = infix(text[3], 100, 120);
+    reverse(needle);
+    SEQAN_ASSERT(goDown(foreignIt, needle));
+    SEQAN_ASSERT(goDown(it, needle));
+    SEQAN_ASSERT(value(foreignIt).range == value(it).range);
+
+    // The k-mer table of another text of the same length is dropped as well.
+    TText otherText = text;
+    for (unsigned j = 0; j < 50; ++j)
+        otherText[0][j] = Dna(3);
+    TKmerIndex otherIndex(otherText);
+    indexCreate(otherIndex);
+    SEQAN_ASSERT(save(getFibre(otherIndex, FibreKmers()), toCString(kmerFileName)));
+    SEQAN_ASSERT(open(foreignIndex, toCString(fileName)));
+    SEQAN_ASSERT(empty(getFibre(foreignIndex, FibreKmers())));
+
+    // So is the k-mer table of an index rebuilt under the same name from a text of the same composition.
+    TText permutedText;
+    for (unsigned i = length(text); i > 0; --i)
+        appendValue(permutedText, text[i - 1]);
+    std::swap(permutedText[0][0], permutedText[0][length(permutedText[0]) - 1]);
+    TKmerIndex permutedIndex(permutedText);
+    indexCreate(permutedIndex, FibreSALF());
+    SEQAN_ASSERT(save(permutedIndex, toCString(fileName)));
+    SEQAN_ASSERT(save(getFibre(kmerIndex, FibreKmers()), toCString(kmerFileName)));
+    TKmerIndex reopenedIndex;
+    SEQAN_ASSERT(open(reopenedIndex, toCString(fileName)));
+    SEQAN_ASSERT(empty(getFibre(reopenedIndex, FibreKmers())));
+
+    // Saving an index without k-mer table removes the table saved before under the same name.
+    SEQAN_ASSERT(save(otherIndex, toCString(fileName)));
+    SEQAN_ASSERT(fileExists(toCString(kmerFileName)));
+    TKmerIndex plainIndex(text);
+    indexCreate(plainIndex, FibreSALF());
+    SEQAN_ASSERT(save(plainIndex, toCString(fileName)));
+    SEQAN_ASSERT_NOT(fileExists(toCString(kmerFileName)));
+    SEQAN_ASSERT(open(foreignIndex, toCString(fileName)));
+    SEQAN_ASSERT(empty(getFibre(foreignIndex, FibreKmers())));
+}
+
+// --------------------------------------------------------------------------
+// Test open(OPEN_RDONLY) with memory mapped fibres
+// --------------------------------------------------------------------------
+
+SEQAN_TEST(FMIndexOpenTest, MMapReadOnly)
+{
+    typedef StringSet<DnaString, Owner<ConcatDirect<> > >               TText;
+    typedef StringSet<String<Dna, MMap<> >, Owner<ConcatDirect<> > >    TMMapText;
+    typedef Index<TText, KmerFMIndex>                                   TIndex;
+    typedef Index<TMMapText, MMapFMIndex>                               TMMapIndex;
+    typedef Iterator<TIndex, TopDown<> >::Type                          TIndexIt;
+    typedef Iterator<TMMapIndex, TopDown<> >::Type                      TMMapIndexIt;
+
+    Rng<MersenneTwister> rng(11);
+
+    TText text;
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        DnaString seq;
+        for (unsigned j = 0; j < 300; ++j)
+            appendValue(seq, Dna(pickRandomNumber(rng) % 4));
+        appendValue(text, seq);
+    }
+
+    TIndex index(text);
+    indexCreate(index);
+
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    SEQAN_ASSERT(save(index, toCString(fileName)));
+
+    TMMapIndex mmapIndex;
+    SEQAN_ASSERT(open(mmapIndex, toCString(fileName), OPEN_RDONLY));
+    SEQAN_ASSERT_EQ(lengthSum(indexText(mmapIndex)), lengthSum(text));
+    SEQAN_ASSERT_NOT(empty(getFibre(mmapIndex, FibreKmers())));
+
+    for (unsigned i = 0; i < 500; ++i)
+    {
+        unsigned needleLength = 1 + pickRandomNumber(rng) % 8;
+        unsigned seqNo = pickRandomNumber(rng) % length(text);
+        unsigned beginPos = pickRandomNumber(rng) % (length(text[seqNo]) - needleLength);
+        DnaString needle = infix(text[seqNo], beginPos, beginPos + needleLength);
+
+        // The FM index is searched backwards.
+        reverse(needle);
+
+        TIndexIt it(index);
+        TMMapIndexIt mmapIt(mmapIndex);
+
+        SEQAN_ASSERT(goDown(it, needle));
+        SEQAN_ASSERT(goDown(mmapIt, needle));
+        SEQAN_ASSERT(getOccurrences(mmapIt) == getOccurrences(it));
+    }
+
+    // A mapped k-mer table of another index is dropped without touching the file.
+    TText otherText = text;
+    otherText[0][0] = (otherText[0][0] == Dna('A')) ? Dna('C') : Dna('A');
+    TIndex otherIndex(otherText);
+    indexCreate(otherIndex);
+    CharString kmerFileName = fileName;
+    append(kmerFileName, ".kmer");
+    SEQAN_ASSERT(save(getFibre(otherIndex, FibreKmers()), toCString(kmerFileName)));
+
+    TMMapIndex staleIndex;
+    SEQAN_ASSERT(open(staleIndex, toCString(fileName), OPEN_RDONLY));
+    SEQAN_ASSERT(empty(getFibre(staleIndex, FibreKmers())));
+}
+
 // ========================================================================== 
 // Functions
 // ========================================================================== 
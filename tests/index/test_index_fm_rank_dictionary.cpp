@@ -69,6 +69,9 @@ typedef
     TagList<RankDictionary<bool,            Levels<> >,
     TagList<RankDictionary<Dna,             Levels<> >,
     TagList<RankDictionary<char,            Levels<> >,
+    TagList<RankDictionary<bool,            EPR<> >,
+    TagList<RankDictionary<Dna,             EPR<> >,
+    TagList<RankDictionary<Dna5,            EPR<> >,
     TagList<RankDictionary<Dna,             WaveletTree<> >,
     TagList<RankDictionary<Dna5,            WaveletTree<> >,
     TagList<RankDictionary<DnaQ,            WaveletTree<> >,
@@ -76,7 +79,7 @@ typedef
     TagList<RankDictionary<AminoAcid,       WaveletTree<> >,
     TagList<RankDictionary<char,            WaveletTree<> >,
     TagList<RankDictionary<unsigned char,   WaveletTree<> >
-    > > > > > > > > > > >
+    > > > > > > > > > > > > > >
     RankDictionaryTypes;
 
 // ========================================================================== 
@@ -198,6 +201,33 @@ SEQAN_TYPED_TEST(RankDictionaryTest, GetRank)
     }
 }
 
+// ----------------------------------------------------------------------------
+// Test createRankDictionary(Parallel)
+// ----------------------------------------------------------------------------
+
+SEQAN_TYPED_TEST(RankDictionaryTest, CreateRankDictionaryParallel)
+{
+    typedef typename TestFixture::TValueSize            TValueSize;
+    typedef typename TestFixture::TText                 TText;
+    typedef typename Size<TText>::Type                  TTextSize;
+
+    // The text must span many blocks to be split among the threads.
+    TText text;
+    for (unsigned i = 0; i < 50; ++i)
+        append(text, this->text);
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    typename TestFixture::TRankDict serialDict;
+    typename TestFixture::TRankDict parallelDict;
+    createRankDictionary(serialDict, text, Serial());
+    createRankDictionary(parallelDict, text, Parallel());
+
+    for (TTextSize pos = 0; pos < length(text); ++pos)
+        for (TValueSize c = 0; c < this->alphabetSize; ++c)
+            SEQAN_ASSERT_EQ(getRank(parallelDict, pos, c), getRank(serialDict, pos, c));
+}
+
 // ----------------------------------------------------------------------------
 // Test setValue()
 // ----------------------------------------------------------------------------
@@ -219,6 +249,38 @@ SEQAN_TYPED_TEST(RankDictionaryTest, GetRank)
 // Test open() and save()
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// Test EPR cache line layout, open() and save()
+// ----------------------------------------------------------------------------
+
+SEQAN_TEST(EPRRankDictionaryTest, OpenSave)
+{
+    typedef RankDictionary<Dna5, EPR<> >                TRankDict;
+    typedef Fibre<TRankDict, FibreRanks>::Type          TRanks;
+    typedef Value<TRanks>::Type                         TEntry;
+
+    SEQAN_ASSERT_EQ(sizeof(TEntry), 64u);
+
+    String<Dna5> text;
+    createText(text, Dna5());
+
+    TRankDict dict(text);
+    SEQAN_ASSERT_EQ(reinterpret_cast<size_t>(begin(dict.ranks, Standard())) % 64, 0u);
+
+    CharString fileName = SEQAN_TEMP_FILENAME();
+    SEQAN_ASSERT(save(dict, toCString(fileName)));
+
+    TRankDict openDict;
+    SEQAN_ASSERT(open(openDict, toCString(fileName)));
+
+    for (unsigned pos = 0; pos < length(text); ++pos)
+    {
+        SEQAN_ASSERT_EQ(getValue(openDict, pos), text[pos]);
+        for (unsigned c = 0; c < ValueSize<Dna5>::VALUE; ++c)
+            SEQAN_ASSERT_EQ(getRank(openDict, pos, c), getRank(dict, pos, c));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Test Size<>
 // ----------------------------------------------------------------------------
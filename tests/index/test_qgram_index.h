@@ -321,6 +321,80 @@ SEQAN_DEFINE_TEST(testUngappedQGramIndexMulti)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndex, typename TText>
+void testParallelQGramIndex(TText & text, unsigned stepSize)
+{
+    typedef typename Fibre<TIndex, QGramShape>::Type    TShape;
+    typedef typename Value<TShape>::Type                THashValue;
+
+    TIndex refIndex(text);
+    TIndex testIndex(text);
+    setStepSize(refIndex, stepSize);
+    setStepSize(testIndex, stepSize);
+    indexCreate(refIndex, QGramSADir());
+    indexCreate(testIndex, QGramSADir(), Parallel());
+
+    SEQAN_ASSERT_EQ(length(indexSA(refIndex)), length(indexSA(testIndex)));
+    SEQAN_ASSERT_EQ(length(indexDir(refIndex)), length(indexDir(testIndex)));
+
+    // The buckets of open addressing indices depend on the insertion order, hence compare the occurrences.
+    DnaString qgram;
+    for (THashValue h = 0; h < (THashValue)ValueSize<TShape>::VALUE; ++h)
+    {
+        unhash(qgram, h, length(indexShape(refIndex)));
+        hash(indexShape(refIndex), begin(qgram));
+        hash(indexShape(testIndex), begin(qgram));
+        SEQAN_ASSERT(getOccurrences(refIndex, indexShape(refIndex)) ==
+                     getOccurrences(testIndex, indexShape(testIndex)));
+    }
+}
+
+SEQAN_DEFINE_TEST(testParallelQGramIndex)
+{
+    typedef Shape<Dna, UngappedShape<4> >                       TShape;
+    typedef StringSet<DnaString>                                TStrings;
+
+    ClassTest::ScopedNumThreads numThreads(4);
+
+    DnaString text;
+    TStrings strings;
+    for (unsigned i = 0; i < 5000; ++i)
+        appendValue(text, Dna((i * 7 + i / 13) % 4));
+    for (unsigned i = 0; i < 30; ++i)
+        appendValue(strings, infix(text, i * 97, i * 97 + i * 5));
+
+    // Direct addressing produces identical tables.
+    for (unsigned stepSize = 1; stepSize <= 3; stepSize += 2)
+    {
+        Index<DnaString, IndexQGram<TShape> > refIndex(text), testIndex(text);
+        setStepSize(refIndex, stepSize);
+        setStepSize(testIndex, stepSize);
+        indexCreate(refIndex, QGramSADir());
+        indexCreate(testIndex, QGramSADir(), Parallel());
+        SEQAN_ASSERT(indexSA(refIndex) == indexSA(testIndex));
+        SEQAN_ASSERT(indexDir(refIndex) == indexDir(testIndex));
+
+        testParallelQGramIndex<Index<DnaString, IndexQGram<TShape> > >(text, stepSize);
+        testParallelQGramIndex<Index<DnaString, IndexQGram<TShape, OpenAddressing> > >(text, stepSize);
+        testParallelQGramIndex<Index<TStrings, IndexQGram<TShape> > >(strings, stepSize);
+        testParallelQGramIndex<Index<TStrings, IndexQGram<TShape, OpenAddressing> > >(strings, stepSize);
+    }
+
+    // Cumulative sum with disabled buckets.
+    String<unsigned> refDir, testDir;
+    for (unsigned i = 0; i < 1000; ++i)
+        appendValue(refDir, (i % 7 == 3 || i % 11 == 4)? (unsigned)-1: i % 5);
+    testDir = refDir;
+    SEQAN_ASSERT_EQ(_qgramCummulativeSum(refDir, True()), _qgramCummulativeSum(testDir, True(), Parallel()));
+    SEQAN_ASSERT(refDir == testDir);
+    _qgramPostprocessBuckets(refDir);
+    _qgramPostprocessBuckets(testDir, Parallel());
+    SEQAN_ASSERT(refDir == testDir);
+
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 SEQAN_DEFINE_TEST(testQGramFind)
@@ -56,6 +56,7 @@
 #include "test_misc_accumulators.h"
 #include "test_misc_edit_environment.h"
 #include "test_misc_bit_twiddling.h"
+#include "test_misc_name_store_cache.h"
 
 using namespace std;
 using namespace seqan;
@@ -130,6 +131,11 @@ SEQAN_BEGIN_TESTSUITE(test_misc) {
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_hamming);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_edit);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_edit);
+
+    SEQAN_CALL_TEST(test_misc_name_store_cache_lookup);
+    SEQAN_CALL_TEST(test_misc_name_store_cache_many);
+    SEQAN_CALL_TEST(test_misc_name_store_cache_open_addressing_lookup);
+    SEQAN_CALL_TEST(test_misc_name_store_cache_open_addressing_many);
 }
 SEQAN_END_TESTSUITE
 
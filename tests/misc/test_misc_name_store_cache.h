@@ -0,0 +1,145 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the NameStoreCache.
+// ==========================================================================
+
+#ifndef SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+#define SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/misc/name_store_cache.h>
+
+using namespace seqan;
+
+template <typename TSpec>
+void testNameStoreCacheLookup()
+{
+    typedef StringSet<CharString>                           TNameStore;
+    typedef NameStoreCache<TNameStore, CharString, TSpec>   TNameStoreCache;
+
+    TNameStore nameStore;
+    appendValue(nameStore, "chr1");
+    appendValue(nameStore, "chr2");
+    appendValue(nameStore, "chr1");     // duplicate
+
+    TNameStoreCache cache(nameStore);
+    SEQAN_ASSERT_NOT(empty(cache));
+
+    unsigned idx = 0;
+    SEQAN_ASSERT(getIdByName(idx, cache, CharString("chr1")));
+    SEQAN_ASSERT_EQ(idx, 0u);
+    SEQAN_ASSERT(getIdByName(idx, cache, "chr2"));
+    SEQAN_ASSERT_EQ(idx, 1u);
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "chr3"));
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, ""));
+
+    appendName(cache, "chr3");
+    SEQAN_ASSERT_EQ(length(nameStore), 4u);
+    SEQAN_ASSERT(getIdByName(idx, cache, "chr3"));
+    SEQAN_ASSERT_EQ(idx, 3u);
+
+    // Duplicate names keep the id of their first occurrence.
+    appendName(cache, "chr2");
+    SEQAN_ASSERT(getIdByName(idx, cache, "chr2"));
+    SEQAN_ASSERT_EQ(idx, 1u);
+
+    SEQAN_ASSERT_EQ(nameToId(cache, "chr3"), 3u);
+    SEQAN_ASSERT_EQ(nameToId(cache, "chr4"), 5u);
+    SEQAN_ASSERT_EQ(length(nameStore), 6u);
+
+    // Names appended without the cache require a refresh.
+    appendValue(nameStore, "chr5");
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "chr5"));
+    refresh(cache);
+    SEQAN_ASSERT(getIdByName(idx, cache, "chr5"));
+    SEQAN_ASSERT_EQ(idx, 6u);
+    SEQAN_ASSERT(getIdByName(idx, cache, "chr1"));
+    SEQAN_ASSERT_EQ(idx, 0u);
+
+    clear(cache);
+    SEQAN_ASSERT(empty(cache));
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "chr1"));
+}
+
+template <typename TSpec>
+void testNameStoreCacheMany()
+{
+    typedef StringSet<CharString>                           TNameStore;
+    typedef NameStoreCache<TNameStore, CharString, TSpec>   TNameStoreCache;
+
+    TNameStore nameStore;
+    TNameStoreCache cache(nameStore);
+    SEQAN_ASSERT(empty(cache));
+
+    for (unsigned i = 0; i < 10000; ++i)
+    {
+        std::stringstream ss;
+        ss << "read" << i;
+        SEQAN_ASSERT_EQ(nameToId(cache, ss.str()), i);
+    }
+    SEQAN_ASSERT_EQ(length(nameStore), 10000u);
+
+    unsigned idx = 0;
+    for (unsigned i = 0; i < 10000; ++i)
+    {
+        std::stringstream ss;
+        ss << "read" << i;
+        SEQAN_ASSERT(getIdByName(idx, cache, ss.str()));
+        SEQAN_ASSERT_EQ(idx, i);
+    }
+    SEQAN_ASSERT_NOT(getIdByName(idx, cache, "read10000"));
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_lookup)
+{
+    testNameStoreCacheLookup<void>();
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_many)
+{
+    testNameStoreCacheMany<void>();
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_open_addressing_lookup)
+{
+    testNameStoreCacheLookup<OpenAddressing>();
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_open_addressing_many)
+{
+    testNameStoreCacheMany<OpenAddressing>();
+}
+
+#endif  // SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
@@ -47,6 +47,9 @@
 #include "test_parallel_splitting.h"
 #include "test_parallel_algorithms.h"
 #include "test_parallel_queue.h"
+#ifdef SEQAN_CXX11_STL
+#include "test_parallel_work_stealing.h"
+#endif
 
 SEQAN_BEGIN_TESTSUITE(test_parallel) {
 #if defined(_OPENMP)
@@ -102,5 +105,13 @@ SEQAN_BEGIN_TESTSUITE(test_parallel) {
         SEQAN_CALL_TEST(test_parallel_queue_mpmc_dynamicsize);
     }
 #endif
+
+#ifdef SEQAN_CXX11_STL
+    // Tests for work-stealing scheduling.
+    SEQAN_CALL_TEST(test_parallel_work_stealing_deque_simple);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_deque_concurrent);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_pool);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_exception);
+#endif
 }
 SEQAN_END_TESTSUITE
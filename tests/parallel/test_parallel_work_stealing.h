@@ -0,0 +1,196 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the work-stealing deque and thread pool.
+// ==========================================================================
+
+#ifndef TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+#define TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/parallel.h>
+
+#include <stdexcept>
+#include <vector>
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_deque_simple)
+{
+    seqan::WorkStealingDeque<unsigned> deque(2);
+    unsigned x = 0;
+
+    SEQAN_ASSERT(empty(deque));
+    SEQAN_ASSERT_NOT(tryPopBack(x, deque));
+    SEQAN_ASSERT_NOT(trySteal(x, deque));
+
+    // Grow the ring buffer beyond its initial capacity.
+    for (unsigned i = 0; i < 10; ++i)
+        appendValue(deque, i);
+    SEQAN_ASSERT_NOT(empty(deque));
+
+    SEQAN_ASSERT(trySteal(x, deque));
+    SEQAN_ASSERT_EQ(x, 0u);
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, 9u);
+    SEQAN_ASSERT(trySteal(x, deque));
+    SEQAN_ASSERT_EQ(x, 1u);
+
+    for (unsigned i = 8; i >= 2; --i)
+    {
+        SEQAN_ASSERT(tryPopBack(x, deque));
+        SEQAN_ASSERT_EQ(x, i);
+    }
+    SEQAN_ASSERT(empty(deque));
+    SEQAN_ASSERT_NOT(tryPopBack(x, deque));
+    SEQAN_ASSERT_NOT(trySteal(x, deque));
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_deque_concurrent)
+{
+    // The owner pushes and pops while thieves steal, every element must be removed exactly once.
+    const unsigned count = 100000;
+    const unsigned thiefCount = 3;
+
+    seqan::WorkStealingDeque<unsigned> deque(4);
+    std::vector<std::atomic<unsigned> > seen(count);
+    for (unsigned i = 0; i < count; ++i)
+        seen[i].store(0);
+
+    std::atomic<bool> done(false);
+    seqan::String<std::thread *> thieves;
+    for (unsigned t = 0; t < thiefCount; ++t)
+        appendValue(thieves, new std::thread([&]()
+        {
+            unsigned x;
+            while (!done.load() || !empty(deque))
+                if (trySteal(x, deque))
+                    seen[x].fetch_add(1);
+        }));
+
+    unsigned x;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        appendValue(deque, i);
+        if (i % 3 == 0 && tryPopBack(x, deque))
+            seen[x].fetch_add(1);
+    }
+    while (tryPopBack(x, deque))
+        seen[x].fetch_add(1);
+    done.store(true);
+
+    for (unsigned t = 0; t < thiefCount; ++t)
+    {
+        thieves[t]->join();
+        delete thieves[t];
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+        SEQAN_ASSERT_EQ(seen[i].load(), 1u);
+}
+
+inline void
+_testWorkStealingSum(seqan::ThreadPool & pool, std::atomic<__uint64> & sum, unsigned begin, unsigned end)
+{
+    if (end - begin <= 16)
+    {
+        __uint64 localSum = 0;
+        for (unsigned i = begin; i < end; ++i)
+            localSum += i;
+        sum.fetch_add(localSum);
+        return;
+    }
+
+    // Nested task groups, the waiting worker keeps executing tasks.
+    unsigned mid = begin + (end - begin) / 2;
+    seqan::TaskGroup group(pool);
+    spawn(group, [&pool, &sum, begin, mid]() { _testWorkStealingSum(pool, sum, begin, mid); });
+    spawn(group, [&pool, &sum, mid, end]() { _testWorkStealingSum(pool, sum, mid, end); });
+    waitFor(group);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_pool)
+{
+    seqan::ThreadPool pool(4);
+    SEQAN_ASSERT_EQ(length(pool), 4u);
+
+    // Flat task group spawned from a non-worker thread.
+    std::atomic<unsigned> counter(0);
+    seqan::TaskGroup group(pool);
+    for (unsigned i = 0; i < 10000; ++i)
+        spawn(group, [&counter]() { counter.fetch_add(1); });
+    waitFor(group);
+    SEQAN_ASSERT_EQ(counter.load(), 10000u);
+
+    // Recursive divide and conquer.
+    std::atomic<__uint64> sum(0);
+    const unsigned n = 100000;
+    _testWorkStealingSum(pool, sum, 0, n);
+    SEQAN_ASSERT_EQ(sum.load(), (__uint64)n * (n - 1) / 2);
+
+    // The group can be reused after waiting.
+    spawn(group, [&counter]() { counter.fetch_add(1); });
+    waitFor(group);
+    SEQAN_ASSERT_EQ(counter.load(), 10001u);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_exception)
+{
+    seqan::ThreadPool pool(2);
+    seqan::TaskGroup group(pool);
+    std::atomic<unsigned> counter(0);
+
+    for (unsigned i = 0; i < 100; ++i)
+        spawn(group, [&counter, i]()
+        {
+            counter.fetch_add(1);
+            if (i == 50)
+                throw std::runtime_error("task failed");
+        });
+
+    bool caught = false;
+    try
+    {
+        waitFor(group);
+    }
+    catch (std::runtime_error const &)
+    {
+        caught = true;
+    }
+    SEQAN_ASSERT(caught);
+
+    // All other tasks still run to completion.
+    SEQAN_ASSERT_EQ(counter.load(), 100u);
+
+    // The exception is only rethrown once.
+    waitFor(group);
+}
+
+#endif  // TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
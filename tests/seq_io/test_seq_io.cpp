@@ -61,6 +61,11 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_all_text_fasta);
 
+    // Test reading many records in parallel.
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_records_chunked_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_records_chunked_fastq);
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_records_chunked_mixed);
+
     // Test writing with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_file_write_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_file_write_all_text_fasta);
@@ -346,4 +346,144 @@ SEQAN_DEFINE_TEST(test_seq_io_sequence_file_write_all_text_fastq_with_qual)
     SEQAN_ASSERT_MSG(seqan::_compareTextFilesAlt(toCString(pathToExpected), toCString(filePath)), "Output should match example.");
 }
 
+// ---------------------------------------------------------------------------
+// Test reading many records in parallel.
+// ---------------------------------------------------------------------------
+
+// readRecords() parses Fasta and Fastq files in parallel, it must give the same results as readRecord().
+template <typename TSeqString>
+void testSeqIOSequenceFileReadRecordsChunked(char const * fileExt, bool withQuals)
+{
+    seqan::CharString filePath = SEQAN_TEMP_FILENAME();
+    append(filePath, fileExt);
+
+    // Write records with multi-line sequences and '@' in the qualities.
+    {
+        seqan::SeqFileOut seqOut(toCString(filePath));
+        context(seqOut).options.lineLength = 7;
+        seqan::CharString id, quals;
+        seqan::Dna5String seq;
+        for (unsigned i = 0; i < 20000; ++i)
+        {
+            clear(id);
+            appendNumber(id, i);
+            append(id, " +@> comment");
+            clear(seq);
+            clear(quals);
+            for (unsigned j = 0; j < i % 37; ++j)
+            {
+                appendValue(seq, seqan::Dna5((i + j) % 5));
+                appendValue(quals, (char)('!' + (i * j) % 40));
+            }
+            writeRecord(seqOut, id, seq, quals);
+        }
+    }
+
+    seqan::SeqFileIn seqInSeq(toCString(filePath));
+    seqan::SeqFileIn seqInPar(toCString(filePath));
+
+    seqan::ClassTest::ScopedNumThreads numThreads(4);
+
+    seqan::CharString id, quals;
+    TSeqString seq;
+    seqan::StringSet<seqan::CharString, seqan::Owner<seqan::ConcatDirect<> > > ids, qualSet;
+    seqan::StringSet<TSeqString, seqan::Owner<seqan::ConcatDirect<> > > seqs;
+    size_t numRecords = 0;
+    while (!atEnd(seqInPar))
+    {
+        clear(ids);
+        clear(seqs);
+        clear(qualSet);
+        if (withQuals)
+            readRecords(ids, seqs, qualSet, seqInPar, 3000);
+        else
+            readRecords(ids, seqs, seqInPar, 3000);
+        SEQAN_ASSERT_EQ(length(ids), length(seqs));
+        for (size_t i = 0; i < length(ids); ++i, ++numRecords)
+        {
+            SEQAN_ASSERT_NOT(atEnd(seqInSeq));
+            if (withQuals)
+            {
+                readRecord(id, seq, quals, seqInSeq);
+                SEQAN_ASSERT_EQ(qualSet[i], quals);
+            }
+            else
+            {
+                readRecord(id, seq, seqInSeq);
+            }
+            SEQAN_ASSERT_EQ(ids[i], id);
+            SEQAN_ASSERT_EQ(seqs[i], seq);
+            for (size_t j = 0; j < length(seq); ++j)
+                SEQAN_ASSERT_EQ(getQualityValue(seqs[i][j]), getQualityValue(seq[j]));
+        }
+    }
+    SEQAN_ASSERT(atEnd(seqInSeq));
+    SEQAN_ASSERT_EQ(numRecords, 20000u);
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_records_chunked_fasta)
+{
+    testSeqIOSequenceFileReadRecordsChunked<seqan::Dna5String>(".fa", false);
+    testSeqIOSequenceFileReadRecordsChunked<seqan::CharString>(".fa", true);
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_records_chunked_fastq)
+{
+    testSeqIOSequenceFileReadRecordsChunked<seqan::Dna5String>(".fq", false);
+    testSeqIOSequenceFileReadRecordsChunked<seqan::Dna5QString>(".fq", false);
+    testSeqIOSequenceFileReadRecordsChunked<seqan::Dna5String>(".fq", true);
+    testSeqIOSequenceFileReadRecordsChunked<seqan::CharString>(".fq", true);
+}
+
+// readRecords() leaves the file where readRecord() continues, also with CR/LF line ends and trailing whitespace.
+void testSeqIOSequenceFileReadRecordsChunkedMixed(char const * fileExt, char const * text)
+{
+    seqan::CharString filePath = SEQAN_TEMP_FILENAME();
+    append(filePath, fileExt);
+    {
+        std::ofstream file(toCString(filePath), std::ios::binary);
+        for (unsigned i = 0; i < 1000; ++i)
+            file << text;
+        file << "\r\n \n";
+    }
+
+    seqan::SeqFileIn seqInSeq(toCString(filePath));
+    seqan::SeqFileIn seqInPar(toCString(filePath));
+
+    seqan::ClassTest::ScopedNumThreads numThreads(4);
+
+    seqan::CharString id, quals, idPar, qualsPar;
+    seqan::Dna5String seq, seqPar;
+    seqan::StringSet<seqan::CharString> ids, qualSet;
+    seqan::StringSet<seqan::Dna5String> seqs;
+    size_t numRecords = 0;
+    while (!atEnd(seqInPar))
+    {
+        readRecords(ids, seqs, qualSet, seqInPar, 7);
+        if (!atEnd(seqInPar))
+        {
+            readRecord(idPar, seqPar, qualsPar, seqInPar);
+            appendValue(ids, idPar);
+            appendValue(seqs, seqPar);
+            appendValue(qualSet, qualsPar);
+        }
+        for (; numRecords < length(ids); ++numRecords)
+        {
+            readRecord(id, seq, quals, seqInSeq);
+            SEQAN_ASSERT_EQ(ids[numRecords], id);
+            SEQAN_ASSERT_EQ(seqs[numRecords], seq);
+            SEQAN_ASSERT_EQ(qualSet[numRecords], quals);
+        }
+    }
+    SEQAN_ASSERT(atEnd(seqInSeq));
+    SEQAN_ASSERT_EQ(numRecords, 2000u);
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_records_chunked_mixed)
+{
+    testSeqIOSequenceFileReadRecordsChunkedMixed(".fa", ">id 1>2\r\nACGT\r\nAC\r\n>id2\r\n\r\nA\r\n");
+    testSeqIOSequenceFileReadRecordsChunkedMixed(".fq", "@id 1+\r\nACGT\r\nACG\r\n+id 1\r\n@@!!\r\n!@!\r\n"
+                                                        "@id2\r\nAC\r\n+\r\n@!\r\n");
+}
+
 #endif  // TESTS_SEQ_IO_TEST_EASY_SEQ_IO_H_
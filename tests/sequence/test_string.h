@@ -617,6 +617,14 @@ SEQAN_DEFINE_TEST(String_Packed)
             erase(str2_, 64-i, 65-i+j);
             SEQAN_ASSERT_EQ(str1_, str2_);
         }
+
+    // Copy infixes of a packed string, word-aligned or not, that span several words.
+    for (int i = 0; i < PackedTraits_<TPackedString>::VALUES_PER_HOST_VALUE; ++i)
+        for (int j = 100; j < 100 + PackedTraits_<TPackedString>::VALUES_PER_HOST_VALUE; ++j)
+        {
+            TPackedString str2_ = infix(str2, i, j);
+            SEQAN_ASSERT_EQ(str2_, infix(str1, i, j));
+        }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -179,4 +179,267 @@ SEQAN_TYPED_TEST(VStreamTest, AutoDetection)
     SEQAN_ASSERT_NOT((bool)vstream);
 }
 
+#if SEQAN_HAS_ZLIB
+// Concatenated gzip files (e.g. written by pigz -i or bgzip) must be read completely.
+SEQAN_TEST(VStreamGZip, MultiMember)
+{
+    CharString tmpName = SEQAN_TEMP_FILENAME();
+    append(tmpName, ".gz");
+    std::ofstream tmpFile(toCString(tmpName), std::ios::out | std::ios::binary);
+
+    // gzip member of unknown size, a BGZF member, and our own members of known size
+    char const * suffixes[] = { ".gz", ".bgzf", ".gz" };
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        CharString fileName = SEQAN_PATH_TO_ROOT();
+        append(fileName, "/tests/seq_io/test_dna.fq");
+        append(fileName, suffixes[i]);
+        std::ifstream file(toCString(fileName), std::ios::in | std::ios::binary);
+        tmpFile << file.rdbuf();
+    }
+    {
+        gzip_ostream zipper(tmpFile);
+        for (unsigned i = 0; i != 10000; ++i)
+            zipper << FASTQ_EXAMPLE;
+    }
+    tmpFile.close();
+
+    CharString expected;
+    for (unsigned i = 0; i != 10003; ++i)
+        append(expected, FASTQ_EXAMPLE);
+
+    VirtualStream<char, Input> vistream(toCString(tmpName), OPEN_RDONLY);
+    SEQAN_ASSERT((bool)vistream);
+    std::stringstream sstr;
+    sstr << vistream.streamBuf;
+    SEQAN_ASSERT_EQ(CharString(sstr.str()), expected);
+    close(vistream);
+}
+
+// A .gz file that starts with a BGZF block might continue with other gzip members and must be read as gzip.
+SEQAN_TEST(VStreamGZip, BgzfFollowedByGZip)
+{
+    CharString tmpName = SEQAN_TEMP_FILENAME();
+    append(tmpName, ".fq.gz");
+    std::ofstream tmpFile(toCString(tmpName), std::ios::out | std::ios::binary);
+
+    char const * suffixes[] = { ".bgzf", ".gz" };
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        CharString fileName = SEQAN_PATH_TO_ROOT();
+        append(fileName, "/tests/seq_io/test_dna.fq");
+        append(fileName, suffixes[i]);
+        std::ifstream file(toCString(fileName), std::ios::in | std::ios::binary);
+        tmpFile << file.rdbuf();
+    }
+    tmpFile.close();
+
+    CharString expected;
+    for (unsigned i = 0; i != 2; ++i)
+        append(expected, FASTQ_EXAMPLE);
+
+    VirtualStream<char, Input> vistream(toCString(tmpName), OPEN_RDONLY);
+    SEQAN_ASSERT((bool)vistream);
+    SEQAN_ASSERT(isEqual(vistream.format, GZFile()));
+    std::stringstream sstr;
+    sstr << vistream.streamBuf;
+    SEQAN_ASSERT_EQ(CharString(sstr.str()), expected);
+    close(vistream);
+}
+
+// Tabix files (e.g. .vcf.gz) are read as BGZF if they are BGZF-compressed.
+SEQAN_TEST(VStreamGZip, TabixFilename)
+{
+    char const * suffixes[] = { ".bgzf", ".gz" };
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        CharString fileName = SEQAN_PATH_TO_ROOT();
+        append(fileName, "/tests/seq_io/test_dna.fq");
+        append(fileName, suffixes[i]);
+
+        CharString tmpName = SEQAN_TEMP_FILENAME();
+        append(tmpName, ".vcf.gz");
+        {
+            std::ifstream file(toCString(fileName), std::ios::in | std::ios::binary);
+            std::ofstream tmpFile(toCString(tmpName), std::ios::out | std::ios::binary);
+            tmpFile << file.rdbuf();
+        }
+
+        VirtualStream<char, Input> vistream(toCString(tmpName), OPEN_RDONLY);
+        SEQAN_ASSERT((bool)vistream);
+        if (i == 0)
+            SEQAN_ASSERT(isEqual(vistream.format, BgzfFile()));
+        else
+            SEQAN_ASSERT(isEqual(vistream.format, GZFile()));
+        SEQAN_ASSERT_EQ(CharString(_getUncompressedBasename(tmpName, vistream.format)),
+                        CharString(prefix(tmpName, length(tmpName) - 3)));
+        std::stringstream sstr;
+        sstr << vistream.streamBuf;
+        SEQAN_ASSERT_EQ(CharString(sstr.str()), CharString(FASTQ_EXAMPLE));
+        close(vistream);
+    }
+
+    // bgzip's .bgz extension is read as BGZF, too.
+    CharString fileName = SEQAN_PATH_TO_ROOT();
+    append(fileName, "/tests/seq_io/test_dna.fq.bgzf");
+    CharString tmpName = SEQAN_TEMP_FILENAME();
+    append(tmpName, ".vcf.bgz");
+    {
+        std::ifstream file(toCString(fileName), std::ios::in | std::ios::binary);
+        std::ofstream tmpFile(toCString(tmpName), std::ios::out | std::ios::binary);
+        tmpFile << file.rdbuf();
+    }
+
+    VirtualStream<char, Input> vistream(toCString(tmpName), OPEN_RDONLY);
+    SEQAN_ASSERT((bool)vistream);
+    SEQAN_ASSERT(isEqual(vistream.format, BgzfFile()));
+    SEQAN_ASSERT_EQ(CharString(_getUncompressedBasename(tmpName, vistream.format)),
+                    CharString(prefix(tmpName, length(tmpName) - 4)));
+    std::stringstream sstr;
+    sstr << vistream.streamBuf;
+    SEQAN_ASSERT_EQ(CharString(sstr.str()), CharString(FASTQ_EXAMPLE));
+    close(vistream);
+}
+
+// A truncated gzip file must raise an error instead of silently ending.
+SEQAN_TEST(VStreamGZip, Truncated)
+{
+    std::stringstream compressed;
+    {
+        gzip_ostream zipper(compressed);
+        for (unsigned i = 0; i != 10000; ++i)
+            zipper << FASTQ_EXAMPLE;
+    }
+    std::string data = compressed.str();
+    std::stringstream truncated(data.substr(0, data.size() - 100));
+
+    gzip_istream unzipper(truncated);
+    bool thrown = false;
+    try
+    {
+        while (unzipper.rdbuf()->sbumpc() != EOF) {}
+    }
+    catch (IOError const &)
+    {
+        thrown = true;
+    }
+    SEQAN_ASSERT(thrown);
+}
+
+// The uncompressed size stored in a gzip footer must not be trusted when allocating.
+SEQAN_TEST(VStreamGZip, CorruptSize)
+{
+    std::stringstream compressed;
+    {
+        gzip_ostream zipper(compressed);
+        for (unsigned i = 0; i != 10000; ++i)
+            zipper << FASTQ_EXAMPLE;
+    }
+    std::string data = compressed.str();
+
+    unsigned const corruptSizes[] = { 0xffffffffu, 1u };
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        std::string corrupt = data;
+        for (unsigned j = 0; j < 4; ++j)
+            corrupt[corrupt.size() - 4 + j] = (char)(corruptSizes[i] >> (8 * j));
+        std::stringstream corruptStream(corrupt);
+
+        gzip_istream unzipper(corruptStream);
+        bool thrown = false;
+        try
+        {
+            while (unzipper.rdbuf()->sbumpc() != EOF) {}
+        }
+        catch (IOError const &)
+        {
+            thrown = true;
+        }
+        SEQAN_ASSERT(thrown);
+    }
+}
+
+// Empty gzip members must not exhaust the pool of decompression jobs.
+SEQAN_TEST(VStreamGZip, EmptyMembers)
+{
+    // a gzip member of unknown size with an empty deflate stream
+    char const emptyMember[] = { '\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\x03',
+                                 '\x03', 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    std::stringstream compressed;
+    for (unsigned i = 0; i != 40; ++i)
+        compressed.write(emptyMember, sizeof(emptyMember));
+    {
+        gzip_ostream zipper(compressed);
+        zipper << FASTQ_EXAMPLE;
+    }
+    for (unsigned i = 0; i != 40; ++i)
+        compressed.write(emptyMember, sizeof(emptyMember));
+
+    gzip_istream unzipper(compressed);
+    std::stringstream sstr;
+    sstr << unzipper.rdbuf();
+    SEQAN_ASSERT_EQ(CharString(sstr.str()), CharString(FASTQ_EXAMPLE));
+}
+
+// Zero padding after the last member (e.g. left by tar or dd) ends the stream, an invalid first header is an error.
+SEQAN_TEST(VStreamGZip, TrailingZeros)
+{
+    std::stringstream compressed;
+    {
+        gzip_ostream zipper(compressed);
+        zipper << FASTQ_EXAMPLE;
+    }
+    for (unsigned i = 0; i != 1024; ++i)
+        compressed.put(0);
+
+    {
+        gzip_istream unzipper(compressed);
+        std::stringstream sstr;
+        sstr << unzipper.rdbuf();
+        SEQAN_ASSERT_EQ(CharString(sstr.str()), CharString(FASTQ_EXAMPLE));
+    }
+
+    std::stringstream padding(std::string(1024, '\0'));
+    gzip_istream unzipper(padding);
+    bool thrown = false;
+    try
+    {
+        while (unzipper.rdbuf()->sbumpc() != EOF) {}
+    }
+    catch (IOError const &)
+    {
+        thrown = true;
+    }
+    SEQAN_ASSERT(thrown);
+}
+
+// The number of (de)compression threads can be chosen by the caller.
+SEQAN_TEST(VStreamGZip, NumThreads)
+{
+    CharString expected;
+    for (unsigned i = 0; i != 10000; ++i)
+        append(expected, FASTQ_EXAMPLE);
+
+    CharString tmpName = SEQAN_TEMP_FILENAME();
+    append(tmpName, ".gz");
+    {
+        std::ofstream tmpFile(toCString(tmpName), std::ios::out | std::ios::binary);
+        gzip_ostream zipper(tmpFile, 1);
+        zipper << expected;
+    }
+
+    for (unsigned numThreads = 1; numThreads <= 4; numThreads *= 2)
+    {
+        VirtualStream<char, Input> vistream;
+        vistream.numThreads = numThreads;
+        SEQAN_ASSERT(open(vistream, toCString(tmpName), OPEN_RDONLY));
+        std::stringstream sstr;
+        sstr << vistream.streamBuf;
+        SEQAN_ASSERT_EQ(CharString(sstr.str()), expected);
+        close(vistream);
+    }
+}
+#endif
+
 #endif // ndef TEST_STREAM_TEST_VIRTUAL_STREAM_H_
@@ -0,0 +1,369 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2015, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+
+#ifndef TESTS_TABIX_IO_TEST_TABIX_INDEX_H_
+#define TESTS_TABIX_IO_TEST_TABIX_INDEX_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/tabix_io.h>
+
+// Write text as a BGZF-compressed file, like bgzip does.
+inline void writeBgzfTestFile(std::string const & path, std::string const & text)
+{
+    using namespace seqan;
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::out);
+    VirtualStream<char, Output> out;
+    SEQAN_ASSERT(open(out, file, BgzfFile()));
+    out.write(text.c_str(), text.size());
+    close(out);
+}
+
+// Check that both indices have the same layout, sequences, bins and linear indices.
+inline void testTabixIndexEqual(seqan::TabixIndex const & index1, seqan::TabixIndex const & index2)
+{
+    SEQAN_ASSERT_EQ(index1._format, index2._format);
+    SEQAN_ASSERT_EQ(index1._colSeq, index2._colSeq);
+    SEQAN_ASSERT_EQ(index1._colBeg, index2._colBeg);
+    SEQAN_ASSERT_EQ(index1._colEnd, index2._colEnd);
+    SEQAN_ASSERT_EQ(index1._meta, index2._meta);
+    SEQAN_ASSERT_EQ(index1._skip, index2._skip);
+    SEQAN_ASSERT(index1._seqNames == index2._seqNames);
+    SEQAN_ASSERT(index1._seqIds == index2._seqIds);
+    SEQAN_ASSERT_EQ(length(index1._binIndices), length(index2._binIndices));
+    for (unsigned i = 0; i < length(index1._binIndices); ++i)
+        SEQAN_ASSERT(index1._binIndices[i] == index2._binIndices[i]);
+    SEQAN_ASSERT(index1._linearIndices == index2._linearIndices);
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_reg2bin)
+{
+    using namespace seqan;
+
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(0, 1), 4681u);
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(16383, 16384), 4681u);
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(16384, 16385), 4682u);
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(16383, 16385), 585u);
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(0, 1u << 26), 1u);
+    SEQAN_ASSERT_EQ(_tabixReg2Bin(0, (1u << 26) + 1), 0u);
+
+    // The bin of each region is one of the candidate bins of all overlapping regions.
+    String<__uint32> bins;
+    _tabixReg2Bins(bins, 100000, 100001);
+    SEQAN_ASSERT_EQ(length(bins), 6u);
+    SEQAN_ASSERT(std::find(begin(bins, Standard()), end(bins, Standard()), _tabixReg2Bin(99000, 100001)) !=
+                 end(bins, Standard()));
+    SEQAN_ASSERT(std::find(begin(bins, Standard()), end(bins, Standard()), _tabixReg2Bin(0, 1000000)) !=
+                 end(bins, Standard()));
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_parse_interval)
+{
+    using namespace seqan;
+
+    TabixIndex index;
+    CharString seqName;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+
+    _tabixSetPreset(index, Vcf());
+    SEQAN_ASSERT(_tabixParseInterval(seqName, beginPos, endPos, "20\t14370\trs6054257\tG\tA\t29\tPASS\tNS=3", index));
+    SEQAN_ASSERT_EQ(seqName, "20");
+    SEQAN_ASSERT_EQ(beginPos, 14369);
+    SEQAN_ASSERT_EQ(endPos, 14370);
+    SEQAN_ASSERT(_tabixParseInterval(seqName, beginPos, endPos, "20\t1234567\tmicrosat1\tGTCT\tG,GTACT\t50", index));
+    SEQAN_ASSERT_EQ(beginPos, 1234566);
+    SEQAN_ASSERT_EQ(endPos, 1234570);
+    SEQAN_ASSERT(_tabixParseInterval(seqName, beginPos, endPos, "2\t321682\t.\tT\t<DEL>\t6\tPASS\tSVTYPE=DEL;END=321887",
+                                     index));
+    SEQAN_ASSERT_EQ(beginPos, 321681);
+    SEQAN_ASSERT_EQ(endPos, 321887);
+    SEQAN_ASSERT_NOT(_tabixParseInterval(seqName, beginPos, endPos, "20\tx\t.\tG\tA", index));
+
+    _tabixSetPreset(index, Bed());
+    SEQAN_ASSERT(_tabixParseInterval(seqName, beginPos, endPos, "chr7\t127471196\t127472363\tPos1", index));
+    SEQAN_ASSERT_EQ(seqName, "chr7");
+    SEQAN_ASSERT_EQ(beginPos, 127471196);
+    SEQAN_ASSERT_EQ(endPos, 127472363);
+
+    _tabixSetPreset(index, Gff());
+    SEQAN_ASSERT(_tabixParseInterval(seqName, beginPos, endPos, "ctg123\t.\tgene\t1000\t9000\t.\t+\t.\tID=gene00001",
+                                     index));
+    SEQAN_ASSERT_EQ(seqName, "ctg123");
+    SEQAN_ASSERT_EQ(beginPos, 999);
+    SEQAN_ASSERT_EQ(endPos, 9000);
+    SEQAN_ASSERT_NOT(_tabixParseInterval(seqName, beginPos, endPos, "ctg123\t.\tgene", index));
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_vcf)
+{
+    using namespace seqan;
+
+    // SNVs every 1000bp on chr1 and chr2, a long deletion [100000, 150000) on chr2.
+    std::ostringstream text;
+    text << "##fileformat=VCFv4.1\n"
+         << "##contig=<ID=chr1,length=5000000>\n"
+         << "##contig=<ID=chr2,length=5000000>\n"
+         << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+    for (unsigned k = 0; k < 4000; ++k)
+        text << "chr1\t" << 1000 * k + 1 << "\t.\tA\tC\t.\tPASS\t.\n";
+    for (unsigned k = 0; k < 300; ++k)
+    {
+        text << "chr2\t" << 1000 * k + 1 << "\t.\tA\tC\t.\tPASS\t.\n";
+        if (k == 100)
+            text << "chr2\t100001\tdel1\tA\t<DEL>\t.\tPASS\tSVTYPE=DEL;END=150000\n";
+    }
+
+    // BGZF files are often named .gz, they must be read with virtual offsets nevertheless.
+    std::string vcfPath = (std::string)SEQAN_TEMP_FILENAME() + ".vcf.gz";
+    std::string tbiPath = vcfPath + ".tbi";
+    writeBgzfTestFile(vcfPath, text.str());
+
+    VcfFileIn vcfFile(vcfPath.c_str());
+    VcfHeader header;
+    readHeader(header, vcfFile);
+
+    TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, vcfFile));
+    SEQAN_ASSERT_EQ(length(index._seqNames), 2u);
+    SEQAN_ASSERT_EQ(index._seqNames[0], "chr1");
+    SEQAN_ASSERT_EQ(index._seqNames[1], "chr2");
+    SEQAN_ASSERT_EQ(length(index._linearIndices[0]), (3999000u >> 14) + 1);
+
+    // Save and load the index again.
+    SEQAN_ASSERT(save(index, tbiPath.c_str()));
+    TabixIndex loaded;
+    SEQAN_ASSERT(open(loaded, tbiPath.c_str()));
+    testTabixIndexEqual(index, loaded);
+
+    VcfRecord record;
+    bool hasEntries = false;
+
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr1", 2000000, 2000500, loaded));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, vcfFile);
+    SEQAN_ASSERT_EQ(record.rID, 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 2000000);
+
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr1", 0, 1, loaded));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, vcfFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 0);
+
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr1", 2000001, 2001000, loaded));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr1", 100000000, 100001000, loaded));
+    SEQAN_ASSERT_NOT(hasEntries);
+
+    // The deletion is the first entry overlapping regions inside of it.
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr2", 120000, 120100, loaded));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, vcfFile);
+    SEQAN_ASSERT_EQ(record.rID, 1);
+    SEQAN_ASSERT_EQ(record.beginPos, 100000);
+    SEQAN_ASSERT_EQ(record.id, "del1");
+    readRecord(record, vcfFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 101000);
+
+    SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr2", 150000, 150001, loaded));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, vcfFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 150000);
+
+    // Compare with the expected first entries of a range of regions on chr1.
+    for (__int32 pos = 0; pos < 4100000; pos += 12345)
+    {
+        __int32 posEnd = pos + 700;
+        __int32 expected = (pos + 999) / 1000 * 1000;
+        bool expectEntries = expected < posEnd && expected < 4000000;
+
+        SEQAN_ASSERT(jumpToRegion(vcfFile, hasEntries, "chr1", pos, posEnd, loaded));
+        SEQAN_ASSERT_EQ(hasEntries, expectEntries);
+        if (!hasEntries)
+            continue;
+        readRecord(record, vcfFile);
+        SEQAN_ASSERT_EQ(record.rID, 0);
+        SEQAN_ASSERT_EQ(record.beginPos, expected);
+    }
+
+    // Unknown sequences and invalid regions cannot be jumped to.
+    SEQAN_ASSERT_NOT(jumpToRegion(vcfFile, hasEntries, "chr3", 0, 1000, loaded));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT_NOT(jumpToRegion(vcfFile, hasEntries, "chr1", 1000, 1000, loaded));
+
+    // The same file with bgzip's .bgz extension can be jumped in as well.
+    std::string bgzPath = (std::string)SEQAN_TEMP_FILENAME() + ".vcf.bgz";
+    writeBgzfTestFile(bgzPath, text.str());
+    VcfFileIn bgzFile(bgzPath.c_str());
+    readHeader(header, bgzFile);
+    SEQAN_ASSERT(jumpToRegion(bgzFile, hasEntries, "chr1", 2000000, 2000500, loaded));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, bgzFile);
+    SEQAN_ASSERT_EQ(record.beginPos, 2000000);
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_bed)
+{
+    using namespace seqan;
+
+    std::ostringstream text;
+    for (unsigned k = 0; k < 3000; ++k)
+        text << "chr1\t" << 500 * k << '\t' << 500 * k + 100 << "\tname" << k << '\n';
+    for (unsigned k = 0; k < 3000; ++k)
+        text << "chr2\t" << 500 * k << '\t' << 500 * k + 100 << "\tname" << k << '\n';
+
+    std::string bedPath = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath, text.str());
+
+    BedFileIn bedFile(bedPath.c_str());
+    TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, bedFile));
+    SEQAN_ASSERT_EQ(index._format, TabixIndex::TBI_UCSC);
+    SEQAN_ASSERT_EQ(length(index._seqNames), 2u);
+
+    BedRecord<Bed3> record;
+    bool hasEntries = false;
+
+    SEQAN_ASSERT(jumpToRegion(bedFile, hasEntries, "chr2", 1234567, 1234600, index));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, bedFile);
+    SEQAN_ASSERT_EQ(record.ref, "chr2");
+    SEQAN_ASSERT_EQ(record.beginPos, 1234500);
+    SEQAN_ASSERT_EQ(record.endPos, 1234600);
+
+    // BED intervals are half-open.
+    SEQAN_ASSERT(jumpToRegion(bedFile, hasEntries, "chr1", 1234600, 1234700, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT(jumpToRegion(bedFile, hasEntries, "chr1", 1234600, 1235001, index));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, bedFile);
+    SEQAN_ASSERT_EQ(record.ref, "chr1");
+    SEQAN_ASSERT_EQ(record.beginPos, 1235000);
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_gff)
+{
+    using namespace seqan;
+
+    std::ostringstream text;
+    text << "##gff-version 3\n";
+    for (unsigned k = 0; k < 3000; ++k)
+        text << "ctg123\t.\tgene\t" << 500 * k + 1 << '\t' << 500 * k + 100 << "\t.\t+\t.\tID=gene" << k << '\n';
+
+    std::string gffPath = (std::string)SEQAN_TEMP_FILENAME() + ".gff.bgzf";
+    writeBgzfTestFile(gffPath, text.str());
+
+    GffFileIn gffFile(gffPath.c_str());
+    TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, gffFile));
+    SEQAN_ASSERT_EQ(index._colBeg, 4);
+    SEQAN_ASSERT_EQ(index._colEnd, 5);
+
+    GffRecord record;
+    bool hasEntries = false;
+
+    SEQAN_ASSERT(jumpToRegion(gffFile, hasEntries, "ctg123", 1000050, 1000051, index));
+    SEQAN_ASSERT(hasEntries);
+    readRecord(record, gffFile);
+    SEQAN_ASSERT_EQ(record.ref, "ctg123");
+    SEQAN_ASSERT_EQ(record.beginPos, 1000000u);
+    SEQAN_ASSERT_EQ(record.endPos, 1000100u);
+    SEQAN_ASSERT_EQ(record.tagValues[0], "gene2000");
+
+    SEQAN_ASSERT(jumpToRegion(gffFile, hasEntries, "ctg123", 1000100, 1000500, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_unsorted)
+{
+    using namespace seqan;
+
+    TabixIndex index;
+
+    std::string bedPath = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath, "chr1\t100\t200\nchr2\t100\t200\nchr1\t300\t400\n");
+    BedFileIn bedFile(bedPath.c_str());
+    SEQAN_ASSERT_NOT(buildIndex(index, bedFile));
+
+    std::string bedPath2 = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath2, "chr1\t300\t400\nchr1\t100\t200\n");
+    BedFileIn bedFile2(bedPath2.c_str());
+    SEQAN_ASSERT_NOT(buildIndex(index, bedFile2));
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_max_pos)
+{
+    using namespace seqan;
+
+    TabixIndex index;
+
+    // The bins cover [0, 2^29), entries ending behind that cannot be indexed.
+    std::string bedPath = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath, "chr1\t536870910\t536870912\n");
+    BedFileIn bedFile(bedPath.c_str());
+    SEQAN_ASSERT(buildIndex(index, bedFile));
+
+    std::string bedPath2 = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath2, "chr1\t100\t200\nchr1\t536870911\t536870913\n");
+    BedFileIn bedFile2(bedPath2.c_str());
+    SEQAN_ASSERT_NOT(buildIndex(index, bedFile2));
+
+    std::string bedPath3 = (std::string)SEQAN_TEMP_FILENAME() + ".bed.bgzf";
+    writeBgzfTestFile(bedPath3, "chr1\t600000000\t600000100\n");
+    BedFileIn bedFile3(bedPath3.c_str());
+    SEQAN_ASSERT_NOT(buildIndex(index, bedFile3));
+}
+
+SEQAN_DEFINE_TEST(test_tabix_io_uncompressed)
+{
+    using namespace seqan;
+
+    // Only BGZF-compressed files can be indexed.
+    CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+
+    VcfFileIn vcfFile(toCString(vcfPath));
+    VcfHeader header;
+    readHeader(header, vcfFile);
+
+    TabixIndex index;
+    SEQAN_ASSERT_NOT(buildIndex(index, vcfFile));
+
+    bool hasEntries = true;
+    SEQAN_ASSERT_NOT(jumpToRegion(vcfFile, hasEntries, "20", 0, 100000, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+}
+
+#endif  // TESTS_TABIX_IO_TEST_TABIX_INDEX_H_
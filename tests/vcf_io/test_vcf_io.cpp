@@ -47,5 +47,13 @@ SEQAN_BEGIN_TESTSUITE(test_vcf_io)
     SEQAN_CALL_TEST(test_vcf_io_write_vcf_header);
     SEQAN_CALL_TEST(test_vcf_io_write_vcf_record);
     SEQAN_CALL_TEST(test_vcf_io_vcf_file_write_record);
+    SEQAN_CALL_TEST(test_vcf_io_vcf_lazy_genotypes);
+
+    SEQAN_CALL_TEST(test_vcf_io_bcf_read_write);
+    SEQAN_CALL_TEST(test_vcf_io_bcf_typed_values);
+    SEQAN_CALL_TEST(test_vcf_io_bcf_lazy_genotypes);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_vcf_io_bcf_file);
+#endif
 }
 SEQAN_END_TESTSUITE
@@ -467,4 +467,522 @@ SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_write_record)
     SEQAN_ASSERT(seqan::_compareTextFilesAlt(tmpPath.c_str(), toCString(goldPath)));
 }
 
+// Compare two records field by field, the missing quality is a NaN.
+inline void
+testVcfRecordEqual(seqan::VcfRecord const & record, seqan::VcfRecord const & expected)
+{
+    SEQAN_ASSERT_EQ(record.rID, expected.rID);
+    SEQAN_ASSERT_EQ(record.beginPos, expected.beginPos);
+    SEQAN_ASSERT_EQ(record.id, expected.id);
+    SEQAN_ASSERT_EQ(record.ref, expected.ref);
+    SEQAN_ASSERT_EQ(record.alt, expected.alt);
+    if (expected.qual == expected.qual)
+        SEQAN_ASSERT_EQ(record.qual, expected.qual);
+    else
+        SEQAN_ASSERT_NEQ(record.qual, record.qual);
+    SEQAN_ASSERT_EQ(record.filter, expected.filter);
+    SEQAN_ASSERT_EQ(record.info, expected.info);
+    SEQAN_ASSERT_EQ(record.format, expected.format);
+    SEQAN_ASSERT_EQ(length(record.genotypeInfos), length(expected.genotypeInfos));
+    for (unsigned i = 0; i < length(expected.genotypeInfos); ++i)
+        SEQAN_ASSERT_EQ(record.genotypeInfos[i], expected.genotypeInfos[i]);
+}
+
+SEQAN_DEFINE_TEST(test_vcf_io_bcf_read_write)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+
+    std::ifstream file(toCString(vcfPath));
+    seqan::DirectionIterator<std::ifstream, seqan::Input>::Type iter = directionIterator(file, seqan::Input());
+
+    seqan::VcfHeader header;
+    seqan::VcfIOContext<> context;
+    seqan::String<seqan::VcfRecord> records;
+    readHeader(header, context, iter, seqan::Vcf());
+    while (!atEnd(iter))
+    {
+        resize(records, length(records) + 1);
+        readRecord(back(records), context, iter, seqan::Vcf());
+    }
+    SEQAN_ASSERT_EQ(length(records), 3u);
+
+    // Encode as uncompressed BCF.
+    seqan::CharString bcf;
+    writeHeader(bcf, header, context, seqan::Bcf());
+    size_t headerLength = length(bcf);
+    for (unsigned i = 0; i < length(records); ++i)
+        writeRecord(bcf, records[i], context, seqan::Bcf());
+
+    SEQAN_ASSERT_EQ(prefix(bcf, 5), "BCF\2\2");
+
+    // The first record starts with CHROM 0 and POS 14369, its alleles are 1-character strings.
+    char const * it = begin(bcf, seqan::Standard()) + headerLength + 8;
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__int32>(it), 0);
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__int32>(it), 14369);
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__int32>(it), 1);
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<float>(it), 29.0f);
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__uint32>(it), (2u << 16) | 5u);
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__uint32>(it), (4u << 24) | 3u);
+
+    // Decode again, PASS is added to the header.
+    seqan::VcfHeader header2;
+    seqan::VcfIOContext<> context2;
+    seqan::Iterator<seqan::CharString, seqan::Rooted>::Type bcfIter = begin(bcf);
+    readHeader(header2, context2, bcfIter, seqan::Bcf());
+
+    SEQAN_ASSERT_EQ(length(header2), length(header) + 1);
+    SEQAN_ASSERT_EQ(header2[0].key, "fileformat");
+    SEQAN_ASSERT_EQ(header2[1].key, "FILTER");
+    SEQAN_ASSERT_EQ(header2[1].value, "<ID=PASS,Description=\"All filters passed\">");
+    for (unsigned i = 1; i < length(header); ++i)
+    {
+        SEQAN_ASSERT_EQ(header2[i + 1].key, header[i].key);
+        SEQAN_ASSERT_EQ(header2[i + 1].value, header[i].value);
+    }
+    SEQAN_ASSERT_EQ(length(contigNames(context2)), 1u);
+    SEQAN_ASSERT_EQ(contigNames(context2)[0], "20");
+    SEQAN_ASSERT_EQ(length(sampleNames(context2)), 3u);
+    SEQAN_ASSERT_EQ(sampleNames(context2)[2], "NA00003");
+
+    seqan::VcfRecord record;
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        SEQAN_ASSERT_NOT(atEnd(bcfIter));
+        readRecord(record, context2, bcfIter, seqan::Bcf());
+        testVcfRecordEqual(record, records[i]);
+    }
+    SEQAN_ASSERT(atEnd(bcfIter));
+}
+
+SEQAN_DEFINE_TEST(test_vcf_io_bcf_typed_values)
+{
+    seqan::VcfIOContext<> context;
+    appendName(contigNamesCache(context), "chr1");
+    appendName(contigNamesCache(context), "chr2");
+    appendName(sampleNamesCache(context), "S1");
+    appendName(sampleNamesCache(context), "S2");
+
+    // No contig lines, they are added for the BCF contig dictionary.
+    seqan::VcfHeader header;
+    appendValue(header, seqan::VcfHeaderRecord("fileformat", "VCFv4.2"));
+    appendValue(header, seqan::VcfHeaderRecord("FILTER", "<ID=PASS,Description=\"All filters passed\">"));
+    appendValue(header, seqan::VcfHeaderRecord("FILTER", "<ID=lowq,Description=\"Low, quality\">"));
+    appendValue(header, seqan::VcfHeaderRecord("INFO", "<ID=END,Number=1,Type=Integer,Description=\"End\">"));
+    appendValue(header, seqan::VcfHeaderRecord("INFO", "<ID=VALS,Number=.,Type=Integer,Description=\"Values\">"));
+    appendValue(header, seqan::VcfHeaderRecord("INFO", "<ID=NOTE,Number=1,Type=String,Description=\"A, note\">"));
+    appendValue(header, seqan::VcfHeaderRecord("FORMAT", "<ID=GT,Number=1,Type=String,Description=\"Genotype\">"));
+    appendValue(header, seqan::VcfHeaderRecord("FORMAT", "<ID=DP,Number=1,Type=Integer,Description=\"Depth\">"));
+    appendValue(header, seqan::VcfHeaderRecord("FORMAT", "<ID=FT,Number=1,Type=String,Description=\"Filter\">"));
+    appendValue(header, seqan::VcfHeaderRecord("FORMAT", "<ID=AB,Number=.,Type=Float,Description=\"Balance\">"));
+
+    seqan::String<seqan::VcfRecord> records;
+    resize(records, 3);
+
+    // Large and negative integers, 16 values need an extra count, a missing genotype, absent fields.
+    records[0].rID = 1;
+    records[0].beginPos = 99;
+    records[0].id = "var1;var2";
+    records[0].ref = "ACGT";
+    records[0].alt = "A,<DEL>";
+    records[0].qual = 12.5;
+    records[0].filter = "lowq";
+    records[0].info = "END=1000;VALS=1,-200,70000,.,5,6,7,8,9,10,11,12,13,14,15,16;NOTE=x y";
+    records[0].format = "GT:DP:FT:AB";
+    appendValue(records[0].genotypeInfos, "0/1:300:ok:0.25,0.75");
+    appendValue(records[0].genotypeInfos, "./.:.:.:.");
+
+    // Mixed phasing and ploidy, an absent field in the middle of a sample.
+    records[1].rID = 0;
+    records[1].beginPos = 5;
+    records[1].id = ".";
+    records[1].ref = "C";
+    records[1].alt = ".";
+    records[1].filter = "PASS";
+    records[1].info = ".";
+    records[1].format = "GT:DP:FT";
+    appendValue(records[1].genotypeInfos, "1|0|2");
+    appendValue(records[1].genotypeInfos, "1::bad");
+
+    // No FILTER, INFO or FORMAT.
+    records[2].rID = 0;
+    records[2].beginPos = 6;
+    records[2].id = "x";
+    records[2].ref = "G";
+    records[2].alt = "T";
+    records[2].filter = ".";
+    records[2].info = ".";
+    records[2].format = ".";
+    appendValue(records[2].genotypeInfos, ".");
+    appendValue(records[2].genotypeInfos, ".");
+
+    seqan::CharString bcf;
+    writeHeader(bcf, header, context, seqan::Bcf());
+    size_t headerLength = length(bcf);
+    for (unsigned i = 0; i < length(records); ++i)
+        writeRecord(bcf, records[i], context, seqan::Bcf());
+
+    // rlen is taken from INFO/END.
+    char const * it = begin(bcf, seqan::Standard()) + headerLength + 16;
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__int32>(it), 901);
+
+    seqan::VcfHeader header2;
+    seqan::VcfIOContext<> context2;
+    seqan::Iterator<seqan::CharString, seqan::Rooted>::Type bcfIter = begin(bcf);
+    readHeader(header2, context2, bcfIter, seqan::Bcf());
+    SEQAN_ASSERT_EQ(length(header2), length(header) + 2);
+    SEQAN_ASSERT_EQ(header2[length(header)].value, "<ID=chr1>");
+    SEQAN_ASSERT_EQ(header2[length(header) + 1].value, "<ID=chr2>");
+    SEQAN_ASSERT_EQ(length(contigNames(context2)), 2u);
+
+    seqan::VcfRecord record;
+    readRecord(record, context2, bcfIter, seqan::Bcf());
+    testVcfRecordEqual(record, records[0]);
+    readRecord(record, context2, bcfIter, seqan::Bcf());
+    records[1].genotypeInfos[1] = "1:.:bad";  // empty fields are read as missing
+    testVcfRecordEqual(record, records[1]);
+    readRecord(record, context2, bcfIter, seqan::Bcf());
+    testVcfRecordEqual(record, records[2]);
+    SEQAN_ASSERT(atEnd(bcfIter));
+
+    // Values must not be read across the end of the shared section.
+    seqan::CharString corrupt = bcf;
+    char * lengths = begin(corrupt, seqan::Standard()) + headerLength;
+    __uint32 lShared, lIndiv;
+    std::memcpy(&lShared, lengths, 4);
+    std::memcpy(&lIndiv, lengths + 4, 4);
+    lShared -= 8;
+    lIndiv += 8;
+    std::memcpy(lengths, &lShared, 4);
+    std::memcpy(lengths + 4, &lIndiv, 4);
+    bcfIter = begin(corrupt);
+    readHeader(header2, context2, bcfIter, seqan::Bcf());
+    SEQAN_TEST_EXCEPTION(seqan::ParseError, readRecord(record, context2, bcfIter, seqan::Bcf()));
+
+    // An END before POS does not give the record a negative length.
+    records[2].info = "END=3";
+    clear(bcf);
+    writeRecord(bcf, records[2], context, seqan::Bcf());
+    it = begin(bcf, seqan::Standard()) + 16;
+    SEQAN_ASSERT_EQ(seqan::_bcfReadPod<__int32>(it), 1);
+
+    // Keys have to be declared in the header.
+    records[2].info = "UNDECLARED=1";
+    SEQAN_TRY
+    {
+        writeRecord(bcf, records[2], context, seqan::Bcf());
+        SEQAN_ASSERT_FAIL("Expected an exception.");
+    }
+    SEQAN_CATCH(seqan::ParseError const &)
+    {}
+}
+
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_lazy_genotypes)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+    std::string tmpPath = (std::string)SEQAN_TEMP_FILENAME() + ".vcf";
+
+    // Read the records with split and with lazy genotypes.
+    seqan::VcfHeader header;
+    seqan::String<seqan::VcfRecord> records;
+    {
+        seqan::VcfFileIn vcfIn(toCString(vcfPath));
+        readHeader(header, vcfIn);
+        while (!atEnd(vcfIn))
+        {
+            resize(records, length(records) + 1);
+            readRecord(back(records), vcfIn);
+        }
+    }
+
+    seqan::VcfFileIn vcfIn(toCString(vcfPath));
+    context(vcfIn).lazyGenotypes = true;
+    seqan::VcfFileOut vcfOut(vcfIn, tmpPath.c_str());
+    readHeader(header, vcfIn);
+    writeHeader(vcfOut, header);
+
+    seqan::String<__int32> codes;
+    seqan::String<int> depths;
+    seqan::CharString eagerBcf;
+    seqan::CharString lazyBcf;
+    writeHeader(eagerBcf, header, context(vcfIn), seqan::Bcf());
+    lazyBcf = eagerBcf;
+    seqan::VcfRecord record;
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        SEQAN_ASSERT_NOT(atEnd(vcfIn));
+        readRecord(record, vcfIn);
+        SEQAN_ASSERT(empty(record.genotypeInfos));
+        SEQAN_ASSERT_EQ(record.format, records[i].format);
+        SEQAN_ASSERT_EQ(numGenotypeInfos(record), 3u);
+        SEQAN_ASSERT_EQ(numGenotypeInfos(records[i]), 3u);
+        for (unsigned s = 0; s < 3u; ++s)
+        {
+            SEQAN_ASSERT_EQ(getGenotypeInfo(record, s), records[i].genotypeInfos[s]);
+            SEQAN_ASSERT_EQ(getGenotypeInfo(records[i], s), records[i].genotypeInfos[s]);
+        }
+
+        // Both kinds of records decode the same columns and are written identically.
+        seqan::String<__int32> eagerCodes;
+        seqan::String<int> eagerDepths;
+        SEQAN_ASSERT_EQ(getGenotypes(codes, record), 2u);
+        SEQAN_ASSERT_EQ(getGenotypes(eagerCodes, records[i]), 2u);
+        SEQAN_ASSERT(codes == eagerCodes);
+        SEQAN_ASSERT(getFormatInts(depths, record, "DP"));
+        SEQAN_ASSERT(getFormatInts(eagerDepths, records[i], "DP"));
+        SEQAN_ASSERT(depths == eagerDepths);
+
+        writeRecord(vcfOut, record);
+        writeRecord(lazyBcf, record, context(vcfIn), seqan::Bcf());
+        writeRecord(eagerBcf, records[i], context(vcfIn), seqan::Bcf());
+    }
+    SEQAN_ASSERT(atEnd(vcfIn));
+    SEQAN_ASSERT(lazyBcf == eagerBcf);
+    close(vcfOut);
+    SEQAN_ASSERT(seqan::_compareTextFilesAlt(tmpPath.c_str(), toCString(vcfPath)));
+
+    // The last record: 1|2:21:6:23,27  2|1:2:0:18,2  2/2:35:4
+    SEQAN_ASSERT_EQ(length(codes), 6u);
+    SEQAN_ASSERT_EQ(codes[0], 2 << 1);
+    SEQAN_ASSERT_EQ(codes[1], 3 << 1 | 1);
+    SEQAN_ASSERT_EQ(codes[2], 3 << 1);
+    SEQAN_ASSERT_EQ(codes[3], 2 << 1 | 1);
+    SEQAN_ASSERT_EQ(codes[4], 3 << 1);
+    SEQAN_ASSERT_EQ(codes[5], 3 << 1);
+    SEQAN_ASSERT_EQ(depths[0], 6);
+    SEQAN_ASSERT_EQ(depths[1], 0);
+    SEQAN_ASSERT_EQ(depths[2], 4);
+
+    SEQAN_ASSERT(getFormatInts(depths, record, "HQ"));
+    SEQAN_ASSERT_EQ(depths[0], 23);
+    SEQAN_ASSERT_EQ(depths[1], 18);
+    SEQAN_ASSERT_EQ(depths[2], seqan::MinValue<int>::VALUE);
+    SEQAN_ASSERT_NOT(getFormatInts(depths, record, "XX"));
+    SEQAN_ASSERT(empty(depths));
+
+    // Missing and haploid genotypes, missing and absent values.
+    clear(record);
+    record.format = "DP:GT";
+    record._genotypeData = "3:0/1\t.:.\t.:1\t7\t5:./.\t6:.|.";
+    seqan::_vcfSplitGenotypes(record, 6u);
+    SEQAN_ASSERT_EQ(numGenotypeInfos(record), 6u);
+    SEQAN_ASSERT_EQ(getGenotypeInfo(record, 3), "7");
+    SEQAN_ASSERT_EQ(getGenotypes(codes, record), 2u);
+    SEQAN_ASSERT_EQ(length(codes), 12u);
+    SEQAN_ASSERT_EQ(codes[0], 1 << 1);
+    SEQAN_ASSERT_EQ(codes[1], 2 << 1);
+    SEQAN_ASSERT_EQ(codes[2], 0);
+    SEQAN_ASSERT_EQ(codes[3], -1);
+    SEQAN_ASSERT_EQ(codes[4], 2 << 1);
+    SEQAN_ASSERT_EQ(codes[5], -1);
+    SEQAN_ASSERT_EQ(codes[6], -1);
+    SEQAN_ASSERT_EQ(codes[7], -1);
+    SEQAN_ASSERT_EQ(codes[8], 0);
+    SEQAN_ASSERT_EQ(codes[9], 0);
+    SEQAN_ASSERT_EQ(codes[10], 0);
+    SEQAN_ASSERT_EQ(codes[11], 1);
+    SEQAN_ASSERT(getFormatInts(depths, record, "DP"));
+    SEQAN_ASSERT_EQ(length(depths), 6u);
+    SEQAN_ASSERT_EQ(depths[0], 3);
+    SEQAN_ASSERT_EQ(depths[1], seqan::MinValue<int>::VALUE);
+    SEQAN_ASSERT_EQ(depths[2], seqan::MinValue<int>::VALUE);
+    SEQAN_ASSERT_EQ(depths[3], 7);
+    SEQAN_ASSERT_EQ(depths[4], 5);
+    SEQAN_ASSERT_EQ(depths[5], 6);
+
+    // Like with split genotypes, there must be one non-empty column per sample, additional columns are cut off.
+    seqan::VcfIOContext<> lazyContext;
+    lazyContext.lazyGenotypes = true;
+    appendValue(sampleNames(lazyContext), "NA00001");
+    appendValue(sampleNames(lazyContext), "NA00002");
+    seqan::CharString prefix = "20\t14370\trs6054257\tG\tA\t29\tPASS\tNS=3\tGT:DP\t";
+
+    seqan::CharString line = prefix;
+    append(line, "0|0:1\t1|0:8\t1/1:5\n");
+    seqan::Iterator<seqan::CharString, seqan::Rooted>::Type iter = begin(line);
+    seqan::readRecord(record, lazyContext, iter, seqan::Vcf());
+    SEQAN_ASSERT(atEnd(iter));
+    SEQAN_ASSERT_EQ(numGenotypeInfos(record), 2u);
+    SEQAN_ASSERT_EQ(getGenotypeInfo(record, 1), "1|0:8");
+    SEQAN_ASSERT_EQ(record._genotypeData, "0|0:1\t1|0:8");
+
+    char const * invalidColumns[] = { "0|0:1\n", "0|0:1\t\n", "\t1|0:8\n" };
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        line = prefix;
+        append(line, invalidColumns[i]);
+        iter = begin(line);
+        SEQAN_TEST_EXCEPTION(seqan::ParseError, seqan::readRecord(record, lazyContext, iter, seqan::Vcf()));
+    }
+    line = prefix;
+    append(line, "0|0:1\t\n");
+    iter = begin(line);
+    SEQAN_TEST_EXCEPTION(seqan::EmptyFieldError, seqan::readRecord(record, lazyContext, iter, seqan::Vcf()));
+}
+
+SEQAN_DEFINE_TEST(test_vcf_io_bcf_lazy_genotypes)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+
+    std::ifstream file(toCString(vcfPath));
+    seqan::DirectionIterator<std::ifstream, seqan::Input>::Type iter = directionIterator(file, seqan::Input());
+
+    seqan::VcfHeader header;
+    seqan::VcfIOContext<> context;
+    seqan::String<seqan::VcfRecord> records;
+    readHeader(header, context, iter, seqan::Vcf());
+    while (!atEnd(iter))
+    {
+        resize(records, length(records) + 1);
+        readRecord(back(records), context, iter, seqan::Vcf());
+    }
+
+    // Mixed ploidy and an absent field in the middle of a sample.
+    resize(records, length(records) + 1);
+    back(records) = records[0];
+    back(records).format = "GT:DP:GQ";
+    back(records).genotypeInfos[0] = "1|0|2";
+    back(records).genotypeInfos[1] = "1:.:7";
+    back(records).genotypeInfos[2] = ".";
+
+    seqan::CharString bcf;
+    writeHeader(bcf, header, context, seqan::Bcf());
+    for (unsigned i = 0; i < length(records); ++i)
+        writeRecord(bcf, records[i], context, seqan::Bcf());
+
+    // Read the records with split and with lazy genotypes.
+    seqan::VcfHeader header2;
+    seqan::VcfIOContext<> eagerContext;
+    seqan::VcfIOContext<> lazyContext;
+    lazyContext.lazyGenotypes = true;
+    seqan::Iterator<seqan::CharString, seqan::Rooted>::Type eagerIter = begin(bcf);
+    seqan::Iterator<seqan::CharString, seqan::Rooted>::Type lazyIter = begin(bcf);
+    readHeader(header2, eagerContext, eagerIter, seqan::Bcf());
+    readHeader(header2, lazyContext, lazyIter, seqan::Bcf());
+
+    seqan::CharString eagerBcf;
+    seqan::CharString lazyBcf;
+    seqan::CharString eagerVcf;
+    seqan::CharString lazyVcf;
+    writeHeader(eagerBcf, header2, eagerContext, seqan::Bcf());
+    lazyBcf = eagerBcf;
+
+    seqan::VcfRecord eager;
+    seqan::VcfRecord lazy;
+    seqan::CharString info;
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        readRecord(eager, eagerContext, eagerIter, seqan::Bcf());
+        readRecord(lazy, lazyContext, lazyIter, seqan::Bcf());
+        SEQAN_ASSERT(empty(lazy.genotypeInfos));
+        SEQAN_ASSERT_EQ(lazy.format, eager.format);
+        SEQAN_ASSERT_EQ(numGenotypeInfos(lazy), 3u);
+        for (unsigned s = 0; s < 3u; ++s)
+        {
+            clear(info);
+            appendGenotypeInfo(info, lazy, s);
+            SEQAN_ASSERT_EQ(info, eager.genotypeInfos[s]);
+        }
+
+        // The typed values are decoded like the text of the columns.
+        seqan::String<__int32> codes;
+        seqan::String<__int32> eagerCodes;
+        SEQAN_ASSERT_EQ(getGenotypes(codes, lazy), getGenotypes(eagerCodes, eager));
+        SEQAN_ASSERT(codes == eagerCodes);
+        for (unsigned k = 0; k < 3u; ++k)
+        {
+            char const * keys[] = {"DP", "GQ", "HQ"};
+            seqan::String<int> values;
+            seqan::String<int> eagerValues;
+            SEQAN_ASSERT_EQ(getFormatInts(values, lazy, keys[k]), getFormatInts(eagerValues, eager, keys[k]));
+            SEQAN_ASSERT(values == eagerValues);
+        }
+
+        writeRecord(eagerBcf, eager, eagerContext, seqan::Bcf());
+        writeRecord(lazyBcf, lazy, lazyContext, seqan::Bcf());
+        writeRecord(eagerVcf, eager, eagerContext, seqan::Vcf());
+        writeRecord(lazyVcf, lazy, lazyContext, seqan::Vcf());
+    }
+    SEQAN_ASSERT(atEnd(lazyIter));
+    SEQAN_ASSERT(lazyBcf == eagerBcf);
+    SEQAN_ASSERT_EQ(lazyVcf, eagerVcf);
+
+    // The last record: 1|0|2  1:.:7  .
+    seqan::String<__int32> codes;
+    SEQAN_ASSERT_EQ(getGenotypes(codes, lazy), 3u);
+    SEQAN_ASSERT_EQ(length(codes), 9u);
+    SEQAN_ASSERT_EQ(codes[0], 2 << 1);
+    SEQAN_ASSERT_EQ(codes[1], 1 << 1 | 1);
+    SEQAN_ASSERT_EQ(codes[2], 3 << 1 | 1);
+    SEQAN_ASSERT_EQ(codes[3], 2 << 1);
+    SEQAN_ASSERT_EQ(codes[4], -1);
+    SEQAN_ASSERT_EQ(codes[6], 0);
+    SEQAN_ASSERT_EQ(codes[7], -1);
+    seqan::String<int> values;
+    SEQAN_ASSERT(getFormatInts(values, lazy, "GQ"));
+    SEQAN_ASSERT_EQ(values[0], seqan::MinValue<int>::VALUE);
+    SEQAN_ASSERT_EQ(values[1], 7);
+    SEQAN_ASSERT_EQ(values[2], seqan::MinValue<int>::VALUE);
+
+    // Samples that are missing in the record are padded.
+    appendName(sampleNamesCache(lazyContext), "NA00004");
+    clear(bcf);
+    writeHeader(bcf, header2, lazyContext, seqan::Bcf());
+    writeRecord(bcf, lazy, lazyContext, seqan::Bcf());
+    lazyIter = begin(bcf);
+    seqan::VcfIOContext<> paddedContext;
+    readHeader(header2, paddedContext, lazyIter, seqan::Bcf());
+    readRecord(eager, paddedContext, lazyIter, seqan::Bcf());
+    SEQAN_ASSERT_EQ(length(eager.genotypeInfos), 4u);
+    SEQAN_ASSERT_EQ(eager.genotypeInfos[0], "1|0|2");
+    SEQAN_ASSERT_EQ(eager.genotypeInfos[1], "1:.:7");
+    SEQAN_ASSERT_EQ(eager.genotypeInfos[3], ".");
+}
+
+#if SEQAN_HAS_ZLIB
+SEQAN_DEFINE_TEST(test_vcf_io_bcf_file)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+    std::string bcfPath = (std::string)SEQAN_TEMP_FILENAME() + ".bcf";
+
+    seqan::VcfHeader header;
+    seqan::String<seqan::VcfRecord> records;
+    {
+        // The output format and BGZF compression are chosen by the extension.
+        seqan::VcfFileIn vcfIn(toCString(vcfPath));
+        seqan::VcfFileOut bcfOut(vcfIn, bcfPath.c_str());
+        SEQAN_ASSERT(isEqual(format(bcfOut), seqan::Bcf()));
+
+        readHeader(header, vcfIn);
+        writeHeader(bcfOut, header);
+        while (!atEnd(vcfIn))
+        {
+            resize(records, length(records) + 1);
+            readRecord(back(records), vcfIn);
+            writeRecord(bcfOut, back(records));
+        }
+    }
+
+    seqan::VcfFileIn bcfIn(bcfPath.c_str());
+    SEQAN_ASSERT(isEqual(format(bcfIn), seqan::Bcf()));
+
+    seqan::VcfHeader header2;
+    readHeader(header2, bcfIn);
+    SEQAN_ASSERT_EQ(length(header2), length(header) + 1);
+    SEQAN_ASSERT_EQ(length(sampleNames(context(bcfIn))), 3u);
+
+    seqan::VcfRecord record;
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        SEQAN_ASSERT_NOT(atEnd(bcfIn));
+        readRecord(record, bcfIn);
+        testVcfRecordEqual(record, records[i]);
+    }
+    SEQAN_ASSERT(atEnd(bcfIn));
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // SEQAN_TESTS_VCF_TEST_VCF_IO_H_